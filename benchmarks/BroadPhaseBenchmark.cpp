@@ -0,0 +1,126 @@
+#include <chrono>
+#include <random>
+#include <string>
+#include <vector>
+#include <cstdio>
+#include <algorithm>
+
+#include <Engine/Physics/BroadPhase.hpp>
+
+// Moves boxes around a cube every frame and finds their overlapping pairs both with the incremental sweep and prune
+// and with the brute force reference, timing each and checking they agree.
+// Usage: BroadPhaseBenchmark [proxy count] [frame count]
+
+using Clock = std::chrono::steady_clock;
+
+static bool SortPair(const BroadPhase::Pair& left, const BroadPhase::Pair& right)
+{
+	return left.First < right.First || (left.First == right.First && left.Second < right.Second);
+}
+
+int main(int argc, char** argv)
+{
+	const size_t proxyCount = argc > 1 ? std::stoul(argv[1]) : 2000;
+	const size_t frameCount = argc > 2 ? std::stoul(argv[2]) : 100;
+
+	// Sized so each box overlaps a few others, like bodies resting in a level.
+	const float worldSize = 100.0f;
+	const float boxSize   = 2.0f;
+	const float speed     = 0.25f;
+
+	std::mt19937 random(1234);
+	std::uniform_real_distribution<float> positionDistribution(0.0f, worldSize);
+	std::uniform_real_distribution<float> velocityDistribution(-speed, speed);
+
+	std::vector<glm::vec3> positions(proxyCount);
+	std::vector<glm::vec3> velocities(proxyCount);
+	std::vector<AABB>      bounds(proxyCount);
+
+	for(size_t i = 0; i < proxyCount; i++)
+	{
+		positions[i]  = glm::vec3(positionDistribution(random), positionDistribution(random), positionDistribution(random));
+		velocities[i] = glm::vec3(velocityDistribution(random), velocityDistribution(random), velocityDistribution(random));
+		bounds[i]     = AABB(positions[i], positions[i] + boxSize);
+	}
+
+	BroadPhase broadPhase;
+
+	const Clock::time_point addStart = Clock::now();
+	broadPhase.AddRange(bounds);
+	const double addTime = std::chrono::duration<double, std::milli>(Clock::now() - addStart).count();
+
+	double sweepTime      = 0.0;
+	double bruteForceTime = 0.0;
+	size_t pairTotal      = 0;
+	size_t mismatchCount  = 0;
+
+	{
+		std::vector<BroadPhase::Pair> addedPairs = broadPhase.GetPairs();
+		std::vector<BroadPhase::Pair> bruteForcePairs = BroadPhase::FindPairsBruteForce(bounds);
+
+		std::sort(addedPairs.begin(), addedPairs.end(), SortPair);
+		std::sort(bruteForcePairs.begin(), bruteForcePairs.end(), SortPair);
+
+		if(addedPairs != bruteForcePairs)
+		{
+			++mismatchCount;
+			std::printf("Initial add: sweep and prune found %zu pairs, brute force %zu.\n", addedPairs.size(), bruteForcePairs.size());
+		}
+
+		broadPhase.ClearPairEvents();
+	}
+
+	for(size_t frame = 0; frame < frameCount; frame++)
+	{
+		for(size_t i = 0; i < proxyCount; i++)
+		{
+			positions[i] += velocities[i];
+			for(int axis = 0; axis < 3; axis++)
+			{
+				if(positions[i][axis] < 0.0f || positions[i][axis] > worldSize)
+				{
+					velocities[i][axis] = -velocities[i][axis];
+				}
+			}
+			bounds[i] = AABB(positions[i], positions[i] + boxSize);
+		}
+
+		const Clock::time_point sweepStart = Clock::now();
+		for(size_t i = 0; i < proxyCount; i++)
+		{
+			broadPhase.Update(BroadPhase::ProxyID(i), bounds[i]);
+		}
+		std::vector<BroadPhase::Pair> sweepPairs = broadPhase.GetPairs();
+		broadPhase.ClearPairEvents();
+		sweepTime += std::chrono::duration<double, std::milli>(Clock::now() - sweepStart).count();
+
+		const Clock::time_point bruteForceStart = Clock::now();
+		std::vector<BroadPhase::Pair> bruteForcePairs = BroadPhase::FindPairsBruteForce(bounds);
+		bruteForceTime += std::chrono::duration<double, std::milli>(Clock::now() - bruteForceStart).count();
+
+		std::sort(sweepPairs.begin(), sweepPairs.end(), SortPair);
+		std::sort(bruteForcePairs.begin(), bruteForcePairs.end(), SortPair);
+
+		if(sweepPairs != bruteForcePairs)
+		{
+			++mismatchCount;
+			std::printf("Frame %zu: sweep and prune found %zu pairs, brute force %zu.\n", frame, sweepPairs.size(), bruteForcePairs.size());
+		}
+
+		pairTotal += bruteForcePairs.size();
+	}
+
+	std::printf("%zu proxies, %zu frames, %.1f pairs per frame\n", proxyCount, frameCount, double(pairTotal) / double(std::max<size_t>(frameCount, 1)));
+	std::printf("Initial add:     %10.3f ms\n", addTime);
+	std::printf("Sweep and prune: %10.3f ms per frame\n", sweepTime / double(std::max<size_t>(frameCount, 1)));
+	std::printf("Brute force:     %10.3f ms per frame\n", bruteForceTime / double(std::max<size_t>(frameCount, 1)));
+
+	if(mismatchCount > 0)
+	{
+		std::printf("Pair sets differed in %zu frames.\n", mismatchCount);
+		return 1;
+	}
+
+	std::printf("Pair sets matched in every frame.\n");
+	return 0;
+}
@@ -0,0 +1,170 @@
+varying vec2 v_position;
+
+#ifdef VERTEX_SHADER
+layout(location = 0) in vec2 a_position;
+
+void main()
+{
+	gl_Position = vec4(a_position, 0.0, 1.0);
+	v_position = a_position * 0.5 + 0.5;
+}
+#endif
+
+#ifdef FRAGMENT_SHADER
+
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
+// ClusteredLightData in DeferredRendererSystem.hpp.
+struct ClusteredLight
+{
+	vec4 positionRange;
+	vec4 colorIntensity;
+	vec4 attenuation;     // constant, linear, exponent, range
+	vec4 directionCutoff; // cutoff is -1 for point lights
+};
+
+layout(std430, binding = 1) readonly buffer ClusterLights
+{
+	ClusteredLight lights[];
+};
+
+// Each cluster's offset into the table and light count, followed by the packed light indices of every cluster.
+layout(std430, binding = 2) readonly buffer ClusterTable
+{
+	uint clusterTable[];
+};
+
+uniform ivec4 u_clusterGrid;  // tiles x, tiles y, slices
+uniform vec2  u_clusterDepth; // near distance, slices per unit of log distance
+
+uniform sampler2D u_albedoTexture;
+uniform sampler2D u_normalTexture;
+uniform sampler2D u_positionTexture;
+uniform sampler2D u_specularTexture;
+uniform sampler2D u_depthTexture;
+uniform bool u_compactGBuffer;
+
+// GBufferLayout::Compact, matching GBufferPacking.hpp.
+const float MaxPackedSpecularIntensity = 16.0;
+
+out vec4 o_color;
+
+vec3 DecodeOctahedral(vec2 encoded)
+{
+	vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-normal.z, 0.0);
+	normal.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+	return normalize(normal);
+}
+
+vec3 ReconstructPosition(vec2 texCoord, float depth)
+{
+	vec4 position = u_frame.inverseViewProjection * vec4(vec3(texCoord, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
+
+void ReadGBuffer(vec2 texCoord, out vec3 normal, out vec3 worldPosition, out float specularIntensity)
+{
+	if(u_compactGBuffer)
+	{
+		normal            = DecodeOctahedral(texture(u_normalTexture, texCoord).xy);
+		worldPosition     = ReconstructPosition(texCoord, texture(u_depthTexture, texCoord).r);
+		specularIntensity = texture(u_albedoTexture, texCoord).a * MaxPackedSpecularIntensity;
+	}
+	else
+	{
+		normal            = texture(u_normalTexture, texCoord).xyz;
+		worldPosition     = texture(u_positionTexture, texCoord).xyz;
+		specularIntensity = texture(u_specularTexture, texCoord).r;
+	}
+}
+
+float CalcSpecularFactor(vec3 lightDirection, vec3 surfaceNormal, vec3 worldPosition, vec3 cameraPosition, float specularIntensity)
+{
+	vec3 unitDirection = normalize(lightDirection);
+	vec3 unitNormal    = normalize(surfaceNormal);
+
+	vec3 directionToEye = normalize(cameraPosition - worldPosition);
+	vec3 reflectedDirection = normalize(reflect(unitDirection, unitNormal));
+
+	float specularFactor = dot(directionToEye, reflectedDirection);
+	if(specularFactor < 0.0)
+		return 0.0;
+
+	specularFactor = pow(specularFactor, specularIntensity * 4.0) * specularIntensity;
+
+	return max(specularFactor, 0.0);
+}
+
+float CalcAttenuation(float distanceToPoint, float constant, float linear, float exponent)
+{
+	return constant + linear * distanceToPoint + exponent * distanceToPoint * distanceToPoint + 0.0001;
+}
+
+// Same as LightClusterGrid::GetSlice; the view distance is the clip space w.
+int GetSlice(vec3 worldPosition)
+{
+	float viewDistance = (u_frame.viewProjection * vec4(worldPosition, 1.0)).w;
+	int slice = int(log(max(viewDistance / u_clusterDepth.x, 1.0)) * u_clusterDepth.y);
+	return min(slice, u_clusterGrid.z - 1);
+}
+
+void main()
+{
+	vec3 normal;
+	vec3 worldPosition;
+	float specularIntensity;
+	ReadGBuffer(v_position, normal, worldPosition, specularIntensity);
+
+	ivec2 tile = min(ivec2(v_position * vec2(u_clusterGrid.xy)), u_clusterGrid.xy - 1);
+	int cluster = (GetSlice(worldPosition) * u_clusterGrid.y + tile.y) * u_clusterGrid.x + tile.x;
+
+	uint offset = clusterTable[cluster * 2];
+	uint count  = clusterTable[cluster * 2 + 1];
+
+	vec4 texColor = texture(u_albedoTexture, v_position);
+
+	vec4 result = vec4(0.0);
+	for(uint i = 0u; i < count; i++)
+	{
+		ClusteredLight light = lights[clusterTable[offset + i]];
+
+		vec3 lightDirection = worldPosition - light.positionRange.xyz;
+		float distanceToPoint = length(lightDirection);
+
+		if(distanceToPoint > light.positionRange.w)
+			continue;
+
+		lightDirection = normalize(lightDirection);
+
+		float spotFactor = 1.0;
+		if(light.directionCutoff.w > -1.0)
+		{
+			spotFactor = dot(lightDirection, light.directionCutoff.xyz);
+			if(spotFactor > light.directionCutoff.w)
+				spotFactor = (1.0 - (1.0 - spotFactor) / (1.0 - light.directionCutoff.w));
+			else
+				continue;
+		}
+
+		float diffuseFactor  = max(dot(-lightDirection, normal), 0.0);
+		float specularFactor = CalcSpecularFactor(lightDirection, normal, worldPosition, u_frame.cameraPosition.xyz, specularIntensity);
+
+		vec4 lightColor = vec4(light.colorIntensity.rgb, 1.0) * light.colorIntensity.a * spotFactor;
+
+		float attenuation = CalcAttenuation(distanceToPoint, light.attenuation.x, light.attenuation.y, light.attenuation.z);
+
+		result += (texColor * lightColor * diffuseFactor + lightColor * specularFactor) / attenuation;
+	}
+
+	o_color = result;
+}
+
+#endif
@@ -1,4 +1,4 @@
-#version 330
+#version 420
 
 layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec2 a_texCoord;
@@ -7,12 +7,21 @@ layout(location = 2) in vec3 a_normal;
 layout(location = 4) in mat4 u_worldMatrix;
 layout(location = 8) in mat4 u_WVPMatrix;
 
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
 out vec2 v_texCoord;
 out vec3 v_normal;
 
 void main()
 {
-	gl_Position = u_WVPMatrix * vec4(a_position, 1.0);
+	gl_Position = u_frame.viewProjection * (u_worldMatrix * vec4(a_position, 1.0));
 	v_texCoord  = a_texCoord;
 	v_normal    = normalize((u_worldMatrix * vec4(a_normal, 0.0)).xyz);
 }
\ No newline at end of file
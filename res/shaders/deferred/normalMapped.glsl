@@ -33,6 +33,15 @@ layout(location = 1) in vec2 a_texCoord;
 layout(location = 2) in vec3 a_normal;
 layout(location = 3) in vec3 a_tangent;
 
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
 uniform vec4 u_clippingPlane;
 
 void main()
@@ -42,7 +51,7 @@ void main()
 	vec4 worldPosition = instance.modelMatrix * vec4(a_position, 1.0);
 	gl_ClipDistance[0] = dot(worldPosition, u_clippingPlane);
 
-	gl_Position = instance.mvpMatrix * vec4(a_position, 1.0);
+	gl_Position = u_frame.viewProjection * worldPosition;
 
 	v_texCoord = a_texCoord;
 
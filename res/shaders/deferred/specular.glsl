@@ -34,6 +34,15 @@ layout(location = 2) in vec3 a_normal;
 layout(location = 4) in mat4 u_worldMatrix;
 layout(location = 8) in mat4 u_WVPMatrix;
 
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
 uniform vec4 u_clippingPlane;
 
 void main()
@@ -41,7 +50,7 @@ void main()
 	vec4 worldPosition = u_worldMatrix * vec4(a_position, 1.0);
 	gl_ClipDistance[0] = dot(worldPosition, u_clippingPlane);
 
-	gl_Position = u_WVPMatrix * vec4(a_position, 1.0);
+	gl_Position = u_frame.viewProjection * worldPosition;
 
 	v_texCoord      = a_texCoord;
 	v_normal        = normalize((u_worldMatrix * vec4(a_normal, 0.0)).xyz);
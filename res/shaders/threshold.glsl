@@ -0,0 +1,31 @@
+
+varying vec2 v_position;
+
+#ifdef VERTEX_SHADER
+layout(location = 0) in vec2 a_position;
+
+void main()
+{
+	gl_Position = vec4(a_position, 0.0, 1.0);
+	v_position = a_position * 0.5 + 0.5;
+}
+#endif
+
+#ifdef FRAGMENT_SHADER
+
+uniform sampler2D u_source;
+uniform float u_threshold;
+uniform int u_levels;
+
+out vec4 o_color;
+
+void main()
+{
+	vec3 color = texture(u_source, v_position).rgb;
+	if(color.r < u_threshold && color.g < u_threshold && color.b < u_threshold)
+		color = vec3(0.0, 0.0, 0.0);
+
+	color /= u_levels;
+	o_color = vec4(color, 1.0);
+}
+#endif
\ No newline at end of file
@@ -74,6 +74,11 @@ namespace ECS
 			m_freeEntitySlots.insert(handle.m_index);
 		}
 
+		for(const auto& [type, index] : entity->ComponentIndices)
+		{
+			m_components.at(type)->Remove(index);
+		}
+
 		entity->~EntityData();
 		m_subscribedEvents.erase(handle.Version());
 	}
@@ -1,12 +1,14 @@
 #include "AssimpMeshLoader.hpp"
 
 #include "../Scene.hpp"
+#include "../../Rendering/MeshOptimizer.hpp"
+#include "../../Rendering/CompactVertex.hpp"
 
 #include "assimp/Importer.hpp"
 #include "assimp/postprocess.h"
 #include "assimp/scene.h"
 
-static Model ProcessModel(const aiMesh* mesh)
+static Model ProcessModel(const aiMesh* mesh, bool compactVertices)
 {
     std::vector<DefaultVertex> vertices;
     std::vector<uint32_t> indices;
@@ -53,20 +55,34 @@ static Model ProcessModel(const aiMesh* mesh)
         }
     }
 
+    const MeshOptimizationReport report = MeshOptimizer::Optimize(vertices, indices);
+    std::cout << "Optimized mesh " << mesh->mName.C_Str() << ": " << report.VertexCountBefore << " -> " << report.VertexCountAfter << " vertices, "
+              << "ACMR " << report.Before.ACMR << " -> " << report.After.ACMR << ", ATVR " << report.Before.ATVR << " -> " << report.After.ATVR << std::endl;
+
+    if(compactVertices)
+    {
+        CompactEncodingError error;
+        Model result = EncodeCompactModel(vertices, indices, &error);
+
+        std::cout << "Compacted mesh " << mesh->mName.C_Str() << ": position error " << error.Position << ", texture coordinate error " << error.TexCoord
+                  << ", normal error " << error.NormalDegrees << " degrees, tangent error " << error.TangentDegrees << " degrees" << std::endl;
+        return result;
+    }
+
     return Model(vertices, indices);
 }
 
-static void ProcessNode(std::vector<Model>& models, aiNode *node, const aiScene *scene)
+static void ProcessNode(std::vector<Model>& models, aiNode *node, const aiScene *scene, bool compactVertices)
 {
     for(size_t i = 0; i < node->mNumMeshes; i++)
     {
         const aiMesh* mesh = scene->mMeshes[node->mMeshes[i]];
-        models.push_back(ProcessModel(mesh));
+        models.push_back(ProcessModel(mesh, compactVertices));
     }
 
     for(size_t i = 0; i < node->mNumChildren; i++)
     {
-        ProcessNode(models, node->mChildren[i], scene);
+        ProcessNode(models, node->mChildren[i], scene, compactVertices);
     }
 }
 
@@ -92,6 +108,6 @@ Model AssimpModelLoader::Load(const std::filesystem::path& path, bool smoothNorm
     }
 
     std::vector<Model> models;
-    ProcessNode(models, assimpScene->mRootNode, assimpScene);
+    ProcessNode(models, assimpScene->mRootNode, assimpScene, CompactVertices);
     return models[0];
 }
@@ -4,5 +4,8 @@
 
 struct AssimpModelLoader final : ModelLoaderBase
 {
+    // Imports into CompactVertex, which takes less than half the memory and bandwidth of DefaultVertex.
+    bool CompactVertices = false;
+
     [[nodiscard]] Model Load(const std::filesystem::path& path, bool smoothNormals) const override;
 };
@@ -6,15 +6,30 @@
 
 #include "Reflection.hpp"
 
+// Vertex attribute element types without a C++ arithmetic equivalent, stored as their raw bits.
+struct HalfFloat
+{
+	uint16_t Bits;
+};
+
+// Four signed components of 10, 10, 10 and 2 bits in one 32-bit word, x in the lowest bits. Used with a count of 1.
+struct PackedSnorm1010102
+{
+	uint32_t Bits;
+};
+
 struct BufferAttribute
 {
-	BufferAttribute(TypeInfo* type, size_t count, size_t offset) :
-		ElementType(type), Count(count), Offset(offset) {}
+	BufferAttribute(TypeInfo* type, size_t count, size_t offset, bool normalized) :
+		ElementType(type), Count(count), Offset(offset), Normalized(normalized) {}
 
 	TypeInfo* ElementType;
 	size_t    Count;
 	size_t    Offset;
 
+	// Integer elements are read as floats in [0, 1] (unsigned) or [-1, 1] (signed).
+	bool Normalized;
+
 	[[nodiscard]] size_t SizeInBytes() const { return Count * ElementType->Size; }
 };
 
@@ -23,16 +38,28 @@ class BufferLayout
 public:
 	BufferLayout() : m_stride(0) {}
 
-	void AddAttribute(TypeInfo* type, size_t count)
+	void AddAttribute(TypeInfo* type, size_t count, bool normalized = false)
 	{
-		const auto& element = m_attributes.emplace_back(type, count, m_stride);
+		const auto& element = m_attributes.emplace_back(type, count, m_stride, normalized);
 		m_stride += element.SizeInBytes();
 	}
 
 	[[nodiscard]] size_t GetStride() const { return m_stride; }
 
+	// Scalars and glm vectors and matrices become that many elements of their component type; other types are one
+	// element of themselves.
 	template<ShallowCopyable T>
-	void AddAttribute() {}
+	void AddAttribute(bool normalized = false)
+	{
+		if constexpr(requires { typename T::value_type; })
+		{
+			AddAttribute(TypeInfo::Get<typename T::value_type>(), sizeof(T) / sizeof(typename T::value_type), normalized);
+		}
+		else
+		{
+			AddAttribute(TypeInfo::Get<T>(), 1, normalized);
+		}
+	}
 
 	[[nodiscard]] auto begin() const { return m_attributes.begin(); }
 	[[nodiscard]] auto end()   const { return m_attributes.end();   }
@@ -265,6 +292,8 @@ public:
 
 	[[nodiscard]] size_t Count() const { return m_count; }
 
+	[[nodiscard]] size_t SizeInBytes() const { return m_elementType ? m_count * m_elementType->Size : 0; }
+
 	void* Data() const { return m_address; }
 
 	[[nodiscard]] TypeInfo* GetLayout() const { return m_elementType; }
@@ -299,18 +328,20 @@ public:
 	ConstDynamicBufferSlice(BufferSlice<TElement> array) :
 		m_address(array.Data()),
 		m_count(array.Count()),
-		m_elementType() {}
+		m_elementType(TypeInfo::Get<TElement>()) {}
 
 	template<ShallowCopyable TElement>
 	ConstDynamicBufferSlice(ConstBufferSlice<TElement> array) :
 		m_address(array.Data()),
 		m_count(array.Count()),
-		m_elementType(&array.GetLayout()) {}
+		m_elementType(TypeInfo::Get<TElement>()) {}
 
 	operator bool() const { return m_address; }
 
 	[[nodiscard]] size_t Count() const { return m_count; }
 
+	[[nodiscard]] size_t SizeInBytes() const { return m_elementType ? m_count * m_elementType->Size : 0; }
+
 	[[nodiscard]] const void* Data() const { return m_address; }
 
 	[[nodiscard]] TypeInfo* GetLayout() const { return m_elementType; }
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <mutex>
+#include <vector>
+#include <cstdint>
+#include <condition_variable>
+
+// Fixed ring of slots handed from one producer thread to one consumer thread. Slots are reused in order and never
+// cleared, so a slot still holds its capacity from the last time it was written. The producer blocks while every
+// slot is either waiting to be read or being read.
+template<typename T>
+class ExtractionRing
+{
+public:
+	explicit ExtractionRing(size_t slotCount = 2) : m_slots(slotCount), m_writeCount(0), m_readCount(0), m_isClosed(false) {}
+
+	ExtractionRing(const ExtractionRing&) = delete;
+	ExtractionRing& operator=(const ExtractionRing&) = delete;
+
+	[[nodiscard]] size_t SlotCount() const { return m_slots.size(); }
+
+	[[nodiscard]] size_t ReadyCount() const
+	{
+		std::lock_guard lock(m_mutex);
+		return m_writeCount - m_readCount;
+	}
+
+	// Returns null once the ring is closed.
+	T* BeginWrite()
+	{
+		std::unique_lock lock(m_mutex);
+		m_condition.wait(lock, [this]() { return m_isClosed || m_writeCount - m_readCount < m_slots.size(); });
+
+		return m_isClosed ? nullptr : &m_slots[m_writeCount % m_slots.size()];
+	}
+
+	void EndWrite()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			++m_writeCount;
+		}
+
+		m_condition.notify_all();
+	}
+
+	// Oldest written slot, or null when none is ready.
+	T* TryBeginRead()
+	{
+		std::lock_guard lock(m_mutex);
+		return m_writeCount > m_readCount ? &m_slots[m_readCount % m_slots.size()] : nullptr;
+	}
+
+	void EndRead()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			++m_readCount;
+		}
+
+		m_condition.notify_all();
+	}
+
+	// Drops every written slot that is not being read. Must not be called between TryBeginRead and EndRead.
+	void Discard()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_readCount = m_writeCount;
+		}
+
+		m_condition.notify_all();
+	}
+
+	void Close()
+	{
+		{
+			std::lock_guard lock(m_mutex);
+			m_isClosed = true;
+		}
+
+		m_condition.notify_all();
+	}
+private:
+	std::vector<T> m_slots;
+
+	uint64_t m_writeCount;
+	uint64_t m_readCount;
+
+	bool m_isClosed;
+
+	mutable std::mutex      m_mutex;
+	std::condition_variable m_condition;
+};
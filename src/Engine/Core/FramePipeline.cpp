@@ -0,0 +1,66 @@
+#include "FramePipeline.hpp"
+
+FramePipeline::FramePipeline(SimulateFunction simulate, size_t slotCount) :
+	m_ring(slotCount), m_simulate(std::move(simulate)), m_isSimulating(false), m_isRunning(true)
+{
+	m_thread = std::thread(&FramePipeline::SimulationLoop, this);
+}
+
+FramePipeline::~FramePipeline()
+{
+	EndSimulation();
+
+	{
+		std::lock_guard lock(m_mutex);
+		m_isRunning = false;
+	}
+
+	m_condition.notify_all();
+	m_ring.Close();
+	m_thread.join();
+}
+
+void FramePipeline::BeginSimulation()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_isSimulating = true;
+	}
+
+	m_condition.notify_all();
+}
+
+void FramePipeline::EndSimulation()
+{
+	std::unique_lock lock(m_mutex);
+	m_condition.wait(lock, [this]() { return !m_isSimulating; });
+}
+
+void FramePipeline::SimulationLoop()
+{
+	while(true)
+	{
+		{
+			std::unique_lock lock(m_mutex);
+			m_condition.wait(lock, [this]() { return m_isSimulating || !m_isRunning; });
+
+			if(!m_isRunning)
+			{
+				return;
+			}
+		}
+
+		if(RenderSnapshot* snapshot = m_ring.BeginWrite())
+		{
+			m_simulate(*snapshot);
+			m_ring.EndWrite();
+		}
+
+		{
+			std::lock_guard lock(m_mutex);
+			m_isSimulating = false;
+		}
+
+		m_condition.notify_all();
+	}
+}
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <mutex>
+#include <thread>
+#include <functional>
+#include <condition_variable>
+
+#include "ExtractionRing.hpp"
+#include "RenderSnapshot.hpp"
+
+// Two-stage frame pipeline. Between BeginSimulation and EndSimulation the simulation thread runs the simulate
+// function, which updates the scene and extracts the frame into a ring slot, while the calling thread submits the
+// snapshot extracted the frame before. Outside of that window the calling thread has the scene to itself, which is
+// when input is processed and the UI runs. Rendering therefore trails simulation by one frame.
+class FramePipeline
+{
+public:
+	using SimulateFunction = std::function<void(RenderSnapshot& snapshot)>;
+
+	explicit FramePipeline(SimulateFunction simulate, size_t slotCount = 2);
+
+	~FramePipeline();
+
+	FramePipeline(const FramePipeline&) = delete;
+	FramePipeline& operator=(const FramePipeline&) = delete;
+
+	void BeginSimulation();
+
+	void EndSimulation();
+
+	// Oldest extracted snapshot that has not been submitted, or null. Release it before the next BeginSimulation.
+	RenderSnapshot* AcquireSnapshot() { return m_ring.TryBeginRead(); }
+
+	void ReleaseSnapshot() { m_ring.EndRead(); }
+
+	// Drops extracted snapshots, e.g. when the scene they came from is no longer on top.
+	void Discard() { m_ring.Discard(); }
+private:
+	ExtractionRing<RenderSnapshot> m_ring;
+
+	SimulateFunction m_simulate;
+
+	std::mutex              m_mutex;
+	std::condition_variable m_condition;
+
+	bool m_isSimulating;
+	bool m_isRunning;
+
+	std::thread m_thread;
+
+	void SimulationLoop();
+};
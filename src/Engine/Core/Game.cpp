@@ -1,4 +1,5 @@
 #include "Game.hpp"
+#include "FramePipeline.hpp"
 
 std::vector<Timer*> Timer::s_timers;
 
@@ -62,12 +63,53 @@ void Game::Start(Application& app) const
 	UIContext uiContext(app.GetKeyboard(), app.GetMouse(), renderContext, defaultTheme);
 
 	const Duration frameTime = Duration::FromSeconds(1) / Settings.FrameRate;
+	const float    frameDelta = static_cast<float>(frameTime.TotalSeconds());
 
 	uint32_t fps = 0;
 	auto lastTime = Clock::CurrentTime();
 	auto fpsTimeCounter = Duration::Zero();
 	auto updateTimer = Duration::FromSeconds(1);
 
+	Timer inputLatencyTimer("Input Latency");
+
+	auto reportStatistics = [&]()
+	{
+		if(fpsTimeCounter.TotalSeconds() >= 1.0)
+		{
+			std::cout << "FPS: " << fps << std::endl;
+
+			for(Timer* timer : Timer::GetTimers())
+			{
+				std::cout << timer->Name << ": " << timer->GetSamplesAverage().TotalMilliSeconds() << "ms" << std::endl;
+			}
+			fpsTimeCounter = Duration::Zero();
+			fps = 0;
+		}
+	};
+
+	// Written before BeginSimulation and read by the simulation thread until EndSimulation.
+	SceneHandle simulatedScene;
+	size_t      simulationSteps = 0;
+	TimeStamp   inputTime = Clock::CurrentTime();
+
+	std::unique_ptr<FramePipeline> pipeline;
+	if(Settings.PipelinedRendering)
+	{
+		pipeline = std::make_unique<FramePipeline>([&](RenderSnapshot& snapshot)
+		{
+			for(size_t i = 0; i < simulationSteps; i++)
+			{
+				simulatedScene->Update(frameDelta, app.GetKeyboard(), app.GetMouse());
+
+				app.GetKeyboard().Update();
+				app.GetMouse().Update();
+			}
+
+			simulatedScene->Extract(snapshot);
+			snapshot.InputTime = inputTime;
+		});
+	}
+
 	bool running = true;
 	while(running)
 	{
@@ -78,6 +120,71 @@ void Game::Start(Application& app) const
 		updateTimer    += passedTime;
 		fpsTimeCounter += passedTime;
 
+		SceneHandle scene = scenes.top();
+		if(pipeline && scene->CanExtract())
+		{
+			if(updateTimer < frameTime)
+			{
+				continue;
+			}
+
+			if(scene != simulatedScene)
+			{
+				pipeline->Discard();
+				simulatedScene = scene;
+			}
+
+			running = app.ProcessEvents();
+			inputTime = Clock::CurrentTime();
+
+			simulationSteps = 0;
+			while(updateTimer >= frameTime)
+			{
+				updateTimer -= frameTime;
+				++simulationSteps;
+			}
+
+			pipeline->BeginSimulation();
+
+			RenderSnapshot* snapshot = pipeline->AcquireSnapshot();
+			if(snapshot)
+			{
+				ScopeTimer timer(totalRenderTimer);
+				scene->Submit(*snapshot, renderDevice, renderContext, *renderDevice.ScreenBuffer);
+			}
+
+			pipeline->EndSimulation();
+
+			// The simulation thread is idle from here on, so the scene's own drawing and the UI can read the scene.
+			uiContext.ShouldRender = false;
+			scene->UpdateAndRenderUI(uiContext);
+
+			if(snapshot)
+			{
+				scene->OnRender(renderDevice, renderContext, *renderDevice.ScreenBuffer);
+				renderContext.Flush();
+
+				uiContext.ShouldRender = true;
+				scene->UpdateAndRenderUI(uiContext);
+
+				app.SwapBuffers();
+				renderDevice.TargetPool.EndFrame();
+				inputLatencyTimer.AddSample(Clock::CurrentTime() - snapshot->InputTime);
+
+				pipeline->ReleaseSnapshot();
+				fps++;
+			}
+
+			reportStatistics();
+			continue;
+		}
+
+		if(simulatedScene)
+		{
+			pipeline->Discard();
+			simulatedScene = nullptr;
+		}
+
 		uiContext.ShouldRender = false;
 		while(updateTimer >= frameTime)
 		{
@@ -86,8 +193,9 @@ void Game::Start(Application& app) const
 			updateTimer -= frameTime;
 
 			running = running && app.ProcessEvents();
+			inputTime = Clock::CurrentTime();
 
-			scenes.top()->Update(static_cast<float>(frameTime.TotalSeconds()), app.GetKeyboard(), app.GetMouse());
+			scenes.top()->Update(frameDelta, app.GetKeyboard(), app.GetMouse());
 			scenes.top()->UpdateAndRenderUI(uiContext);
 
 			uiContext.ShouldRender = true;
@@ -95,17 +203,7 @@ void Game::Start(Application& app) const
 			app.GetKeyboard().Update();
 			app.GetMouse().Update();
 
-			if(fpsTimeCounter.TotalSeconds() >= 1.0)
-			{
-				std::cout << "FPS: " << fps << std::endl;
-
-				for(Timer* timer : Timer::GetTimers())
-				{
-					std::cout << timer->Name << ": " << timer->GetSamplesAverage().TotalMilliSeconds() << "ms" << std::endl;
-				}
-				fpsTimeCounter = Duration::Zero();
-				fps = 0;
-			}
+			reportStatistics();
 		}
 
 		if(uiContext.ShouldRender)
@@ -129,6 +227,8 @@ void Game::Start(Application& app) const
 			scenes.top()->UpdateAndRenderUI(uiContext);
 
 			app.SwapBuffers();
+			renderDevice.TargetPool.EndFrame();
+			inputLatencyTimer.AddSample(Clock::CurrentTime() - inputTime);
 			fps++;
 		}
 	}
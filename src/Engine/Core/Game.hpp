@@ -12,16 +12,21 @@
 class GameSettings
 {
 public:
-	GameSettings(ScreenGraphicsMode graphicsMode, std::string title, SceneHandle  startScene, double frameRate = 60.0) :
+	GameSettings(ScreenGraphicsMode graphicsMode, std::string title, SceneHandle  startScene, double frameRate = 60.0, bool pipelinedRendering = false) :
 		GraphicsMode(graphicsMode),
 		Title(std::move(title)),
 		StartScene(std::move(startScene)),
-		FrameRate(frameRate) {}
+		FrameRate(frameRate),
+		PipelinedRendering(pipelinedRendering) {}
 
 	ScreenGraphicsMode GraphicsMode;
 	std::string        Title;
 	SceneHandle        StartScene;
 	double             FrameRate;
+
+	// Simulates the next frame on a separate thread while the current one is submitted, trading a frame of latency
+	// for throughput. Scenes whose renderer systems cannot all extract a RenderSnapshot still run single-threaded.
+	bool PipelinedRendering;
 };
 
 class Timer
@@ -0,0 +1,81 @@
+#include "JobSystem.hpp"
+
+JobSystem::JobSystem(size_t workerCount) : m_isRunning(true)
+{
+	m_workers.reserve(workerCount);
+	for(size_t i = 0; i < workerCount; i++)
+	{
+		m_workers.emplace_back(&JobSystem::WorkerLoop, this);
+	}
+}
+
+JobSystem::~JobSystem()
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_isRunning = false;
+	}
+
+	m_condition.notify_all();
+
+	for(std::thread& worker : m_workers)
+	{
+		worker.join();
+	}
+}
+
+JobSystem& JobSystem::Get()
+{
+	static JobSystem s_instance;
+	return s_instance;
+}
+
+void JobSystem::Submit(std::function<void()> job)
+{
+	{
+		std::lock_guard lock(m_mutex);
+		m_jobs.push_back(std::move(job));
+	}
+
+	m_condition.notify_one();
+}
+
+bool JobSystem::TryRunJob()
+{
+	std::function<void()> job;
+	{
+		std::lock_guard lock(m_mutex);
+		if(m_jobs.empty())
+		{
+			return false;
+		}
+
+		job = std::move(m_jobs.front());
+		m_jobs.pop_front();
+	}
+
+	job();
+	return true;
+}
+
+void JobSystem::WorkerLoop()
+{
+	while(true)
+	{
+		std::function<void()> job;
+		{
+			std::unique_lock lock(m_mutex);
+			m_condition.wait(lock, [this]() { return !m_isRunning || !m_jobs.empty(); });
+
+			if(!m_isRunning && m_jobs.empty())
+			{
+				return;
+			}
+
+			job = std::move(m_jobs.front());
+			m_jobs.pop_front();
+		}
+
+		job();
+	}
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <mutex>
+#include <algorithm>
+#include <deque>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <concepts>
+#include <functional>
+#include <condition_variable>
+
+class JobSystem
+{
+public:
+	explicit JobSystem(size_t workerCount = DefaultWorkerCount());
+
+	~JobSystem();
+
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator=(const JobSystem&) = delete;
+
+	static JobSystem& Get();
+
+	static size_t DefaultWorkerCount() { return std::max(1U, std::thread::hardware_concurrency()) - 1; }
+
+	[[nodiscard]] size_t WorkerCount() const { return m_workers.size(); }
+
+	// Calls function(begin, end) over [0, count) in batches of batchSize. The calling thread takes batches too and
+	// runs other queued jobs while it waits, so nested calls cannot deadlock.
+	template<std::invocable<size_t, size_t> TFunction>
+	void ParallelFor(size_t count, size_t batchSize, TFunction&& function)
+	{
+		if(count == 0)
+		{
+			return;
+		}
+
+		batchSize = std::max<size_t>(batchSize, 1);
+
+		const size_t batchCount  = (count + batchSize - 1) / batchSize;
+		const size_t helperCount = std::min(m_workers.size(), batchCount - 1);
+
+		std::atomic<size_t> nextBatch(0);
+		std::atomic<size_t> runningHelpers(helperCount);
+
+		auto runBatches = [&]()
+		{
+			for(size_t batch = nextBatch++; batch < batchCount; batch = nextBatch++)
+			{
+				const size_t begin = batch * batchSize;
+				function(begin, std::min(begin + batchSize, count));
+			}
+		};
+
+		for(size_t i = 0; i < helperCount; i++)
+		{
+			Submit([&]()
+			{
+				runBatches();
+				--runningHelpers;
+			});
+		}
+
+		runBatches();
+
+		while(runningHelpers > 0)
+		{
+			if(!TryRunJob())
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+private:
+	std::vector<std::thread>          m_workers;
+	std::deque<std::function<void()>> m_jobs;
+
+	std::mutex              m_mutex;
+	std::condition_variable m_condition;
+
+	bool m_isRunning;
+
+	void Submit(std::function<void()> job);
+
+	bool TryRunJob();
+
+	void WorkerLoop();
+};
@@ -0,0 +1,77 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <unordered_map>
+
+#include <Common.hpp>
+
+#include "Camera.hpp"
+#include "Timing.hpp"
+
+struct RendererSystem;
+
+struct CameraSnapshot
+{
+	CameraSnapshot() :
+		View(glm::identity<glm::mat4>()), Projection(glm::identity<glm::mat4>()), ViewProjection(glm::identity<glm::mat4>()),
+		Position(0.0f), Rotation(glm::identity<glm::quat>()) {}
+
+	explicit CameraSnapshot(const Camera& camera) :
+		View(camera.GetViewMatrix()),
+		Projection(camera.GetProjection().Matrix),
+		ViewProjection(Projection * View),
+		Position(camera.GetTransformation().GetTransformedPosition()),
+		Rotation(camera.GetTransformation().GetTransformedRotation()) {}
+
+	glm::mat4 View;
+	glm::mat4 Projection;
+	glm::mat4 ViewProjection;
+	glm::vec3 Position;
+	glm::quat Rotation;
+};
+
+// Render state of one simulated frame: the camera plus whatever each renderer system copied out of the scene in
+// OnExtract. Renderer systems keep their copies in per-system storage that lives as long as the snapshot, so a
+// snapshot reused from an ExtractionRing extracts into vectors that already have their capacity.
+class RenderSnapshot
+{
+public:
+	RenderSnapshot() : FrameIndex(0), Source(nullptr), InputTime(Clock::CurrentTime()) {}
+
+	uint64_t FrameIndex;
+
+	// The scene the snapshot was extracted from; a snapshot is only ever submitted by that scene.
+	const void* Source;
+
+	// When the input the frame simulated was sampled, used to measure input-to-present latency.
+	TimeStamp InputTime;
+
+	CameraSnapshot Camera;
+
+	// The renderer systems that extracted into this snapshot, in submission order.
+	std::vector<RendererSystem*> Systems;
+
+	template<typename TData>
+	TData& GetData(const RendererSystem& system)
+	{
+		std::shared_ptr<void>& data = m_data[&system];
+		if(!data)
+		{
+			data = std::make_shared<TData>();
+		}
+
+		return *static_cast<TData*>(data.get());
+	}
+
+	template<typename TData>
+	const TData& GetData(const RendererSystem& system) const
+	{
+		const auto it = m_data.find(&system);
+		DEBUG_ASSERT(it != m_data.end(), "The renderer system did not extract into this snapshot.");
+		return *static_cast<const TData*>(it->second.get());
+	}
+private:
+	std::unordered_map<const RendererSystem*, std::shared_ptr<void>> m_data;
+};
@@ -6,9 +6,13 @@
 
 #include <string>
 #include <fstream>
+#include <algorithm>
 #include <stb_image.h>
 
 #include "../Rendering/RenderContext2D.hpp"
+#include "../Rendering/MeshOptimizer.hpp"
+#include "../Rendering/MeshSimplifier.hpp"
+#include "../EngineComponents/LODGroup.hpp"
 #include "../Json/Json.hpp"
 #include <Engine/Json/ValueBase.hpp>
 #include <utility>
@@ -45,6 +49,68 @@ void Scene::Render(RenderDevice& renderDevice, RenderContext2D& renderContext2D,
 	OnRender(renderDevice, renderContext2D, target);
 }
 
+bool Scene::CanExtract() const
+{
+	return std::ranges::all_of(m_rendererSystems, [](const auto& system) { return !system->IsEnabled || system->CanExtract(); });
+}
+
+void Scene::Extract(RenderSnapshot& snapshot)
+{
+	snapshot.FrameIndex = ++m_extractedFrameCount;
+	snapshot.Source     = this;
+	snapshot.Camera     = CameraSnapshot(PrimaryCamera);
+
+	snapshot.Systems.clear();
+	for(const auto& system : m_rendererSystems)
+	{
+		if(system->IsEnabled)
+		{
+			system->OnExtract(*this, snapshot);
+			snapshot.Systems.push_back(system.get());
+		}
+	}
+}
+
+void Scene::Submit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target)
+{
+	DEBUG_ASSERT(snapshot.Source == this, "The snapshot was extracted from another scene.");
+
+	m_frameGraph.Reset();
+
+	const FrameGraphTarget output = m_frameGraph.ImportTarget("Target", target, ColorBuffer);
+	m_frameGraph.AddPass("Clear target", [output](FrameGraphBuilder& builder) { builder.Clear(output, ColorBuffer | DepthBuffer); });
+
+	for(RendererSystem* system : snapshot.Systems)
+	{
+		system->OnSetupPasses(snapshot, m_frameGraph, output, renderContext2D);
+	}
+
+	m_frameGraph.Compile();
+	m_frameGraph.Execute(renderDevice);
+}
+
+void RendererSystem::OnSetupPasses(const RenderSnapshot& snapshot, FrameGraph& graph, FrameGraphTarget target, RenderContext2D& renderContext2D)
+{
+	graph.AddPass("Submit", [target](FrameGraphBuilder& builder)
+	{
+		builder.Write(target, ColorBuffer | DepthBuffer);
+		builder.SetSideEffects();
+	},
+	[this, &snapshot, &renderContext2D, target](RenderDevice& renderDevice, const FrameGraph& graph)
+	{
+		OnSubmit(snapshot, renderDevice, renderContext2D, graph.GetTarget(target));
+	});
+}
+
+void ExtractingRendererSystem::OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target)
+{
+	m_snapshot.Source = &scene;
+	m_snapshot.Camera = CameraSnapshot(scene.PrimaryCamera);
+
+	OnExtract(scene, m_snapshot);
+	OnSubmit(m_snapshot, renderDevice, renderContext2D, target);
+}
+
 void Scene::UpdateAndRenderUI(UIContext& context)
 {
 	OnUIRender(context);
@@ -84,6 +150,11 @@ RenderTargetHandle Scene::CreateRenderTarget(uint32_t width, uint32_t height, co
 	return m_app->GetRenderDevice().CreateRenderTarget(width, height, colorAttachments, depthAttachment);
 }
 
+RenderTargetArrayHandle Scene::CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment) const
+{
+	return m_app->GetRenderDevice().CreateRenderTargetArray(width, height, layerCount, depthAttachment);
+}
+
 ShaderHandle Scene::CreateShader(std::string_view sourceCode) const
 {
 	return m_app->GetRenderDevice().CreateShader(sourceCode);
@@ -357,6 +428,8 @@ MeshHandle Scene::CreateCone(uint32_t detail) const
     }
 
 	CalculateNormals(vertices, indices);
+
+	MeshOptimizer::Optimize(vertices, indices);
 	return CreateMesh(Model(vertices, indices));
 }
 
@@ -432,16 +505,16 @@ MeshHandle Scene::CreateCylinder(uint32_t detail) const
     }
 
 	CalculateNormals(vertices, indices);
+
+	MeshOptimizer::Optimize(vertices, indices);
 	return CreateMesh(Model(vertices, indices));
 }
 
-MeshHandle Scene::CreateSphere(uint32_t detail) const
+static void GenerateSphere(uint32_t detail, std::vector<DefaultVertex>& vertices, std::vector<uint32_t>& indices)
 {
 	uint32_t sectorCount = detail;
     uint32_t stackCount  = detail;
 
-    std::vector<DefaultVertex> vertices;
-
 	const float sectorStep = 2 * glm::pi<float>() / static_cast<float>(sectorCount);
     const float stackStep = glm::pi<float>() / static_cast<float>(stackCount);
 
@@ -470,8 +543,6 @@ MeshHandle Scene::CreateSphere(uint32_t detail) const
         }
     }
 
-	std::vector<uint32_t> indices;
-
 	for(uint32_t i = 0; i < stackCount; ++i)
     {
         uint32_t k1 = i * (sectorCount + 1);
@@ -495,9 +566,37 @@ MeshHandle Scene::CreateSphere(uint32_t detail) const
         }
     }
 
+	MeshOptimizer::Optimize(vertices, indices);
+}
+
+MeshHandle Scene::CreateSphere(uint32_t detail) const
+{
+	std::vector<DefaultVertex> vertices;
+	std::vector<uint32_t> indices;
+	GenerateSphere(detail, vertices, indices);
 	return CreateMesh(Model(vertices, indices));
 }
 
+LODGroup Scene::CreateSphereLODGroup(uint32_t detail, size_t levelCount) const
+{
+	std::vector<DefaultVertex> vertices;
+	std::vector<uint32_t> indices;
+	GenerateSphere(detail, vertices, indices);
+	return CreateLODGroup(MeshSimplifier::BuildLODChain(vertices, indices, levelCount));
+}
+
+LODGroup Scene::CreateLODGroup(const std::vector<LODModel>& chain, float hysteresis) const
+{
+	std::vector<LODLevel> levels;
+	levels.reserve(chain.size());
+	for(const LODModel& level : chain)
+	{
+		levels.emplace_back(CreateMesh(level.Geometry), level.Error);
+	}
+
+	return LODGroup(levels, hysteresis);
+}
+
 MeshHandle Scene::CreateTerrain(const HeightMap& heightMap) const
 {
 	std::vector<DefaultVertex> vertices;
@@ -539,6 +638,7 @@ MeshHandle Scene::CreateTerrain(const HeightMap& heightMap) const
 	CalculateNormals(vertices, indices);
 	CalculateTangents(vertices, indices);
 	
+	MeshOptimizer::Optimize(vertices, indices);
 	return CreateMesh(Model(vertices, indices));
 }
 
@@ -17,6 +17,9 @@
 class Application;
 class Scene;
 
+struct LODGroup;
+struct LODModel;
+
 using SceneHandle = std::shared_ptr<Scene>;
 
 struct DefaultVertex
@@ -120,6 +123,7 @@ public:
 	                                 MagFilterMode magFilter = MagFilterMode::Linear,
 	                                 TextureWrappingMode wrappingMode = TextureWrappingMode::ClampedToEdge) const;
 	RenderTargetHandle CreateRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachments) const;
+	RenderTargetArrayHandle CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment) const;
 		  ShaderHandle CreateShader(std::string_view sourceCode) const;
 			FontHandle CreateFont(const BitmapBase& image, std::istream& jsonStream) const;
 	       SoundHandle CreateSound(ConstBufferSlice<float> samples) const;
@@ -132,6 +136,9 @@ public:
 	MeshHandle CreateSphere(uint32_t detail = 60) const;
 	MeshHandle CreateTerrain(const HeightMap& heightMap) const;
 
+	LODGroup CreateSphereLODGroup(uint32_t detail = 60, size_t levelCount = 4) const;
+	LODGroup CreateLODGroup(const std::vector<LODModel>& chain, float hysteresis = 0.25f) const;
+
 	AssetFolder RootAssetFolder;
 
 	void  PlayMusic(MusicHandle music, bool loop);
@@ -144,6 +151,9 @@ public:
 
 	void SetMusicPosition(float seconds) { m_app->GetAudioDevice().SetMusicPosition(seconds); }
 
+	// The passes of the last submitted frame. Submit rebuilds it on the render thread, so only read it between frames.
+	[[nodiscard]] const FrameGraph& GetFrameGraph() const { return m_frameGraph; }
+
 	friend struct Game;
 private:
 	Application* m_app;
@@ -161,8 +171,18 @@ private:
 
 	bool m_isMusicPaused;
 
+	uint64_t m_extractedFrameCount = 0;
+
+	FrameGraph m_frameGraph;
+
 	void Start(Application* app, std::stack<SceneHandle>* scenes);
 	void Update(float delta, KeyboardDevice& keyboard, MouseDevice& mouse);
+
+	// Pipelined rendering: Extract runs after Update on the simulation thread, Submit draws the snapshot on the
+	// render thread. The scene's own OnRender reads the scene, so the game calls it once the simulation has stopped.
+	[[nodiscard]] bool CanExtract() const;
+	void Extract(RenderSnapshot& snapshot);
+	void Submit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target);
 };
 
 // template<typename Pixel>
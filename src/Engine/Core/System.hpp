@@ -2,6 +2,8 @@
 
 #include "../Core/Input.hpp"
 #include "../Rendering/RenderContext2D.hpp"
+#include "../Rendering/FrameGraph.hpp"
+#include "RenderSnapshot.hpp"
 
 class Scene;
 
@@ -22,6 +24,34 @@ struct UpdaterSystem : System
 struct RendererSystem : System
 {
 	virtual void OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) = 0;
+
+	// Pipelined rendering splits a frame at OnExtract, which copies what the system draws out of the scene on the
+	// simulation thread. OnSubmit draws from that copy on the render thread while the next frame simulates, so it
+	// must not read the scene. A scene with any enabled system that cannot extract renders single-threaded.
+	[[nodiscard]] virtual bool CanExtract() const { return false; }
+
+	virtual void OnExtract(Scene& scene, RenderSnapshot& snapshot) {}
+
+	virtual void OnSubmit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) {}
+
+	// Declares what OnSubmit draws as passes of the scene's frame graph. The default is one pass that runs OnSubmit
+	// and draws over target's color and depth; systems declaring their own passes let the graph cull their unused
+	// passes and drop the clears and copies other passes make redundant.
+	virtual void OnSetupPasses(const RenderSnapshot& snapshot, FrameGraph& graph, FrameGraphTarget target, RenderContext2D& renderContext2D);
+};
+
+// A renderer system that always draws through a snapshot; single-threaded frames extract into a private one.
+struct ExtractingRendererSystem : RendererSystem
+{
+	void OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) final;
+
+	[[nodiscard]] bool CanExtract() const final { return true; }
+
+	void OnExtract(Scene& scene, RenderSnapshot& snapshot) override = 0;
+
+	void OnSubmit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override = 0;
+private:
+	RenderSnapshot m_snapshot;
 };
 
 struct ScreenVertex
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <memory>
+
+#include <ECS/Component.hpp>
+
+#include "../Physics/StaticCollisionWorld.hpp"
+
+using StaticCollisionWorldHandle = std::shared_ptr<StaticCollisionWorld>;
+
+struct CharacterControllerComponent : public ECS::Component<CharacterControllerComponent>
+{
+	CharacterControllerComponent(const StaticCollisionWorldHandle& world, float radius, float height, const glm::vec3& offset = glm::vec3(0.0f)) :
+		World(world), Radius(radius), Height(height), Offset(offset), m_hasResolvedPosition(false), m_resolvedPosition(0.0f) {}
+
+	StaticCollisionWorldHandle World;
+
+	float     Radius;
+	float     Height;
+	glm::vec3 Offset;
+
+	// Capsule centred on position + Offset; Height includes both hemispherical caps.
+	[[nodiscard]] Capsule GetCapsule(const glm::vec3& position) const
+	{
+		return Capsule(position + Offset, Radius, std::max(Height * 0.5f - Radius, 0.0f));
+	}
+
+	friend struct CharacterControllerSystem;
+private:
+	bool      m_hasResolvedPosition;
+	glm::vec3 m_resolvedPosition;
+};
@@ -0,0 +1,14 @@
+#pragma once
+
+#include <ECS/Component.hpp>
+
+#include "../Physics/AABB.hpp"
+#include "../Physics/BroadPhase.hpp"
+
+struct ColliderComponent : public ECS::Component<ColliderComponent>
+{
+	explicit ColliderComponent(const AABB& bounds = AABB(glm::vec3(-0.5f), glm::vec3(0.5f))) : Bounds(bounds), Proxy(BroadPhase::InvalidProxy) {}
+
+	AABB                Bounds;
+	BroadPhase::ProxyID Proxy;
+};
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <ECS/Component.hpp>
+
+// Opts an entity into visibility culling with a bounding sphere around its transformed position.
+struct CullableComponent : public ECS::Component<CullableComponent>
+{
+	explicit CullableComponent(float radius = 1.0f) : Radius(radius) {}
+
+	float Radius;
+};
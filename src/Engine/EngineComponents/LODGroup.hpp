@@ -0,0 +1,58 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include <ECS/Component.hpp>
+
+#include "../Rendering/Mesh.hpp"
+
+struct LODLevel
+{
+	LODLevel(const MeshHandle& mesh, float error) : Mesh(mesh), Error(error) {}
+
+	MeshHandle Mesh;
+
+	// How far, in object-space units, the level's surface strays from the finest level.
+	float Error;
+};
+
+// Swaps the entity's RenderableMesh between levels of detail as it gets smaller on screen; see LODSystem. Levels go
+// from finest to coarsest.
+struct LODGroup : public ECS::Component<LODGroup>
+{
+	explicit LODGroup(const std::vector<LODLevel>& levels, float hysteresis = 0.25f) : Levels(levels), Hysteresis(hysteresis), CurrentLevel(0) {}
+
+	std::vector<LODLevel> Levels;
+
+	// A coarser level is only picked once its error is this fraction under the threshold, so objects near a switching
+	// distance do not pop back and forth.
+	float Hysteresis;
+
+	size_t CurrentLevel;
+
+	// The level to draw when one object-space unit of error covers errorToPixels pixels, starting from CurrentLevel:
+	// finer while the current level's error is over maxPixelError, coarser while the next one's is under it by the
+	// hysteresis margin.
+	[[nodiscard]] size_t SelectLevel(float errorToPixels, float maxPixelError) const
+	{
+		if(Levels.empty())
+		{
+			return 0;
+		}
+
+		size_t level = std::min(CurrentLevel, Levels.size() - 1);
+
+		while(level > 0 && Levels[level].Error * errorToPixels > maxPixelError)
+		{
+			level--;
+		}
+
+		while(level + 1 < Levels.size() && Levels[level + 1].Error * errorToPixels <= maxPixelError * (1.0f - Hysteresis))
+		{
+			level++;
+		}
+
+		return level;
+	}
+};
@@ -13,6 +13,15 @@ struct ShadowInfo
 
 using ShadowInfoHandle = std::shared_ptr<ShadowInfo>;
 
+// Layout of "layout(std140, binding = 2) uniform LightConstants { ... } u_light" (LightConstantSlot) in the light
+// shaders, uploaded once per light.
+struct LightConstants
+{
+	glm::vec4 ColorIntensity = glm::vec4(0.0f);
+	glm::vec4 Attenuation    = glm::vec4(0.0f); // constant, linear, exponent, range
+	glm::vec4 Cone           = glm::vec4(0.0f); // cutoff, shadow softness
+};
+
 struct Light;
 
 using LightHandle = std::shared_ptr<Light>;
@@ -35,10 +44,11 @@ struct Light
 
 	virtual TypeInfo* GetType() const = 0;
 
-	virtual void UpdateShader(ShaderHandle shader) const
+	// Lights are recorded from the constants filled in here rather than from the light itself, so a light extracted
+	// into a snapshot can be recorded on a worker while the simulation changes it.
+	virtual void GetConstants(LightConstants& constants) const
 	{
-		shader->Get<glm::vec3>("u_color") = Color;
-		shader->Get<float>("u_intensity") = Intensity;
+		constants.ColorIntensity = glm::vec4(Color, Intensity);
 	}
 };
 
@@ -58,19 +68,24 @@ struct AmbientLight : public Light
 
 struct DirectionalLight : public Light
 {
-	DirectionalLight(const glm::vec3& color, float intensity, float shadowSoftness = 3.0f) :
+	DirectionalLight(const glm::vec3& color, float intensity, float shadowSoftness = 3.0f, float shadowDistance = 100.0f) :
 		Light(color, intensity, std::make_shared<struct ShadowInfo>(glm::ortho(-40.0f, 40.0f, -40.0f, 40.0f, -40.0f, 40.0f))),
-		ShadowSoftness(shadowSoftness) {}
+		ShadowSoftness(shadowSoftness), ShadowDistance(shadowDistance), CascadeSplitBlend(0.75f) {}
 
 	float ShadowSoftness;
 
+	// How far from the camera the shadow cascades reach. ShadowInfo only applies when there are no cascades.
+	float ShadowDistance;
+
+	// 0 spaces the cascade splits evenly, 1 logarithmically.
+	float CascadeSplitBlend;
+
 	virtual TypeInfo* GetType() const override { return TypeInfo::Get<DirectionalLight>(); }
 
-	virtual void UpdateShader(ShaderHandle shader) const override
+	virtual void GetConstants(LightConstants& constants) const override
 	{
-		Light::UpdateShader(shader);
-		shader->TrySet("u_shadowSoftness", ShadowSoftness);
-		//shader->Get<float>("u_shadowSoftness") = ShadowSoftness;
+		Light::GetConstants(constants);
+		constants.Cone.y = ShadowSoftness;
 	}
 };
 
@@ -110,13 +125,10 @@ struct PointLight : public Light
 
 	TypeInfo* GetType() const override { return TypeInfo::Get<PointLight>(); }
 
-	void UpdateShader(ShaderHandle shader) const override
+	void GetConstants(LightConstants& constants) const override
 	{
-		Light::UpdateShader(shader);
-		shader->Get<float>("u_constant") = LightAttenuation.Constant;
-		shader->Get<float>("u_linear") = LightAttenuation.Linear;
-		shader->Get<float>("u_exponent") = LightAttenuation.Exponent;
-		shader->Get<float>("u_range") = Range;
+		Light::GetConstants(constants);
+		constants.Attenuation = glm::vec4(LightAttenuation.Constant, LightAttenuation.Linear, LightAttenuation.Exponent, Range);
 	}
 };
 
@@ -133,11 +145,10 @@ struct SpotLight : public PointLight
 
 	TypeInfo* GetType() const override { return TypeInfo::Get<SpotLight>(); }
 
-	void UpdateShader(ShaderHandle shader) const override
+	void GetConstants(LightConstants& constants) const override
 	{
-		PointLight::UpdateShader(shader);
-		shader->Get<float>("u_cutoff") = Cutoff;
-		shader->TrySet("u_shadowSoftness", ShadowSoftness);
+		PointLight::GetConstants(constants);
+		constants.Cone = glm::vec4(Cutoff, ShadowSoftness, 0.0f, 0.0f);
 	}
 };
 
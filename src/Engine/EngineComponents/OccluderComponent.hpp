@@ -0,0 +1,13 @@
+#pragma once
+
+#include <ECS/Component.hpp>
+
+#include "../Rendering/OcclusionCuller.hpp"
+
+// Rasterizes the entity's transformed mesh into the software depth buffer before other meshes are tested against it.
+struct OccluderComponent : public ECS::Component<OccluderComponent>
+{
+	explicit OccluderComponent(const OccluderMeshHandle& mesh) : Mesh(mesh) {}
+
+	OccluderMeshHandle Mesh;
+};
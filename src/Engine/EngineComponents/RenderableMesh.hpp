@@ -11,13 +11,17 @@ public:
 		Mesh(mesh),
 		Material(material),
 		Emissive(emissive),
-		ShadowOnly(false) {}
+		ShadowOnly(false),
+		Static(false) {}
 
 	MeshHandle Mesh;
 	TMaterial  Material;
 
 	bool Emissive;
 	bool ShadowOnly;
+
+	// Set for meshes that rarely move; their shadows are cached per light and only re-rendered when one of them moves.
+	bool Static;
 };
 
 //struct EmissiveMesh : public ECS::Component<EmissiveMesh>
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <memory>
+
+#include <ECS/Component.hpp>
+#include <ECS/Entity.hpp>
+
+#include "../Physics/SpatialGrid.hpp"
+
+using EntityGrid       = SpatialGrid<ECS::Entity>;
+using EntityGridHandle = std::shared_ptr<EntityGrid>;
+
+struct SpatialGridComponent : public ECS::Component<SpatialGridComponent>
+{
+	explicit SpatialGridComponent(const EntityGridHandle& grid) : Grid(grid), Handle(EntityGrid::InvalidHandle) {}
+
+	// A copy is a new entry, inserted by SpatialGridSystem on its next update.
+	SpatialGridComponent(const SpatialGridComponent& other) : Grid(other.Grid), Handle(EntityGrid::InvalidHandle) {}
+
+	SpatialGridComponent& operator=(const SpatialGridComponent&) = delete;
+
+	~SpatialGridComponent() { Remove(); }
+
+	EntityGridHandle   Grid;
+	EntityGrid::Handle Handle;
+
+	void Remove()
+	{
+		if(Handle != EntityGrid::InvalidHandle)
+		{
+			Grid->Remove(Handle);
+			Handle = EntityGrid::InvalidHandle;
+		}
+	}
+};
@@ -2,14 +2,23 @@
 
 #include <ECS/Component.hpp>
 #include <Engine/Rendering/Material.hpp>
+#include <Engine/Rendering/RenderTarget.hpp>
+#include <Engine/Rendering/WaterUpdatePolicy.hpp>
 
 class WaterComponent : public ECS::Component<WaterComponent>
 {
 public:
-	WaterComponent(MaterialHandle material, float waveSpeed = 0.01f) :
-		Material(material), WaveSpeed(waveSpeed) {}
+	WaterComponent(MaterialHandle material, float waveSpeed = 0.01f, const WaterUpdatePolicy& updatePolicy = WaterUpdatePolicy()) :
+		Material(material), WaveSpeed(waveSpeed), UpdatePolicy(updatePolicy), LastUpdateFrame(WaterUpdatePolicy::NeverUpdated) {}
 
 	MaterialHandle Material;
 
 	float WaveSpeed;
-};
\ No newline at end of file
+
+	WaterUpdatePolicy UpdatePolicy;
+
+	// Acquired by WaterRendererSystem from the device's target pool and kept between the frames that re-render them.
+	RenderTargetHandle ReflectionTarget;
+	RenderTargetHandle RefractionTarget;
+	uint64_t           LastUpdateFrame;
+};
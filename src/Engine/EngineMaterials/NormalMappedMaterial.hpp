@@ -18,4 +18,6 @@ struct NormalMappedMaterial final
 
     MaterialTextureInfo AlbedoTexture;
     MaterialTextureInfo NormalTexture;
+
+    bool operator==(const NormalMappedMaterial& other) const = default;
 };
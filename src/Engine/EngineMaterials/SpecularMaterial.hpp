@@ -15,4 +15,6 @@ struct SpecularMaterial final
     glm::vec2 TilingFactor;
 
     MaterialTextureInfo AlbedoTexture;
+
+    bool operator==(const SpecularMaterial& other) const = default;
 };
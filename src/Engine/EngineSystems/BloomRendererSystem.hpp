@@ -1,111 +1,171 @@
 #pragma once
 
-#include "../Core/Scene.hpp"
-#include "../EngineComponents/RenderableMesh.hpp"
+#include <string>
+#include <vector>
 
-class BloomRendererSystem : public RendererSystem
+#include "../Core/Scene.hpp"
+#include "../Rendering/CommandList.hpp"
+#include "../Rendering/FrameGraph.hpp"
+
+// Adds a glow around bright pixels. Pixels of the target brighter than Threshold go into the first level of a chain
+// of targets, each half the size of the one before and blurred on the way down, and the last level is added back over
+// the target. The levels are transient frame graph targets, so they only hold pooled memory while the bloom passes
+// run.
+class BloomRendererSystem final : public ExtractingRendererSystem
 {
-private:
-	std::vector<FrameBufferHandle> m_targets;
-
-	FrameBufferHandle m_mainTarget;
-
-	ShaderHandle m_screenShader;
-	ShaderHandle m_thresholdShader;
-	ShaderHandle m_downSamplerShader;
-
-	VertexArrayHandle m_screenQuad;
 public:
-	BloomRendererSystem(size_t levels = 6) 
+	explicit BloomRendererSystem(Scene& scene, size_t levelCount = 6, float threshold = 1.3f) : Threshold(threshold)
 	{
-		m_targets.resize(levels);
-	}
+		const ScreenGraphicsMode graphicsMode = scene.SelectedGraphicsMode();
 
-	virtual void OnStart(Scene& scene, RenderDevice& renderDevice) override
-	{
-		/*m_target = scene.CreateFrameBuffer(scene.GraphicsMode().Width, scene.GraphicsMode().Height,
+		uint32_t width  = graphicsMode.Width;
+		uint32_t height = graphicsMode.Height;
+		for(size_t i = 0; i < levelCount; i++)
 		{
-			AttachmentInfo(InternalFormat::RGB8, Format::RGB, MinFilterMode),
-		}, 
-		false);*/
-
-
-
-		uint32_t width  = scene.SelectedGraphicsMode().Width;
-		uint32_t height = scene.SelectedGraphicsMode().Height;
-
-		m_mainTarget = scene.CreateFrameBuffer(width, height,
-		{
-			AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, ElementType::Float32, MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
-		}, {});
-
-		for(size_t i = 0; i < m_targets.size(); i++)
-		{
-			m_targets[i] = scene.CreateFrameBuffer(width, height,
+			m_levelDescriptions.emplace_back(width, height, std::vector<AttachmentInfo>
 			{
-				AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, ElementType::Float32, MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
-			},  {});
+				AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, TypeInfo::Get<glm::f32vec3>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
+			});
 
-			width  /= 2;
-			height /= 2;
+			width  = std::max(width  / 2, 1U);
+			height = std::max(height / 2, 1U);
 		}
 
-		     m_screenShader = scene.LoadShader("screen.glsl", "screen_FS.glsl");
-		  m_thresholdShader = scene.LoadShader("threshold_VS.glsl", "threshold_FS.glsl");
-		m_downSamplerShader = scene.LoadShader("gaussianBlur_VS.glsl", "gaussianBlur_FS.glsl");
-
-		Array<ScreenVertex> vertices = 
+		const std::vector<ScreenVertex> screenVertices
 		{
-			glm::vec2(-1, -1), 
-			glm::vec2( 1, -1),
-			glm::vec2(-1,  1),
-			glm::vec2( 1,  1),
+			{ glm::vec2(-1, -1) },
+			{ glm::vec2( 1, -1) },
+			{ glm::vec2(-1,  1) },
+			{ glm::vec2( 1,  1) },
 		};
 
-		std::vector<uint32_t> indices = 
-		{ 
+		const std::vector<uint32_t> screenIndices =
+		{
 			0, 2, 1,
 			1, 2, 3
 		};
 
-		m_screenQuad = renderDevice.CreateMesh(Model(vertices, indices))->CreateVertexArray(BufferLayout());
+		m_screenQuad = scene.CreateMesh(Model(screenVertices, screenIndices));
+
+		auto shadersFolder = scene.RootAssetFolder.Navigate("shaders");
+
+		     m_screenShader = shadersFolder.LoadShader("screen.glsl");
+		  m_thresholdShader = shadersFolder.LoadShader("threshold.glsl");
+		m_downSamplerShader = shadersFolder.LoadShader("gaussianBlur.glsl");
 	}
 
-	virtual void OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, FrameBufferHandle target) override
+	const float Threshold;
+
+	// Bloom only reads the target, so there is nothing to copy out of the scene.
+	void OnExtract(Scene& scene, RenderSnapshot& snapshot) override {}
+
+	// Single-threaded frames draw the same passes through a graph of their own.
+	void OnSubmit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override
 	{
-		renderDevice.Disable(RenderFlags::DepthTest);
+		m_frameGraph.Reset();
+		OnSetupPasses(snapshot, m_frameGraph, m_frameGraph.ImportTarget("Target", target, ColorBuffer), renderContext2D);
+		m_frameGraph.Execute(renderDevice);
+	}
 
-		m_targets[0]->Bind();
-		m_thresholdShader->SetTexture("u_source", target->GetColorAttachment(0));
-		m_thresholdShader->Get<float>("u_threshold") = 1.3f;
-		m_thresholdShader->Get<int>("u_levels") = int(m_targets.size());
-		m_thresholdShader->Use(nullptr);
-		m_screenQuad->Draw(nullptr);
+	void OnSetupPasses(const RenderSnapshot& snapshot, FrameGraph& graph, FrameGraphTarget target, RenderContext2D& renderContext2D) override
+	{
+		if(m_levelDescriptions.empty())
+		{
+			return;
+		}
 
-		for(size_t i = 1; i < m_targets.size(); i++)
+		std::vector<FrameGraphTarget> levels;
+		for(size_t i = 0; i < m_levelDescriptions.size(); i++)
 		{
-			TextureHandle source = m_targets[i - 1]->GetColorAttachment(0);
+			levels.push_back(graph.CreateTarget("Bloom level " + std::to_string(i), m_levelDescriptions[i]));
+		}
 
-			m_targets[i]->Bind();
-			m_downSamplerShader->SetTexture("u_source", source);
-			m_downSamplerShader->Get<glm::vec2>("u_sourceSize") = glm::vec2(source->Width, source->Height);
-			m_downSamplerShader->Use(nullptr);
-			m_screenQuad->Draw(nullptr);
+		graph.AddPass("Bloom threshold", [target, level = levels[0]](FrameGraphBuilder& builder)
+		{
+			builder.Read(target, ColorBuffer);
+			builder.Write(level, ColorBuffer);
+		},
+		[this, target, level = levels[0], levelCount = int(levels.size())](RenderDevice& renderDevice, const FrameGraph& graph)
+		{
+			m_thresholdShader->SetUniform("u_source", graph.GetTarget(target).GetColorAttachment(0));
+
+			m_commands.Reset();
+			m_commands.Disable(DepthTest);
+			m_commands.UseRenderTarget(graph.GetTarget(level));
+			m_commands.UseShader(*m_thresholdShader);
+			m_commands.SetUniform(*m_thresholdShader, "u_threshold", Threshold);
+			m_commands.SetUniform(*m_thresholdShader, "u_levels", levelCount);
+			DrawScreenQuad(renderDevice);
+			m_commands.Enable(DepthTest);
+			m_commands.Execute(renderDevice);
+		});
+
+		for(size_t i = 1; i < levels.size(); i++)
+		{
+			graph.AddPass("Bloom downsample " + std::to_string(i), [source = levels[i - 1], level = levels[i]](FrameGraphBuilder& builder)
+			{
+				builder.Read(source, ColorBuffer);
+				builder.Write(level, ColorBuffer);
+			},
+			[this, source = levels[i - 1], level = levels[i]](RenderDevice& renderDevice, const FrameGraph& graph)
+			{
+				RenderTarget& sourceTarget = graph.GetTarget(source);
+				m_downSamplerShader->SetUniform("u_source", sourceTarget.GetColorAttachment(0));
+
+				m_commands.Reset();
+				m_commands.Disable(DepthTest);
+				m_commands.UseRenderTarget(graph.GetTarget(level));
+				m_commands.UseShader(*m_downSamplerShader);
+				m_commands.SetUniform(*m_downSamplerShader, "u_sourceSize", glm::vec2(sourceTarget.Size));
+				DrawScreenQuad(renderDevice);
+				m_commands.Enable(DepthTest);
+				m_commands.Execute(renderDevice);
+			});
 		}
 
-		target->Bind();
-		
-		renderDevice.Enable(RenderFlags::Blending);
-		renderDevice.SetBlendFunction(BlendFactor::One, BlendFactor::One);
+		graph.AddPass("Bloom composite", [target, level = levels.back()](FrameGraphBuilder& builder)
+		{
+			builder.Read(level, ColorBuffer);
+			builder.Write(target, ColorBuffer);
+		},
+		[this, target, level = levels.back()](RenderDevice& renderDevice, const FrameGraph& graph)
+		{
+			m_screenShader->SetUniform("u_source", graph.GetTarget(level).GetColorAttachment(0));
+
+			m_commands.Reset();
+			m_commands.Disable(DepthTest);
+			m_commands.Enable(Blending);
+			m_commands.SetBlendFunction(BlendFactor::One, BlendFactor::One);
+			m_commands.UseRenderTarget(graph.GetTarget(target));
+			m_commands.UseShader(*m_screenShader);
+			DrawScreenQuad(renderDevice);
+			m_commands.Disable(Blending);
+			m_commands.Enable(DepthTest);
+			m_commands.Execute(renderDevice);
+		});
+	}
+private:
+	std::vector<RenderTargetDescription> m_levelDescriptions;
+
+	FrameGraph  m_frameGraph;
+	CommandList m_commands;
+
+	MeshHandle m_screenQuad;
+
+	// The screen shaders read no instance data, but every draw goes through an instance buffer.
+	LocalRenderBufferHandle<glm::vec4> m_instanceBuffer;
 
-		for(size_t i = m_targets.size() - 1; i < m_targets.size(); i++)
+	ShaderHandle m_screenShader;
+	ShaderHandle m_thresholdShader;
+	ShaderHandle m_downSamplerShader;
+
+	void DrawScreenQuad(RenderDevice& renderDevice)
+	{
+		if(!m_instanceBuffer)
 		{
-			m_screenShader->SetTexture("u_source", m_targets[i]->GetColorAttachment(0));
-			m_screenShader->Use(nullptr);
-			m_screenQuad->Draw(nullptr);
+			m_instanceBuffer = renderDevice.CreateRenderBuffer<glm::vec4>(1);
 		}
 
-		renderDevice.Disable(RenderFlags::Blending);
-		renderDevice.Enable(RenderFlags::DepthTest);
+		m_commands.Draw(*m_screenQuad, *m_instanceBuffer, glm::vec4(0.0f));
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "../Core/Scene.hpp"
+#include "../EngineComponents/Transformation.hpp"
+#include "../EngineComponents/CharacterControllerComponent.hpp"
+
+// Must be added after the systems that move the controlled entities: whatever they did to the position this
+// update is treated as the desired motion and swept from the last resolved position.
+struct CharacterControllerSystem : public UpdaterSystem
+{
+	virtual void OnStart(Scene& scene) {}
+
+	virtual void OnUpdate(Scene& scene, float delta, KeyboardDevice& keyboard, MouseDevice& mouse) override
+	{
+		for(auto [ entity, transformation, controller ] : scene.View<Transformation, CharacterControllerComponent>())
+		{
+			if(!controller.m_hasResolvedPosition)
+			{
+				controller.m_resolvedPosition    = transformation.Position;
+				controller.m_hasResolvedPosition = true;
+			}
+
+			const glm::vec3 offset = transformation.Position - controller.m_resolvedPosition;
+
+			const Capsule   capsule  = controller.GetCapsule(controller.m_resolvedPosition);
+			const glm::vec3 resolved = controller.World->Move(capsule, offset) - controller.Offset;
+
+			transformation.Position        = resolved;
+			controller.m_resolvedPosition = resolved;
+		}
+	}
+};
@@ -0,0 +1,99 @@
+#pragma once
+
+#include "../Core/Scene.hpp"
+#include "../Core/Game.hpp"
+#include "../EngineComponents/Transformation.hpp"
+#include "../EngineComponents/ColliderComponent.hpp"
+
+#include <ECS/Event.hpp>
+
+struct CollisionSystem : public UpdaterSystem
+{
+	CollisionSystem() : m_frame(0), m_broadPhaseTimer("Broad Phase Time") {}
+
+	ECS::EntityEvent<ECS::Entity> CollisionEnter;
+	ECS::EntityEvent<ECS::Entity> CollisionExit;
+
+	virtual void OnStart(Scene& scene) {}
+
+	virtual void OnUpdate(Scene& scene, float delta, KeyboardDevice& keyboard, MouseDevice& mouse) override
+	{
+		{
+			ScopeTimer timer(m_broadPhaseTimer);
+
+			++m_frame;
+
+			for(auto [ entity, transformation, collider ] : scene.View<Transformation, ColliderComponent>())
+			{
+				AABB bounds = collider.Bounds.Transform(transformation.ToMatrix());
+
+				if(collider.Proxy == BroadPhase::InvalidProxy)
+				{
+					collider.Proxy = m_broadPhase.Add(bounds);
+
+					if(collider.Proxy >= m_proxies.size())
+					{
+						m_proxies.resize(collider.Proxy + 1);
+					}
+				}
+				else
+				{
+					m_broadPhase.Update(collider.Proxy, bounds);
+				}
+
+				m_proxies[collider.Proxy] = ProxyInfo(entity, m_frame);
+			}
+
+			// Proxies not refreshed this frame belong to deleted entities or removed colliders.
+			for(BroadPhase::ProxyID proxy = 0; proxy < m_proxies.size(); proxy++)
+			{
+				ProxyInfo& info = m_proxies[proxy];
+				if(info.LastFrame != 0 && info.LastFrame != m_frame)
+				{
+					m_broadPhase.Remove(proxy);
+					info.LastFrame = 0;
+				}
+			}
+		}
+
+		// Events are dispatched after the view is finished so handlers are free to create and delete entities.
+		m_pendingEvents = m_broadPhase.GetPairEvents();
+		m_broadPhase.ClearPairEvents();
+
+		for(const BroadPhase::PairEvent& pairEvent : m_pendingEvents)
+		{
+			ECS::Entity first  = m_proxies[pairEvent.Pair.First ].Entity;
+			ECS::Entity second = m_proxies[pairEvent.Pair.Second].Entity;
+
+			ECS::EntityEvent<ECS::Entity>& event = pairEvent.Added ? CollisionEnter : CollisionExit;
+
+			if(first.IsValid())
+			{
+				event(first, second);
+			}
+
+			if(second.IsValid())
+			{
+				event(second, first);
+			}
+		}
+	}
+
+	[[nodiscard]] const BroadPhase& GetBroadPhase() const { return m_broadPhase; }
+private:
+	struct ProxyInfo
+	{
+		ProxyInfo(ECS::Entity entity = ECS::Entity::Null, size_t lastFrame = 0) : Entity(entity), LastFrame(lastFrame) {}
+
+		ECS::Entity Entity;
+		size_t      LastFrame;
+	};
+
+	BroadPhase             m_broadPhase;
+	std::vector<ProxyInfo> m_proxies;
+	size_t                 m_frame;
+
+	std::vector<BroadPhase::PairEvent> m_pendingEvents;
+
+	Timer m_broadPhaseTimer;
+};
@@ -4,7 +4,15 @@
 #include "../EngineComponents/Transformation.hpp"
 #include "../EngineComponents/RenderableMesh.hpp"
 #include "../EngineComponents/LightComponent.hpp"
+#include "../EngineComponents/OccluderComponent.hpp"
 #include "../Rendering/RenderStream.hpp"
+#include "../Rendering/RenderQueue.hpp"
+#include "../Rendering/CommandList.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../Rendering/VisibilitySet.hpp"
+#include "../Rendering/ShadowCascades.hpp"
+#include "../Rendering/LightClusterGrid.hpp"
+#include "../Rendering/GBufferPacking.hpp"
 
 struct LightInfo
 {
@@ -24,6 +32,89 @@ struct LightInfo
 		return result;
 	}
 };
+
+// Layout of "layout(std140, binding = 0) uniform FrameConstants { ... } u_frame" (FrameConstantSlot) in the geometry and
+// light shaders, uploaded once per frame.
+struct FrameConstants
+{
+	FrameConstants(const glm::mat4& viewProjection, const glm::vec3& cameraPosition, const glm::vec2& shadowMapSize) :
+		ViewProjection(viewProjection), CameraPosition(cameraPosition, 1.0f), ShadowMapSize(shadowMapSize, 0.0f, 0.0f),
+		InverseViewProjection(glm::inverse(viewProjection)) {}
+
+	glm::mat4 ViewProjection;
+	glm::vec4 CameraPosition;
+	glm::vec4 ShadowMapSize;
+	glm::mat4 InverseViewProjection;
+};
+
+// One element of "layout(std430, binding = 1) buffer ClusterLights" (ClusterLightStorageSlot) in the clustered light
+// shader, indexed like the extracted ClusterLights.
+struct ClusteredLightData
+{
+	glm::vec4 PositionRange;   // world position, range
+	glm::vec4 ColorIntensity;
+	glm::vec4 Attenuation;     // constant, linear, exponent, range
+	glm::vec4 DirectionCutoff; // world direction, cone cutoff; -1 for point lights
+};
+
+// A light shader's uniforms, resolved once so recording a light does no name lookups.
+struct LightShaderUniforms
+{
+	explicit LightShaderUniforms(Shader& shader) :
+		CompactGBuffer(shader.GetUniform<int32_t>("u_compactGBuffer")),
+		ScreenRect(shader.GetUniform<glm::vec4>("u_screenRect")),
+		CascadeCount(shader.GetUniform<int32_t>("u_cascadeCount")),
+		ClusterGrid(shader.GetUniform<glm::ivec4>("u_clusterGrid")),
+		ClusterDepth(shader.GetUniform<glm::vec2>("u_clusterDepth"))
+	{
+		static constexpr std::string_view cascadeMatrixNames[MaxShadowCascades] =
+		{
+			"u_cascadeMatrices[0]", "u_cascadeMatrices[1]", "u_cascadeMatrices[2]", "u_cascadeMatrices[3]",
+		};
+
+		for(uint32_t i = 0; i < MaxShadowCascades; i++)
+		{
+			CascadeMatrices[i] = shader.GetUniform<glm::mat4>(cascadeMatrixNames[i]);
+		}
+	}
+
+	UniformHandle<int32_t>   CompactGBuffer;
+	UniformHandle<glm::vec4> ScreenRect;
+	UniformHandle<int32_t>   CascadeCount;
+
+	UniformHandle<glm::ivec4> ClusterGrid;  // tiles x, tiles y, slices
+	UniformHandle<glm::vec2>  ClusterDepth; // near distance, slices per unit of log distance
+
+	std::array<UniformHandle<glm::mat4>, MaxShadowCascades> CascadeMatrices;
+
+	// The textures last bound to the shader.
+	AttachmentHandle   BoundAlbedo;
+	TextureAtlasHandle BoundShadowMap;
+};
+
+struct GeometryShaderUniforms
+{
+	GeometryShaderUniforms() : ShaderID(UINT32_MAX) {}
+
+	explicit GeometryShaderUniforms(Shader& shader) :
+		ShaderID(shader.ID),
+		CompactGBuffer(shader.GetUniform<int32_t>("u_compactGBuffer")),
+		ClippingPlane(shader.GetUniform<glm::vec4>("u_clippingPlane")) {}
+
+	uint32_t ShaderID;
+
+	UniformHandle<int32_t>   CompactGBuffer;
+	UniformHandle<glm::vec4> ClippingPlane;
+};
+
+// Full stores RGB8 albedo, RGB32F normal and position and R16F specular intensity, about 29 bytes per pixel. Compact
+// stores 12: albedo with specular intensity in its alpha, an RG16F octahedral normal and a depth texture the light
+// shaders rebuild positions from (see GBufferPacking.hpp). Shaders branch on u_compactGBuffer.
+enum class GBufferLayout
+{
+	Full,
+	Compact,
+};
 //
 //struct InstanceInfo
 //{
@@ -42,11 +133,14 @@ struct LightInfo
 class DeferredRenderContext
 {
 public:
-	explicit DeferredRenderContext(Scene& scene, const glm::uvec2& shadowMapSize = glm::uvec2(1024)) :
+	// Directional lights render cascadeCount shadow maps of shadowMapSize; with no cascades they use ShadowInfo.
+	explicit DeferredRenderContext(Scene& scene, const glm::uvec2& shadowMapSize = glm::uvec2(1024), uint32_t cascadeCount = MaxShadowCascades, GBufferLayout layout = GBufferLayout::Full) :
+		Layout(layout),
+		GBufferDescription(CreateGBufferDescription(scene.SelectedGraphicsMode().Width, scene.SelectedGraphicsMode().Height, layout)),
+		ShadowMapRenderTarget(CreateShadowRenderTarget(scene, shadowMapSize)),
+		CascadeShadowMaps(CreateCascadeShadowMaps(scene, shadowMapSize, cascadeCount)),
 		m_lightInfoLayout(LightInfo::GetLayout()),
-		m_isRenderingWater(true),
-		GBuffer(CreateGBuffer(scene)),
-		ShadowMapRenderTarget(CreateShadowRenderTarget(scene, shadowMapSize))
+		m_isRenderingWater(true)
 	{
 		const std::vector<ScreenVertex> screenVertices
 		{
@@ -73,45 +167,101 @@ public:
 		LightShaders[TypeInfo::Get<PointLight>()      ] = deferredFolder.LoadShader("point.glsl");
 		LightShaders[TypeInfo::Get<SpotLight>()       ] = deferredFolder.LoadShader("spot.glsl");
 
+		ClusteredLightShader = deferredFolder.LoadShader("clustered.glsl");
+
 		m_shadowMapShader = shadersFolder.LoadShader("shadowMapShader.glsl");
 
 		m_altCamera = scene.CreateCamera(Transformation(), Projection(glm::identity<glm::mat4>()));
 	}
 
-	const RenderTargetHandle GBuffer;
+	const GBufferLayout Layout;
+
+	// The G-buffer is acquired from RenderDevice::TargetPool for the geometry and light passes only, so other passes
+	// of the frame acquiring the same description (e.g. a water system's nested deferred renders) share its memory.
+	const RenderTargetDescription GBufferDescription;
 
 	const RenderTargetHandle ShadowMapRenderTarget;
 
+	// One layer per cascade, sampled by the directional light shader as u_cascadeShadowMap. Null without cascades.
+	const RenderTargetArrayHandle CascadeShadowMaps;
+
 	Camera GetAlternateCamera() const { return m_altCamera; }
 
 	ShaderHandle GetShadowMapShader() const { return m_shadowMapShader; }
 
+	MeshHandle GetScreenQuad() const { return m_screenQuad; }
+
+	// A depth-only target with the size and format of ShadowMapRenderTarget, e.g. for a light's cached shadows.
+	RenderTargetHandle CreateShadowMap(RenderDevice& renderDevice) const
+	{
+		const glm::uvec2 size = ShadowMapRenderTarget->GetDepthAttachment()->Size;
+		return renderDevice.CreateRenderTarget(size.x, size.y, {}, ShadowMapAttachment());
+	}
+
 	std::unordered_map<TypeInfo*, ShaderHandle> LightShaders;
-private:
-	static RenderTargetHandle CreateGBuffer(Scene& scene)
+
+	// Shades every point and spot light without shadows in one full-screen pass over the light clusters.
+	ShaderHandle ClusteredLightShader;
+
+	// Writes RenderableMesh instances into the G-buffer.
+	ShaderHandle GeometryShader;
+
+	// Optional output of a culling pass; entities it hides are skipped for geometry, shadows and lighting.
+	VisibilitySetHandle Visibility;
+
+	[[nodiscard]] bool IsVisible(const ECS::Entity& entity) const { return !Visibility || Visibility->IsVisible(entity); }
+
+	// Optional software occlusion pass; meshes hidden behind OccluderComponent entities are skipped for geometry.
+	OcclusionCullerHandle Occlusion;
+
+	static RenderTargetDescription CreateGBufferDescription(uint32_t width, uint32_t height, GBufferLayout layout)
 	{
-		return scene.CreateRenderTarget(scene.SelectedGraphicsMode().Width, scene.SelectedGraphicsMode().Height,
+		if(layout == GBufferLayout::Compact)
+		{
+			return RenderTargetDescription(width, height,
+			{
+				AttachmentInfo(InternalImageFormat::RGBA8, ImageFormat::RGBA, TypeInfo::Get<glm::u8vec4 >(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
+				AttachmentInfo(InternalImageFormat::RG16F, ImageFormat::RG  , TypeInfo::Get<glm::f32vec2>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
+			},
+			AttachmentInfo(InternalImageFormat::DepthComponent32, ImageFormat::DepthComponent, TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge));
+		}
+
+		return RenderTargetDescription(width, height,
 		{
 			AttachmentInfo(InternalImageFormat::RGB8  , ImageFormat::RGB, TypeInfo::Get<glm::u8vec3 >(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
 			AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, TypeInfo::Get<glm::f32vec3>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
 			AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, TypeInfo::Get<glm::f32vec3>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
 			AttachmentInfo(InternalImageFormat::R16F  , ImageFormat::R  , TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
-		}, {});
+		});
+	}
+private:
+
+	static AttachmentInfo ShadowMapAttachment()
+	{
+		return AttachmentInfo(
+			InternalImageFormat::DepthComponent32,
+			ImageFormat::DepthComponent,
+			TypeInfo::Get<glm::f32vec1>(),
+			MinFilterMode::Nearest,
+			MagFilterMode::Nearest,
+			TextureWrappingMode::ClampedToEdge);
 	}
 
 	static RenderTargetHandle CreateShadowRenderTarget(Scene& scene, const glm::uvec2& shadowMapSize)
 	{
-		return scene.CreateRenderTarget(
-			shadowMapSize.x,
-			shadowMapSize.y,
-			{},
-			AttachmentInfo(
-				InternalImageFormat::DepthComponent32,
-				ImageFormat::DepthComponent,
-				TypeInfo::Get<glm::f32vec1>(),
-				MinFilterMode::Nearest,
-				MagFilterMode::Nearest,
-				TextureWrappingMode::ClampedToEdge));
+		return scene.CreateRenderTarget(shadowMapSize.x, shadowMapSize.y, {}, ShadowMapAttachment());
+	}
+
+	static RenderTargetArrayHandle CreateCascadeShadowMaps(Scene& scene, const glm::uvec2& shadowMapSize, uint32_t cascadeCount)
+	{
+		DEBUG_ASSERT(cascadeCount <= MaxShadowCascades, "Too many shadow cascades.");
+
+		if(cascadeCount == 0)
+		{
+			return nullptr;
+		}
+
+		return scene.CreateRenderTargetArray(shadowMapSize.x, shadowMapSize.y, cascadeCount, ShadowMapAttachment());
 	}
 
 	MeshHandle m_screenQuad;
@@ -126,7 +276,7 @@ private:
 };
 
 template<typename TMaterial>
-class DeferredRendererSystem final : public RendererSystem
+class DeferredRendererSystem final : public ExtractingRendererSystem
 {
 public:
 	struct RenderInstance final
@@ -148,33 +298,83 @@ public:
 		glm::mat4 MVPMatrix;
 	};
 
+	static constexpr uint32_t GeometryPass = 0;
+	static constexpr uint32_t   ShadowPass = 1;
+
+	static constexpr size_t InstanceBufferSize = 1024;
+
+	// Distance at which front-to-back ordering saturates.
+	static constexpr float MaximumSortDepth = 256.0f;
+
+	// Frames a shadow cache is kept after the last frame its light was visible.
+	static constexpr uint64_t ShadowCacheLifetime = 300;
+
 	explicit DeferredRendererSystem(const std::shared_ptr<DeferredRenderContext>& context) : m_context(context),
-		m_deferredRenderingTimer("Deferred Render Time") {}
+		m_geometryTimer("Deferred Geometry Time"), m_lightingTimer("Deferred Lighting Time"), m_extractionTimer("Deferred Extraction Time"), m_occlusionCullingTimer("Occlusion Culling Time"),
+		m_lightClusteringTimer("Light Clustering Time"), m_lightRecordingTimer("Light Recording Time") {}
 
-	void OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override
+	void OnExtract(Scene& scene, RenderSnapshot& snapshot) override
 	{
-		renderDevice.SetFaceCullingMode(FaceCullingMode::Inside);
-		renderDevice.Enable(RenderFlags::DepthTest);
-
-		m_context->GBuffer->Clear(ColorBuffer | DepthBuffer);
+		ScopeTimer timer(m_extractionTimer);
+
+		ExtractedFrame& frame = snapshot.GetData<ExtractedFrame>(*this);
+		frame.Geometry.clear();
+		frame.StaticShadowCasters.clear();
+		frame.DynamicShadowCasters.clear();
+		frame.Lights.clear();
+		frame.ClusterLights.clear();
+		frame.ClusterLightData.clear();
+		frame.ClusteredLights.clear();
+
+		const glm::mat4& viewProjection = snapshot.Camera.ViewProjection;
+		const glm::vec3& cameraPosition = snapshot.Camera.Position;
+
+		const OcclusionCullerHandle& occlusion = m_context->Occlusion;
+		if(occlusion)
+		{
+			ScopeTimer occlusionTimer(m_occlusionCullingTimer);
 
-		ScopeTimer timer(m_deferredRenderingTimer);
-		glm::mat4 viewProjection = scene.PrimaryCamera.GetViewProjection();
+			occlusion->BeginFrame(viewProjection);
+			for(auto [ entity, transformation, occluder ] : scene.View<Transformation, OccluderComponent>())
+			{
+				if(m_context->IsVisible(entity))
+				{
+					occlusion->AddOccluder(*occluder.Mesh, transformation.ToMatrix());
+				}
+			}
+			occlusion->Rasterize();
+		}
 
 		for(ECS::Entity entity : scene.RawView<Transformation, RenderableMesh<TMaterial>>())
 		{
 			const auto& transformation = entity.GetComponent<Transformation>();
 			const auto& renderableMesh = entity.GetComponent<RenderableMesh<TMaterial>>();
 
-			if(renderableMesh.ShadowOnly)
+			if(renderableMesh.ShadowOnly || !m_context->IsVisible(entity))
 			{
 				continue;
 			}
 
 			glm::mat4 modelMatrix = transformation.ToMatrix();
+
+			const AABB worldBounds = renderableMesh.Mesh->Bounds.Transform(modelMatrix);
+			if(!IsInsideFrustum(worldBounds, viewProjection))
+			{
+				continue;
+			}
+
+			// Occluders are never tested against themselves.
+			if(occlusion && !entity.ContainsComponent<OccluderComponent>() && !occlusion->IsVisible(worldBounds))
+			{
+				continue;
+			}
+
+			// Quantized meshes store positions the model matrix has to decode first.
+			modelMatrix = modelMatrix * renderableMesh.Mesh->VertexTransform;
 			glm::mat4 mvpMatrix = viewProjection * modelMatrix;
 
-			m_renderInstances[renderableMesh.Mesh].emplace_back(modelMatrix, mvpMatrix, renderableMesh.Material);
+			const float distance = glm::distance(cameraPosition, transformation.GetTransformedPosition());
+			frame.Geometry.push_back({ RenderInstance(modelMatrix, mvpMatrix, renderableMesh.Material), renderableMesh.Mesh, distance });
 
 			//Array<MatrixTransformation>* matrices = nullptr;
 			//
@@ -191,23 +391,217 @@ public:
 			//matrices->Emplace(modelMatrix, mvpMatrix);
 		}
 
-		for (auto [mesh, instances] : m_renderInstances)
+		frame.Clipping = scene.TryGet<bool>("Clipping", false);
+		if(frame.Clipping)
+		{
+			frame.ClippingPlane = scene.TryGet<glm::vec4>("ClippingPlane");
+		}
+
+		// Gathered once so light recording only reads plain arrays. Casters ignore camera visibility, since a caster
+		// the camera cannot see can still shadow what it does see; SubmitShadowCasters culls them against each light's
+		// frustum or cascade instead.
+		frame.StaticCasterSignature = FNVOffsetBasis;
+		for(auto [ meshEntity, meshTransformation, renderableMesh ] : scene.View<Transformation, RenderableMesh<TMaterial>>())
+		{
+			if(renderableMesh.Emissive)
+			{
+				continue;
+			}
+
+			const glm::mat4 worldMatrix = meshTransformation.ToMatrix();
+			const ShadowCaster caster = { worldMatrix * renderableMesh.Mesh->VertexTransform, meshTransformation.GetTransformedPosition(), renderableMesh.Mesh->Bounds.Transform(worldMatrix), renderableMesh.Mesh };
+
+			if(renderableMesh.Static)
+			{
+				frame.StaticShadowCasters.push_back(caster);
+				const ::Mesh* mesh = caster.Mesh.get();
+				frame.StaticCasterSignature = HashBytes(frame.StaticCasterSignature, &mesh, sizeof(mesh));
+				frame.StaticCasterSignature = HashBytes(frame.StaticCasterSignature, &caster.WorldMatrix, sizeof(caster.WorldMatrix));
+			}
+			else
+			{
+				frame.DynamicShadowCasters.push_back(caster);
+			}
+		}
+
+		for(auto [ entity, transformation, lightComponent ] : scene.View<Transformation, LightComponent>())
 		{
-			bool clipping = scene.TryGet<bool>("Clipping", false);
-			if(clipping)
+			if(!m_context->IsVisible(entity))
 			{
-				renderDevice.Enable(ClipPlane0);
-				material->GetType()->TrySet("u_clippingPlane", scene.TryGet<glm::vec4>("ClippingPlane"));
+				continue;
 			}
 
-			RenderStream<RenderInstance> renderStream(m_renderBuffer, mesh, m_context->GBuffer);
-			renderStream.WriteRange(ConstBufferSlice<RenderInstance>(instances.data(), instances.size()));
-			renderStream.Flush();
+			const auto& light = lightComponent.Light;
 
-			if(clipping)
+			auto altViewProjection = glm::identity<glm::mat4>();
+			if(light->ShadowInfo)
 			{
-				renderDevice.Disable(ClipPlane0);
+				auto alternateCamera = m_context->GetAlternateCamera();
+
+				alternateCamera.GetTransformation() = transformation;
+				alternateCamera.GetProjection() = light->ShadowInfo->Projection;
+
+				altViewProjection = alternateCamera.GetViewProjection();
 			}
+
+			LightConstants constants;
+			light->GetConstants(constants);
+
+			const glm::vec3 lightDirection = glm::rotate(transformation.GetTransformedRotation(), glm::vec3(0, 0, -1));
+			VisibleLight& visibleLight = frame.Lights.emplace_back(light, light->ShadowInfo != nullptr, constants, LightInfo(lightDirection, transformation.GetTransformedPosition(), altViewProjection));
+
+			const auto* directionalLight = dynamic_cast<const DirectionalLight*>(light.get());
+			if(directionalLight && visibleLight.CastsShadow && m_context->CascadeShadowMaps)
+			{
+				const RenderTargetArray& cascadeMaps = *m_context->CascadeShadowMaps;
+
+				visibleLight.CascadeCount = cascadeMaps.LayerCount;
+				ComputeShadowCascades(snapshot.Camera.View, snapshot.Camera.Projection, lightDirection,
+				                      directionalLight->ShadowDistance, directionalLight->CascadeSplitBlend, directionalLight->ShadowDistance,
+				                      cascadeMaps.Width, std::span(visibleLight.Cascades.data(), visibleLight.CascadeCount));
+
+				visibleLight.Info.Projection = visibleLight.Cascades[0].ViewProjection;
+			}
+
+			if(dynamic_cast<const PointLight*>(light.get()))
+			{
+				ClusterLight& clusterLight = frame.ClusterLights.emplace_back();
+				clusterLight.Position = glm::vec3(snapshot.Camera.View * glm::vec4(visibleLight.Info.Position, 1.0f));
+				clusterLight.Range    = constants.Attenuation.w;
+				clusterLight.IsListed = !visibleLight.CastsShadow;
+
+				ClusteredLightData& data = frame.ClusterLightData.emplace_back();
+				data.PositionRange   = glm::vec4(visibleLight.Info.Position, constants.Attenuation.w);
+				data.ColorIntensity  = constants.ColorIntensity;
+				data.Attenuation     = constants.Attenuation;
+				data.DirectionCutoff = glm::vec4(lightDirection, -1.0f);
+
+				if(dynamic_cast<const SpotLight*>(light.get()))
+				{
+					clusterLight.Direction = glm::normalize(glm::mat3(snapshot.Camera.View) * lightDirection);
+					clusterLight.CosAngle  = constants.Cone.x;
+
+					data.DirectionCutoff.w = constants.Cone.x;
+				}
+
+				frame.ClusteredLights.push_back(static_cast<uint32_t>(frame.Lights.size() - 1));
+			}
+		}
+
+		// Point and spot lights only shade the screen tiles of the clusters they touch, and lights that touch no
+		// cluster are outside the view frustum. Lights without shadows are shaded by the clustered pass instead of
+		// one of their own.
+		if(!frame.ClusterLights.empty())
+		{
+			ScopeTimer clusteringTimer(m_lightClusteringTimer);
+
+			frame.Clusters.SetProjection(snapshot.Camera.Projection);
+			frame.Clusters.Assign(frame.ClusterLights);
+
+			for(uint32_t i = 0; i < frame.ClusteredLights.size(); i++)
+			{
+				VisibleLight& visibleLight = frame.Lights[frame.ClusteredLights[i]];
+				visibleLight.ScreenRect  = frame.Clusters.GetScreenRect(i);
+				visibleLight.IsClustered = true;
+				visibleLight.IsListed    = frame.ClusterLights[i].IsListed;
+			}
+
+			std::erase_if(frame.Lights, [](const VisibleLight& visibleLight) { return visibleLight.IsListed || visibleLight.ScreenRect.x > visibleLight.ScreenRect.z; });
+		}
+	}
+
+	// Single-threaded frames draw the same passes through a graph of their own.
+	void OnSubmit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override
+	{
+		m_frameGraph.Reset();
+		OnSetupPasses(snapshot, m_frameGraph, m_frameGraph.ImportTarget("Target", target, ColorBuffer), renderContext2D);
+		m_frameGraph.Execute(renderDevice);
+	}
+
+	void OnSetupPasses(const RenderSnapshot& snapshot, FrameGraph& graph, FrameGraphTarget target, RenderContext2D& renderContext2D) override
+	{
+		const FrameGraphTarget gBuffer = graph.CreateTarget("G-buffer", m_context->GBufferDescription);
+
+		graph.AddPass("Deferred geometry", [gBuffer](FrameGraphBuilder& builder)
+		{
+			builder.Clear(gBuffer, ColorBuffer | DepthBuffer);
+			builder.Write(gBuffer, ColorBuffer | DepthBuffer);
+		},
+		[this, &snapshot, gBuffer](RenderDevice& renderDevice, const FrameGraph& graph)
+		{
+			SubmitGeometry(snapshot, renderDevice, graph.GetTarget(gBuffer));
+		});
+
+		// Light volumes are depth tested against the scene, so the target needs the G-buffer's depth.
+		graph.AddPass("Deferred lighting", [gBuffer, target](FrameGraphBuilder& builder)
+		{
+			builder.Read(gBuffer, ColorBuffer | DepthBuffer);
+			builder.Require(target, gBuffer, DepthBuffer);
+			builder.Clear(target, ColorBuffer);
+			builder.Write(target, ColorBuffer);
+		},
+		[this, &snapshot, gBuffer, target](RenderDevice& renderDevice, const FrameGraph& graph)
+		{
+			SubmitLighting(snapshot, renderDevice, graph.GetTarget(gBuffer), graph.GetTarget(target));
+		});
+	}
+
+private:
+	void SubmitGeometry(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderTarget& gBuffer)
+	{
+		const ExtractedFrame& frame = snapshot.GetData<ExtractedFrame>(*this);
+
+		renderDevice.SetFaceCullingMode(FaceCullingMode::Inside);
+		renderDevice.Enable(RenderFlags::DepthTest);
+
+		ScopeTimer timer(m_geometryTimer);
+
+		DEBUG_ASSERT(m_context->GeometryShader, "DeferredRenderContext::GeometryShader is not set.");
+
+		const glm::vec3& cameraPosition = snapshot.Camera.Position;
+
+		const glm::vec2 shadowMapSize(m_context->ShadowMapRenderTarget->GetDepthAttachment()->Size);
+
+		const FrameConstants frameConstants(snapshot.Camera.ViewProjection, cameraPosition, shadowMapSize);
+		if(!m_frameConstants)
+		{
+			m_frameConstants = renderDevice.CreateConstantBlock(FrameConstantSlot, frameConstants);
+			m_lightConstants = renderDevice.CreateConstantBlock(LightConstantSlot, LightConstants());
+		}
+		m_frameConstants->Update(frameConstants);
+
+		if(!m_renderBuffer && !frame.Geometry.empty())
+		{
+			m_renderBuffer = renderDevice.CreateRenderBuffer<RenderInstance>(InstanceBufferSize);
+		}
+
+		for(const GeometryInstance& geometry : frame.Geometry)
+		{
+			m_renderQueue.Submit(GeometryPass, geometry.Distance, MaximumSortDepth, gBuffer, *m_context->GeometryShader, 0, *geometry.Mesh, geometry.Instance);
+		}
+
+		Shader& geometryShader = *m_context->GeometryShader;
+		if(m_geometryUniforms.ShaderID != geometryShader.ID)
+		{
+			m_geometryUniforms = GeometryShaderUniforms(geometryShader);
+		}
+
+		geometryShader.SetUniform(m_geometryUniforms.CompactGBuffer, int32_t(m_context->Layout == GBufferLayout::Compact));
+
+		if(frame.Clipping)
+		{
+			renderDevice.Enable(ClipPlane0);
+			geometryShader.SetUniform(m_geometryUniforms.ClippingPlane, frame.ClippingPlane);
+		}
+
+		if(!m_renderQueue.IsEmpty())
+		{
+			m_renderQueue.Execute(*m_renderBuffer);
+		}
+
+		if(frame.Clipping)
+		{
+			renderDevice.Disable(ClipPlane0);
 		}
 
 		//for(auto it = m_meshQueue.begin(); it != m_meshQueue.end(); ++it)
@@ -231,91 +625,91 @@ public:
 		//	if(clipping)
 		//		renderDevice.Disable(ClipPlane0);
 		//}
+	}
 
-		TextureAtlasHandle shadowMap = m_context->ShadowMapRenderTarget->GetDepthAttachment();
+	void SubmitLighting(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderTarget& gBuffer, RenderTarget& target)
+	{
+		const ExtractedFrame& frame = snapshot.GetData<ExtractedFrame>(*this);
 
-		m_context->GBuffer->CopyTo(target, MagFilterMode::Nearest, DepthBuffer);
+		ScopeTimer timer(m_lightingTimer);
 
-		target.Clear(ColorBuffer);
+		TextureAtlasHandle shadowMap = m_context->ShadowMapRenderTarget->GetDepthAttachment();
 
-		for(auto [ entity, transformation, lightComponent ] : scene.View<Transformation, LightComponent>())
+		// Device objects and shared state are prepared here, so the recording jobs below only touch their own list.
+		if(!m_shadowRenderBuffer)
 		{
-			const auto& light = lightComponent.Light;
-			glm::vec3 lightDirection = glm::rotate(transformation.GetTransformedRotation(), glm::vec3(0, 0, -1));
+			m_shadowRenderBuffer = renderDevice.CreateRenderBuffer<ShadowInstance>(InstanceBufferSize);
+			m_lightInfoBuffer    = renderDevice.CreateRenderBuffer<LightInfo>(1);
+		}
 
-			auto lightProjection = glm::identity<glm::mat4>();
+		// Caches of deleted lights go straight away. A light that left the scene can still be kept alive by a handle
+		// elsewhere, so caches no visible light has used for a while go too, releasing their shadow maps.
+		++m_lightingFrame;
+		std::erase_if(m_shadowCaches, [this](const auto& entry)
+		{
+			return entry.second.Owner.expired() || m_lightingFrame - entry.second.LastUsedFrame > ShadowCacheLifetime;
+		});
 
-			auto altViewProjection = glm::identity<glm::mat4>();
-			if(light->ShadowInfo)
+		m_lightShadowCaches.assign(frame.Lights.size(), nullptr);
+		for(size_t i = 0; i < frame.Lights.size(); i++)
+		{
+			const VisibleLight& visibleLight = frame.Lights[i];
+			if(!visibleLight.CastsShadow || visibleLight.CascadeCount > 0)
 			{
-				auto alternateCamera = m_context->GetAlternateCamera();
+				continue;
+			}
 
-				alternateCamera.GetTransformation() = transformation;
-				alternateCamera.GetProjection() = light->ShadowInfo->Projection;
+			// A new light can reuse the address of a deleted one, so the cache also checks who owns it.
+			ShadowCache& cache = m_shadowCaches[visibleLight.Light.get()];
+			if(cache.Owner.lock() != visibleLight.Light)
+			{
+				cache = ShadowCache();
+				cache.Owner = visibleLight.Light;
+			}
 
-				altViewProjection = alternateCamera.GetViewProjection();
+			if(!cache.StaticShadowMap)
+			{
+				cache.StaticShadowMap = m_context->CreateShadowMap(renderDevice);
+			}
 
-				for(auto [ meshEntity, meshTransformation, renderableMesh ] : scene.View<Transformation, RenderableMesh<TMaterial>>())
-				{
-					if(renderableMesh.Emissive)
-					{
-						continue;
-					}
+			cache.LastUsedFrame    = m_lightingFrame;
+			m_lightShadowCaches[i] = &cache;
+		}
 
-					glm::mat4 worldMatrix = meshTransformation.ToMatrix();
-					m_shadowInstances[renderableMesh.Mesh].emplace_back(worldMatrix, altViewProjection * worldMatrix);
-				}
+		for(auto& [ lightType, shader ] : m_context->LightShaders)
+		{
+			BindLightTextures(*shader, gBuffer, shadowMap);
+		}
+		BindLightTextures(*m_context->ClusteredLightShader, gBuffer, shadowMap);
 
-				m_shadowMapShader->Use(nullptr);
+		if(m_lightCommands.size() < frame.Lights.size())
+		{
+			m_lightCommands.resize(frame.Lights.size());
+			m_lightShadowQueues.resize(frame.Lights.size());
+		}
 
-				m_context->ShadowMapRenderTarget->Clear(DepthBuffer);
+		{
+			ScopeTimer recordingTimer(m_lightRecordingTimer);
 
-				for (auto [mesh, instances] : m_shadowInstances)
+			JobSystem::Get().ParallelFor(frame.Lights.size(), 1, [&](size_t begin, size_t end)
+			{
+				for(size_t i = begin; i < end; i++)
 				{
-					RenderStream<ShadowInstance> renderStream(m_renderBuffer, mesh, m_context->ShadowMapRenderTarget);
-					renderStream.WriteRange(ConstBufferSlice<ShadowInstance>(instances.data(), instances.size()));
-					renderStream.Flush();
+					RecordLight(frame, frame.Lights[i], m_lightShadowCaches[i], m_lightCommands[i], m_lightShadowQueues[i], target);
 				}
+			});
+		}
 
-//
-				//m_shadowMapFrameBuffer->Bind();
-				//renderDevice.ClearScreen(DepthBuffer);
-//
-				//for(auto it = m_shadowMeshQueue.begin(); it != m_shadowMeshQueue.end(); ++it)
-				//{
-				//	VertexArrayHandle vertexArray = it->first;
-//
-				//	Array<MatrixTransformation>& matrices = it->second;
-//
-				//	vertexArray->Draw(matrices);
-				//	matrices.Clear();
-				//}
-//
-			}
-
-			renderDevice.Disable(DepthWriting);
-			renderDevice.Enable(Blending);
-			renderDevice.SetBlendFunction(BlendFactor::One, BlendFactor::One);
-
-			ShaderHandle shader = m_context->LightShaders[light->GetType()];
-			shader->TrySetTexture("u_albedoTexture", m_context->GBuffer->GetColorAttachment(0));
-			shader->TrySetTexture("u_normalTexture", m_context->GBuffer->GetColorAttachment(1));
-			shader->TrySetTexture("u_positionTexture", m_context->GBuffer->GetColorAttachment(2));
-			shader->TrySetTexture("u_specularTexture", m_context->GBuffer->GetColorAttachment(3));
-
-			shader->TrySetTexture("u_shadowMap", shadowMap);
-
-			LightInfo info(lightDirection, transformation.GetTransformedPosition(), altViewProjection);
-
-			shader->TrySet("u_cameraPosition", scene.PrimaryCamera.GetTransformation().Position);
-			shader->TrySet("u_shadowMapSize", glm::vec2(shadowMap->Size));
-
-			light->UpdateShader(shader);
-			shader->Use(nullptr);
-			m_screenQuad->Draw(ConstDynamicBufferSlice(&info, 1, m_lightInfoLayout));
+		// Replayed in light order, whichever worker recorded each list.
+		for(size_t i = 0; i < frame.Lights.size(); i++)
+		{
+			m_lightCommands[i].Execute(renderDevice);
+		}
 
-			renderDevice.Disable(Blending);
-			renderDevice.Enable(DepthWriting);
+		// The grid is only assigned on frames with point or spot lights, so older lists are ignored.
+		if(!frame.ClusterLights.empty() && !frame.Clusters.GetLightIndices().empty())
+		{
+			SubmitClusteredLights(frame, renderDevice, target);
 		}
 
 		//target->Bind();
@@ -345,16 +739,366 @@ public:
 		//}
 	}
 
-private:
+	struct ShadowCaster
+	{
+		glm::mat4  WorldMatrix;
+		glm::vec3  Position;
+		AABB       Bounds;
+		MeshHandle Mesh;
+	};
+
+	// Depth of a light's static casters. It is re-rendered only when the light's projection changes or a static
+	// caster is added, removed or moved; dynamic casters are drawn over a copy of it every frame.
+	struct ShadowCache
+	{
+		std::weak_ptr<struct Light> Owner;
+		RenderTargetHandle          StaticShadowMap;
+
+		glm::mat4 Projection    = glm::mat4(0.0f);
+		uint64_t  Signature     = 0;
+		bool      IsValid       = false;
+		uint64_t  LastUsedFrame = 0;
+	};
+
+	// Holds the light only to dispatch on its type; everything recorded comes from the copied constants.
+	struct VisibleLight
+	{
+		VisibleLight(LightHandle light, bool castsShadow, const LightConstants& constants, const LightInfo& info) :
+			Light(std::move(light)), CastsShadow(castsShadow), Constants(constants), Info(info),
+			ScreenRect(-1.0f, -1.0f, 1.0f, 1.0f), IsClustered(false), IsListed(false), CascadeCount(0) {}
+
+		LightHandle    Light;
+		bool           CastsShadow;
+		LightConstants Constants;
+		LightInfo      Info;
+
+		// Normalized device rectangle the light is drawn over, narrowed by the light clusters for clustered lights.
+		glm::vec4 ScreenRect;
+		bool      IsClustered;
+
+		// Shaded by the clustered pass rather than a pass of its own.
+		bool IsListed;
+
+		// Cascaded lights render into DeferredRenderContext::CascadeShadowMaps instead of their ShadowInfo projection.
+		uint32_t                                     CascadeCount;
+		std::array<ShadowCascade, MaxShadowCascades> Cascades;
+	};
+
+	struct GeometryInstance
+	{
+		RenderInstance Instance;
+		MeshHandle     Mesh;
+		float          Distance;
+	};
+
+	// Everything a frame draws, copied out of the scene by OnExtract. Meshes are shared, so one removed from the scene
+	// stays alive until the frames in flight that draw it are done.
+	struct ExtractedFrame
+	{
+		std::vector<GeometryInstance> Geometry;
+		std::vector<ShadowCaster>     StaticShadowCasters;
+		std::vector<ShadowCaster>     DynamicShadowCasters;
+		std::vector<VisibleLight>     Lights;
+
+		// Point and spot lights in view space, their shading data in world space and the index in Lights each one was
+		// extracted to.
+		std::vector<ClusterLight>       ClusterLights;
+		std::vector<ClusteredLightData> ClusterLightData;
+		std::vector<uint32_t>           ClusteredLights;
+		LightClusterGrid          Clusters;
+
+		// Hash of the static casters' meshes and world matrices, compared against each light's cache.
+		uint64_t StaticCasterSignature = 0;
+
+		bool      Clipping      = false;
+		glm::vec4 ClippingPlane = glm::vec4(0.0f);
+	};
+
 	std::shared_ptr<DeferredRenderContext> m_context;
 
 	LocalRenderBufferHandle<RenderInstance> m_renderBuffer;
 	LocalRenderBufferHandle<ShadowInstance> m_shadowRenderBuffer;
 
-	std::unordered_map<MeshHandle, std::vector<RenderInstance>> m_renderInstances;
-	std::unordered_map<MeshHandle, std::vector<ShadowInstance>> m_shadowInstances;
+	RenderQueue<RenderInstance> m_renderQueue;
+
+	LocalRenderBufferHandle<LightInfo> m_lightInfoBuffer;
+
+	// One list and shadow queue per visible light, kept across frames so recording stops allocating.
+	std::vector<CommandList>                 m_lightCommands;
+	std::vector<RenderQueue<ShadowInstance>> m_lightShadowQueues;
+
+	LocalRenderBufferHandle<ClusteredLightData> m_clusterLightBuffer;
+	LocalRenderBufferHandle<uint32_t>           m_clusterTableBuffer;
+	CommandList                                 m_clusteredLightCommands;
+
+	// Keyed by light; each visible light's entry is resolved before recording so a job only touches its own cache.
+	std::unordered_map<const struct Light*, ShadowCache> m_shadowCaches;
+	std::vector<ShadowCache*>                            m_lightShadowCaches;
+	uint64_t                                             m_lightingFrame = 0;
+
+	ConstantBlockHandle<FrameConstants> m_frameConstants;
+	ConstantBlockHandle<LightConstants> m_lightConstants;
 
-	Timer m_deferredRenderingTimer;
+	// Resolved on first use, keyed by shader ID.
+	std::unordered_map<uint32_t, LightShaderUniforms> m_lightShaderUniforms;
+
+	GeometryShaderUniforms m_geometryUniforms;
+
+	// Used by OnSubmit only; pipelined frames declare their passes in the scene's graph.
+	FrameGraph m_frameGraph;
+
+	Timer m_geometryTimer;
+	Timer m_lightingTimer;
+	Timer m_extractionTimer;
+	Timer m_occlusionCullingTimer;
+	Timer m_lightClusteringTimer;
+	Timer m_lightRecordingTimer;
+
+	// Points a light shader's samplers at this frame's G-buffer and shadow maps.
+	void BindLightTextures(Shader& shader, RenderTarget& gBuffer, const TextureAtlasHandle& shadowMap)
+	{
+		auto it = m_lightShaderUniforms.find(shader.ID);
+		if(it == m_lightShaderUniforms.end())
+		{
+			it = m_lightShaderUniforms.emplace(shader.ID, LightShaderUniforms(shader)).first;
+		}
+
+		// Textures are bound by name, so they are only set again when the pool hands out another G-buffer or
+		// shadow map.
+		LightShaderUniforms& uniforms = it->second;
+		if(uniforms.BoundAlbedo == gBuffer.GetColorAttachment(0) && uniforms.BoundShadowMap == shadowMap)
+		{
+			return;
+		}
+
+		uniforms.BoundAlbedo    = gBuffer.GetColorAttachment(0);
+		uniforms.BoundShadowMap = shadowMap;
+
+		shader.SetUniform("u_albedoTexture", gBuffer.GetColorAttachment(0));
+		shader.SetUniform("u_normalTexture", gBuffer.GetColorAttachment(1));
+
+		if(m_context->Layout == GBufferLayout::Compact)
+		{
+			shader.SetUniform("u_depthTexture", gBuffer.GetDepthAttachment());
+		}
+		else
+		{
+			shader.SetUniform("u_positionTexture", gBuffer.GetColorAttachment(2));
+			shader.SetUniform("u_specularTexture", gBuffer.GetColorAttachment(3));
+		}
+
+		shader.SetUniform(uniforms.CompactGBuffer, int32_t(m_context->Layout == GBufferLayout::Compact));
+
+		shader.SetUniform("u_shadowMap", shadowMap);
+
+		if(m_context->CascadeShadowMaps)
+		{
+			shader.SetUniform("u_cascadeShadowMap", m_context->CascadeShadowMaps->GetDepthAttachment());
+		}
+	}
+
+	// Uploads the clustered lights and each cluster's offset, count and light indices, then shades them all with
+	// one full-screen draw.
+	void SubmitClusteredLights(const ExtractedFrame& frame, RenderDevice& renderDevice, RenderTarget& target)
+	{
+		const LightClusterGrid& clusters = frame.Clusters;
+
+		const std::vector<uint32_t>& counts  = clusters.GetLightCounts();
+		const std::vector<uint32_t>& offsets = clusters.GetLightOffsets();
+		const std::vector<uint32_t>& indices = clusters.GetLightIndices();
+
+		// Buffers grow to twice what the frame needs, so a slowly growing light count does not recreate them often.
+		const size_t lightCount = frame.ClusterLightData.size();
+		if(!m_clusterLightBuffer || m_clusterLightBuffer->Elements.Count() < lightCount)
+		{
+			m_clusterLightBuffer = renderDevice.CreateRenderBuffer<ClusteredLightData>(lightCount * 2, 3, ClusterLightStorageSlot);
+		}
+
+		const size_t indexStart = counts.size() * 2;
+		const size_t tableSize  = indexStart + indices.size();
+		if(!m_clusterTableBuffer || m_clusterTableBuffer->Elements.Count() < tableSize)
+		{
+			m_clusterTableBuffer = renderDevice.CreateRenderBuffer<uint32_t>(tableSize * 2, 3, ClusterTableStorageSlot);
+		}
+
+		std::copy(frame.ClusterLightData.begin(), frame.ClusterLightData.end(), m_clusterLightBuffer->Elements.Data());
+		m_clusterLightBuffer->Update(lightCount);
+
+		uint32_t* table = m_clusterTableBuffer->Elements.Data();
+		for(size_t cluster = 0; cluster < counts.size(); cluster++)
+		{
+			table[cluster * 2    ] = static_cast<uint32_t>(indexStart) + offsets[cluster];
+			table[cluster * 2 + 1] = counts[cluster];
+		}
+		std::copy(indices.begin(), indices.end(), table + indexStart);
+		m_clusterTableBuffer->Update(tableSize);
+
+		Shader& shader = *m_context->ClusteredLightShader;
+		const LightShaderUniforms& uniforms = m_lightShaderUniforms.at(shader.ID);
+
+		const glm::ivec4 grid(clusters.TilesX, clusters.TilesY, clusters.Slices, 0);
+		const glm::vec2  depth(clusters.GetNearDistance(), float(clusters.Slices) / std::log(clusters.GetFarDistance() / clusters.GetNearDistance()));
+
+		CommandList& commands = m_clusteredLightCommands;
+		commands.Reset();
+
+		commands.Disable(DepthWriting);
+		commands.Enable(Blending);
+		commands.SetBlendFunction(BlendFactor::One, BlendFactor::One);
+
+		commands.UseRenderTarget(target);
+		commands.UseShader(shader);
+		commands.SetUniform(shader, uniforms.ClusterGrid, grid);
+		commands.SetUniform(shader, uniforms.ClusterDepth, depth);
+		commands.Draw(*m_context->GetScreenQuad(), *m_lightInfoBuffer, LightInfo(glm::vec3(0.0f), glm::vec3(0.0f), glm::identity<glm::mat4>()));
+
+		commands.Disable(Blending);
+		commands.Enable(DepthWriting);
+
+		commands.Execute(renderDevice);
+	}
+
+	// Runs on a worker thread: everything it does to the device goes through commands.
+	void RecordLight(const ExtractedFrame& frame, const VisibleLight& visibleLight, ShadowCache* shadowCache, CommandList& commands, RenderQueue<ShadowInstance>& shadowQueue, RenderTarget& target)
+	{
+		commands.Reset();
+
+		const struct Light& light = *visibleLight.Light;
+		if(visibleLight.CascadeCount > 0)
+		{
+			// Cascades follow the camera, so their casters are drawn every frame rather than cached.
+			RenderTargetArray& cascadeMaps = *m_context->CascadeShadowMaps;
+			for(uint32_t i = 0; i < visibleLight.CascadeCount; i++)
+			{
+				RenderTarget& cascadeMap = cascadeMaps.GetLayer(i);
+				const glm::mat4& cascadeViewProjection = visibleLight.Cascades[i].ViewProjection;
+
+				commands.Clear(cascadeMap, DepthBuffer);
+				SubmitShadowCasters(frame.StaticShadowCasters , cascadeMap, cascadeViewProjection, visibleLight.Info.Position, shadowQueue);
+				SubmitShadowCasters(frame.DynamicShadowCasters, cascadeMap, cascadeViewProjection, visibleLight.Info.Position, shadowQueue);
+				if(!shadowQueue.IsEmpty())
+				{
+					shadowQueue.Record(commands, *m_shadowRenderBuffer);
+				}
+			}
+		}
+		else if(visibleLight.CastsShadow)
+		{
+			ShadowCache& cache = *shadowCache;
+
+			const glm::mat4& altViewProjection = visibleLight.Info.Projection;
+			if(!cache.IsValid || cache.Projection != altViewProjection || cache.Signature != frame.StaticCasterSignature)
+			{
+				commands.Clear(*cache.StaticShadowMap, DepthBuffer);
+				SubmitShadowCasters(frame.StaticShadowCasters, *cache.StaticShadowMap, altViewProjection, visibleLight.Info.Position, shadowQueue);
+				if(!shadowQueue.IsEmpty())
+				{
+					shadowQueue.Record(commands, *m_shadowRenderBuffer);
+				}
+
+				cache.Projection = altViewProjection;
+				cache.Signature  = frame.StaticCasterSignature;
+				cache.IsValid    = true;
+			}
+
+			commands.CopyTo(*cache.StaticShadowMap, *m_context->ShadowMapRenderTarget, MagFilterMode::Nearest, DepthBuffer);
+
+			SubmitShadowCasters(frame.DynamicShadowCasters, *m_context->ShadowMapRenderTarget, visibleLight.Info.Projection, visibleLight.Info.Position, shadowQueue);
+			if(!shadowQueue.IsEmpty())
+			{
+				shadowQueue.Record(commands, *m_shadowRenderBuffer);
+			}
+		}
+
+		commands.Disable(DepthWriting);
+		commands.Enable(Blending);
+		commands.SetBlendFunction(BlendFactor::One, BlendFactor::One);
+
+		Shader& shader = *m_context->LightShaders.at(light.GetType());
+		commands.UseRenderTarget(target);
+		commands.UseShader(shader);
+		commands.UpdateConstants(*m_lightConstants, visibleLight.Constants);
+
+		const LightShaderUniforms& uniforms = m_lightShaderUniforms.at(shader.ID);
+
+		if(visibleLight.IsClustered)
+		{
+			commands.SetUniform(shader, uniforms.ScreenRect, visibleLight.ScreenRect);
+		}
+
+		if(visibleLight.CascadeCount > 0)
+		{
+			for(uint32_t i = 0; i < visibleLight.CascadeCount; i++)
+			{
+				commands.SetUniform(shader, uniforms.CascadeMatrices[i], visibleLight.Cascades[i].ViewProjection);
+			}
+			commands.SetUniform(shader, uniforms.CascadeCount, int32_t(visibleLight.CascadeCount));
+		}
+		commands.Draw(*m_context->GetScreenQuad(), *m_lightInfoBuffer, visibleLight.Info);
+
+		commands.Disable(Blending);
+		commands.Enable(DepthWriting);
+	}
+
+	// Casters entirely outside the light's frustum, or the cascade's, are skipped.
+	void SubmitShadowCasters(const std::vector<ShadowCaster>& casters, RenderTarget& shadowMap, const glm::mat4& altViewProjection, const glm::vec3& lightPosition, RenderQueue<ShadowInstance>& shadowQueue) const
+	{
+		for(const ShadowCaster& caster : casters)
+		{
+			if(!IsInsideFrustum(caster.Bounds, altViewProjection))
+			{
+				continue;
+			}
+
+			const ShadowInstance instance(caster.WorldMatrix, altViewProjection * caster.WorldMatrix);
+
+			const float distance = glm::distance(lightPosition, caster.Position);
+			shadowQueue.Submit(ShadowPass, distance, MaximumSortDepth, shadowMap, *m_context->GetShadowMapShader(), 0, *caster.Mesh, instance);
+		}
+	}
+
+	static bool IsInsideFrustum(const AABB& bounds, const glm::mat4& viewProjection)
+	{
+		glm::vec4 corners[8];
+		for(int i = 0; i < 8; i++)
+		{
+			const glm::vec3 corner((i & 1) ? bounds.Maximum.x : bounds.Minimum.x, (i & 2) ? bounds.Maximum.y : bounds.Minimum.y, (i & 4) ? bounds.Maximum.z : bounds.Minimum.z);
+			corners[i] = viewProjection * glm::vec4(corner, 1.0f);
+		}
+
+		// Outside when every corner is beyond the same clip plane.
+		for(int axis = 0; axis < 3; axis++)
+		{
+			bool allBelow = true;
+			bool allAbove = true;
+			for(const glm::vec4& corner : corners)
+			{
+				allBelow = allBelow && corner[axis] < -corner.w;
+				allAbove = allAbove && corner[axis] >  corner.w;
+			}
+
+			if(allBelow || allAbove)
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	static constexpr uint64_t FNVOffsetBasis = 14695981039346656037ULL;
+	static constexpr uint64_t FNVPrime       = 1099511628211ULL;
+
+	static uint64_t HashBytes(uint64_t hash, const void* data, size_t size)
+	{
+		const auto* bytes = static_cast<const uint8_t*>(data);
+		for(size_t i = 0; i < size; i++)
+		{
+			hash = (hash ^ bytes[i]) * FNVPrime;
+		}
+
+		return hash;
+	}
 
 	//std::unordered_map<DeferredRendererKey, Array<MatrixTransformation>> m_meshQueue;
 	//std::unordered_map<DeferredRendererKey, Array<MatrixTransformation>> m_emissiveQueue;
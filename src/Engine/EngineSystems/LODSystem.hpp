@@ -0,0 +1,78 @@
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+#include "../Core/Scene.hpp"
+#include "../Core/Game.hpp"
+#include "../Core/JobSystem.hpp"
+#include "../EngineComponents/Transformation.hpp"
+#include "../EngineComponents/RenderableMesh.hpp"
+#include "../EngineComponents/LODGroup.hpp"
+
+// Picks each LODGroup's level from the primary camera: the coarsest level whose error, projected to the screen at the
+// entity's distance, stays within MaxPixelError pixels. The chosen mesh is written into the entity's RenderableMesh
+// before the renderers extract it. Entities are spread over the job system's workers.
+template<ShallowCopyable TMaterial>
+class LODSystem final : public UpdaterSystem
+{
+public:
+	explicit LODSystem(float maxPixelError = 1.0f) : MaxPixelError(maxPixelError), m_selectionTimer("LOD Selection Time") {}
+
+	float MaxPixelError;
+
+	void OnStart(Scene& scene) {}
+
+	void OnUpdate(Scene& scene, float delta, KeyboardDevice& keyboard, MouseDevice& mouse) override
+	{
+		ScopeTimer timer(m_selectionTimer);
+
+		m_entries.clear();
+		for(auto [ entity, transformation, renderableMesh, group ] : scene.View<Transformation, RenderableMesh<TMaterial>, LODGroup>())
+		{
+			m_entries.push_back({ &transformation, &renderableMesh, &group });
+		}
+
+		// Pixels covered by one world unit at distance one.
+		const float pixelsPerUnit = 0.5f * float(scene.SelectedGraphicsMode().Height) * scene.PrimaryCamera.GetProjection().Matrix[1][1];
+		const glm::vec3 cameraPosition = scene.PrimaryCamera.GetTransformation().GetTransformedPosition();
+
+		JobSystem::Get().ParallelFor(m_entries.size(), 64, [&](size_t begin, size_t end)
+		{
+			for(size_t i = begin; i < end; i++)
+			{
+				const Transformation& transformation = *m_entries[i].Transform;
+				LODGroup& group = *m_entries[i].Group;
+
+				if(group.Levels.empty())
+				{
+					continue;
+				}
+
+				const glm::vec3 scale = glm::abs(transformation.GetTransformedScale());
+				const float distance = std::max(glm::distance(cameraPosition, transformation.GetTransformedPosition()), 1e-4f);
+
+				const float errorToPixels = pixelsPerUnit * std::max(scale.x, std::max(scale.y, scale.z)) / distance;
+
+				const size_t level = group.SelectLevel(errorToPixels, MaxPixelError);
+				group.CurrentLevel = level;
+
+				if(m_entries[i].Mesh->Mesh != group.Levels[level].Mesh)
+				{
+					m_entries[i].Mesh->Mesh = group.Levels[level].Mesh;
+				}
+			}
+		});
+	}
+private:
+	struct Entry
+	{
+		const Transformation*      Transform;
+		RenderableMesh<TMaterial>* Mesh;
+		LODGroup*                  Group;
+	};
+
+	std::vector<Entry> m_entries;
+
+	Timer m_selectionTimer;
+};
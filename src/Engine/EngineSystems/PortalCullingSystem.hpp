@@ -0,0 +1,126 @@
+#pragma once
+
+#include "../Core/Scene.hpp"
+#include "../Core/Game.hpp"
+#include "../EngineComponents/Transformation.hpp"
+#include "../EngineComponents/CullableComponent.hpp"
+#include "../EngineComponents/LightComponent.hpp"
+#include "../Rendering/PortalGraph.hpp"
+#include "../Rendering/VisibilitySet.hpp"
+
+// Must be added before the renderer systems that read the visibility set. worldToGrid maps world (x, z, 1) into
+// the portal graph's grid space, the same convention as SpatialGrid. Culling runs entirely during extraction; the
+// systems after it copy only what is visible, so there is nothing left to submit.
+class PortalCullingSystem final : public ExtractingRendererSystem
+{
+public:
+	PortalCullingSystem(const std::shared_ptr<PortalGraph>& graph, const glm::mat3& worldToGrid, const VisibilitySetHandle& visibility) :
+		m_graph(graph), m_worldToGrid(worldToGrid), m_visibility(visibility), m_cullingTimer("Portal Culling Time") {}
+
+	void OnExtract(Scene& scene, RenderSnapshot& snapshot) override
+	{
+		ScopeTimer timer(m_cullingTimer);
+
+		m_visibility->Clear();
+
+		if(m_graph->GetCells().empty())
+		{
+			return;
+		}
+
+		const glm::mat4& projection = snapshot.Camera.Projection;
+
+		const glm::quat rotation = snapshot.Camera.Rotation;
+		const glm::vec2 eye      = ToGrid(snapshot.Camera.Position, 1.0f);
+		const glm::vec2 forward  = ToGrid(glm::rotate(rotation, glm::vec3(0, 0, -1)), 0.0f);
+
+		// Looking straight up or down leaves no horizontal direction to cull along.
+		if(glm::length(forward) < 1e-3f)
+		{
+			return;
+		}
+
+		// The wedge has to contain the ground projection of all four frustum edges, which widens as the camera pitches.
+		float halfAngle = 0.0f;
+		for(float x : { -1.0f, 1.0f })
+		{
+			for(float y : { -1.0f, 1.0f })
+			{
+				const glm::vec3 corner = glm::rotate(rotation, glm::vec3(x / projection[0][0], y / projection[1][1], -1.0f));
+				const glm::vec2 ground = ToGrid(corner, 0.0f);
+
+				if(glm::length(ground) < 1e-3f)
+				{
+					return;
+				}
+
+				halfAngle = std::max(halfAngle, std::acos(glm::clamp(glm::dot(glm::normalize(ground), glm::normalize(forward)), -1.0f, 1.0f)));
+			}
+		}
+
+		if(halfAngle >= glm::radians(89.0f))
+		{
+			return;
+		}
+
+		m_graph->FindVisibleCells(eye, glm::normalize(forward), halfAngle, m_visibleCells);
+
+		const float gridScale = glm::length(glm::vec2(m_worldToGrid[0]));
+
+		for(auto [ entity, transformation, cullable ] : scene.View<Transformation, CullableComponent>())
+		{
+			m_visibility->Set(entity, IsCircleVisible(ToGrid(transformation.GetTransformedPosition(), 1.0f), cullable.Radius * gridScale));
+		}
+
+		for(auto [ entity, transformation, lightComponent ] : scene.View<Transformation, LightComponent>())
+		{
+			if(const auto* pointLight = dynamic_cast<const PointLight*>(lightComponent.Light.get()))
+			{
+				m_visibility->Set(entity, IsCircleVisible(ToGrid(transformation.GetTransformedPosition(), 1.0f), pointLight->Range * gridScale));
+			}
+		}
+	}
+
+	void OnSubmit(const RenderSnapshot& snapshot, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override {}
+
+	// Draws nothing, so it adds no pass to the frame graph.
+	void OnSetupPasses(const RenderSnapshot& snapshot, FrameGraph& graph, FrameGraphTarget target, RenderContext2D& renderContext2D) override {}
+
+	[[nodiscard]] const std::vector<bool>& GetVisibleCells() const { return m_visibleCells; }
+private:
+	std::shared_ptr<PortalGraph> m_graph;
+	glm::mat3                    m_worldToGrid;
+	VisibilitySetHandle          m_visibility;
+
+	std::vector<bool> m_visibleCells;
+
+	Timer m_cullingTimer;
+
+	[[nodiscard]] glm::vec2 ToGrid(const glm::vec3& value, float w) const { return glm::vec2(m_worldToGrid * glm::vec3(value.x, value.z, w)); }
+
+	[[nodiscard]] bool IsCircleVisible(const glm::vec2& center, float radius) const
+	{
+		const glm::ivec2 minimum(glm::floor(center - radius));
+		const glm::ivec2 maximum(glm::floor(center + radius));
+
+		for(int y = minimum.y; y <= maximum.y; y++)
+		{
+			for(int x = minimum.x; x <= maximum.x; x++)
+			{
+				const uint32_t cell = m_graph->GetCell(glm::ivec2(x, y));
+				if(cell == PortalGraph::InvalidCell || !m_visibleCells[cell])
+				{
+					continue;
+				}
+
+				const glm::vec2 closest = glm::clamp(center, glm::vec2(x, y), glm::vec2(x + 1, y + 1));
+				if(glm::dot(closest - center, closest - center) <= radius * radius)
+				{
+					return true;
+				}
+			}
+		}
+
+		return false;
+	}
+};
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "../Core/Scene.hpp"
+#include "../EngineComponents/Transformation.hpp"
+#include "../EngineComponents/SpatialGridComponent.hpp"
+
+struct SpatialGridSystem : public UpdaterSystem
+{
+	virtual void OnStart(Scene& scene) {}
+
+	virtual void OnUpdate(Scene& scene, float delta, KeyboardDevice& keyboard, MouseDevice& mouse) override
+	{
+		for(auto [ entity, transformation, gridComponent ] : scene.View<Transformation, SpatialGridComponent>())
+		{
+			glm::vec3 position = transformation.GetTransformedPosition();
+
+			if(gridComponent.Handle == EntityGrid::InvalidHandle)
+			{
+				gridComponent.Handle = gridComponent.Grid->Insert(entity, position);
+			}
+			else
+			{
+				gridComponent.Grid->Move(gridComponent.Handle, position);
+			}
+		}
+	}
+};
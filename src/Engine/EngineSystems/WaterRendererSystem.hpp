@@ -1,9 +1,13 @@
 #pragma once
 
+#include <algorithm>
+
 #include "../Core/Scene.hpp"
 #include "../EngineComponents/WaterComponent.hpp"
 #include "../EngineSystems/DeferredRendererSystem.hpp"
 #include "../Rendering/RenderTarget.hpp"
+#include "../Rendering/CommandList.hpp"
+#include "../Rendering/WaterUpdatePolicy.hpp"
 
 struct WaterVertex
 {
@@ -36,280 +40,203 @@ struct WaterInfo
 	}
 };
 
-struct WaterLightInfo
-{
-	WaterLightInfo(const glm::vec3& direction, const glm::vec3& position, const glm::mat4& projection) :
-		Direction(direction), Position(position), Projection(projection) {}
-
-	glm::vec3 Direction;
-	glm::vec3 Position;
-	glm::mat4 Projection;
-
-	static BufferLayout GetLayout()
-	{
-		BufferLayout result;
-		result.AddAttribute<decltype(Direction)>();
-		result.AddAttribute<decltype(Position)>();
-		result.AddAttribute<decltype(Projection)>();
-		return result;
-	}
-};
-
+// Draws WaterComponent planes textured with reflection and refraction images made by rendering the scene again,
+// mirrored and clipped at the water level. The nested renders run the scene's own renderer systems, so they share the
+// deferred context's shaders, shadow maps and pooled G-buffer instead of keeping copies. Each plane re-renders its
+// images as often and as large as its UpdatePolicy allows, and not at all while it is culled. The images outlive the
+// frame, so they are acquired from the device's target pool and only given back when their size changes or their
+// plane is removed.
 class WaterRendererSystem : public RendererSystem
 {
-private:
-	const glm::uvec2 m_shadowMapSize;
-
-	std::unordered_map<VertexArrayHandle, Array<MatrixTransformation>> m_shadowMeshQueue;
-
-	VertexArrayHandle m_waterQuad;
-	VertexArrayHandle m_screenQuad;
-
-	RenderTargetHandle m_reflectionFrameBuffer;
-	RenderTargetHandle m_refractionFrameBuffer;
-
-	RenderTargetHandle m_shadowMapFrameBuffer;
-
-	RenderTargetHandle m_gBuffer;
-
-	ShaderHandle m_blackShader;
-
-	std::unordered_map<TypeInfo*, ShaderHandle> m_lightShaders;
-
-	ShaderHandle m_screenShader;
-	ShaderHandle m_shadowMapShader;
-
-	Camera m_altCamera;
-
-	const BufferLayout m_waterInfoLayout;
-	const BufferLayout m_lightInfoLayout;
 public:
-	WaterRendererSystem(const glm::uvec2& shadowMapSize) : m_shadowMapSize(shadowMapSize), m_waterInfoLayout(WaterInfo::GetLayout()), m_lightInfoLayout(WaterLightInfo::GetLayout()) {}
+	explicit WaterRendererSystem(const std::shared_ptr<DeferredRenderContext>& context) :
+		m_context(context), m_frameIndex(0), m_updateCount(0), m_waterTimer("Water Render Time") {}
+
+	// Reflection and refraction renders made so far, for checking how often the update policies let planes update.
+	[[nodiscard]] uint64_t GetUpdateCount() const { return m_updateCount; }
 
-	virtual void OnStart(Scene& scene, RenderDevice& renderDevice)
+	void OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override
 	{
-		Array<WaterVertex> waterVertices =
-		{
-			WaterVertex(glm::vec2(-1, -1)),
-			WaterVertex(glm::vec2( 1, -1)),
-			WaterVertex(glm::vec2(-1,  1)),
-			WaterVertex(glm::vec2( 1,  1)),
-		};
+		ScopeTimer timer(m_waterTimer);
 
-		std::vector<uint32_t> waterIndices =
+		if(!m_waterQuad)
 		{
-			0, 1, 2,
-			3, 2, 1
-		};
+			const std::vector<WaterVertex> waterVertices =
+			{
+				WaterVertex(glm::vec2(-1, -1)),
+				WaterVertex(glm::vec2( 1, -1)),
+				WaterVertex(glm::vec2(-1,  1)),
+				WaterVertex(glm::vec2( 1,  1)),
+			};
 
-		m_waterQuad = renderDevice.CreateMesh(Model(waterVertices, waterIndices))->CreateVertexArray(WaterInfo::GetLayout());
+			const std::vector<uint32_t> waterIndices =
+			{
+				0, 1, 2,
+				3, 2, 1
+			};
 
-		Array<ScreenVertex> screenVertices =
-		{
-			glm::vec2(-1, -1), 
-			glm::vec2( 1, -1),
-			glm::vec2(-1,  1),
-			glm::vec2( 1,  1),
-		};
+			m_waterQuad       = scene.CreateMesh(Model(waterVertices, waterIndices));
+			m_waterInfoBuffer = renderDevice.CreateRenderBuffer<WaterInfo>(1);
+		}
 
-		std::vector<uint32_t> screenIndices = 
-		{ 
-			0, 2, 1,
-			1, 2, 3
-		};
+		m_frameIndex++;
 
-		m_screenQuad = renderDevice.CreateMesh(Model(screenVertices, screenIndices))->CreateVertexArray(LightInfo::GetLayout());
+		const glm::mat4 viewProjection = scene.PrimaryCamera.GetViewProjection();
+		const glm::vec3 cameraPosition = scene.PrimaryCamera.GetTransformation().GetTransformedPosition();
 
-		m_reflectionFrameBuffer = scene.CreateRenderTarget(1024, 1024,
+		// Gathered first, since the nested renders below run other systems over the scene.
+		m_visibleWater.clear();
+		m_heldTargets.clear();
+		for(auto [ entity, transformation, waterComponent ] : scene.View<Transformation, WaterComponent>())
 		{
-			AttachmentInfo(InternalImageFormat::RGB8, ImageFormat::RGB, ElementType::UInt8, MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
-		}, {});
+			if(waterComponent.ReflectionTarget)
+			{
+				m_heldTargets.push_back(waterComponent.ReflectionTarget);
+				m_heldTargets.push_back(waterComponent.RefractionTarget);
+			}
 
-		m_refractionFrameBuffer = scene.CreateRenderTarget(1024, 1024, 
-		{
-			AttachmentInfo(InternalImageFormat::RGB8, ImageFormat::RGB, ElementType::UInt8, MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
-		},
-		AttachmentInfo(InternalImageFormat::DepthComponent16, ImageFormat::DepthComponent, ElementType::Float32, MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge));
+			const glm::mat4 worldMatrix = transformation.ToMatrix();
+
+			const WaterScreenCoverage coverage = ComputeWaterScreenCoverage(worldMatrix, viewProjection, cameraPosition);
+			if(coverage.IsVisible && m_context->IsVisible(entity))
+			{
+				m_visibleWater.push_back({ &transformation, &waterComponent, worldMatrix, coverage });
+			}
+		}
 
-		m_gBuffer = scene.CreateRenderTarget(scene.SelectedGraphicsMode().Width, scene.SelectedGraphicsMode().Height,
+		// Targets of planes removed since the last frame go back to the pool.
+		std::erase_if(m_acquiredTargets, [this, &renderDevice](const RenderTargetHandle& acquiredTarget)
 		{
-			AttachmentInfo(InternalImageFormat::RGB8  , ImageFormat::RGB, ElementType::UInt8  , MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
-			AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, ElementType::Float32, MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
-			AttachmentInfo(InternalImageFormat::RGB32F, ImageFormat::RGB, ElementType::Float32, MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
-			AttachmentInfo(InternalImageFormat::R16F  , ImageFormat::R  , ElementType::Float32, MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge),
-		}, {});
+			if(std::find(m_heldTargets.begin(), m_heldTargets.end(), acquiredTarget) != m_heldTargets.end())
+			{
+				return false;
+			}
 
-		m_shadowMapFrameBuffer = scene.CreateRenderTarget(m_shadowMapSize.x, m_shadowMapSize.y, {}, AttachmentInfo(InternalImageFormat::DepthComponent32, ImageFormat::DepthComponent, ElementType::Float32, MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge));
+			renderDevice.TargetPool.Release(acquiredTarget);
+			return true;
+		});
 
-		m_blackShader = scene.LoadShader("deferred/water/black_VS.glsl", "deferred/water/black_FS.glsl");
+		for(const VisibleWater& water : m_visibleWater)
+		{
+			WaterComponent& waterComponent = *water.Component;
 
-		//m_lightShaders[Type::Get<AmbientLight>()    ] = scene.LoadShader("deferred/ambient_VS.glsl", "deferred/ambient_FS.glsl");
-		m_lightShaders[TypeInfo::Get<DirectionalLight>()] = scene.LoadShader("deferred/water/directional_VS.glsl", "deferred/water/directional_FS.glsl");
-		m_lightShaders[TypeInfo::Get<PointLight>()      ] = scene.LoadShader("deferred/water/point_VS.glsl", "deferred/water/point_FS.glsl");
-		m_lightShaders[TypeInfo::Get<SpotLight>()       ] = scene.LoadShader("deferred/water/spot_VS.glsl", "deferred/water/spot_FS.glsl");
+			const uint32_t currentResolution = waterComponent.ReflectionTarget ? waterComponent.ReflectionTarget->Width : 0;
 
-		m_screenShader = scene.LoadShader("screen.glsl", "screen_FS.glsl");
+			const uint32_t resolution = waterComponent.UpdatePolicy.GetResolution(water.Coverage, scene.SelectedGraphicsMode().Height, currentResolution);
+			if(resolution != currentResolution)
+			{
+				CreateTargets(renderDevice, waterComponent, resolution);
+			}
 
-		m_shadowMapShader = scene.LoadShader("shadowMapShader_VS.glsl", "shadowMapShader_FS.glsl");
+			if(waterComponent.UpdatePolicy.IsDue(m_frameIndex, waterComponent.LastUpdateFrame))
+			{
+				RenderReflections(scene, renderDevice, renderContext2D, *water.Transform, waterComponent);
+				waterComponent.LastUpdateFrame = m_frameIndex;
+				m_updateCount++;
+			}
 
-		m_altCamera = scene.CreateCamera(Transformation(), Projection(glm::identity<glm::mat4>()));
+			// The reflection and refraction images are already lit, so the surface is drawn straight into the target
+			// and depth tested against the scene.
+			Shader& shader = *waterComponent.Material->GetType();
+
+			m_commands.Reset();
+			m_commands.UseRenderTarget(target);
+			m_commands.SetUniform(shader, "u_reflection", waterComponent.ReflectionTarget->GetColorAttachment(0));
+			m_commands.SetUniform(shader, "u_refraction", waterComponent.RefractionTarget->GetColorAttachment(0));
+			m_commands.SetUniform(shader, "u_depthTexture", waterComponent.RefractionTarget->GetDepthAttachment());
+			m_commands.UseShader(shader);
+			m_commands.SetUniform(shader, "u_cameraPosition", cameraPosition);
+			m_commands.Draw(*m_waterQuad, *m_waterInfoBuffer, WaterInfo(water.WorldMatrix, viewProjection * water.WorldMatrix));
+			m_commands.Execute(renderDevice);
+		}
 	}
-
-	virtual void OnRender(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, RenderTarget& target) override
+private:
+	struct VisibleWater
 	{
-		target->CopyTo(m_gBuffer, MagFilterMode::Nearest, DepthBuffer);
-		m_gBuffer->Use();
-		renderDevice.ClearScreen(ColorBuffer);
+		const Transformation* Transform;
+		WaterComponent*       Component;
+		glm::mat4             WorldMatrix;
+		WaterScreenCoverage   Coverage;
+	};
 
-		scene.DisableSystem<WaterRendererSystem>();
-
-		glm::mat4 viewProjection = scene.PrimaryCamera.GetViewProjection();
-
-		glm::vec3& cameraPosition = scene.PrimaryCamera.GetTransformation().Position;
-		glm::quat& cameraRotation = scene.PrimaryCamera.GetTransformation().Rotation;
-
-		bool any = false;
-
-		for(ECS::Entity entity : scene.View<Transformation, WaterComponent>())
-		{
-			any = true;
+	std::shared_ptr<DeferredRenderContext> m_context;
 
-			const Transformation& transformation = entity.GetComponent<Transformation>();
-			const WaterComponent& waterComponent = entity.GetComponent<WaterComponent>();
+	MeshHandle                        m_waterQuad;
+	LocalRenderBufferHandle<WaterInfo> m_waterInfoBuffer;
 
-			float distance = cameraPosition.y - transformation.Position.y;
+	CommandList m_commands;
 
-			cameraPosition.y -= distance * 2;
-			cameraRotation.x = -cameraRotation.x;
-			cameraRotation.z = -cameraRotation.z;
+	std::vector<VisibleWater> m_visibleWater;
 
-			scene.Set("Clipping", true);
+	std::vector<RenderTargetHandle> m_acquiredTargets;
+	std::vector<RenderTargetHandle> m_heldTargets;
 
-			scene.Set("ClippingPlane", glm::vec4(0,  1, 0, -transformation.Position.y));
-			scene.Render(renderDevice, renderContext2D, m_reflectionFrameBuffer);
+	uint64_t m_frameIndex;
+	uint64_t m_updateCount;
 
-			cameraPosition.y += distance * 2;
-			cameraRotation.x = -cameraRotation.x;
-			cameraRotation.z = -cameraRotation.z;
+	Timer m_waterTimer;
 
-			scene.Set("ClippingPlane", glm::vec4(0, -1, 0, transformation.Position.y + 0.1f));
-			scene.Render(renderDevice, renderContext2D, m_refractionFrameBuffer);
-
-			scene.Set("Clipping", false);
-			renderDevice.Disable(ClipPlane0);
-
-			m_gBuffer->Use();
-
-			ShaderHandle shader = waterComponent.Material->GetType();
-			shader->SetTexture("u_reflection", m_reflectionFrameBuffer->GetColorAttachment(0));
-			shader->SetTexture("u_refraction", m_refractionFrameBuffer->GetColorAttachment(0));
-			shader->SetTexture("u_depthTexture", m_refractionFrameBuffer->GetDepthAttachment());
-
-			shader->TrySet("u_cameraPosition", cameraPosition);
-
-			glm::mat4 worldMatrix = transformation.ToMatrix();
-			WaterInfo info(worldMatrix, viewProjection * worldMatrix);
-
-			waterComponent.Material->Use();
-			m_waterQuad->Draw(ConstDynamicBufferSlice(&info, 1, m_waterInfoLayout));
-
-			target->Use();
-			m_blackShader->Use(nullptr);
-			m_waterQuad->Draw(ConstDynamicBufferSlice(&info, 1, m_waterInfoLayout));
+	void CreateTargets(RenderDevice& renderDevice, WaterComponent& waterComponent, uint32_t resolution)
+	{
+		if(waterComponent.ReflectionTarget)
+		{
+			ReleaseTarget(renderDevice, waterComponent.ReflectionTarget);
+			ReleaseTarget(renderDevice, waterComponent.RefractionTarget);
 		}
 
-		TextureHandle shadowMap = m_shadowMapFrameBuffer->GetDepthAttachment();
-
-		if(any)
+		const RenderTargetDescription reflectionDescription(resolution, resolution,
 		{
-			for(ECS::Entity entity : scene.View<Transformation, LightComponent>())
-			{
-				const Transformation& transformation = entity.GetComponent<Transformation>();
-				const LightComponent& lightComponent = entity.GetComponent<LightComponent>();
-
-				LightHandle light = lightComponent.Light;
-				glm::vec3 lightDirection = glm::rotate(transformation.GetTransformedRotation(), glm::vec3(0, 0, -1));
-
-				ShaderHandle shader = m_lightShaders[light->GetType()];
-				if(!shader)
-					continue;
-
-				glm::mat4 altViewProjection = glm::identity<glm::mat4>();
-				if(light->ShadowInfo)
-				{
-					m_altCamera.GetTransformation() = transformation;
-					m_altCamera.GetProjection() = light->ShadowInfo->Projection;
-
-					altViewProjection = m_altCamera.GetViewProjection();
-
-					for(ECS::Entity entity : scene.View<Transformation, RenderableMesh>())
-					{
-						const Transformation& meshTransformation = entity.GetComponent<Transformation>();
-						const RenderableMesh& renderableMesh     = entity.GetComponent<RenderableMesh>();
-
-						if(renderableMesh.Emissive)
-							continue;
-
-						Buffer<MatrixTransformation>& matrices = m_shadowMeshQueue[renderableMesh.VertexArray];
-						matrices.Reserve(scene.MaxEntityCount());
-						glm::mat4 worldMatrix = meshTransformation.ToMatrix();
-						matrices.Emplace(worldMatrix, altViewProjection * worldMatrix);
-					}
-
-					m_shadowMapShader->Use(nullptr);
-
-					m_shadowMapFrameBuffer->Use();
-					renderDevice.ClearScreen(DepthBuffer);
+			AttachmentInfo(InternalImageFormat::RGB8, ImageFormat::RGB, TypeInfo::Get<glm::u8vec3>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
+		},
+		AttachmentInfo(InternalImageFormat::DepthComponent16, ImageFormat::DepthComponent, TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge));
 
-					for(auto it = m_shadowMeshQueue.begin(); it != m_shadowMeshQueue.end(); ++it)
-					{
-						VertexArrayHandle vertexArray = it->first;
+		const RenderTargetDescription refractionDescription(resolution, resolution,
+		{
+			AttachmentInfo(InternalImageFormat::RGB8, ImageFormat::RGB, TypeInfo::Get<glm::u8vec3>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge),
+		},
+		AttachmentInfo(InternalImageFormat::DepthComponent16, ImageFormat::DepthComponent, TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge));
 
-						Buffer<MatrixTransformation>& matrices = it->second;
+		waterComponent.ReflectionTarget = m_acquiredTargets.emplace_back(renderDevice.TargetPool.Acquire(reflectionDescription));
+		waterComponent.RefractionTarget = m_acquiredTargets.emplace_back(renderDevice.TargetPool.Acquire(refractionDescription));
 
-						vertexArray->Draw(matrices);
-						matrices.Clear();
-					}
+		waterComponent.LastUpdateFrame = WaterUpdatePolicy::NeverUpdated;
+	}
 
-					target->Use();
-				}
+	void ReleaseTarget(RenderDevice& renderDevice, const RenderTargetHandle& acquiredTarget)
+	{
+		renderDevice.TargetPool.Release(acquiredTarget);
+		std::erase(m_acquiredTargets, acquiredTarget);
+	}
 
-				shader->TrySetTexture("u_normalTexture", m_gBuffer->GetColorAttachment(1));
-				shader->TrySetTexture("u_positionTexture", m_gBuffer->GetColorAttachment(2));
-				shader->TrySetTexture("u_specularTexture", m_gBuffer->GetColorAttachment(3));
+	// Renders the scene mirrored below the water into the reflection and clipped to below the water into the
+	// refraction, with this system disabled so it does not recurse.
+	static void RenderReflections(Scene& scene, RenderDevice& renderDevice, RenderContext2D& renderContext2D, const Transformation& transformation, WaterComponent& waterComponent)
+	{
+		scene.DisableSystem<WaterRendererSystem>();
 
-				shader->TrySetTexture("u_shadowMap", shadowMap);
+		Transformation& cameraTransformation = scene.PrimaryCamera.GetTransformation();
 
-				renderDevice.Disable(RenderFlags::DepthWriting);
-				renderDevice.Enable(RenderFlags::Blending);
-				renderDevice.SetBlendFunction(BlendFactor::One, BlendFactor::One);
+		const float waterHeight = transformation.GetTransformedPosition().y;
+		const float distance    = cameraTransformation.Position.y - waterHeight;
 
-				WaterLightInfo info(lightDirection, transformation.GetTransformedPosition(), altViewProjection);
+		cameraTransformation.Position.y -= distance * 2;
+		cameraTransformation.Rotation.x = -cameraTransformation.Rotation.x;
+		cameraTransformation.Rotation.z = -cameraTransformation.Rotation.z;
 
-				shader->TrySet("u_cameraPosition", scene.PrimaryCamera.GetTransformation().Position);
-				shader->TrySet("u_shadowMapSize", glm::vec2(shadowMap->Width, shadowMap->Height));
+		scene.Set("Clipping", true);
 
-				light->UpdateShader(shader);
-				shader->Use(nullptr);
-				m_screenQuad->Draw(ConstDynamicBufferSlice(&info, 1, m_lightInfoLayout));
+		scene.Set("ClippingPlane", glm::vec4(0, 1, 0, -waterHeight));
+		scene.Render(renderDevice, renderContext2D, *waterComponent.ReflectionTarget);
 
-				renderDevice.Disable(RenderFlags::Blending);
-				renderDevice.Enable(RenderFlags::DepthWriting);
-			}
-		}
-		renderDevice.Disable(RenderFlags::DepthWriting);
-		renderDevice.Enable(RenderFlags::Blending);
-		renderDevice.SetBlendFunction(BlendFactor::One, BlendFactor::One);
+		cameraTransformation.Position.y += distance * 2;
+		cameraTransformation.Rotation.x = -cameraTransformation.Rotation.x;
+		cameraTransformation.Rotation.z = -cameraTransformation.Rotation.z;
 
-		target->Use();
+		scene.Set("ClippingPlane", glm::vec4(0, -1, 0, waterHeight + 0.1f));
+		scene.Render(renderDevice, renderContext2D, *waterComponent.RefractionTarget);
 
-		m_screenShader->SetTexture("u_source", m_gBuffer->GetColorAttachment(0));
-		m_screenShader->Use(nullptr);
-		m_screenQuad->Draw(nullptr);
-		
-		renderDevice.Disable(RenderFlags::Blending);
-		renderDevice.Enable(RenderFlags::DepthWriting);
+		scene.Set("Clipping", false);
 
 		scene.EnableSystem<WaterRendererSystem>();
 	}
-};
\ No newline at end of file
+};
@@ -1,25 +1,21 @@
 #pragma once
 
+#include <algorithm>
+
 #include <glm/glm.hpp>
 
 class AABB
 {
 public:
-	AABB(const glm::vec3& minimum, const glm::vec3& maximum) : Minimum(minimum), Maximum(maximum)
-	{
-		Minimum.x = std::min(Minimum.x, Maximum.x);
-		Minimum.y = std::min(Minimum.y, Maximum.y);
-		Minimum.z = std::min(Minimum.z, Maximum.z);
+	AABB() : Minimum(0.0f), Maximum(0.0f) {}
 
-		Maximum.x = std::max(Maximum.x, Maximum.x);
-		Maximum.y = std::max(Maximum.y, Maximum.y);
-		Maximum.z = std::max(Maximum.z, Maximum.z);
-	}
+	AABB(const glm::vec3& minimum, const glm::vec3& maximum) : Minimum(glm::min(minimum, maximum)), Maximum(glm::max(minimum, maximum)) {}
 
 	glm::vec3 Minimum;
 	glm::vec3 Maximum;
 
-	glm::vec3 Size() const { return Maximum - Minimum; }
+	glm::vec3 Size()   const { return Maximum - Minimum; }
+	glm::vec3 Center() const { return (Minimum + Maximum) * 0.5f; }
 
 	bool Contains(const AABB& other) const
 	{
@@ -28,8 +24,30 @@ public:
 			   Minimum.z < other.Minimum.z && Maximum.z >= other.Maximum.z;
 	}
 
-	bool Intersects(const AABB& other)
+	bool Intersects(const AABB& other) const
 	{
+		return Minimum.x < other.Maximum.x && other.Minimum.x < Maximum.x &&
+			   Minimum.y < other.Maximum.y && other.Minimum.y < Maximum.y &&
+			   Minimum.z < other.Maximum.z && other.Minimum.z < Maximum.z;
+	}
+
+	AABB Merge(const AABB& other) const { return AABB(glm::min(Minimum, other.Minimum), glm::max(Maximum, other.Maximum)); }
+
+	// Arvo's method: the transformed box of an affine matrix without visiting all eight corners.
+	AABB Transform(const glm::mat4& matrix) const
+	{
+		glm::vec3 minimum(matrix[3]);
+		glm::vec3 maximum(matrix[3]);
+
+		for(int column = 0; column < 3; column++)
+		{
+			glm::vec3 a = glm::vec3(matrix[column]) * Minimum[column];
+			glm::vec3 b = glm::vec3(matrix[column]) * Maximum[column];
+
+			minimum += glm::min(a, b);
+			maximum += glm::max(a, b);
+		}
 
+		return AABB(minimum, maximum);
 	}
-};
\ No newline at end of file
+};
@@ -0,0 +1,279 @@
+#include "BroadPhase.hpp"
+
+#include <cfloat>
+#include <algorithm>
+
+BroadPhase::ProxyID BroadPhase::Add(const AABB& bounds)
+{
+	ProxyID proxy;
+	if(!m_freeProxies.empty())
+	{
+		proxy = m_freeProxies.back();
+		m_freeProxies.pop_back();
+	}
+	else
+	{
+		proxy = ProxyID(m_proxies.size());
+
+		Proxy& newProxy = m_proxies.emplace_back();
+		newProxy.Bounds = AABB(glm::vec3(FLT_MAX), glm::vec3(FLT_MAX));
+
+		// New endpoints start parked at the end of every axis and are sorted into place by Update.
+		for(int axis = 0; axis < 3; axis++)
+		{
+			auto& endpoints = m_endpoints[axis];
+
+			newProxy.Maximum[axis] = uint32_t(endpoints.size());
+			endpoints.emplace_back(FLT_MAX, proxy, true);
+
+			newProxy.Minimum[axis] = uint32_t(endpoints.size());
+			endpoints.emplace_back(FLT_MAX, proxy, false);
+		}
+	}
+
+	m_proxies[proxy].IsAlive = true;
+	Update(proxy, bounds);
+	return proxy;
+}
+
+std::vector<BroadPhase::ProxyID> BroadPhase::AddRange(std::span<const AABB> bounds)
+{
+	const ProxyID firstProxy = ProxyID(m_proxies.size());
+
+	std::vector<ProxyID> result(bounds.size());
+	for(size_t i = 0; i < bounds.size(); i++)
+	{
+		const ProxyID proxy = firstProxy + ProxyID(i);
+		result[i] = proxy;
+
+		Proxy& newProxy = m_proxies.emplace_back();
+		newProxy.Bounds  = bounds[i];
+		newProxy.IsAlive = true;
+
+		for(int axis = 0; axis < 3; axis++)
+		{
+			m_endpoints[axis].emplace_back(bounds[i].Minimum[axis], proxy, false);
+			m_endpoints[axis].emplace_back(bounds[i].Maximum[axis], proxy, true);
+		}
+	}
+
+	for(int axis = 0; axis < 3; axis++)
+	{
+		auto& endpoints = m_endpoints[axis];
+
+		std::sort(endpoints.begin(), endpoints.end());
+		for(uint32_t index = 0; index < endpoints.size(); index++)
+		{
+			SetEndpointIndex(axis, index);
+		}
+	}
+
+	// Sweeps the x axis keeping the proxies whose interval is open. Pairs between two old proxies are already known.
+	std::vector<ProxyID>  active;
+	std::vector<uint32_t> activeIndices(m_proxies.size());
+	for(const Endpoint& endpoint : m_endpoints[0])
+	{
+		const ProxyID proxy = endpoint.GetProxy();
+		if(!m_proxies[proxy].IsAlive)
+		{
+			continue;
+		}
+
+		if(endpoint.IsMaximum())
+		{
+			const uint32_t index = activeIndices[proxy];
+			active[index] = active.back();
+			activeIndices[active[index]] = index;
+			active.pop_back();
+			continue;
+		}
+
+		for(const ProxyID other : active)
+		{
+			if(proxy >= firstProxy || other >= firstProxy)
+			{
+				OnOverlapBegin(proxy, other);
+			}
+		}
+
+		activeIndices[proxy] = uint32_t(active.size());
+		active.push_back(proxy);
+	}
+
+	return result;
+}
+
+void BroadPhase::Remove(ProxyID proxy)
+{
+	m_proxies[proxy].IsAlive = false;
+	Update(proxy, AABB(glm::vec3(FLT_MAX), glm::vec3(FLT_MAX)));
+	m_freeProxies.push_back(proxy);
+}
+
+void BroadPhase::Update(ProxyID proxy, const AABB& bounds)
+{
+	Proxy& target = m_proxies[proxy];
+	target.Bounds = bounds;
+
+	for(int axis = 0; axis < 3; axis++)
+	{
+		auto& endpoints = m_endpoints[axis];
+
+		const float oldMinimum = endpoints[target.Minimum[axis]].Value;
+		const float oldMaximum = endpoints[target.Maximum[axis]].Value;
+
+		const float newMinimum = bounds.Minimum[axis];
+		const float newMaximum = bounds.Maximum[axis];
+
+		endpoints[target.Minimum[axis]].Value = newMinimum;
+		endpoints[target.Maximum[axis]].Value = newMaximum;
+
+		// Grow before shrinking so the minimum never has to cross its own maximum.
+		if(newMinimum < oldMinimum) { SortDown(axis, target.Minimum[axis]); }
+		if(newMaximum > oldMaximum) { SortUp  (axis, target.Maximum[axis]); }
+		if(newMinimum > oldMinimum) { SortUp  (axis, target.Minimum[axis]); }
+		if(newMaximum < oldMaximum) { SortDown(axis, target.Maximum[axis]); }
+	}
+}
+
+std::vector<BroadPhase::Pair> BroadPhase::GetPairs() const
+{
+	std::vector<Pair> result;
+	result.reserve(m_pairs.size());
+	for(uint64_t key : m_pairs)
+	{
+		result.emplace_back(ProxyID(key >> 32), ProxyID(key & UINT32_MAX));
+	}
+	return result;
+}
+
+std::vector<BroadPhase::Pair> BroadPhase::FindPairsBruteForce(const std::vector<AABB>& bounds)
+{
+	std::vector<Pair> result;
+	for(size_t i = 0; i < bounds.size(); i++)
+	{
+		for(size_t j = i + 1; j < bounds.size(); j++)
+		{
+			if(bounds[i].Intersects(bounds[j]))
+			{
+				result.emplace_back(ProxyID(i), ProxyID(j));
+			}
+		}
+	}
+	return result;
+}
+
+void BroadPhase::SortDown(int axis, uint32_t index)
+{
+	auto& endpoints = m_endpoints[axis];
+
+	const Endpoint current = endpoints[index];
+	const ProxyID  proxy   = current.GetProxy();
+
+	while(index > 0 && current < endpoints[index - 1])
+	{
+		const Endpoint& previous = endpoints[index - 1];
+		const ProxyID   other    = previous.GetProxy();
+
+		if(other != proxy)
+		{
+			if(!current.IsMaximum() && previous.IsMaximum())
+			{
+				OnOverlapBegin(proxy, other);
+			}
+			else if(current.IsMaximum() && !previous.IsMaximum())
+			{
+				OnOverlapEnd(proxy, other);
+			}
+		}
+
+		endpoints[index] = previous;
+		SetEndpointIndex(axis, index);
+		--index;
+	}
+
+	endpoints[index] = current;
+	SetEndpointIndex(axis, index);
+}
+
+void BroadPhase::SortUp(int axis, uint32_t index)
+{
+	auto& endpoints = m_endpoints[axis];
+
+	const Endpoint current = endpoints[index];
+	const ProxyID  proxy   = current.GetProxy();
+
+	while(index + 1 < endpoints.size() && endpoints[index + 1] < current)
+	{
+		const Endpoint& next  = endpoints[index + 1];
+		const ProxyID   other = next.GetProxy();
+
+		if(other != proxy)
+		{
+			if(current.IsMaximum() && !next.IsMaximum())
+			{
+				OnOverlapBegin(proxy, other);
+			}
+			else if(!current.IsMaximum() && next.IsMaximum())
+			{
+				OnOverlapEnd(proxy, other);
+			}
+		}
+
+		endpoints[index] = next;
+		SetEndpointIndex(axis, index);
+		++index;
+	}
+
+	endpoints[index] = current;
+	SetEndpointIndex(axis, index);
+}
+
+void BroadPhase::SetEndpointIndex(int axis, uint32_t index)
+{
+	const Endpoint& endpoint = m_endpoints[axis][index];
+
+	Proxy& proxy = m_proxies[endpoint.GetProxy()];
+	if(endpoint.IsMaximum())
+	{
+		proxy.Maximum[axis] = index;
+	}
+	else
+	{
+		proxy.Minimum[axis] = index;
+	}
+}
+
+void BroadPhase::OnOverlapBegin(ProxyID first, ProxyID second)
+{
+	const Proxy& a = m_proxies[first];
+	const Proxy& b = m_proxies[second];
+
+	if(!a.IsAlive || !b.IsAlive || !a.Bounds.Intersects(b.Bounds))
+	{
+		return;
+	}
+
+	Pair pair(first, second);
+	if(m_pairs.insert(GetPairKey(pair)).second)
+	{
+		m_pairEvents.emplace_back(pair, true);
+	}
+}
+
+void BroadPhase::OnOverlapEnd(ProxyID first, ProxyID second)
+{
+	const Proxy& a = m_proxies[first];
+	const Proxy& b = m_proxies[second];
+
+	if(a.IsAlive && b.IsAlive && a.Bounds.Intersects(b.Bounds))
+	{
+		return;
+	}
+
+	Pair pair(first, second);
+	if(m_pairs.erase(GetPairKey(pair)) > 0)
+	{
+		m_pairEvents.emplace_back(pair, false);
+	}
+}
@@ -0,0 +1,110 @@
+#pragma once
+
+#include <span>
+#include <array>
+#include <vector>
+#include <cstdint>
+#include <unordered_set>
+
+#include "AABB.hpp"
+
+class BroadPhase
+{
+public:
+	using ProxyID = uint32_t;
+
+	static constexpr ProxyID InvalidProxy = UINT32_MAX;
+
+	struct Pair
+	{
+		Pair(ProxyID first, ProxyID second) : First(std::min(first, second)), Second(std::max(first, second)) {}
+
+		ProxyID First;
+		ProxyID Second;
+
+		bool operator==(const Pair& other) const { return First == other.First && Second == other.Second; }
+	};
+
+	struct PairEvent
+	{
+		PairEvent(const Pair& pair, bool added) : Pair(pair), Added(added) {}
+
+		BroadPhase::Pair Pair;
+		bool             Added;
+	};
+
+	BroadPhase() = default;
+
+	ProxyID Add(const AABB& bounds);
+
+	// Adds every box with one sort per axis and one sweep for the new pairs, instead of sorting each box into place.
+	// The new proxies are always appended, so their IDs are consecutive and freed IDs are left for Add.
+	std::vector<ProxyID> AddRange(std::span<const AABB> bounds);
+
+	void Remove(ProxyID proxy);
+
+	void Update(ProxyID proxy, const AABB& bounds);
+
+	[[nodiscard]] const AABB& GetBounds(ProxyID proxy) const { return m_proxies[proxy].Bounds; }
+
+	[[nodiscard]] size_t ProxyCount() const { return m_proxies.size() - m_freeProxies.size(); }
+	[[nodiscard]] size_t  PairCount() const { return m_pairs.size(); }
+
+	[[nodiscard]] bool ContainsPair(ProxyID first, ProxyID second) const { return m_pairs.contains(GetPairKey(Pair(first, second))); }
+
+	// Every overlapping pair, in no particular order.
+	[[nodiscard]] std::vector<Pair> GetPairs() const;
+
+	// Pair additions and removals in the order they happened since the last ClearPairEvents call.
+	[[nodiscard]] const std::vector<PairEvent>& GetPairEvents() const { return m_pairEvents; }
+
+	void ClearPairEvents() { m_pairEvents.clear(); }
+
+	// O(n^2) reference used to validate and benchmark the incremental version.
+	static std::vector<Pair> FindPairsBruteForce(const std::vector<AABB>& bounds);
+private:
+	struct Endpoint
+	{
+		Endpoint(float value, ProxyID proxy, bool isMaximum) : Value(value), Data((proxy << 1) | uint32_t(isMaximum)) {}
+
+		float    Value;
+		uint32_t Data;
+
+		[[nodiscard]] ProxyID GetProxy()  const { return Data >> 1;      }
+		[[nodiscard]] bool    IsMaximum() const { return (Data & 1) != 0; }
+
+		// At equal values maxima sort before minima, matching the strict overlap test in AABB::Intersects.
+		bool operator<(const Endpoint& other) const
+		{
+			return Value < other.Value || (Value == other.Value && IsMaximum() && !other.IsMaximum());
+		}
+	};
+
+	struct Proxy
+	{
+		AABB Bounds;
+
+		std::array<uint32_t, 3> Minimum;
+		std::array<uint32_t, 3> Maximum;
+
+		bool IsAlive;
+	};
+
+	std::array<std::vector<Endpoint>, 3> m_endpoints;
+
+	std::vector<Proxy>   m_proxies;
+	std::vector<ProxyID> m_freeProxies;
+
+	std::unordered_set<uint64_t> m_pairs;
+	std::vector<PairEvent>       m_pairEvents;
+
+	static uint64_t GetPairKey(const Pair& pair) { return (uint64_t(pair.First) << 32) | pair.Second; }
+
+	void SortDown(int axis, uint32_t index);
+	void SortUp(int axis, uint32_t index);
+
+	void SetEndpointIndex(int axis, uint32_t index);
+
+	void OnOverlapBegin(ProxyID first, ProxyID second);
+	void OnOverlapEnd(ProxyID first, ProxyID second);
+};
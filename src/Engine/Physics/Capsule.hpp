@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cmath>
+
+#include "AABB.hpp"
+
+// Upright capsule: a vertical core segment of length 2 * HalfHeight around Center, swept by Radius.
+struct Capsule
+{
+	Capsule(const glm::vec3& center, float radius, float halfHeight) : Center(center), Radius(radius), HalfHeight(halfHeight) {}
+
+	glm::vec3 Center;
+	float     Radius;
+	float     HalfHeight;
+
+	[[nodiscard]] AABB GetBounds() const
+	{
+		glm::vec3 extent(Radius, HalfHeight + Radius, Radius);
+		return AABB(Center - extent, Center + extent);
+	}
+
+	// Returns the depth of penetration into the box, or a value <= 0 when separated. Normal points out of the box.
+	float Penetration(const AABB& box, glm::vec3& normal) const
+	{
+		const float bottom = Center.y - HalfHeight;
+		const float top    = Center.y + HalfHeight;
+
+		// For a vertical core segment the closest points separate into a planar XZ part and an interval gap on Y.
+		glm::vec3 closest = glm::clamp(Center, box.Minimum, box.Maximum);
+		glm::vec3 offset(Center.x - closest.x, 0.0f, Center.z - closest.z);
+
+		if(bottom > box.Maximum.y)
+		{
+			offset.y = bottom - box.Maximum.y;
+		}
+		else if(top < box.Minimum.y)
+		{
+			offset.y = top - box.Minimum.y;
+		}
+
+		const float distanceSquared = glm::dot(offset, offset);
+		if(distanceSquared > 1e-12f)
+		{
+			const float distance = std::sqrt(distanceSquared);
+			normal = offset / distance;
+			return Radius - distance;
+		}
+
+		// The core segment is inside the box, so push out along the axis of least penetration.
+		const glm::vec3 toMaximum = box.Maximum - glm::vec3(Center.x, bottom, Center.z);
+		const glm::vec3 toMinimum = glm::vec3(Center.x, top, Center.z) - box.Minimum;
+
+		float depth = INFINITY;
+		for(int axis = 0; axis < 3; axis++)
+		{
+			if(toMaximum[axis] < depth)
+			{
+				depth = toMaximum[axis];
+				normal = glm::vec3(0.0f);
+				normal[axis] = 1.0f;
+			}
+
+			if(toMinimum[axis] < depth)
+			{
+				depth = toMinimum[axis];
+				normal = glm::vec3(0.0f);
+				normal[axis] = -1.0f;
+			}
+		}
+
+		return depth + Radius;
+	}
+};
@@ -0,0 +1,312 @@
+#pragma once
+
+#include <cmath>
+#include <vector>
+#include <cstdint>
+#include <concepts>
+#include <type_traits>
+
+#include <glm/glm.hpp>
+#include <Common.hpp>
+
+template<typename T>
+class SpatialGrid
+{
+public:
+	using Handle = uint32_t;
+
+	static constexpr Handle InvalidHandle = UINT32_MAX;
+
+	SpatialGrid(const glm::uvec2& size, float cellSize = 1.0f, const glm::vec2& origin = glm::vec2(0.0f)) :
+		SpatialGrid(size, glm::mat3(
+			glm::vec3(1.0f / cellSize, 0.0f, 0.0f),
+			glm::vec3(0.0f, 1.0f / cellSize, 0.0f),
+			glm::vec3(-origin / cellSize, 1.0f))) {}
+
+	// worldToGrid maps (x, z, 1) in world space to continuous grid coordinates, cell (i, j) covering [i, i + 1) x [j, j + 1).
+	SpatialGrid(const glm::uvec2& size, const glm::mat3& worldToGrid) :
+		m_size(size),
+		m_worldToGrid(worldToGrid),
+		m_gridToWorld(glm::inverse(worldToGrid)),
+		m_heads(size_t(size.x) * size.y, InvalidHandle),
+		m_blocked(size_t(size.x) * size.y, false),
+		m_freeList(InvalidHandle),
+		m_count(0) {}
+
+	[[nodiscard]] glm::uvec2 Size()  const { return m_size;  }
+	[[nodiscard]] size_t     Count() const { return m_count; }
+
+	[[nodiscard]] bool IsInside(const glm::ivec2& cell) const
+	{
+		return cell.x >= 0 && cell.y >= 0 && cell.x < int(m_size.x) && cell.y < int(m_size.y);
+	}
+
+	[[nodiscard]] glm::vec2 WorldToGrid(const glm::vec3& position) const
+	{
+		return glm::vec2(m_worldToGrid * glm::vec3(position.x, position.z, 1.0f));
+	}
+
+	[[nodiscard]] glm::ivec2 WorldToCell(const glm::vec3& position) const
+	{
+		return glm::ivec2(glm::floor(WorldToGrid(position)));
+	}
+
+	[[nodiscard]] glm::vec3 CellToWorld(const glm::ivec2& cell, float height = 0.0f) const
+	{
+		glm::vec3 world = m_gridToWorld * glm::vec3(glm::vec2(cell) + 0.5f, 1.0f);
+		return glm::vec3(world.x, height, world.y);
+	}
+
+	Handle Insert(const T& item, const glm::ivec2& cell)
+	{
+		Handle handle = m_freeList;
+		if(handle != InvalidHandle)
+		{
+			m_freeList = m_nodes[handle].Next;
+			m_nodes[handle] = Node(item);
+		}
+		else
+		{
+			handle = Handle(m_nodes.size());
+			m_nodes.emplace_back(item);
+		}
+
+		Link(handle, CellIndex(cell));
+		++m_count;
+		return handle;
+	}
+
+	Handle Insert(const T& item, const glm::vec3& position) { return Insert(item, WorldToCell(position)); }
+
+	void Remove(Handle handle)
+	{
+		DEBUG_ASSERT(IsValid(handle), "Invalid spatial grid handle.");
+
+		Unlink(handle);
+		m_nodes[handle].Cell = InvalidHandle;
+		m_nodes[handle].Next = m_freeList;
+		m_freeList = handle;
+		--m_count;
+	}
+
+	// Returns true when the item changed cell; moves within a cell cost a single comparison.
+	bool Move(Handle handle, const glm::ivec2& cell)
+	{
+		DEBUG_ASSERT(IsValid(handle), "Invalid spatial grid handle.");
+
+		uint32_t cellIndex = CellIndex(cell);
+		if(m_nodes[handle].Cell == cellIndex)
+		{
+			return false;
+		}
+
+		Unlink(handle);
+		Link(handle, cellIndex);
+		return true;
+	}
+
+	bool Move(Handle handle, const glm::vec3& position) { return Move(handle, WorldToCell(position)); }
+
+	[[nodiscard]] bool IsValid(Handle handle) const { return handle < m_nodes.size() && m_nodes[handle].Cell != InvalidHandle; }
+
+	[[nodiscard]]       T& Get(Handle handle)       { return m_nodes[handle].Item; }
+	[[nodiscard]] const T& Get(Handle handle) const { return m_nodes[handle].Item; }
+
+	[[nodiscard]] glm::ivec2 GetCell(Handle handle) const
+	{
+		uint32_t cellIndex = m_nodes[handle].Cell;
+		return glm::ivec2(cellIndex % m_size.x, cellIndex / m_size.x);
+	}
+
+	template<std::invocable<Handle, T&> TFunction>
+	void ForEachInCell(const glm::ivec2& cell, TFunction&& function)
+	{
+		if(!IsInside(cell))
+		{
+			return;
+		}
+
+		Handle handle = m_heads[CellIndex(cell)];
+		while(handle != InvalidHandle)
+		{
+			// Read the link first so the callback may remove or move the current item.
+			Handle next = m_nodes[handle].Next;
+			function(handle, m_nodes[handle].Item);
+			handle = next;
+		}
+	}
+
+	template<std::invocable<Handle, T&> TFunction>
+	void ForEachInRange(const glm::ivec2& cell, uint32_t radius, TFunction&& function)
+	{
+		glm::ivec2 minimum = glm::max(cell - int(radius), glm::ivec2(0));
+		glm::ivec2 maximum = glm::min(cell + int(radius), glm::ivec2(m_size) - 1);
+
+		for(int y = minimum.y; y <= maximum.y; y++)
+		{
+			for(int x = minimum.x; x <= maximum.x; x++)
+			{
+				ForEachInCell(glm::ivec2(x, y), function);
+			}
+		}
+	}
+
+	template<std::invocable<Handle, T&> TFunction>
+	void ForEachInRange(const glm::vec3& position, float radius, TFunction&& function)
+	{
+		glm::vec2 center = WorldToGrid(position);
+		glm::vec2 extent = (glm::abs(glm::vec2(m_worldToGrid[0])) + glm::abs(glm::vec2(m_worldToGrid[1]))) * radius;
+
+		glm::ivec2 minimum = glm::max(glm::ivec2(glm::floor(center - extent)), glm::ivec2(0));
+		glm::ivec2 maximum = glm::min(glm::ivec2(glm::floor(center + extent)), glm::ivec2(m_size) - 1);
+
+		for(int y = minimum.y; y <= maximum.y; y++)
+		{
+			for(int x = minimum.x; x <= maximum.x; x++)
+			{
+				ForEachInCell(glm::ivec2(x, y), function);
+			}
+		}
+	}
+
+	void SetBlocked(const glm::ivec2& cell, bool blocked) { m_blocked[CellIndex(cell)] = blocked; }
+
+	[[nodiscard]] bool IsBlocked(const glm::ivec2& cell) const { return !IsInside(cell) || m_blocked[CellIndex(cell)]; }
+
+	// Amanatides-Woo traversal of every cell touched by the segment, in order. When the segment passes exactly
+	// through a cell corner both side cells are visited, so queries built on top of it stay conservative.
+	template<std::invocable<glm::ivec2> TFunction>
+	bool Traverse(const glm::vec2& from, const glm::vec2& to, TFunction&& function) const requires std::convertible_to<std::invoke_result_t<TFunction, glm::ivec2>, bool>
+	{
+		glm::ivec2 cell = glm::ivec2(glm::floor(from));
+		glm::ivec2 last = glm::ivec2(glm::floor(to));
+
+		glm::vec2  direction = to - from;
+		glm::ivec2 step(direction.x > 0.0f ? 1 : -1, direction.y > 0.0f ? 1 : -1);
+
+		glm::vec2 tDelta(INFINITY);
+		glm::vec2 tMax(INFINITY);
+
+		for(int axis = 0; axis < 2; axis++)
+		{
+			if(direction[axis] != 0.0f)
+			{
+				tDelta[axis] = std::abs(1.0f / direction[axis]);
+
+				float boundary = step[axis] > 0 ? float(cell[axis] + 1) : float(cell[axis]);
+				tMax[axis] = (boundary - from[axis]) / direction[axis];
+			}
+		}
+
+		if(!function(cell))
+		{
+			return false;
+		}
+
+		size_t remaining = size_t(std::abs(last.x - cell.x) + std::abs(last.y - cell.y));
+		while(remaining > 0)
+		{
+			if(tMax.x == tMax.y)
+			{
+				if(!function(glm::ivec2(cell.x + step.x, cell.y)) || !function(glm::ivec2(cell.x, cell.y + step.y)))
+				{
+					return false;
+				}
+
+				cell += step;
+				tMax += tDelta;
+				remaining = remaining > 1 ? remaining - 2 : 0;
+			}
+			else if(tMax.x < tMax.y)
+			{
+				cell.x += step.x;
+				tMax.x += tDelta.x;
+				--remaining;
+			}
+			else
+			{
+				cell.y += step.y;
+				tMax.y += tDelta.y;
+				--remaining;
+			}
+
+			if(!function(cell))
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	[[nodiscard]] bool IsVisible(const glm::vec2& from, const glm::vec2& to) const
+	{
+		return Traverse(from, to, [this](const glm::ivec2& cell) { return !IsBlocked(cell); });
+	}
+
+	[[nodiscard]] bool IsVisible(const glm::vec3& from, const glm::vec3& to) const
+	{
+		return IsVisible(WorldToGrid(from), WorldToGrid(to));
+	}
+private:
+	struct Node
+	{
+		explicit Node(const T& item) : Item(item), Cell(InvalidHandle), Previous(InvalidHandle), Next(InvalidHandle) {}
+
+		T        Item;
+		uint32_t Cell;
+		Handle   Previous;
+		Handle   Next;
+	};
+
+	glm::uvec2 m_size;
+	glm::mat3  m_worldToGrid;
+	glm::mat3  m_gridToWorld;
+
+	std::vector<Node>   m_nodes;
+	std::vector<Handle> m_heads;
+	std::vector<bool>   m_blocked;
+
+	Handle m_freeList;
+	size_t m_count;
+
+	[[nodiscard]] uint32_t CellIndex(const glm::ivec2& cell) const
+	{
+		glm::ivec2 clamped = glm::clamp(cell, glm::ivec2(0), glm::ivec2(m_size) - 1);
+		return uint32_t(clamped.y) * m_size.x + uint32_t(clamped.x);
+	}
+
+	void Link(Handle handle, uint32_t cellIndex)
+	{
+		Node& node = m_nodes[handle];
+		node.Cell     = cellIndex;
+		node.Previous = InvalidHandle;
+		node.Next     = m_heads[cellIndex];
+
+		if(node.Next != InvalidHandle)
+		{
+			m_nodes[node.Next].Previous = handle;
+		}
+
+		m_heads[cellIndex] = handle;
+	}
+
+	void Unlink(Handle handle)
+	{
+		Node& node = m_nodes[handle];
+
+		if(node.Previous != InvalidHandle)
+		{
+			m_nodes[node.Previous].Next = node.Next;
+		}
+		else
+		{
+			m_heads[node.Cell] = node.Next;
+		}
+
+		if(node.Next != InvalidHandle)
+		{
+			m_nodes[node.Next].Previous = node.Previous;
+		}
+	}
+};
@@ -0,0 +1,114 @@
+#include "StaticCollisionWorld.hpp"
+
+#include <cmath>
+#include <cfloat>
+#include <algorithm>
+
+void StaticCollisionWorld::Build()
+{
+	glm::vec2 minimum( FLT_MAX);
+	glm::vec2 maximum(-FLT_MAX);
+
+	for(const AABB& box : m_colliders)
+	{
+		minimum = glm::min(minimum, glm::vec2(box.Minimum.x, box.Minimum.z));
+		maximum = glm::max(maximum, glm::vec2(box.Maximum.x, box.Maximum.z));
+	}
+
+	if(m_colliders.empty())
+	{
+		minimum = maximum = glm::vec2(0.0f);
+	}
+
+	m_origin = minimum;
+	m_size   = glm::max(glm::ivec2(glm::ceil((maximum - minimum) / m_cellSize)), glm::ivec2(1));
+
+	const size_t cellCount = size_t(m_size.x) * m_size.y;
+
+	m_isBuilt = true;
+
+	// Two passes build a compact cell -> collider table: count per cell, then prefix sum and fill.
+	m_cellStarts.assign(cellCount + 1, 0);
+
+	for(const AABB& box : m_colliders)
+	{
+		const glm::ivec2 first = GetCell(box.Minimum);
+		const glm::ivec2 last  = GetCell(box.Maximum);
+
+		for(int y = first.y; y <= last.y; y++)
+		{
+			for(int x = first.x; x <= last.x; x++)
+			{
+				++m_cellStarts[size_t(y) * m_size.x + x + 1];
+			}
+		}
+	}
+
+	for(size_t i = 1; i <= cellCount; i++)
+	{
+		m_cellStarts[i] += m_cellStarts[i - 1];
+	}
+
+	std::vector<uint32_t> cursors(m_cellStarts.begin(), m_cellStarts.end() - 1);
+	m_cellColliders.resize(m_cellStarts.back());
+
+	for(ColliderID collider = 0; collider < m_colliders.size(); collider++)
+	{
+		const glm::ivec2 first = GetCell(m_colliders[collider].Minimum);
+		const glm::ivec2 last  = GetCell(m_colliders[collider].Maximum);
+
+		for(int y = first.y; y <= last.y; y++)
+		{
+			for(int x = first.x; x <= last.x; x++)
+			{
+				m_cellColliders[cursors[size_t(y) * m_size.x + x]++] = collider;
+			}
+		}
+	}
+}
+
+glm::vec3 StaticCollisionWorld::Move(const Capsule& capsule, const glm::vec3& offset, uint32_t maxIterations) const
+{
+	DEBUG_ASSERT(capsule.Radius > 0.0f, "A capsule moved through the static world needs a positive radius.");
+
+	const float    maxStep   = std::max(capsule.Radius * 0.5f, MinStepLength);
+	const uint32_t stepCount = uint32_t(std::clamp(std::ceil(glm::length(offset) / maxStep), 1.0f, float(MaxStepCount)));
+	const glm::vec3 step     = offset / float(stepCount);
+
+	Capsule current = capsule;
+	for(uint32_t i = 0; i < stepCount; i++)
+	{
+		current.Center += step;
+		current.Center = Resolve(current, maxIterations);
+	}
+
+	return current.Center;
+}
+
+glm::vec3 StaticCollisionWorld::Resolve(const Capsule& capsule, uint32_t maxIterations) const
+{
+	Capsule current = capsule;
+
+	for(uint32_t iteration = 0; iteration < maxIterations; iteration++)
+	{
+		bool isPenetrating = false;
+
+		ForEachOverlapping(current.GetBounds(), [&](ColliderID, const AABB& box)
+		{
+			glm::vec3 normal;
+			const float depth = current.Penetration(box, normal);
+			if(depth > 0.0f)
+			{
+				current.Center += normal * depth;
+				isPenetrating = true;
+			}
+		});
+
+		if(!isPenetrating)
+		{
+			break;
+		}
+	}
+
+	return current.Center;
+}
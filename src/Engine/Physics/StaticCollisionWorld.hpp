@@ -0,0 +1,103 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <concepts>
+
+#include <Common.hpp>
+
+#include "AABB.hpp"
+#include "Capsule.hpp"
+
+// Immovable level geometry bucketed into a uniform XZ grid once at load time, so per-frame queries only touch
+// the few cells around the querying shape.
+class StaticCollisionWorld
+{
+public:
+	using ColliderID = uint32_t;
+
+	explicit StaticCollisionWorld(float cellSize = 2.0f) : m_cellSize(cellSize), m_origin(0.0f), m_size(0), m_isBuilt(false) {}
+
+	ColliderID Add(const AABB& box)
+	{
+		m_colliders.push_back(box);
+		m_enabled.push_back(true);
+		m_isBuilt = false;
+		return ColliderID(m_colliders.size() - 1);
+	}
+
+	void SetEnabled(ColliderID collider, bool enabled) { m_enabled[collider] = enabled; }
+
+	[[nodiscard]] bool IsEnabled(ColliderID collider) const { return m_enabled[collider]; }
+
+	[[nodiscard]] size_t ColliderCount() const { return m_colliders.size(); }
+
+	[[nodiscard]] bool IsBuilt() const { return m_isBuilt; }
+
+	void Build();
+
+	template<std::invocable<ColliderID, const AABB&> TFunction>
+	void ForEachOverlapping(const AABB& region, TFunction&& function) const
+	{
+		DEBUG_ASSERT(m_isBuilt, "StaticCollisionWorld::Build must be called after adding colliders.");
+
+		const glm::ivec2 minimum = GetCell(region.Minimum);
+		const glm::ivec2 maximum = GetCell(region.Maximum);
+
+		for(int y = minimum.y; y <= maximum.y; y++)
+		{
+			for(int x = minimum.x; x <= maximum.x; x++)
+			{
+				const uint32_t cell = uint32_t(y) * m_size.x + uint32_t(x);
+				for(uint32_t i = m_cellStarts[cell]; i < m_cellStarts[cell + 1]; i++)
+				{
+					const ColliderID collider = m_cellColliders[i];
+					const AABB&      box      = m_colliders[collider];
+
+					if(!m_enabled[collider] || !box.Intersects(region))
+					{
+						continue;
+					}
+
+					// A box spanning several cells is only reported from the cell holding the overlap's minimum corner.
+					if(GetCell(glm::max(region.Minimum, box.Minimum)) != glm::ivec2(x, y))
+					{
+						continue;
+					}
+
+					function(collider, box);
+				}
+			}
+		}
+	}
+
+	// Sub-steps are never shorter than this, so a tiny radius cannot produce an unbounded step count.
+	static constexpr float MinStepLength = 1e-3f;
+
+	// Offsets longer than this many sub-steps take longer ones instead, so a teleport-sized offset stays cheap.
+	static constexpr uint32_t MaxStepCount = 64;
+
+	// Moves the capsule by the given offset in sub-steps no longer than half its radius, pushing it out of
+	// every collider after each step. Motion into a wall is removed and motion along it is kept.
+	[[nodiscard]] glm::vec3 Move(const Capsule& capsule, const glm::vec3& offset, uint32_t maxIterations = 4) const;
+private:
+	float      m_cellSize;
+	glm::vec2  m_origin;
+	glm::ivec2 m_size;
+
+	std::vector<AABB> m_colliders;
+	std::vector<bool> m_enabled;
+
+	std::vector<uint32_t>   m_cellStarts;
+	std::vector<ColliderID> m_cellColliders;
+
+	bool m_isBuilt;
+
+	[[nodiscard]] glm::ivec2 GetCell(const glm::vec3& position) const
+	{
+		const glm::ivec2 cell(glm::floor((glm::vec2(position.x, position.z) - m_origin) / m_cellSize));
+		return glm::clamp(cell, glm::ivec2(0), m_size - 1);
+	}
+
+	glm::vec3 Resolve(const Capsule& capsule, uint32_t maxIterations) const;
+};
@@ -0,0 +1,278 @@
+#include "NullRenderDevice.hpp"
+
+#include <cstring>
+#include <sstream>
+#include <unordered_map>
+
+static TypeInfo* GetUniformType(std::string_view typeName)
+{
+	static const std::unordered_map<std::string_view, TypeInfo*> s_types
+	{
+		{ "int"  , TypeInfo::Get<int32_t   >() },
+		{ "ivec2", TypeInfo::Get<glm::ivec2>() },
+		{ "ivec3", TypeInfo::Get<glm::ivec3>() },
+		{ "ivec4", TypeInfo::Get<glm::ivec4>() },
+		{ "float", TypeInfo::Get<float     >() },
+		{ "vec2" , TypeInfo::Get<glm::vec2 >() },
+		{ "vec3" , TypeInfo::Get<glm::vec3 >() },
+		{ "vec4" , TypeInfo::Get<glm::vec4 >() },
+		{ "mat2" , TypeInfo::Get<glm::mat2 >() },
+		{ "mat3" , TypeInfo::Get<glm::mat3 >() },
+		{ "mat4" , TypeInfo::Get<glm::mat4 >() },
+	};
+
+	if(typeName.starts_with("sampler"))
+	{
+		return TypeInfo::Get<int>();
+	}
+
+	auto it = s_types.find(typeName);
+	return it == s_types.end() ? nullptr : it->second;
+}
+
+NullMesh::NullMesh(const Model& model, RenderCommandLogHandle log) : Mesh(model), m_log(std::move(log))
+{
+	const size_t vertexBytes = model.Vertices->Count() * model.Vertices->GetElementType()->Size;
+	const size_t  indexBytes = IndexCount * IndexSize;
+
+	m_log->Record(RenderCommand(RenderCommandType::CreateMesh, this, 0, vertexBytes + indexBytes, VertexCount));
+}
+
+void NullMesh::Draw(size_t instanceCount)
+{
+	m_log->Record(RenderCommand(RenderCommandType::Draw, this, instanceCount, 0, IndexCount));
+}
+
+void NullRenderBuffer::Commit(size_t sizeInBytes, size_t elementCount)
+{
+	m_log->Record(RenderCommand(RenderCommandType::UpdateRenderBuffer, this, Slot, sizeInBytes, elementCount));
+}
+
+void NullConstantBuffer::Update(uint32_t slot, const void*, size_t sizeInBytes)
+{
+	m_log->Record(RenderCommand(RenderCommandType::UpdateConstantBuffer, this, slot, sizeInBytes, 1));
+}
+
+void NullTextureAtlas::Bind(uint32_t slot)
+{
+	m_log->Record(RenderCommand(RenderCommandType::BindTexture, this, slot));
+}
+
+void NullAttachmentTexture::CopyTo(BitmapBaseHandle cpuBuffer)
+{
+	const size_t sizeInBytes = cpuBuffer->PixelCount * cpuBuffer->Format->PixelType->Size;
+	memset(cpuBuffer->GetPixels(), 0, sizeInBytes);
+
+	m_log->Record(RenderCommand(RenderCommandType::ReadBack, this, 0, sizeInBytes, cpuBuffer->PixelCount));
+}
+
+void NullAttachmentTexture::Bind(uint32_t slot)
+{
+	m_log->Record(RenderCommand(RenderCommandType::BindTexture, this, slot));
+}
+
+NullRenderTarget::NullRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment, RenderCommandLogHandle log) :
+	RenderTarget(width, height, static_cast<uint32_t>(colorAttachments.size()), depthAttachment.has_value()),
+	m_log(std::move(log))
+{
+	size_t sizeInBytes = 0;
+	for(const AttachmentInfo& attachment : colorAttachments)
+	{
+		m_attachments.push_back(std::make_shared<NullAttachmentTexture>(width, height, m_log));
+		sizeInBytes += attachment.GetSizeInBytes(width, height);
+	}
+
+	if(depthAttachment)
+	{
+		m_depthAttachment = std::make_shared<NullTextureAtlas>(width, height, m_log);
+		sizeInBytes += depthAttachment->GetSizeInBytes(width, height);
+	}
+
+	m_log->Record(RenderCommand(RenderCommandType::CreateRenderTarget, this, 0, sizeInBytes, colorAttachments.size()));
+}
+
+void NullRenderTarget::Clear(int bufferType)
+{
+	m_log->Record(RenderCommand(RenderCommandType::Clear, this, uint64_t(bufferType)));
+}
+
+void NullRenderTarget::ClearColorBuffer(PixelFormat format, const void*)
+{
+	m_log->Record(RenderCommand(RenderCommandType::ClearColorBuffer, this, 0, format.PixelType->Size));
+}
+
+void NullRenderTarget::CopyTo(RenderTarget&, MagFilterMode, uint32_t bufferType)
+{
+	m_log->Record(RenderCommand(RenderCommandType::CopyRenderTarget, this, bufferType));
+}
+
+void NullRenderTarget::Use()
+{
+	m_log->Record(RenderCommand(RenderCommandType::UseRenderTarget, this));
+}
+
+NullRenderTargetArray::NullRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment, RenderCommandLogHandle log) :
+	RenderTargetArray(width, height, layerCount)
+{
+	m_depthAttachment = std::make_shared<NullTextureAtlas>(width, height, log);
+
+	m_layers.reserve(layerCount);
+	for(uint32_t i = 0; i < layerCount; i++)
+	{
+		m_layers.push_back(std::make_unique<NullRenderTarget>(width, height, m_depthAttachment, log));
+	}
+
+	log->Record(RenderCommand(RenderCommandType::CreateRenderTarget, this, 0, depthAttachment.GetSizeInBytes(width, height) * layerCount));
+}
+
+NullShader::NullShader(std::string_view sourceCode, RenderCommandLogHandle log) : Shader(sourceCode), m_log(std::move(log))
+{
+	std::istringstream stream(SourceCode);
+
+	std::string word;
+	while(stream >> word)
+	{
+		if(word != "uniform")
+		{
+			continue;
+		}
+
+		std::string typeName, name;
+		if(!(stream >> typeName >> name))
+		{
+			break;
+		}
+
+		// "name;" or "name[4];" - arrays and blocks ("uniform Block {") have no single value to report.
+		const size_t end = name.find_first_of(";[{");
+		if(end == 0 || name.find('[') != std::string::npos || name.find('{') != std::string::npos)
+		{
+			continue;
+		}
+
+		if(TypeInfo* type = GetUniformType(typeName))
+		{
+			m_uniforms.emplace_back(name.substr(0, end), type);
+		}
+	}
+
+	m_log->Record(RenderCommand(RenderCommandType::CreateShader, this, 0, SourceCode.size(), m_uniforms.size()));
+}
+
+void NullShader::GetUniforms(std::vector<Uniform>& uniforms)
+{
+	for(const Uniform& uniform : m_uniforms)
+	{
+		uniforms.emplace_back(uniform.Name, uniform.Type);
+	}
+}
+
+void NullShader::SetUniform(TypeInfo* type, std::string_view name, const void*)
+{
+	m_log->Record(RenderCommand(RenderCommandType::SetUniform, this, 0, type ? type->Size : 0, 1, std::string(name)));
+}
+
+void NullShader::SetUniform(std::string_view name, const TextureHandle&)
+{
+	m_log->Record(RenderCommand(RenderCommandType::SetTexture, this, 0, 0, 1, std::string(name)));
+}
+
+int32_t NullShader::GetUniformLocation(TypeInfo* type, std::string_view name)
+{
+	for(size_t i = 0; i < m_uniforms.size(); i++)
+	{
+		if(m_uniforms[i].Name == name)
+		{
+			return m_uniforms[i].Type == type ? int32_t(i) : -1;
+		}
+	}
+	return -1;
+}
+
+void NullShader::SetUniform(TypeInfo* type, int32_t location, const void*)
+{
+	if(location < 0 || size_t(location) >= m_uniforms.size())
+	{
+		return;
+	}
+
+	m_log->Record(RenderCommand(RenderCommandType::SetUniform, this, uint64_t(location), type ? type->Size : 0, 1, m_uniforms[location].Name));
+}
+
+void NullShader::Use()
+{
+	m_log->Record(RenderCommand(RenderCommandType::UseShader, this));
+}
+
+NullRenderDevice::NullRenderDevice(ScreenGraphicsMode graphicsMode, const RenderCommandLogHandle& log) :
+	RenderDevice(std::make_shared<NullRenderTarget>(graphicsMode.Width, graphicsMode.Height, std::vector<AttachmentInfo>(), std::nullopt, log), 31),
+	m_log(log) {}
+
+void NullRenderDevice::Enable(uint32_t flags)
+{
+	m_log->Record(RenderCommand(RenderCommandType::Enable, this, flags));
+}
+
+void NullRenderDevice::Disable(uint32_t flags)
+{
+	m_log->Record(RenderCommand(RenderCommandType::Disable, this, flags));
+}
+
+void NullRenderDevice::SetFaceCullingMode(FaceCullingMode faceCullingMode)
+{
+	m_log->Record(RenderCommand(RenderCommandType::SetFaceCullingMode, this, uint64_t(faceCullingMode)));
+}
+
+void NullRenderDevice::SetDepthFunction(DepthFunction depthFunction)
+{
+	m_log->Record(RenderCommand(RenderCommandType::SetDepthFunction, this, uint64_t(depthFunction)));
+}
+
+void NullRenderDevice::SetBlendFunction(BlendFactor sourceFactor, BlendFactor destFactor)
+{
+	m_log->Record(RenderCommand(RenderCommandType::SetBlendFunction, this, (uint64_t(sourceFactor) << 32) | uint64_t(destFactor)));
+}
+
+MeshHandle NullRenderDevice::CreateMesh(const Model& model)
+{
+	return std::make_shared<NullMesh>(model, m_log);
+}
+
+TextureAtlasHandle NullRenderDevice::CreateTextureAtlas(const BitmapBase& image, MinFilterMode, MagFilterMode, TextureWrappingMode)
+{
+	auto result = std::make_shared<NullTextureAtlas>(image.Width, image.Height, m_log);
+	m_log->Record(RenderCommand(RenderCommandType::CreateTexture, result.get(), 0, image.PixelCount * image.Format->PixelType->Size, image.PixelCount));
+	return result;
+}
+
+TextureAtlasHandle NullRenderDevice::CreateCubeMap(const BitmapBase& image, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode)
+{
+	return CreateTextureAtlas(image, minFilter, magFilter, wrappingMode);
+}
+
+RenderTargetHandle NullRenderDevice::CreateRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment)
+{
+	return std::make_shared<NullRenderTarget>(width, height, colorAttachments, depthAttachment, m_log);
+}
+
+RenderTargetArrayHandle NullRenderDevice::CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment)
+{
+	return std::make_shared<NullRenderTargetArray>(width, height, layerCount, depthAttachment, m_log);
+}
+
+ShaderHandle NullRenderDevice::CreateShader(std::string_view sourceCode)
+{
+	return std::make_shared<NullShader>(sourceCode, m_log);
+}
+
+DeviceRenderBufferHandle NullRenderDevice::CreateDeviceRenderBuffer(size_t sizeInBytes, size_t, uint32_t slot)
+{
+	m_log->Record(RenderCommand(RenderCommandType::CreateRenderBuffer, nullptr, slot, sizeInBytes));
+	return std::make_shared<NullRenderBuffer>(sizeInBytes, slot, m_log);
+}
+
+DeviceConstantBufferHandle NullRenderDevice::CreateDeviceConstantBuffer(size_t blockSize, size_t sectionCount)
+{
+	m_log->Record(RenderCommand(RenderCommandType::CreateConstantBuffer, nullptr, 0, blockSize * sectionCount, sectionCount));
+	return std::make_shared<NullConstantBuffer>(blockSize * sectionCount, m_log);
+}
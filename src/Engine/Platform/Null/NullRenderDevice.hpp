@@ -0,0 +1,172 @@
+#pragma once
+
+#include "../../Rendering/RenderDevice.hpp"
+
+#include "RenderCommandLog.hpp"
+
+// Headless backend: creates no GPU objects and records every state change, upload and draw into a shared
+// RenderCommandLog, so renderer systems can be exercised and measured without a window or GL context.
+
+class NullMesh final : public Mesh
+{
+public:
+	NullMesh(const Model& model, RenderCommandLogHandle log);
+protected:
+	void Draw(size_t instanceCount) override;
+private:
+	RenderCommandLogHandle m_log;
+};
+
+class NullRenderBuffer final : public DeviceRenderBuffer
+{
+public:
+	NullRenderBuffer(size_t sizeInBytes, uint32_t slot, RenderCommandLogHandle log) : Slot(slot), m_data(sizeInBytes), m_log(std::move(log)) {}
+
+	const uint32_t Slot;
+
+	[[nodiscard]] std::size_t SizeInBytes() const override { return m_data.size(); }
+
+	void* Map() override { return m_data.data(); }
+
+	void Commit(size_t sizeInBytes, size_t elementCount) override;
+
+	// A single region; Map always returns it, so it holds whatever was written before the last Commit.
+	[[nodiscard]] const std::vector<uint8_t>& GetData() const { return m_data; }
+private:
+	std::vector<uint8_t> m_data;
+
+	RenderCommandLogHandle m_log;
+};
+
+class NullConstantBuffer final : public DeviceConstantBuffer
+{
+public:
+	NullConstantBuffer(size_t sizeInBytes, RenderCommandLogHandle log) : m_sizeInBytes(sizeInBytes), m_log(std::move(log)) {}
+
+	[[nodiscard]] std::size_t SizeInBytes() const override { return m_sizeInBytes; }
+
+	void Update(uint32_t slot, const void* data, size_t sizeInBytes) override;
+private:
+	const size_t m_sizeInBytes;
+
+	RenderCommandLogHandle m_log;
+};
+
+class NullTextureAtlas final : public TextureAtlas
+{
+public:
+	NullTextureAtlas(uint32_t width, uint32_t height, RenderCommandLogHandle log) : TextureAtlas(width, height), m_log(std::move(log)) {}
+protected:
+	void Bind(uint32_t slot) override;
+private:
+	RenderCommandLogHandle m_log;
+};
+
+class NullAttachmentTexture final : public AttachmentTexture
+{
+public:
+	NullAttachmentTexture(uint32_t width, uint32_t height, RenderCommandLogHandle log) : AttachmentTexture(width, height), m_log(std::move(log)) {}
+
+	// Fills the bitmap with zeros, as a cleared attachment would read back.
+	void CopyTo(BitmapBaseHandle cpuBuffer) override;
+protected:
+	void Bind(uint32_t slot) override;
+private:
+	RenderCommandLogHandle m_log;
+};
+
+class NullRenderTarget final : public RenderTarget
+{
+public:
+	NullRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment, RenderCommandLogHandle log);
+
+	// Layer of a NullRenderTargetArray, which records the creation of the whole array.
+	NullRenderTarget(uint32_t width, uint32_t height, TextureAtlasHandle depthAttachment, RenderCommandLogHandle log) :
+		RenderTarget(width, height, 0, true), m_depthAttachment(std::move(depthAttachment)), m_log(std::move(log)) {}
+
+	  AttachmentHandle GetColorAttachment(size_t index) const override { return m_attachments[index]; }
+	TextureAtlasHandle GetDepthAttachment()             const override { return m_depthAttachment;    }
+
+	void Clear(int bufferType) override;
+
+	void ClearColorBuffer(PixelFormat format, const void* value) override;
+
+	void CopyTo(RenderTarget& target, MagFilterMode filterMode, uint32_t bufferType) override;
+protected:
+	void Use() override;
+private:
+	std::vector<AttachmentHandle> m_attachments;
+	TextureAtlasHandle m_depthAttachment;
+
+	RenderCommandLogHandle m_log;
+};
+
+class NullRenderTargetArray final : public RenderTargetArray
+{
+public:
+	NullRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment, RenderCommandLogHandle log);
+
+	RenderTarget& GetLayer(uint32_t layer) override { return *m_layers[layer]; }
+
+	TextureAtlasHandle GetDepthAttachment() const override { return m_depthAttachment; }
+private:
+	TextureAtlasHandle m_depthAttachment;
+
+	std::vector<std::unique_ptr<NullRenderTarget>> m_layers;
+};
+
+class NullShader final : public Shader
+{
+public:
+	NullShader(std::string_view sourceCode, RenderCommandLogHandle log);
+
+	// Reports the plain uniform declarations found in the source; uniform blocks and arrays are skipped.
+	void GetUniforms(std::vector<Uniform>& uniforms) override;
+
+	void SetUniform(TypeInfo* type, std::string_view name, const void* data) override;
+
+	void SetUniform(std::string_view name, const TextureHandle& texture) override;
+
+	// Locations are indices into the parsed uniform declarations.
+	int32_t GetUniformLocation(TypeInfo* type, std::string_view name) override;
+
+	void SetUniform(TypeInfo* type, int32_t location, const void* data) override;
+protected:
+	void Use() override;
+private:
+	std::vector<Uniform> m_uniforms;
+
+	RenderCommandLogHandle m_log;
+};
+
+class NullRenderDevice final : public RenderDevice
+{
+public:
+	explicit NullRenderDevice(ScreenGraphicsMode graphicsMode, const RenderCommandLogHandle& log = std::make_shared<RenderCommandLog>());
+
+	[[nodiscard]] const RenderCommandLogHandle& GetLog() const { return m_log; }
+
+	void Enable(uint32_t flags) override;
+
+	void Disable(uint32_t flags) override;
+
+	void SetFaceCullingMode(FaceCullingMode faceCullingMode) override;
+
+	void SetDepthFunction(DepthFunction depthFunction) override;
+
+	void SetBlendFunction(BlendFactor sourceFactor, BlendFactor destFactor) override;
+
+	MeshHandle         CreateMesh        (const Model& model) override;
+	TextureAtlasHandle CreateTextureAtlas(const BitmapBase& image, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode) override;
+	TextureAtlasHandle CreateCubeMap     (const BitmapBase& image, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode) override;
+	RenderTargetHandle CreateRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment) override;
+	ShaderHandle       CreateShader      (std::string_view sourceCode) override;
+
+	RenderTargetArrayHandle CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment) override;
+protected:
+	DeviceRenderBufferHandle CreateDeviceRenderBuffer(size_t sizeInBytes, size_t regionCount, uint32_t slot) override;
+
+	DeviceConstantBufferHandle CreateDeviceConstantBuffer(size_t blockSize, size_t sectionCount) override;
+private:
+	RenderCommandLogHandle m_log;
+};
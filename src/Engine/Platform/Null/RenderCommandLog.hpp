@@ -0,0 +1,140 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+enum class RenderCommandType : uint8_t
+{
+	Enable,
+	Disable,
+	SetFaceCullingMode,
+	SetDepthFunction,
+	SetBlendFunction,
+
+	CreateMesh,
+	CreateTexture,
+	CreateRenderTarget,
+	CreateShader,
+	CreateRenderBuffer,
+	CreateConstantBuffer,
+
+	UpdateRenderBuffer,
+	UpdateConstantBuffer,
+	SetUniform,
+	SetTexture,
+	BindTexture,
+
+	UseShader,
+	UseRenderTarget,
+	Clear,
+	ClearColorBuffer,
+	CopyRenderTarget,
+	ReadBack,
+
+	Draw,
+};
+
+// One recorded call. Argument holds the flags or enum value of a state change, the buffer mask of a clear, the
+// instance count of a draw or the slot of a buffer creation or update; ElementCount holds the index count of a draw
+// and the element count of an upload.
+struct RenderCommand
+{
+	RenderCommand(RenderCommandType type, const void* object, uint64_t argument = 0, size_t byteCount = 0, size_t elementCount = 0, std::string name = {}) :
+		Type(type), Object(object), Argument(argument), ByteCount(byteCount), ElementCount(elementCount), Name(std::move(name)) {}
+
+	RenderCommandType Type;
+	const void*       Object;
+	uint64_t          Argument;
+	size_t            ByteCount;
+	size_t            ElementCount;
+	std::string       Name;
+
+	[[nodiscard]] bool IsUpload() const
+	{
+		return Type == RenderCommandType::CreateMesh || Type == RenderCommandType::CreateTexture ||
+			   Type == RenderCommandType::UpdateRenderBuffer || Type == RenderCommandType::UpdateConstantBuffer ||
+			   Type == RenderCommandType::SetUniform;
+	}
+
+	[[nodiscard]] bool IsStateChange() const { return Type <= RenderCommandType::SetBlendFunction || Type == RenderCommandType::UseShader || Type == RenderCommandType::UseRenderTarget || Type == RenderCommandType::BindTexture; }
+};
+
+struct RenderStatistics
+{
+	size_t      DrawCount = 0;
+	size_t  InstanceCount = 0;
+	size_t  TriangleCount = 0;
+	size_t StateChangeCount = 0;
+	size_t    UploadCount = 0;
+	size_t  UploadedBytes = 0;
+
+	size_t RenderTargetCount = 0;
+	size_t RenderTargetBytes = 0;
+};
+
+// Shared by a NullRenderDevice and every object it creates, so commands stay in call order across objects.
+class RenderCommandLog
+{
+public:
+	void Record(RenderCommand command)
+	{
+		if(m_isRecording)
+		{
+			m_commands.push_back(std::move(command));
+		}
+	}
+
+	[[nodiscard]] const std::vector<RenderCommand>& GetCommands() const { return m_commands; }
+
+	// Call between frames to measure one frame at a time.
+	void Clear() { m_commands.clear(); }
+
+	void SetRecording(bool recording) { m_isRecording = recording; }
+
+	[[nodiscard]] size_t Count(RenderCommandType type) const
+	{
+		size_t result = 0;
+		for(const RenderCommand& command : m_commands)
+		{
+			result += command.Type == type;
+		}
+		return result;
+	}
+
+	[[nodiscard]] RenderStatistics GetStatistics() const
+	{
+		RenderStatistics result;
+		for(const RenderCommand& command : m_commands)
+		{
+			if(command.Type == RenderCommandType::Draw)
+			{
+				++result.DrawCount;
+				result.InstanceCount += command.Argument;
+				result.TriangleCount += command.Argument * (command.ElementCount / 3);
+			}
+			else if(command.Type == RenderCommandType::CreateRenderTarget)
+			{
+				++result.RenderTargetCount;
+				result.RenderTargetBytes += command.ByteCount;
+			}
+			else if(command.IsUpload())
+			{
+				++result.UploadCount;
+				result.UploadedBytes += command.ByteCount;
+			}
+			else if(command.IsStateChange())
+			{
+				++result.StateChangeCount;
+			}
+		}
+		return result;
+	}
+private:
+	std::vector<RenderCommand> m_commands;
+
+	bool m_isRecording = true;
+};
+
+using RenderCommandLogHandle = std::shared_ptr<RenderCommandLog>;
@@ -1,6 +1,7 @@
 #include "OpenGLCommon.hpp"
 
 #include "Reflection.hpp"
+#include "../../Core/Buffer.hpp"
 
 class TypeInfo;
 
@@ -36,15 +37,25 @@ GL::ElementType GetElementType(TypeInfo* elementType)
         return GL::ElementType::SInt32;
     }
 
+    if (elementType == TypeInfo::Get<HalfFloat>())
+    {
+        return GL::ElementType::Float16;
+    }
+
     if (elementType == TypeInfo::Get<float>())
     {
         return GL::ElementType::Float32;
     }
 
-    if (elementType == TypeInfo::Get<int32_t>())
+    if (elementType == TypeInfo::Get<double>())
     {
         return GL::ElementType::Float64;
     }
 
+    if (elementType == TypeInfo::Get<PackedSnorm1010102>())
+    {
+        return GL::ElementType::SInt2101010;
+    }
+
     return GL::ElementType::UInt8;
 }
@@ -0,0 +1,32 @@
+#include "OpenGLConstantBuffer.hpp"
+
+#include <Common.hpp>
+
+#include <algorithm>
+
+static size_t AlignUp(size_t size, size_t alignment)
+{
+    return (size + alignment - 1) / alignment * alignment;
+}
+
+OpenGLConstantBuffer::OpenGLConstantBuffer(size_t blockSize, size_t sectionCount) :
+    m_sectionSize(AlignUp(blockSize, GL::UniformBuffer::GetOffsetAlignment())),
+    m_sectionCount(std::max<size_t>(sectionCount, 1)),
+    m_nextSection(0),
+    m_buffer(m_sectionSize * m_sectionCount) {}
+
+std::size_t OpenGLConstantBuffer::SizeInBytes() const
+{
+    return m_sectionSize * m_sectionCount;
+}
+
+void OpenGLConstantBuffer::Update(uint32_t slot, const void* data, size_t sizeInBytes)
+{
+    DEBUG_ASSERT(sizeInBytes <= m_sectionSize, "Constant block is larger than its buffer section.");
+
+    const size_t offset = m_nextSection * m_sectionSize;
+    m_nextSection = (m_nextSection + 1) % m_sectionCount;
+
+    m_buffer.UpdateData(data, offset, sizeInBytes);
+    m_buffer.BindRange(slot, offset, sizeInBytes);
+}
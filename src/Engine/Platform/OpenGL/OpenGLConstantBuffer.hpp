@@ -0,0 +1,22 @@
+#pragma once
+#include "Engine/Rendering/ConstantBlock.hpp"
+#include "OpenGLRenderer/UniformBuffer.hpp"
+
+// A uniform buffer split into sections that Update cycles through, so writing a block rarely touches memory a draw
+// recorded earlier in the frame is still reading.
+class OpenGLConstantBuffer final : public DeviceConstantBuffer
+{
+public:
+    OpenGLConstantBuffer(size_t blockSize, size_t sectionCount);
+
+    [[nodiscard]] std::size_t SizeInBytes() const override;
+
+    void Update(uint32_t slot, const void* data, size_t sizeInBytes) override;
+private:
+    const size_t m_sectionSize;
+    const size_t m_sectionCount;
+
+    size_t m_nextSection;
+
+    GL::UniformBuffer m_buffer;
+};
@@ -7,7 +7,11 @@ OpenGLMesh::OpenGLMesh(const Model& model) : Mesh(model)
     GL::BufferLayout vertexBufferLayout;
     for(const BufferAttribute& attribute : model.GetLayout())
     {
-        vertexBufferLayout.AddElement(GetElementType(attribute.ElementType), attribute.Count);
+        const GL::ElementType elementType = GetElementType(attribute.ElementType);
+
+        // GL counts the components of a packed element rather than the elements.
+        const size_t count = elementType == GL::ElementType::SInt2101010 ? attribute.Count * 4 : attribute.Count;
+        vertexBufferLayout.AddElement(elementType, count, attribute.Normalized);
     }
 
     const auto vertexBuffer = std::make_shared<GL::VertexBuffer>(model.Vertices->Data(), model.Vertices->Count(), GL::BufferUsage::StaticDraw, false, vertexBufferLayout);
@@ -5,7 +5,12 @@ std::size_t OpenGLRenderBuffer::SizeInBytes() const
     return m_sizeInBytes;
 }
 
-void OpenGLRenderBuffer::Update(ConstDynamicBufferSlice instanceData)
+void* OpenGLRenderBuffer::Map()
 {
-    m_buffer.UpdateData(instanceData.Data(), 0, instanceData.Count());
+    return m_buffer.Map();
+}
+
+void OpenGLRenderBuffer::Commit(size_t sizeInBytes, size_t)
+{
+    m_buffer.Commit(Slot, sizeInBytes);
 }
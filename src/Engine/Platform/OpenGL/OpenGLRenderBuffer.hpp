@@ -1,17 +1,22 @@
 #pragma once
 #include "Engine/Rendering/RenderBuffer.hpp"
-#include "OpenGLRenderer/ShaderStorageBuffer.hpp"
+#include "OpenGLRenderer/StreamBuffer.hpp"
 
 class OpenGLRenderBuffer final : public DeviceRenderBuffer
 {
 public:
-    explicit OpenGLRenderBuffer(size_t sizeInBytes) : m_buffer(sizeInBytes), m_sizeInBytes(sizeInBytes) {}
+    // Each commit binds its range to the "layout(std430, binding = slot) buffer" blocks of the shaders.
+    OpenGLRenderBuffer(size_t sizeInBytes, size_t regionCount, uint32_t slot) : Slot(slot), m_buffer(sizeInBytes, regionCount), m_sizeInBytes(sizeInBytes) {}
+
+    const uint32_t Slot;
 
     [[nodiscard]] std::size_t SizeInBytes() const override;
 
-    void Update(ConstDynamicBufferSlice instanceData) override;
+    void* Map() override;
+
+    void Commit(size_t sizeInBytes, size_t elementCount) override;
 private:
-    GL::ShaderStorageBuffer m_buffer;
+    GL::StreamBuffer m_buffer;
 
     const size_t m_sizeInBytes;
 };
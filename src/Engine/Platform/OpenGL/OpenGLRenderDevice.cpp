@@ -11,9 +11,10 @@
 #include <OpenGLRenderer/Renderer.hpp>
 
 #include "OpenGLRenderBuffer.hpp"
+#include "OpenGLConstantBuffer.hpp"
 
 OpenGLRenderDevice::OpenGLRenderDevice(ScreenGraphicsMode graphicsMode) :
-    RenderDevice(std::make_shared<OpenGLRenderTarget>(graphicsMode.Width, graphicsMode.Height), 31),
+    RenderDevice(std::make_shared<OpenGLRenderTarget>(graphicsMode.Width, graphicsMode.Height), OpenGLShader::FirstTextureUnit),
     m_graphicsMode(graphicsMode)
 {
 	if(glewInit() != GLEW_OK)
@@ -21,6 +22,8 @@ OpenGLRenderDevice::OpenGLRenderDevice(ScreenGraphicsMode graphicsMode) :
 	    std::cout << "Glew Initialization Failed!" << std::endl;
 	}
 
+	GL::StateCache::Get().Invalidate();
+
 	GL::Enable(GL::EnableFlags::CullFace);
 	GL::Enable(GL::EnableFlags::DepthTest);
 	GL::Enable(GL::EnableFlags::DepthClamp);
@@ -269,14 +272,24 @@ RenderTargetHandle OpenGLRenderDevice::CreateRenderTarget(uint32_t width, uint32
     return std::make_shared<OpenGLRenderTarget>(width, height, colorAttachments, depthAttachment);
 }
 
+RenderTargetArrayHandle OpenGLRenderDevice::CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment)
+{
+    return std::make_shared<OpenGLRenderTargetArray>(width, height, layerCount, depthAttachment);
+}
+
 ShaderHandle OpenGLRenderDevice::CreateShader(std::string_view sourceCode)
 {
     return std::make_shared<OpenGLShader>(sourceCode);
 }
 
-DeviceRenderBufferHandle OpenGLRenderDevice::CreateDeviceRenderBuffer(size_t sizeInBytes)
+DeviceRenderBufferHandle OpenGLRenderDevice::CreateDeviceRenderBuffer(size_t sizeInBytes, size_t regionCount, uint32_t slot)
+{
+    return std::make_shared<OpenGLRenderBuffer>(sizeInBytes, regionCount, slot);
+}
+
+DeviceConstantBufferHandle OpenGLRenderDevice::CreateDeviceConstantBuffer(size_t blockSize, size_t sectionCount)
 {
-    return std::make_shared<OpenGLRenderBuffer>(sizeInBytes);
+    return std::make_shared<OpenGLConstantBuffer>(blockSize, sectionCount);
 }
 
 
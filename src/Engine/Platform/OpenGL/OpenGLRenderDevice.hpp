@@ -2,11 +2,18 @@
 
 #include "../../Rendering/RenderDevice.hpp"
 
+#include <OpenGLRenderer/StateCache.hpp>
+
 class OpenGLRenderDevice : public RenderDevice
 {
 public:
 	explicit OpenGLRenderDevice(ScreenGraphicsMode graphicsMode);
 
+	// State calls that reached GL versus those dropped as redundant since the last reset.
+	[[nodiscard]] const GL::StateStatistics& GetStateStatistics() const { return GL::StateCache::Get().GetStatistics(); }
+
+	void ResetStateStatistics() { GL::StateCache::Get().ResetStatistics(); }
+
 	void Enable(uint32_t flags) override;
 
 	void Disable(uint32_t flags) override;
@@ -23,8 +30,12 @@ public:
 	RenderTargetHandle CreateRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment) override;
 	ShaderHandle       CreateShader      (std::string_view sourceCode) override;
 
+	RenderTargetArrayHandle CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment) override;
+
 protected:
-	DeviceRenderBufferHandle CreateDeviceRenderBuffer(size_t sizeInBytes) override;
+	DeviceRenderBufferHandle CreateDeviceRenderBuffer(size_t sizeInBytes, size_t regionCount, uint32_t slot) override;
+
+	DeviceConstantBufferHandle CreateDeviceConstantBuffer(size_t blockSize, size_t sectionCount) override;
 private:
 	ScreenGraphicsMode m_graphicsMode;
 };
\ No newline at end of file
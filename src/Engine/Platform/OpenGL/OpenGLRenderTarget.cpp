@@ -89,6 +89,20 @@ std::vector<GL::AttachmentInfo> GetAttachments(const std::vector<AttachmentInfo>
 	return result;
 }
 
+OpenGLRenderTargetArray::OpenGLRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachmentInfo) :
+	RenderTargetArray(width, height, layerCount)
+{
+	const GL::AttachmentInfo attachment = GetAttachment(depthAttachmentInfo);
+	m_depthArray = std::make_shared<GL::Texture2DArray>(width, height, layerCount, attachment.InternalFormat, attachment.Format, attachment.PixelElementType, attachment.MinFilter, attachment.MagFilter, attachment.WrappingMode);
+	m_depthAttachment = std::make_shared<OpenGLDepthAttachmentTexture>(*m_depthArray);
+
+	m_layers.reserve(layerCount);
+	for(uint32_t i = 0; i < layerCount; i++)
+	{
+		m_layers.push_back(std::make_unique<OpenGLRenderTarget>(m_depthArray, i, m_depthAttachment));
+	}
+}
+
 void OpenGLRenderTarget::Clear(const int bufferType)
 {
 	uint32_t mask = 0;
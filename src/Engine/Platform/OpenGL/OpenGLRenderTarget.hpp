@@ -34,7 +34,7 @@ public:
 class OpenGLDepthAttachmentTexture : public TextureAtlas
 {
 public:
-	explicit OpenGLDepthAttachmentTexture(GL::Texture2D& texture) : TextureAtlas(texture.Width, texture.Height), m_texture(texture)
+	explicit OpenGLDepthAttachmentTexture(GL::Texture& texture) : TextureAtlas(texture.Width, texture.Height), m_texture(texture)
 	{
 	}
 
@@ -43,7 +43,7 @@ public:
 		m_texture.Bind(slot);
 	}
 private:
-	GL::Texture2D& m_texture;
+	GL::Texture& m_texture;
 };
 
 class OpenGLRenderTarget : public RenderTarget
@@ -69,6 +69,9 @@ public:
 		}
 	}
 
+	OpenGLRenderTarget(const std::shared_ptr<GL::Texture2DArray>& depthArray, uint32_t layer, TextureAtlasHandle depthAttachment) :
+		RenderTarget(depthArray->Width, depthArray->Height, 0, true), m_frameBuffer(depthArray, layer), m_depthAttachment(std::move(depthAttachment)) {}
+
 	  AttachmentHandle GetColorAttachment(size_t index) const override { return m_attachments[index]; }
 	TextureAtlasHandle GetDepthAttachment()             const override { return m_depthAttachment;    }
 
@@ -104,4 +107,19 @@ private:
 	GL::FrameBuffer m_frameBuffer;
 	std::vector<AttachmentHandle> m_attachments;
 	TextureAtlasHandle m_depthAttachment;
+};
+
+class OpenGLRenderTargetArray final : public RenderTargetArray
+{
+public:
+	OpenGLRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachmentInfo);
+
+	RenderTarget& GetLayer(uint32_t layer) override { return *m_layers[layer]; }
+
+	TextureAtlasHandle GetDepthAttachment() const override { return m_depthAttachment; }
+private:
+	std::shared_ptr<GL::Texture2DArray> m_depthArray;
+	TextureAtlasHandle m_depthAttachment;
+
+	std::vector<std::unique_ptr<OpenGLRenderTarget>> m_layers;
 };
\ No newline at end of file
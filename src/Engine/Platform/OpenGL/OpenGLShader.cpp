@@ -1,11 +1,13 @@
 #include "OpenGLShader.hpp"
 
+#include <Common.hpp>
+
 TypeInfo* GetType(GL::UniformType uniformType)
 {
 	switch(uniformType)
 	{
 		case GL::UniformType::Int:
-			return TypeInfo::Get<glm::ivec1>();
+			return TypeInfo::Get<int32_t>();
 		case GL::UniformType::Int2:
 			return TypeInfo::Get<glm::ivec2>();
 		case GL::UniformType::Int3:
@@ -13,7 +15,7 @@ TypeInfo* GetType(GL::UniformType uniformType)
 		case GL::UniformType::Int4:
 			return TypeInfo::Get<glm::ivec4>();
 		case GL::UniformType::Float:
-			return TypeInfo::Get<glm::fvec1>();
+			return TypeInfo::Get<float>();
 		case GL::UniformType::Float2:
 			return TypeInfo::Get<glm::fvec2>();
 		case GL::UniformType::Float3:
@@ -30,6 +32,8 @@ TypeInfo* GetType(GL::UniformType uniformType)
 		case GL::UniformType::Sampler3D:
 		case GL::UniformType::SamplerCube:
 			return TypeInfo::Get<int>();
+		default:
+			break;
 	}
 
 	return nullptr;
@@ -96,37 +100,104 @@ void OpenGLShader::GetUniforms(std::vector<Uniform>& uniforms)
 
 void OpenGLShader::SetUniform(TypeInfo* type, std::string_view name, const void* source)
 {
+	SetUniform(type, GetUniformLocation(type, name), source);
+}
+
+void OpenGLShader::SetUniform(std::string_view name, const TextureHandle& texture)
+{
+	DEBUG_ASSERT(texture.Atlas, "Shader cannot have null texture.");
+
+	auto it = m_textures.find(name);
+	if(it == m_textures.end())
+	{
+		// Looked up by name, since array and shadow samplers are missing from the active uniform table.
+		const GLint location = m_shader.GetUniformLocation(name);
+		if(location < 0)
+			return;
+
+		const uint32_t unit = FirstTextureUnit + static_cast<uint32_t>(m_textures.size());
+		DEBUG_ASSERT(unit < GL::StateCache::TextureUnitCount, "The shader samples more textures than there are units left for it.");
+
+		m_shader.SetUniform(location, static_cast<int>(unit));
+		it = m_textures.emplace(std::string(name), BoundTexture{ unit, nullptr }).first;
+	}
+
+	it->second.Texture = texture.Atlas;
+}
+
+int32_t OpenGLShader::GetUniformLocation(TypeInfo* type, std::string_view name)
+{
+	auto it = m_activeUniforms.find(name);
+	if(it != m_activeUniforms.end())
+	{
+		return it->second.Type == type ? it->second.Location : -1;
+	}
+
+	// Only the first element of an array of structs is listed as active, so the rest are looked up by name.
+	return m_shader.GetUniformLocation(name);
+}
+
+void OpenGLShader::SetUniform(TypeInfo* type, int32_t location, const void* source)
+{
+	if(location < 0)
+		return;
+
 	if(type == TypeInfo::Get<int>())
-		SetUniform<int32_t>(name, source);
+		SetUniform<int32_t>(location, source);
 	else if(type == TypeInfo::Get<glm::ivec2>())
-		SetUniform<glm::ivec2>(name, source);
+		SetUniform<glm::ivec2>(location, source);
 	else if(type == TypeInfo::Get<glm::ivec3>())
-		SetUniform<glm::ivec3>(name, source);
+		SetUniform<glm::ivec3>(location, source);
 	else if(type == TypeInfo::Get<glm::ivec4>())
-		SetUniform<glm::ivec4>(name, source);
+		SetUniform<glm::ivec4>(location, source);
 	else if(type == TypeInfo::Get<float>())
-		SetUniform<float>(name, source);
+		SetUniform<float>(location, source);
 	else if(type == TypeInfo::Get<glm::vec2>())
-		SetUniform<glm::vec2>(name, source);
+		SetUniform<glm::vec2>(location, source);
 	else if(type == TypeInfo::Get<glm::vec3>())
-		SetUniform<glm::vec3>(name, source);
+		SetUniform<glm::vec3>(location, source);
 	else if(type == TypeInfo::Get<glm::vec4>())
-		SetUniform<glm::vec4>(name, source);
+		SetUniform<glm::vec4>(location, source);
 	else if(type == TypeInfo::Get<glm::mat2>())
-		SetUniform<glm::mat2>(name, source);
+		SetUniform<glm::mat2>(location, source);
 	else if(type == TypeInfo::Get<glm::mat3>())
-		SetUniform<glm::mat3>(name, source);
+		SetUniform<glm::mat3>(location, source);
 	else if(type == TypeInfo::Get<glm::mat4>())
-		SetUniform<glm::mat4>(name, source);
+		SetUniform<glm::mat4>(location, source);
 }
 
 OpenGLShader::OpenGLShader(std::string_view sourceCode) :
 	Shader(sourceCode),
-	m_shader(430, sourceCode) {}
+	m_shader(430, sourceCode)
+{
+	for(GL::Uniform uniform : m_shader.GetUniforms())
+	{
+		TypeInfo* type = GetType(uniform.Type);
+		if(!type)
+		{
+			continue;
+		}
+
+		const ActiveUniform activeUniform = { static_cast<int32_t>(uniform.Location), type };
+		m_activeUniforms.emplace(std::string(uniform.Name), activeUniform);
+
+		// Arrays are reported as "name[0]" but may be addressed by their plain name.
+		if(uniform.Name.ends_with("[0]"))
+		{
+			m_activeUniforms.emplace(std::string(uniform.Name.substr(0, uniform.Name.size() - 3)), activeUniform);
+		}
+	}
+}
 
 void OpenGLShader::Use()
 {
 	m_shader.Bind();
+
+	for(const auto& [ name, boundTexture ] : m_textures)
+	{
+		boundTexture.Texture->Bind(boundTexture.Unit);
+	}
+
 	// for(const Field& field : GetMaterialFields())
 	// {
 	// 	const void* source = static_cast<const uint8_t*>(materialData) + field.Offset;
@@ -9,6 +9,9 @@ class OpenGLShader final : public Shader
 public:
 	OpenGLShader(std::string_view sourceCode);
 
+	// Textures set on a shader take the units from here up, above the ones RenderDevice gives material textures.
+	static constexpr uint32_t FirstTextureUnit = 24;
+
 	void Use();
 
 	void GetUniforms(std::vector<Uniform>& uniforms) override;
@@ -16,18 +19,38 @@ public:
 	void SetUniform(TypeInfo* type, std::string_view name, const void* data) override;
 
 	void SetUniform(std::string_view name, const TextureHandle& texture) override;
+
+	int32_t GetUniformLocation(TypeInfo* type, std::string_view name) override;
+
+	void SetUniform(TypeInfo* type, int32_t location, const void* data) override;
 private:
+	struct ActiveUniform
+	{
+		int32_t   Location;
+		TypeInfo* Type;
+	};
+
+	struct BoundTexture
+	{
+		uint32_t           Unit;
+		TextureAtlasHandle Texture;
+	};
+
 	GL::Shader m_shader;
 
+	std::unordered_map<std::string, ActiveUniform, GL::StringHash, std::equal_to<>> m_activeUniforms;
+
+	std::unordered_map<std::string, BoundTexture, GL::StringHash, std::equal_to<>> m_textures;
+
 	std::unordered_map<std::string_view, std::string> m_materialNameMap;
 
 	template<class T>
-	void SetUniform(std::string_view name, const void* address);
+	void SetUniform(int32_t location, const void* address);
 };
 
 template<typename T>
-void OpenGLShader::SetUniform(std::string_view name, const void* address)
+void OpenGLShader::SetUniform(int32_t location, const void* address)
 {
 	const T& value = *static_cast<const T*>(address);
-	m_shader.SetUniform(name, value);
+	m_shader.SetUniform(location, value);
 }
@@ -0,0 +1,16 @@
+#include "CommandList.hpp"
+
+void CommandList::Execute(RenderDevice& renderDevice) const
+{
+    size_t offset = 0;
+    while(offset < m_size)
+    {
+        const std::byte* start = m_data.data() + offset;
+
+        Header header;
+        std::memcpy(&header, start, sizeof(Header));
+
+        header.Execute(renderDevice, start + AlignUp(sizeof(Header)), start + header.DataOffset);
+        offset += header.Size;
+    }
+}
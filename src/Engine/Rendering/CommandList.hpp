@@ -0,0 +1,321 @@
+#pragma once
+
+#include <vector>
+#include <cstring>
+#include <cstdint>
+#include <string_view>
+#include <type_traits>
+
+#include "RenderDevice.hpp"
+
+// Device work recorded on any thread and replayed later on the render thread. Commands and their data are packed
+// into one byte arena that keeps its capacity across Reset, so recording stops allocating once a list has seen its
+// largest frame. Execute replays commands in recording order; replaying several lists in a fixed order gives the
+// same frame no matter which thread recorded which list. Every referenced object must outlive the replay.
+class CommandList
+{
+public:
+    CommandList() : m_size(0), m_commandCount(0) {}
+
+    void Reset()
+    {
+        m_size = 0;
+        m_commandCount = 0;
+        m_textures.clear();
+    }
+
+    [[nodiscard]] bool   IsEmpty()      const { return m_commandCount == 0; }
+    [[nodiscard]] size_t CommandCount() const { return m_commandCount; }
+    [[nodiscard]] size_t SizeInBytes()  const { return m_size; }
+
+    void Enable(uint32_t flags)  { Record(StateCommand{ StateCommand::Enable , flags }); }
+    void Disable(uint32_t flags) { Record(StateCommand{ StateCommand::Disable, flags }); }
+
+    void SetBlendFunction(BlendFactor sourceFactor, BlendFactor destFactor) { Record(BlendCommand{ sourceFactor, destFactor }); }
+
+    void SetDepthFunction(DepthFunction depthFunction) { Record(DepthCommand{ depthFunction }); }
+
+    void SetFaceCullingMode(FaceCullingMode faceCullingMode) { Record(CullCommand{ faceCullingMode }); }
+
+    void Clear(RenderTarget& target, int bufferType) { Record(ClearCommand{ &target, bufferType }); }
+
+    void UseRenderTarget(RenderTarget& target) { Record(UseRenderTargetCommand{ &target }); }
+
+    void CopyTo(RenderTarget& source, RenderTarget& dest, MagFilterMode filterMode, uint32_t bufferType)
+    {
+        Record(CopyCommand{ &source, &dest, filterMode, bufferType });
+    }
+
+    void UseShader(Shader& shader) { Record(UseShaderCommand{ &shader }); }
+
+    template<ShallowCopyable TValue>
+    void SetUniform(Shader& shader, const UniformHandle<TValue>& uniform, const TValue& value)
+    {
+        if(uniform.IsValid())
+        {
+            Record(UniformCommand{ &shader, TypeInfo::Get<TValue>(), uniform.Location }, &value, sizeof(TValue));
+        }
+    }
+
+    // The name is copied into the list; it is looked up through the shader's hashed fallback on replay.
+    template<ShallowCopyable TValue>
+    void SetUniform(Shader& shader, std::string_view name, const TValue& value)
+    {
+        std::byte* data = Record(NamedUniformCommand{ &shader, TypeInfo::Get<TValue>(), name.size() }, nullptr, sizeof(TValue) + name.size());
+        std::memcpy(data, &value, sizeof(TValue));
+        std::memcpy(data + sizeof(TValue), name.data(), name.size());
+    }
+
+    // The list keeps the texture alive until Reset. Textures are bound when the shader is used, so they have to be set
+    // before the UseShader they are meant for.
+    void SetUniform(Shader& shader, std::string_view name, const TextureHandle& texture)
+    {
+        std::byte* data = Record(TextureUniformCommand{ &shader, this, m_textures.size(), name.size() }, nullptr, name.size());
+        std::memcpy(data, name.data(), name.size());
+        m_textures.push_back(texture);
+    }
+
+    void SetUniform(Shader& shader, std::string_view name, const TextureAtlasHandle& texture) { SetUniform(shader, name, TextureHandle(texture)); }
+
+    template<ShallowCopyable TStruct>
+    void SetUniforms(Shader& shader, const UniformBlock& block, const TStruct& data)
+    {
+        Record(UniformBlockCommand{ &shader, &block }, &data, sizeof(TStruct));
+    }
+
+    template<ShallowCopyable TBlock>
+    void UpdateConstants(ConstantBlock<TBlock>& block, const TBlock& data)
+    {
+        Record(ConstantsCommand{ &block, &ApplyConstants<TBlock> }, &data, sizeof(TBlock));
+    }
+
+    // Returns room for count instances, valid until the next call on this list. On replay they are written to the
+    // buffer's current region and drawn in as many instanced draws as the region needs.
+    template<ShallowCopyable TInstance>
+    TInstance* Draw(Mesh& mesh, LocalRenderBuffer<TInstance>& buffer, size_t count)
+    {
+        std::byte* data = Record(DrawCommand{ &mesh, &buffer, count, &DrawInstances<TInstance> }, nullptr, count * sizeof(TInstance));
+        return reinterpret_cast<TInstance*>(data);
+    }
+
+    template<ShallowCopyable TInstance>
+    void Draw(Mesh& mesh, LocalRenderBuffer<TInstance>& buffer, const TInstance& instance)
+    {
+        *Draw(mesh, buffer, 1) = instance;
+    }
+
+    void Execute(RenderDevice& renderDevice) const;
+private:
+    // Offsets of commands and their data are kept at this alignment so instance data can be written in place.
+    static constexpr size_t Alignment = 16;
+
+    using ExecuteFunction = void(*)(RenderDevice& renderDevice, const std::byte* command, const std::byte* data);
+
+    struct Header
+    {
+        ExecuteFunction Execute;
+        uint32_t        Size;
+        uint32_t        DataOffset;
+    };
+
+    struct StateCommand
+    {
+        enum Operation : uint32_t { Enable, Disable };
+
+        Operation Type;
+        uint32_t  Flags;
+
+        void Execute(RenderDevice& renderDevice, const std::byte*) const
+        {
+            Type == Enable ? renderDevice.Enable(Flags) : renderDevice.Disable(Flags);
+        }
+    };
+
+    struct BlendCommand
+    {
+        BlendFactor Source;
+        BlendFactor Dest;
+
+        void Execute(RenderDevice& renderDevice, const std::byte*) const { renderDevice.SetBlendFunction(Source, Dest); }
+    };
+
+    struct DepthCommand
+    {
+        DepthFunction Function;
+
+        void Execute(RenderDevice& renderDevice, const std::byte*) const { renderDevice.SetDepthFunction(Function); }
+    };
+
+    struct CullCommand
+    {
+        FaceCullingMode Mode;
+
+        void Execute(RenderDevice& renderDevice, const std::byte*) const { renderDevice.SetFaceCullingMode(Mode); }
+    };
+
+    struct ClearCommand
+    {
+        RenderTarget* Target;
+        int           BufferType;
+
+        void Execute(RenderDevice&, const std::byte*) const { Target->Clear(BufferType); }
+    };
+
+    struct UseRenderTargetCommand
+    {
+        RenderTarget* Target;
+
+        void Execute(RenderDevice&, const std::byte*) const { Target->Use(); }
+    };
+
+    struct CopyCommand
+    {
+        RenderTarget* Source;
+        RenderTarget* Dest;
+        MagFilterMode FilterMode;
+        uint32_t      BufferType;
+
+        void Execute(RenderDevice&, const std::byte*) const { Source->CopyTo(*Dest, FilterMode, BufferType); }
+    };
+
+    struct UseShaderCommand
+    {
+        ::Shader* Shader;
+
+        void Execute(RenderDevice&, const std::byte*) const { Shader->Use(); }
+    };
+
+    struct UniformCommand
+    {
+        ::Shader* Shader;
+        TypeInfo* Type;
+        int32_t   Location;
+
+        void Execute(RenderDevice&, const std::byte* data) const { Shader->SetUniform(Type, Location, data); }
+    };
+
+    struct NamedUniformCommand
+    {
+        ::Shader* Shader;
+        TypeInfo* Type;
+        size_t    NameLength;
+
+        void Execute(RenderDevice&, const std::byte* data) const
+        {
+            const std::string_view name(reinterpret_cast<const char*>(data + Type->Size), NameLength);
+            Shader->SetUniform(Type, name, data);
+        }
+    };
+
+    struct TextureUniformCommand
+    {
+        ::Shader*          Shader;
+        const CommandList* List;
+        size_t             TextureIndex;
+        size_t             NameLength;
+
+        void Execute(RenderDevice&, const std::byte* data) const
+        {
+            Shader->SetUniform(std::string_view(reinterpret_cast<const char*>(data), NameLength), List->m_textures[TextureIndex]);
+        }
+    };
+
+    struct UniformBlockCommand
+    {
+        ::Shader*           Shader;
+        const UniformBlock* Block;
+
+        void Execute(RenderDevice&, const std::byte* data) const { Shader->SetUniforms(*Block, static_cast<const void*>(data)); }
+    };
+
+    struct ConstantsCommand
+    {
+        void* Block;
+        void(*Apply)(void* block, const std::byte* data);
+
+        void Execute(RenderDevice&, const std::byte* data) const { Apply(Block, data); }
+    };
+
+    struct DrawCommand
+    {
+        ::Mesh* Mesh;
+        void*   Buffer;
+        size_t  Count;
+        void(*Apply)(::Mesh& mesh, void* buffer, const std::byte* instances, size_t count);
+
+        void Execute(RenderDevice&, const std::byte* data) const { Apply(*Mesh, Buffer, data, Count); }
+    };
+
+    std::vector<std::byte> m_data;
+
+    // Textures set by the recorded commands, which only store their index.
+    std::vector<TextureHandle> m_textures;
+
+    size_t m_size;
+    size_t m_commandCount;
+
+    static constexpr size_t AlignUp(size_t size) { return (size + Alignment - 1) / Alignment * Alignment; }
+
+    // Appends the command and dataSize bytes of data, copied from data when it is given. Returns the data's storage.
+    template<typename TCommand>
+    std::byte* Record(const TCommand& command, const void* data = nullptr, size_t dataSize = 0)
+    {
+        static_assert(std::is_trivially_copyable_v<TCommand> && alignof(TCommand) <= Alignment);
+
+        const size_t commandOffset = AlignUp(sizeof(Header));
+        const size_t    dataOffset = commandOffset + AlignUp(sizeof(TCommand));
+        const size_t          size = dataOffset + AlignUp(dataSize);
+
+        if(m_size + size > m_data.size())
+        {
+            m_data.resize(std::max(m_data.size() * 2, m_size + size));
+        }
+
+        std::byte* start = m_data.data() + m_size;
+
+        const Header header = { &ExecuteCommand<TCommand>, uint32_t(size), uint32_t(dataOffset) };
+        std::memcpy(start, &header, sizeof(Header));
+        std::memcpy(start + commandOffset, &command, sizeof(TCommand));
+        if(data)
+        {
+            std::memcpy(start + dataOffset, data, dataSize);
+        }
+
+        m_size += size;
+        ++m_commandCount;
+        return start + dataOffset;
+    }
+
+    template<typename TCommand>
+    static void ExecuteCommand(RenderDevice& renderDevice, const std::byte* command, const std::byte* data)
+    {
+        TCommand copy;
+        std::memcpy(&copy, command, sizeof(TCommand));
+        copy.Execute(renderDevice, data);
+    }
+
+    template<ShallowCopyable TBlock>
+    static void ApplyConstants(void* block, const std::byte* data)
+    {
+        std::memcpy(&static_cast<ConstantBlock<TBlock>*>(block)->Data, data, sizeof(TBlock));
+        static_cast<ConstantBlock<TBlock>*>(block)->Update();
+    }
+
+    template<ShallowCopyable TInstance>
+    static void DrawInstances(::Mesh& mesh, void* buffer, const std::byte* instances, size_t count)
+    {
+        auto& renderBuffer = *static_cast<LocalRenderBuffer<TInstance>*>(buffer);
+
+        while(count > 0)
+        {
+            const size_t batchCount = std::min(count, renderBuffer.Elements.Count());
+            std::memcpy(renderBuffer.Elements.Data(), instances, batchCount * sizeof(TInstance));
+
+            renderBuffer.Update(batchCount);
+            mesh.Draw(batchCount);
+
+            instances += batchCount * sizeof(TInstance);
+            count     -= batchCount;
+        }
+    }
+};
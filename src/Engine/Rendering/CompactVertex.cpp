@@ -0,0 +1,102 @@
+#include "CompactVertex.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include <glm/gtc/packing.hpp>
+#include <glm/gtc/matrix_transform.hpp>
+
+#include "Engine/Core/Scene.hpp"
+
+static constexpr float MaxQuantizedPosition = 65535.0f;
+
+static float GetAngleDegrees(const glm::vec3& left, const glm::vec3& right)
+{
+	return glm::degrees(std::acos(std::clamp(glm::dot(left, right), -1.0f, 1.0f)));
+}
+
+static glm::vec3 SafeNormalize(const glm::vec3& vector)
+{
+	const float length = glm::length(vector);
+	return length > 0.0f ? vector / length : glm::vec3(0.0f);
+}
+
+Model EncodeCompactModel(const std::vector<DefaultVertex>& vertices, const std::vector<uint32_t>& indices, CompactEncodingError* error)
+{
+	glm::vec3 minimum(0.0f);
+	glm::vec3 maximum(0.0f);
+	if(!vertices.empty())
+	{
+		minimum = maximum = vertices[0].Position;
+		for(const DefaultVertex& vertex : vertices)
+		{
+			minimum = glm::min(minimum, vertex.Position);
+			maximum = glm::max(maximum, vertex.Position);
+		}
+	}
+
+	// One scale for all axes, so the VertexTransform only scales uniformly and normals stay perpendicular.
+	const glm::vec3 extent = maximum - minimum;
+	const float size = std::max(std::max(extent.x, extent.y), std::max(extent.z, 1e-6f));
+
+	// The position attribute is normalized, so the shaders read each component as quantized / 65535 in [0, 1].
+	const glm::mat4 vertexTransform = glm::scale(glm::translate(glm::mat4(1.0f), minimum), glm::vec3(size));
+
+	CompactEncodingError maxError;
+
+	std::vector<CompactVertex> result;
+	result.reserve(vertices.size());
+
+	for(const DefaultVertex& vertex : vertices)
+	{
+		CompactVertex& compact = result.emplace_back();
+
+		const glm::vec3 quantized = glm::round((vertex.Position - minimum) / size * MaxQuantizedPosition);
+		compact.Position = glm::u16vec4(glm::clamp(quantized, 0.0f, MaxQuantizedPosition), 0);
+
+		compact.TexCoord[0].Bits = glm::packHalf1x16(vertex.TexCoord.x);
+		compact.TexCoord[1].Bits = glm::packHalf1x16(vertex.TexCoord.y);
+
+		const glm::vec3 normal  = SafeNormalize(vertex.Normal);
+		const glm::vec3 tangent = SafeNormalize(vertex.Tangent);
+
+		compact.Normal.Bits  = glm::packSnorm3x10_1x2(glm::vec4(normal , 0.0f));
+		compact.Tangent.Bits = glm::packSnorm3x10_1x2(glm::vec4(tangent, 0.0f));
+
+		if(error)
+		{
+			const glm::vec3 decodedPosition = glm::vec3(vertexTransform * glm::vec4(glm::vec3(compact.Position) / MaxQuantizedPosition, 1.0f));
+			const glm::vec2 decodedTexCoord(glm::unpackHalf1x16(compact.TexCoord[0].Bits), glm::unpackHalf1x16(compact.TexCoord[1].Bits));
+
+			// The shaders normalize what they read, so the error is the angle to the normalized decoded vector.
+			const glm::vec3 decodedNormal  = SafeNormalize(glm::vec3(glm::unpackSnorm3x10_1x2(compact.Normal.Bits)));
+			const glm::vec3 decodedTangent = SafeNormalize(glm::vec3(glm::unpackSnorm3x10_1x2(compact.Tangent.Bits)));
+
+			const glm::vec3 positionError = glm::abs(decodedPosition - vertex.Position);
+			const glm::vec2 texCoordError = glm::abs(decodedTexCoord - vertex.TexCoord);
+
+			maxError.Position = std::max(maxError.Position, std::max(positionError.x, std::max(positionError.y, positionError.z)));
+			maxError.TexCoord = std::max(maxError.TexCoord, std::max(texCoordError.x, texCoordError.y));
+
+			if(normal != glm::vec3(0.0f))
+			{
+				maxError.NormalDegrees = std::max(maxError.NormalDegrees, GetAngleDegrees(normal, decodedNormal));
+			}
+
+			if(tangent != glm::vec3(0.0f))
+			{
+				maxError.TangentDegrees = std::max(maxError.TangentDegrees, GetAngleDegrees(tangent, decodedTangent));
+			}
+		}
+	}
+
+	if(error)
+	{
+		*error = maxError;
+	}
+
+	Model model(result, indices);
+	model.Bounds = AABB(minimum, maximum);
+	model.VertexTransform = vertexTransform;
+	return model;
+}
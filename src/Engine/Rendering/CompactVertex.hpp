@@ -0,0 +1,43 @@
+#pragma once
+
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "Mesh.hpp"
+
+struct DefaultVertex;
+
+// DefaultVertex in 20 bytes instead of 44. Positions are 16-bit fractions of the mesh's bounding cube that the model's
+// VertexTransform maps back to object space, texture coordinates are half floats, and normals and tangents are signed
+// normalized 10-bit vectors. The attributes read back as the same vec3, vec2, vec3 and vec3 a DefaultVertex gives the
+// vertex shaders, so meshes of either format draw with the same shaders.
+struct CompactVertex
+{
+	glm::u16vec4       Position; // w is unused and keeps the following attributes 4-byte aligned
+	HalfFloat          TexCoord[2];
+	PackedSnorm1010102 Normal;
+	PackedSnorm1010102 Tangent;
+
+	static BufferLayout GetLayout()
+	{
+		BufferLayout result;
+		result.AddAttribute<decltype(Position)>(true);
+		result.AddAttribute(TypeInfo::Get<HalfFloat>(), 2);
+		result.AddAttribute<decltype(Normal)>(true);
+		result.AddAttribute<decltype(Tangent)>(true);
+		return result;
+	}
+};
+
+// Largest difference between a vertex and its decoded compact version.
+struct CompactEncodingError
+{
+	float Position       = 0.0f; // object-space units, about the bounding cube's size / 131070
+	float TexCoord       = 0.0f; // grows with the coordinate's magnitude, 1/2048 of it at most
+	float NormalDegrees  = 0.0f;
+	float TangentDegrees = 0.0f;
+};
+
+// Quantizes a mesh into CompactVertex. The model's Bounds and VertexTransform describe the original positions.
+Model EncodeCompactModel(const std::vector<DefaultVertex>& vertices, const std::vector<uint32_t>& indices, CompactEncodingError* error = nullptr);
@@ -0,0 +1,57 @@
+#pragma once
+
+#include <memory>
+#include <utility>
+
+#include <Common.hpp>
+
+// Uniform block binding points shared by every shader, e.g. "layout(std140, binding = 0) uniform FrameConstants".
+enum ConstantSlot : uint32_t
+{
+    FrameConstantSlot = 0,
+    PassConstantSlot  = 1,
+    LightConstantSlot = 2,
+};
+
+class DeviceConstantBuffer
+{
+public:
+    virtual ~DeviceConstantBuffer() = default;
+
+    [[nodiscard]] virtual std::size_t SizeInBytes() const = 0;
+
+    // Writes data into the next section of the ring and binds that section to slot.
+    virtual void Update(uint32_t slot, const void* data, size_t sizeInBytes) = 0;
+};
+
+using DeviceConstantBufferHandle = std::shared_ptr<DeviceConstantBuffer>;
+
+// A struct uploaded once per frame or pass and read by all shaders through a uniform block at a fixed slot.
+// TBlock has to follow std140 layout rules: pad vec3 members to 16 bytes and prefer vec4 and mat4 members.
+template<ShallowCopyable TBlock>
+class ConstantBlock
+{
+public:
+    ConstantBlock(DeviceConstantBufferHandle deviceBuffer, uint32_t slot, const TBlock& defaultValue) :
+        Data(defaultValue), Slot(slot), m_deviceBuffer(std::move(deviceBuffer)) {}
+
+    TBlock Data;
+
+    const uint32_t Slot;
+
+    void Update()
+    {
+        m_deviceBuffer->Update(Slot, &Data, sizeof(TBlock));
+    }
+
+    void Update(const TBlock& data)
+    {
+        Data = data;
+        Update();
+    }
+private:
+    const DeviceConstantBufferHandle m_deviceBuffer;
+};
+
+template<ShallowCopyable TBlock>
+using ConstantBlockHandle = std::shared_ptr<ConstantBlock<TBlock>>;
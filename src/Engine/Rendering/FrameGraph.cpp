@@ -0,0 +1,457 @@
+#include "FrameGraph.hpp"
+
+#include <array>
+#include <sstream>
+
+#include <Common.hpp>
+
+#include "RenderDevice.hpp"
+
+static constexpr uint32_t BufferTypeCount = 3;
+
+static constexpr size_t NoStep = SIZE_MAX;
+
+static std::string GetBufferTypeNames(uint32_t bufferType)
+{
+	static const char* const names[BufferTypeCount] = { "color", "depth", "stencil" };
+
+	std::string result;
+	for(uint32_t i = 0; i < BufferTypeCount; i++)
+	{
+		if(bufferType & (1u << i))
+		{
+			result += result.empty() ? names[i] : std::string(" ") + names[i];
+		}
+	}
+	return result;
+}
+
+static uint32_t GetMask(const auto& accesses, uint32_t target)
+{
+	uint32_t result = 0;
+	for(const auto& access : accesses)
+	{
+		if(access.Target == target)
+		{
+			result |= access.BufferType;
+		}
+	}
+	return result;
+}
+
+void FrameGraphBuilder::Read(FrameGraphTarget target, uint32_t bufferType)
+{
+	DEBUG_ASSERT(target.IsValid(), "Invalid frame graph target.");
+	m_reads.push_back({ target.Index, bufferType });
+}
+
+void FrameGraphBuilder::Write(FrameGraphTarget target, uint32_t bufferType)
+{
+	DEBUG_ASSERT(target.IsValid(), "Invalid frame graph target.");
+	m_writes.push_back({ target.Index, bufferType });
+}
+
+void FrameGraphBuilder::Clear(FrameGraphTarget target, uint32_t bufferType)
+{
+	DEBUG_ASSERT(target.IsValid(), "Invalid frame graph target.");
+	m_clears.push_back({ target.Index, bufferType });
+}
+
+void FrameGraphBuilder::Require(FrameGraphTarget target, FrameGraphTarget source, uint32_t bufferType, MagFilterMode filterMode)
+{
+	DEBUG_ASSERT(target.IsValid() && source.IsValid(), "Invalid frame graph target.");
+	m_requirements.push_back({ target.Index, source.Index, bufferType, filterMode });
+}
+
+FrameGraphTarget FrameGraph::ImportTarget(std::string name, RenderTarget& target, uint32_t outputBufferType)
+{
+	m_targets.push_back({ std::move(name), &target, std::nullopt, outputBufferType, SIZE_MAX });
+	m_isCompiled = false;
+	return FrameGraphTarget(uint32_t(m_targets.size() - 1));
+}
+
+FrameGraphTarget FrameGraph::CreateTarget(std::string name, const RenderTargetDescription& description)
+{
+	m_targets.push_back({ std::move(name), nullptr, description, 0, SIZE_MAX });
+	m_isCompiled = false;
+	return FrameGraphTarget(uint32_t(m_targets.size() - 1));
+}
+
+void FrameGraph::AddPass(std::string name, const std::function<void(FrameGraphBuilder& builder)>& setup, ExecuteFunction execute)
+{
+	PassNode& pass = m_passes.emplace_back(PassNode{ std::move(name), FrameGraphBuilder(), std::move(execute), false });
+	setup(pass.Builder);
+	m_isCompiled = false;
+}
+
+void FrameGraph::Reset()
+{
+	m_targets.clear();
+	m_passes.clear();
+	m_steps.clear();
+	m_statistics = FrameGraphStatistics();
+	m_transientTargets.Reset();
+	m_isCompiled = false;
+}
+
+void FrameGraph::Compile()
+{
+	m_steps.clear();
+	m_statistics = FrameGraphStatistics();
+	m_statistics.PassCount = m_passes.size();
+
+	CullPasses();
+	BuildSteps();
+	PlanTransientTargets();
+
+	m_isCompiled = true;
+}
+
+void FrameGraph::CullPasses()
+{
+	// Walking backwards from the outputs, live holds the buffers whose current content something still reads.
+	std::vector<uint32_t> live(m_targets.size());
+	for(size_t i = 0; i < m_targets.size(); i++)
+	{
+		live[i] = m_targets[i].OutputBufferType;
+	}
+
+	for(auto it = m_passes.rbegin(); it != m_passes.rend(); ++it)
+	{
+		PassNode&                pass    = *it;
+		const FrameGraphBuilder& builder = pass.Builder;
+
+		m_statistics.RequestedClearCount += builder.m_clears.size();
+		m_statistics.RequestedCopyCount  += builder.m_requirements.size();
+
+		pass.IsCulled = !builder.m_hasSideEffects;
+		for(const auto* accesses : { &builder.m_writes, &builder.m_clears })
+		{
+			for(const auto& access : *accesses)
+			{
+				if(live[access.Target] & access.BufferType)
+				{
+					pass.IsCulled = false;
+				}
+			}
+		}
+
+		if(pass.IsCulled)
+		{
+			m_statistics.CulledPassCount++;
+			continue;
+		}
+
+		// Buffers the pass clears or has copied in do not depend on earlier passes...
+		for(const auto& clear : builder.m_clears)
+		{
+			live[clear.Target] &= ~clear.BufferType;
+		}
+
+		for(const auto& requirement : builder.m_requirements)
+		{
+			live[requirement.Target] &= ~requirement.BufferType;
+		}
+
+		// ...but the ones it reads, copies from or draws over do.
+		for(const auto& read : builder.m_reads)
+		{
+			live[read.Target] |= read.BufferType;
+		}
+
+		for(const auto& requirement : builder.m_requirements)
+		{
+			live[requirement.Source] |= requirement.BufferType;
+		}
+
+		for(const auto& write : builder.m_writes)
+		{
+			live[write.Target] |= write.BufferType & ~(GetMask(builder.m_clears, write.Target) | GetMask(builder.m_requirements, write.Target));
+		}
+	}
+}
+
+void FrameGraph::BuildSteps()
+{
+	// Each buffer's content is identified by a version, so a copy is only needed between buffers whose versions
+	// differ. Copies take the source's version, everything else that changes a buffer makes a new one.
+	struct BufferState
+	{
+		uint64_t Version;
+		bool     IsCleared;
+		size_t   LastUseStep;
+	};
+
+	uint64_t version = 0;
+
+	std::vector<std::array<BufferState, BufferTypeCount>> states(m_targets.size());
+	for(auto& targetStates : states)
+	{
+		for(BufferState& state : targetStates)
+		{
+			state = { ++version, false, NoStep };
+		}
+	}
+
+	auto use = [&states](uint32_t target, uint32_t bufferType, size_t step)
+	{
+		for(uint32_t i = 0; i < BufferTypeCount; i++)
+		{
+			if(bufferType & (1u << i))
+			{
+				states[target][i].LastUseStep = step;
+			}
+		}
+	};
+
+	// The last clear step of each target, which later clears of buffers unused since then are merged into.
+	std::vector<size_t> lastClears(m_targets.size(), NoStep);
+
+	for(uint32_t passIndex = 0; passIndex < m_passes.size(); passIndex++)
+	{
+		const PassNode& pass = m_passes[passIndex];
+		if(pass.IsCulled)
+		{
+			continue;
+		}
+
+		const FrameGraphBuilder& builder = pass.Builder;
+
+		for(const auto& clear : builder.m_clears)
+		{
+			uint32_t bufferType = 0;
+			bool     canMerge   = lastClears[clear.Target] != NoStep;
+			for(uint32_t i = 0; i < BufferTypeCount; i++)
+			{
+				const BufferState& state = states[clear.Target][i];
+				if((clear.BufferType & (1u << i)) && !state.IsCleared)
+				{
+					bufferType |= 1u << i;
+					canMerge   &= state.LastUseStep == NoStep || state.LastUseStep < lastClears[clear.Target];
+				}
+			}
+
+			if(!bufferType)
+			{
+				continue;
+			}
+
+			size_t step = lastClears[clear.Target];
+			if(canMerge)
+			{
+				m_steps[step].BufferType |= bufferType;
+			}
+			else
+			{
+				step = m_steps.size();
+				m_steps.push_back({ FrameGraphStepType::Clear, clear.Target, clear.Target, bufferType, MagFilterMode::Nearest });
+				lastClears[clear.Target] = step;
+			}
+
+			for(uint32_t i = 0; i < BufferTypeCount; i++)
+			{
+				if(bufferType & (1u << i))
+				{
+					states[clear.Target][i] = { ++version, true, step };
+				}
+			}
+		}
+
+		for(const auto& requirement : builder.m_requirements)
+		{
+			uint32_t bufferType = 0;
+			for(uint32_t i = 0; i < BufferTypeCount; i++)
+			{
+				if((requirement.BufferType & (1u << i)) && states[requirement.Target][i].Version != states[requirement.Source][i].Version)
+				{
+					bufferType |= 1u << i;
+				}
+			}
+
+			if(!bufferType)
+			{
+				continue;
+			}
+
+			const size_t step = m_steps.size();
+			m_steps.push_back({ FrameGraphStepType::Copy, requirement.Target, requirement.Source, bufferType, requirement.FilterMode });
+
+			// Cleared colors differ between targets, so copied buffers never count as cleared.
+			for(uint32_t i = 0; i < BufferTypeCount; i++)
+			{
+				if(bufferType & (1u << i))
+				{
+					states[requirement.Target][i] = { states[requirement.Source][i].Version, false, step };
+					states[requirement.Source][i].LastUseStep = step;
+				}
+			}
+		}
+
+		if(!pass.Execute)
+		{
+			continue;
+		}
+
+		const size_t step = m_steps.size();
+		m_steps.push_back({ FrameGraphStepType::Pass, passIndex, passIndex, 0, MagFilterMode::Nearest });
+
+		for(const auto& read : builder.m_reads)
+		{
+			use(read.Target, read.BufferType, step);
+		}
+
+		for(const auto& clear : builder.m_clears)
+		{
+			use(clear.Target, clear.BufferType, step);
+		}
+
+		for(const auto& requirement : builder.m_requirements)
+		{
+			use(requirement.Target, requirement.BufferType, step);
+		}
+
+		for(const auto& write : builder.m_writes)
+		{
+			for(uint32_t i = 0; i < BufferTypeCount; i++)
+			{
+				if(write.BufferType & (1u << i))
+				{
+					states[write.Target][i] = { ++version, false, step };
+				}
+			}
+		}
+	}
+
+	for(const FrameGraphStep& step : m_steps)
+	{
+		m_statistics.ClearCount += step.Type == FrameGraphStepType::Clear;
+		m_statistics.CopyCount  += step.Type == FrameGraphStepType::Copy;
+	}
+}
+
+void FrameGraph::PlanTransientTargets()
+{
+	m_transientTargets.Reset();
+
+	std::vector<std::pair<size_t, size_t>> lifetimes(m_targets.size(), { NoStep, 0 });
+	auto extend = [&lifetimes](uint32_t target, size_t step)
+	{
+		lifetimes[target].first  = std::min(lifetimes[target].first, step);
+		lifetimes[target].second = std::max(lifetimes[target].second, step);
+	};
+
+	for(size_t i = 0; i < m_steps.size(); i++)
+	{
+		const FrameGraphStep& step = m_steps[i];
+		if(step.Type != FrameGraphStepType::Pass)
+		{
+			extend(step.Index, i);
+			extend(step.Source, i);
+			continue;
+		}
+
+		const FrameGraphBuilder& builder = m_passes[step.Index].Builder;
+		for(const auto* accesses : { &builder.m_reads, &builder.m_writes, &builder.m_clears })
+		{
+			for(const auto& access : *accesses)
+			{
+				extend(access.Target, i);
+			}
+		}
+
+		for(const auto& requirement : builder.m_requirements)
+		{
+			extend(requirement.Target, i);
+			extend(requirement.Source, i);
+		}
+	}
+
+	for(size_t i = 0; i < m_targets.size(); i++)
+	{
+		TargetNode& target = m_targets[i];
+		target.TransientIndex = SIZE_MAX;
+
+		if(target.Description && lifetimes[i].first != NoStep)
+		{
+			target.TransientIndex = m_transientTargets.Declare(*target.Description, uint32_t(lifetimes[i].first), uint32_t(lifetimes[i].second));
+			m_statistics.TransientTargetCount++;
+		}
+	}
+
+	m_statistics.PhysicalTargetCount = m_transientTargets.GetPhysicalCount();
+}
+
+void FrameGraph::Execute(RenderDevice& renderDevice)
+{
+	if(!m_isCompiled)
+	{
+		Compile();
+	}
+
+	m_transientTargets.Acquire(renderDevice.TargetPool);
+
+	for(const FrameGraphStep& step : m_steps)
+	{
+		switch(step.Type)
+		{
+			case FrameGraphStepType::Clear:
+				GetTarget(FrameGraphTarget(step.Index)).Clear(int(step.BufferType));
+				break;
+			case FrameGraphStepType::Copy:
+				GetTarget(FrameGraphTarget(step.Source)).CopyTo(GetTarget(FrameGraphTarget(step.Index)), step.FilterMode, step.BufferType);
+				break;
+			case FrameGraphStepType::Pass:
+				m_passes[step.Index].Execute(renderDevice, *this);
+				break;
+		}
+	}
+
+	m_transientTargets.Release(renderDevice.TargetPool);
+}
+
+RenderTarget& FrameGraph::GetTarget(FrameGraphTarget target) const
+{
+	const TargetNode& node = m_targets[target.Index];
+	if(node.External)
+	{
+		return *node.External;
+	}
+
+	DEBUG_ASSERT(node.TransientIndex != SIZE_MAX, "The target is not used by any pass that runs.");
+	return *m_transientTargets.Get(node.TransientIndex);
+}
+
+std::string FrameGraph::Dump() const
+{
+	std::ostringstream stream;
+	stream << "passes " << m_statistics.PassCount - m_statistics.CulledPassCount << '/' << m_statistics.PassCount
+	       << ", clears " << m_statistics.ClearCount << '/' << m_statistics.RequestedClearCount
+	       << ", copies " << m_statistics.CopyCount << '/' << m_statistics.RequestedCopyCount
+	       << ", transient targets " << m_statistics.TransientTargetCount << " on " << m_statistics.PhysicalTargetCount << '\n';
+
+	for(const FrameGraphStep& step : m_steps)
+	{
+		switch(step.Type)
+		{
+			case FrameGraphStepType::Clear:
+				stream << "clear  " << m_targets[step.Index].Name << " [" << GetBufferTypeNames(step.BufferType) << "]\n";
+				break;
+			case FrameGraphStepType::Copy:
+				stream << "copy   " << m_targets[step.Source].Name << " -> " << m_targets[step.Index].Name << " [" << GetBufferTypeNames(step.BufferType) << "]\n";
+				break;
+			case FrameGraphStepType::Pass:
+				stream << "pass   " << m_passes[step.Index].Name << '\n';
+				break;
+		}
+	}
+
+	for(const PassNode& pass : m_passes)
+	{
+		if(pass.IsCulled)
+		{
+			stream << "culled " << pass.Name << '\n';
+		}
+	}
+
+	return stream.str();
+}
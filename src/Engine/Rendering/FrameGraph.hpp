@@ -0,0 +1,193 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <optional>
+#include <functional>
+
+#include "RenderTarget.hpp"
+#include "RenderTargetPool.hpp"
+
+class RenderDevice;
+class FrameGraph;
+
+struct FrameGraphTarget
+{
+	static constexpr uint32_t InvalidIndex = UINT32_MAX;
+
+	FrameGraphTarget() : Index(InvalidIndex) {}
+
+	explicit FrameGraphTarget(uint32_t index) : Index(index) {}
+
+	uint32_t Index;
+
+	[[nodiscard]] bool IsValid() const { return Index != InvalidIndex; }
+
+	bool operator==(const FrameGraphTarget& other) const = default;
+};
+
+// What a pass does to the targets of the graph, declared when the pass is added. Buffer types are ScreenBufferType
+// flags.
+class FrameGraphBuilder
+{
+public:
+	// Samples the buffers as textures.
+	void Read(FrameGraphTarget target, uint32_t bufferType);
+
+	// Draws into the buffers, depth testing or blending against what is already there.
+	void Write(FrameGraphTarget target, uint32_t bufferType);
+
+	// The buffers have to be cleared when the pass starts. A clear alone does not draw anything; passes that clear
+	// and then draw declare both.
+	void Clear(FrameGraphTarget target, uint32_t bufferType);
+
+	// The buffers of target have to hold the ones of source when the pass starts, e.g. to depth test against the
+	// G-buffer's depth. The graph only copies them if target does not hold them already.
+	void Require(FrameGraphTarget target, FrameGraphTarget source, uint32_t bufferType, MagFilterMode filterMode = MagFilterMode::Nearest);
+
+	// Keeps the pass even if nothing reads what it draws.
+	void SetSideEffects() { m_hasSideEffects = true; }
+private:
+	struct Access
+	{
+		uint32_t Target;
+		uint32_t BufferType;
+	};
+
+	struct Requirement
+	{
+		uint32_t      Target;
+		uint32_t      Source;
+		uint32_t      BufferType;
+		MagFilterMode FilterMode;
+	};
+
+	FrameGraphBuilder() : m_hasSideEffects(false) {}
+
+	std::vector<Access>      m_reads;
+	std::vector<Access>      m_writes;
+	std::vector<Access>      m_clears;
+	std::vector<Requirement> m_requirements;
+
+	bool m_hasSideEffects;
+
+	friend class FrameGraph;
+};
+
+enum class FrameGraphStepType
+{
+	Clear,
+	Copy,
+	Pass,
+};
+
+struct FrameGraphStep
+{
+	FrameGraphStepType Type;
+
+	// The pass for Pass steps, the target cleared or copied into for the others.
+	uint32_t Index;
+
+	// The target copied from, for Copy steps.
+	uint32_t Source;
+
+	uint32_t      BufferType;
+	MagFilterMode FilterMode;
+};
+
+struct FrameGraphStatistics
+{
+	size_t PassCount       = 0;
+	size_t CulledPassCount = 0;
+
+	// Clears and copies the passes asked for, against the ones left after merging and dropping redundant ones.
+	size_t RequestedClearCount = 0;
+	size_t ClearCount          = 0;
+	size_t RequestedCopyCount  = 0;
+	size_t CopyCount           = 0;
+
+	size_t TransientTargetCount = 0;
+	size_t PhysicalTargetCount  = 0;
+};
+
+// Declarative pass ordering for a frame. Passes are added in the order they would run and declare the buffers they
+// read, draw into, need cleared or need copied from another target. Compile then works out:
+//   - which passes can be culled, because nothing that reaches an output reads what they draw;
+//   - where clears go, dropping clears of buffers nothing touched since they were last cleared and merging clears of
+//     one target into a single call when the buffers are not used in between;
+//   - which copies Require needs, skipping targets that already hold the buffers;
+//   - how long each transient target lives, so targets used by passes that do not overlap share memory.
+// Compiling touches no device, so a graph can be built, compiled and dumped headless.
+class FrameGraph
+{
+public:
+	using ExecuteFunction = std::function<void(RenderDevice& renderDevice, const FrameGraph& graph)>;
+
+	FrameGraph() : m_isCompiled(false) {}
+
+	FrameGraph(const FrameGraph&) = delete;
+	FrameGraph& operator=(const FrameGraph&) = delete;
+
+	// A target that lives outside the graph. The buffers in outputBufferType are what the frame produces; passes
+	// that end up drawing into nothing else are culled.
+	FrameGraphTarget ImportTarget(std::string name, RenderTarget& target, uint32_t outputBufferType = 0);
+
+	// A target acquired from RenderDevice::TargetPool only for the passes using it.
+	FrameGraphTarget CreateTarget(std::string name, const RenderTargetDescription& description);
+
+	void AddPass(std::string name, const std::function<void(FrameGraphBuilder& builder)>& setup, ExecuteFunction execute = {});
+
+	// Removes every pass and target, keeping the capacity for the next frame.
+	void Reset();
+
+	void Compile();
+
+	// Acquires the transient targets, runs the compiled steps and releases the targets.
+	void Execute(RenderDevice& renderDevice);
+
+	// The target behind a handle, valid inside pass execute functions.
+	[[nodiscard]] RenderTarget& GetTarget(FrameGraphTarget target) const;
+
+	[[nodiscard]] const std::vector<FrameGraphStep>& GetSteps() const { return m_steps; }
+
+	[[nodiscard]] bool IsCulled(size_t pass) const { return m_passes[pass].IsCulled; }
+
+	[[nodiscard]] const FrameGraphStatistics& GetStatistics() const { return m_statistics; }
+
+	// One line per compiled step, followed by the culled passes.
+	[[nodiscard]] std::string Dump() const;
+private:
+	struct TargetNode
+	{
+		std::string Name;
+
+		RenderTarget*                          External;
+		std::optional<RenderTargetDescription> Description;
+		uint32_t                               OutputBufferType;
+
+		size_t TransientIndex;
+	};
+
+	struct PassNode
+	{
+		std::string       Name;
+		FrameGraphBuilder Builder;
+		ExecuteFunction   Execute;
+		bool              IsCulled;
+	};
+
+	std::vector<TargetNode> m_targets;
+	std::vector<PassNode>   m_passes;
+
+	std::vector<FrameGraphStep> m_steps;
+	FrameGraphStatistics        m_statistics;
+
+	TransientRenderTargets m_transientTargets;
+
+	bool m_isCompiled;
+
+	void CullPasses();
+	void BuildSteps();
+	void PlanTransientTargets();
+};
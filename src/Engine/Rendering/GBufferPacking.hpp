@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+
+#include <glm/glm.hpp>
+
+// CPU reference of the packing the geometry and light shaders do for GBufferLayout::Compact. The shaders carry the
+// same functions in GLSL, so these define what the compact G-buffer stores and are what its precision is checked with.
+
+// Specular intensity is stored in the albedo attachment's 8-bit alpha channel as a fraction of this.
+static constexpr float MaxPackedSpecularIntensity = 16.0f;
+
+// Folds the unit sphere onto the [-1, 1] square: the upper hemisphere maps to the inner diamond and the lower one is
+// folded over its edges into the corners.
+inline glm::vec2 EncodeOctahedral(const glm::vec3& normal)
+{
+	const glm::vec3 octahedron = normal / (std::abs(normal.x) + std::abs(normal.y) + std::abs(normal.z));
+
+	glm::vec2 result(octahedron.x, octahedron.y);
+	if(octahedron.z < 0.0f)
+	{
+		const glm::vec2 sign(result.x >= 0.0f ? 1.0f : -1.0f, result.y >= 0.0f ? 1.0f : -1.0f);
+		result = (1.0f - glm::abs(glm::vec2(result.y, result.x))) * sign;
+	}
+
+	return result;
+}
+
+inline glm::vec3 DecodeOctahedral(const glm::vec2& encoded)
+{
+	glm::vec3 normal(encoded.x, encoded.y, 1.0f - std::abs(encoded.x) - std::abs(encoded.y));
+
+	const float fold = std::max(-normal.z, 0.0f);
+	normal.x += normal.x >= 0.0f ? -fold : fold;
+	normal.y += normal.y >= 0.0f ? -fold : fold;
+
+	return glm::normalize(normal);
+}
+
+inline glm::vec4 PackAlbedoSpecular(const glm::vec3& albedo, float specularIntensity)
+{
+	return glm::vec4(albedo, std::clamp(specularIntensity / MaxPackedSpecularIntensity, 0.0f, 1.0f));
+}
+
+inline float UnpackSpecularIntensity(const glm::vec4& albedoSpecular)
+{
+	return albedoSpecular.a * MaxPackedSpecularIntensity;
+}
+
+// World position of the pixel at texCoord in [0, 1] from its depth buffer value in [0, 1].
+inline glm::vec3 ReconstructPosition(const glm::vec2& texCoord, float depth, const glm::mat4& inverseViewProjection)
+{
+	const glm::vec4 position = inverseViewProjection * glm::vec4(glm::vec3(texCoord, depth) * 2.0f - 1.0f, 1.0f);
+	return glm::vec3(position) / position.w;
+}
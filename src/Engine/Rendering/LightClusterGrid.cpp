@@ -0,0 +1,323 @@
+#include "LightClusterGrid.hpp"
+
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <algorithm>
+
+#include <Common.hpp>
+
+#include "Engine/Core/JobSystem.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define LIGHT_CLUSTER_GRID_SSE
+	#include <xmmintrin.h>
+#endif
+
+// Distance in front of the camera of the point the inverse projection maps the given NDC depth to.
+static float GetViewDistance(const glm::mat4& inverseProjection, float ndcDepth)
+{
+	const glm::vec4 point = inverseProjection * glm::vec4(0.0f, 0.0f, ndcDepth, 1.0f);
+	return -point.z / point.w;
+}
+
+static glm::vec3 Unproject(const glm::mat4& inverseProjection, const glm::vec3& ndc)
+{
+	const glm::vec4 point = inverseProjection * glm::vec4(ndc, 1.0f);
+	return glm::vec3(point) / point.w;
+}
+
+LightClusterGrid::LightClusterGrid(uint32_t tilesX, uint32_t tilesY, uint32_t slices) :
+	TilesX(tilesX),
+	TilesY(tilesY),
+	Slices(slices),
+	m_tileCount(tilesX * tilesY),
+	m_paddedTileCount((tilesX * tilesY + 3) & ~3U),
+	m_projection(0.0f),
+	m_nearDistance(0.0f),
+	m_farDistance(0.0f),
+	m_sliceHits(slices)
+{
+}
+
+void LightClusterGrid::SetProjection(const glm::mat4& projection)
+{
+	if(!m_sliceBounds.empty() && projection == m_projection)
+	{
+		return;
+	}
+
+	m_projection = projection;
+
+	const glm::mat4 inverseProjection = glm::inverse(projection);
+
+	m_nearDistance = GetViewDistance(inverseProjection, -1.0f);
+	m_farDistance  = GetViewDistance(inverseProjection,  1.0f);
+
+	m_sliceDistances.resize(Slices + 1);
+	for(uint32_t slice = 0; slice <= Slices; slice++)
+	{
+		m_sliceDistances[slice] = m_nearDistance * std::pow(m_farDistance / m_nearDistance, float(slice) / float(Slices));
+	}
+
+	// Tile corners on the near and far planes; the corners at any depth in between lie on the lines joining them.
+	std::vector<glm::vec3> nearCorners((TilesX + 1) * (TilesY + 1));
+	std::vector<glm::vec3>  farCorners((TilesX + 1) * (TilesY + 1));
+	for(uint32_t y = 0; y <= TilesY; y++)
+	{
+		for(uint32_t x = 0; x <= TilesX; x++)
+		{
+			const glm::vec2 ndc(float(x) / float(TilesX) * 2.0f - 1.0f, float(y) / float(TilesY) * 2.0f - 1.0f);
+
+			nearCorners[y * (TilesX + 1) + x] = Unproject(inverseProjection, glm::vec3(ndc, -1.0f));
+			 farCorners[y * (TilesX + 1) + x] = Unproject(inverseProjection, glm::vec3(ndc,  1.0f));
+		}
+	}
+
+	// Padding tiles get inverted bounds, which no light can touch.
+	constexpr float Far = std::numeric_limits<float>::max();
+
+	m_sliceBounds.resize(Slices);
+	for(uint32_t slice = 0; slice < Slices; slice++)
+	{
+		SliceBounds& bounds = m_sliceBounds[slice];
+		for(std::vector<float>* values : { &bounds.MinimumX, &bounds.MinimumY, &bounds.MinimumZ })
+		{
+			values->assign(m_paddedTileCount, Far);
+		}
+		for(std::vector<float>* values : { &bounds.MaximumX, &bounds.MaximumY, &bounds.MaximumZ })
+		{
+			values->assign(m_paddedTileCount, -Far);
+		}
+		for(std::vector<float>* values : { &bounds.CenterX, &bounds.CenterY, &bounds.CenterZ, &bounds.Radius })
+		{
+			values->assign(m_paddedTileCount, 0.0f);
+		}
+
+		const float startFraction = (m_sliceDistances[slice    ] - m_nearDistance) / (m_farDistance - m_nearDistance);
+		const float   endFraction = (m_sliceDistances[slice + 1] - m_nearDistance) / (m_farDistance - m_nearDistance);
+
+		for(uint32_t y = 0; y < TilesY; y++)
+		{
+			for(uint32_t x = 0; x < TilesX; x++)
+			{
+				glm::vec3 minimum( Far);
+				glm::vec3 maximum(-Far);
+				for(uint32_t corner = 0; corner < 4; corner++)
+				{
+					const uint32_t cornerIndex = (y + corner / 2) * (TilesX + 1) + x + corner % 2;
+					for(const float fraction : { startFraction, endFraction })
+					{
+						const glm::vec3 point = glm::mix(nearCorners[cornerIndex], farCorners[cornerIndex], fraction);
+
+						minimum = glm::min(minimum, point);
+						maximum = glm::max(maximum, point);
+					}
+				}
+
+				const uint32_t tile = y * TilesX + x;
+				const glm::vec3 center = (minimum + maximum) * 0.5f;
+
+				bounds.MinimumX[tile] = minimum.x; bounds.MinimumY[tile] = minimum.y; bounds.MinimumZ[tile] = minimum.z;
+				bounds.MaximumX[tile] = maximum.x; bounds.MaximumY[tile] = maximum.y; bounds.MaximumZ[tile] = maximum.z;
+				bounds.CenterX [tile] = center.x ; bounds.CenterY [tile] = center.y ; bounds.CenterZ [tile] = center.z ;
+				bounds.Radius  [tile] = glm::distance(center, maximum);
+			}
+		}
+	}
+}
+
+uint32_t LightClusterGrid::GetSlice(float viewDistance) const
+{
+	if(viewDistance <= m_nearDistance)
+	{
+		return 0;
+	}
+
+	const float slice = std::log(viewDistance / m_nearDistance) / std::log(m_farDistance / m_nearDistance) * float(Slices);
+	return std::min(static_cast<uint32_t>(slice), Slices - 1);
+}
+
+void LightClusterGrid::Assign(std::span<const ClusterLight> lights)
+{
+	DEBUG_ASSERT(!m_sliceBounds.empty(), "SetProjection has to be called before Assign.");
+
+	m_lightCounts.assign(size_t(Slices) * m_tileCount, 0);
+
+	JobSystem::Get().ParallelFor(Slices, 1, [&](size_t begin, size_t end)
+	{
+		for(size_t slice = begin; slice < end; slice++)
+		{
+			AssignSlice(static_cast<uint32_t>(slice), lights);
+		}
+	});
+
+	m_lightOffsets.resize(m_lightCounts.size());
+
+	uint32_t indexCount = 0;
+	for(size_t cluster = 0; cluster < m_lightCounts.size(); cluster++)
+	{
+		m_lightOffsets[cluster] = indexCount;
+		indexCount += m_lightCounts[cluster];
+	}
+
+	m_lightIndices.resize(indexCount);
+	m_screenRects.assign(lights.size(), glm::vec4(float(TilesX), float(TilesY), 0.0f, 0.0f));
+
+	// Hits are ordered by light within each slice, so appending keeps every list sorted. The offsets advance to the
+	// end of each list here and are moved back to its start afterwards.
+	for(uint32_t slice = 0; slice < Slices; slice++)
+	{
+		const std::vector<uint32_t>& hits = m_sliceHits[slice];
+		for(size_t i = 0; i < hits.size(); i += 2)
+		{
+			const uint32_t tile = hits[i];
+			if(lights[hits[i + 1]].IsListed)
+			{
+				m_lightIndices[m_lightOffsets[size_t(slice) * m_tileCount + tile]++] = hits[i + 1];
+			}
+
+			const glm::vec4 tileRect(float(tile % TilesX), float(tile / TilesX), float(tile % TilesX + 1), float(tile / TilesX + 1));
+
+			glm::vec4& rect = m_screenRects[hits[i + 1]];
+			rect = glm::vec4(glm::min(glm::vec2(rect), glm::vec2(tileRect)), glm::max(glm::vec2(rect.z, rect.w), glm::vec2(tileRect.z, tileRect.w)));
+		}
+	}
+
+	for(size_t cluster = 0; cluster < m_lightCounts.size(); cluster++)
+	{
+		m_lightOffsets[cluster] -= m_lightCounts[cluster];
+	}
+
+	// Tile coordinates to normalized device coordinates; untouched lights keep minimum > maximum.
+	const glm::vec4 scale(2.0f / float(TilesX), 2.0f / float(TilesY), 2.0f / float(TilesX), 2.0f / float(TilesY));
+	for(glm::vec4& rect : m_screenRects)
+	{
+		rect = rect * scale - 1.0f;
+	}
+}
+
+void LightClusterGrid::AssignSlice(uint32_t slice, std::span<const ClusterLight> lights)
+{
+	const SliceBounds& bounds = m_sliceBounds[slice];
+	std::vector<uint32_t>& hits = m_sliceHits[slice];
+
+	hits.clear();
+
+	const float sliceStart = m_sliceDistances[slice];
+	const float sliceEnd   = m_sliceDistances[slice + 1];
+
+	for(uint32_t lightIndex = 0; lightIndex < lights.size(); lightIndex++)
+	{
+		const ClusterLight& light = lights[lightIndex];
+
+		const float distance = -light.Position.z;
+		if(distance + light.Range < sliceStart || distance - light.Range > sliceEnd)
+		{
+			continue;
+		}
+
+		// Cones of 180 degrees or more are tested as spheres.
+		const bool  isCone   = light.CosAngle > 0.0f;
+		const float sinAngle = std::sqrt(std::max(1.0f - light.CosAngle * light.CosAngle, 0.0f));
+
+#ifdef LIGHT_CLUSTER_GRID_SSE
+		const __m128 positionX = _mm_set1_ps(light.Position.x);
+		const __m128 positionY = _mm_set1_ps(light.Position.y);
+		const __m128 positionZ = _mm_set1_ps(light.Position.z);
+		const __m128 range     = _mm_set1_ps(light.Range);
+		const __m128 zero      = _mm_setzero_ps();
+
+		const __m128 directionX = _mm_set1_ps(light.Direction.x);
+		const __m128 directionY = _mm_set1_ps(light.Direction.y);
+		const __m128 directionZ = _mm_set1_ps(light.Direction.z);
+		const __m128 cosAngle   = _mm_set1_ps(light.CosAngle);
+		const __m128 sinAngleV  = _mm_set1_ps(sinAngle);
+
+		for(uint32_t tile = 0; tile < m_paddedTileCount; tile += 4)
+		{
+			// Squared distance from the light to the closest point of each cluster box.
+			const __m128 deltaX = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&bounds.MinimumX[tile]), positionX), zero), _mm_max_ps(_mm_sub_ps(positionX, _mm_loadu_ps(&bounds.MaximumX[tile])), zero));
+			const __m128 deltaY = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&bounds.MinimumY[tile]), positionY), zero), _mm_max_ps(_mm_sub_ps(positionY, _mm_loadu_ps(&bounds.MaximumY[tile])), zero));
+			const __m128 deltaZ = _mm_add_ps(_mm_max_ps(_mm_sub_ps(_mm_loadu_ps(&bounds.MinimumZ[tile]), positionZ), zero), _mm_max_ps(_mm_sub_ps(positionZ, _mm_loadu_ps(&bounds.MaximumZ[tile])), zero));
+
+			const __m128 distanceSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(deltaX, deltaX), _mm_mul_ps(deltaY, deltaY)), _mm_mul_ps(deltaZ, deltaZ));
+
+			int mask = _mm_movemask_ps(_mm_cmple_ps(distanceSquared, _mm_mul_ps(range, range)));
+			if(mask != 0 && isCone)
+			{
+				// Cone against the cluster's bounding sphere: reject spheres beside the cone, beyond its range or
+				// behind its apex.
+				const __m128 radius = _mm_loadu_ps(&bounds.Radius[tile]);
+
+				const __m128 toCenterX = _mm_sub_ps(_mm_loadu_ps(&bounds.CenterX[tile]), positionX);
+				const __m128 toCenterY = _mm_sub_ps(_mm_loadu_ps(&bounds.CenterY[tile]), positionY);
+				const __m128 toCenterZ = _mm_sub_ps(_mm_loadu_ps(&bounds.CenterZ[tile]), positionZ);
+
+				const __m128 lengthSquared = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCenterX, toCenterX), _mm_mul_ps(toCenterY, toCenterY)), _mm_mul_ps(toCenterZ, toCenterZ));
+				const __m128 along = _mm_add_ps(_mm_add_ps(_mm_mul_ps(toCenterX, directionX), _mm_mul_ps(toCenterY, directionY)), _mm_mul_ps(toCenterZ, directionZ));
+				const __m128 across = _mm_sqrt_ps(_mm_max_ps(_mm_sub_ps(lengthSquared, _mm_mul_ps(along, along)), zero));
+
+				const __m128 closestDistance = _mm_sub_ps(_mm_mul_ps(cosAngle, across), _mm_mul_ps(along, sinAngleV));
+
+				const __m128 culled = _mm_or_ps(_mm_or_ps(
+					_mm_cmpgt_ps(closestDistance, radius),
+					_mm_cmpgt_ps(along, _mm_add_ps(radius, range))),
+					_mm_cmplt_ps(along, _mm_sub_ps(zero, radius)));
+
+				mask &= ~_mm_movemask_ps(culled);
+			}
+
+			for(; mask != 0; mask &= mask - 1)
+			{
+				const uint32_t hitTile = tile + uint32_t(std::countr_zero(uint32_t(mask)));
+				if(hitTile < m_tileCount)
+				{
+					hits.push_back(hitTile);
+					hits.push_back(lightIndex);
+				}
+			}
+		}
+#else
+		for(uint32_t tile = 0; tile < m_tileCount; tile++)
+		{
+			const glm::vec3 minimum(bounds.MinimumX[tile], bounds.MinimumY[tile], bounds.MinimumZ[tile]);
+			const glm::vec3 maximum(bounds.MaximumX[tile], bounds.MaximumY[tile], bounds.MaximumZ[tile]);
+
+			const glm::vec3 delta = glm::max(minimum - light.Position, 0.0f) + glm::max(light.Position - maximum, 0.0f);
+			if(glm::dot(delta, delta) > light.Range * light.Range)
+			{
+				continue;
+			}
+
+			if(isCone)
+			{
+				const float radius = bounds.Radius[tile];
+
+				const glm::vec3 toCenter = glm::vec3(bounds.CenterX[tile], bounds.CenterY[tile], bounds.CenterZ[tile]) - light.Position;
+
+				const float along  = glm::dot(toCenter, light.Direction);
+				const float across = std::sqrt(std::max(glm::dot(toCenter, toCenter) - along * along, 0.0f));
+
+				const float closestDistance = light.CosAngle * across - along * sinAngle;
+				if(closestDistance > radius || along > radius + light.Range || along < -radius)
+				{
+					continue;
+				}
+			}
+
+			hits.push_back(tile);
+			hits.push_back(lightIndex);
+		}
+#endif
+	}
+
+	uint32_t* lightCounts = &m_lightCounts[size_t(slice) * m_tileCount];
+	for(size_t i = 0; i < hits.size(); i += 2)
+	{
+		if(lights[hits[i + 1]].IsListed)
+		{
+			lightCounts[hits[i]]++;
+		}
+	}
+}
\ No newline at end of file
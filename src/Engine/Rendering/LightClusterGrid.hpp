@@ -0,0 +1,85 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// A point or spot light in view space. Point lights keep CosAngle at -1, which turns the cone into a sphere.
+struct ClusterLight
+{
+	glm::vec3 Position  = glm::vec3(0.0f);
+	float     Range     = 0.0f;
+	glm::vec3 Direction = glm::vec3(0.0f, 0.0f, -1.0f);
+	float     CosAngle  = -1.0f; // cosine of half the cone angle
+
+	// Lights shaded in a pass of their own only need their screen rectangle and are left out of the cluster lists.
+	bool IsListed = true;
+};
+
+// Slices the view frustum into TilesX x TilesY screen tiles by Slices depth slices, spaced logarithmically like
+// perspective depth, and finds the lights whose sphere or cone touches each cluster. Listed lights are packed into
+// per-cluster index lists for a single clustered shading pass; every light also gets the screen rectangle of the
+// tiles it touches, which scissors the lights still shaded one pass each.
+class LightClusterGrid
+{
+public:
+	explicit LightClusterGrid(uint32_t tilesX = 16, uint32_t tilesY = 9, uint32_t slices = 24);
+
+	const uint32_t TilesX;
+	const uint32_t TilesY;
+	const uint32_t Slices;
+
+	// Recomputes the cluster bounds if the projection changed since the last call.
+	void SetProjection(const glm::mat4& projection);
+
+	// Assigns the lights slice by slice on the job system.
+	void Assign(std::span<const ClusterLight> lights);
+
+	[[nodiscard]] uint32_t GetClusterIndex(uint32_t x, uint32_t y, uint32_t slice) const { return (slice * TilesY + y) * TilesX + x; }
+
+	// Slice containing the given distance in front of the camera.
+	[[nodiscard]] uint32_t GetSlice(float viewDistance) const;
+
+	[[nodiscard]] float GetNearDistance() const { return m_nearDistance; }
+	[[nodiscard]] float GetFarDistance()  const { return m_farDistance; }
+
+	// Number of listed lights touching each cluster, indexed by GetClusterIndex.
+	[[nodiscard]] const std::vector<uint32_t>& GetLightCounts() const { return m_lightCounts; }
+
+	// Where each cluster's list starts in GetLightIndices. Lists are packed back to back in cluster order and hold
+	// light indices in ascending order.
+	[[nodiscard]] const std::vector<uint32_t>& GetLightOffsets() const { return m_lightOffsets; }
+	[[nodiscard]] const std::vector<uint32_t>& GetLightIndices() const { return m_lightIndices; }
+
+	// Normalized device rectangle (minimum xy, maximum xy) over the tiles a light touches. Lights that touch no
+	// cluster are outside the frustum and get an empty rectangle, with its minimum above its maximum.
+	[[nodiscard]] const glm::vec4& GetScreenRect(uint32_t lightIndex) const { return m_screenRects[lightIndex]; }
+private:
+	struct SliceBounds
+	{
+		// Structure of arrays over the tiles of the slice, padded to a multiple of four tiles.
+		std::vector<float> MinimumX, MinimumY, MinimumZ;
+		std::vector<float> MaximumX, MaximumY, MaximumZ;
+		std::vector<float> CenterX , CenterY , CenterZ , Radius;
+	};
+
+	uint32_t m_tileCount;
+	uint32_t m_paddedTileCount;
+
+	glm::mat4 m_projection;
+	float     m_nearDistance;
+	float     m_farDistance;
+
+	std::vector<float>                 m_sliceDistances; // Slices + 1 boundaries
+	std::vector<SliceBounds>           m_sliceBounds;
+	std::vector<std::vector<uint32_t>> m_sliceHits;      // tile, light pairs found by the job assigning each slice
+
+	std::vector<uint32_t>  m_lightCounts;
+	std::vector<uint32_t>  m_lightOffsets;
+	std::vector<uint32_t>  m_lightIndices;
+	std::vector<glm::vec4> m_screenRects;
+
+	void AssignSlice(uint32_t slice, std::span<const ClusterLight> lights);
+};
@@ -33,6 +33,8 @@ public:
 
         m_region = texture.Region;
     }
+
+    bool operator==(const MaterialTextureInfo& other) const = default;
 private:
     uint32_t  m_bindingIndex;
     Rectangle m_region;
@@ -1,9 +1,11 @@
 #pragma once
 
 #include <memory>
+#include <algorithm>
 #include <vector>
 
 #include "Engine/Core/Buffer.hpp"
+#include "Engine/Physics/AABB.hpp"
 
 class Model
 {
@@ -15,12 +17,36 @@ public:
 		Indices(std::make_shared<std::vector<uint32_t>>(indices)),
 		m_layout(TVertex::GetLayout())
 	{
+		if constexpr(requires { requires std::same_as<decltype(TVertex::Position), glm::vec3>; })
+		{
+			if(!vertices.empty())
+			{
+				Bounds = AABB(vertices[0].Position, vertices[0].Position);
+				for(const TVertex& vertex : vertices)
+				{
+					Bounds.Minimum = glm::min(Bounds.Minimum, vertex.Position);
+					Bounds.Maximum = glm::max(Bounds.Maximum, vertex.Position);
+				}
+			}
+		}
 	}
 
 	const BufferLayout& GetLayout() const { return m_layout; }
 
+	// Bytes per index once uploaded; devices store indices as uint16_t when every one of them fits.
+	[[nodiscard]] size_t GetIndexSize() const
+	{
+		return std::ranges::all_of(*Indices, [](uint32_t index) { return index <= UINT16_MAX; }) ? sizeof(uint16_t) : sizeof(uint32_t);
+	}
+
 	std::shared_ptr<DynamicBuffer>          Vertices;
 	std::shared_ptr<std::vector<uint32_t>> Indices;
+
+	// Object-space bounds of vertices with a glm::vec3 Position member, empty otherwise.
+	AABB Bounds;
+
+	// Maps stored positions to object space; only quantized vertex formats set anything but the identity.
+	glm::mat4 VertexTransform = glm::mat4(1.0f);
 private:
 	BufferLayout m_layout;
 };
@@ -29,19 +55,33 @@ class Mesh
 {
 public:
 	explicit Mesh(const Model& model) :
-		VertexCount(model.Vertices->Count()), IndexCount(model.Indices->size()) {}
+		ID(s_nextID++), VertexCount(model.Vertices->Count()), IndexCount(model.Indices->size()), IndexSize(model.GetIndexSize()), Bounds(model.Bounds), VertexTransform(model.VertexTransform) {}
 
 	virtual ~Mesh() = default;
 
+	const uint32_t ID;
+
 	const std::size_t VertexCount;
 	const std::size_t  IndexCount;
+	const std::size_t  IndexSize;
+
+	const AABB Bounds;
+
+	const glm::mat4 VertexTransform;
 
 	friend class RenderDevice;
 
 	template<ShallowCopyable TElement>
 	friend class RenderStream;
+
+	template<ShallowCopyable TInstance>
+	friend class RenderQueue;
+
+	friend class CommandList;
 protected:
 	virtual void Draw(size_t instanceCount) = 0;
+private:
+	inline static uint32_t s_nextID;
 };
 
 using MeshHandle = std::shared_ptr<Mesh>;
\ No newline at end of file
@@ -0,0 +1,388 @@
+#include "MeshOptimizer.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <numeric>
+#include <algorithm>
+#include <unordered_map>
+
+static constexpr uint32_t NoIndex = UINT32_MAX;
+
+VertexCacheStatistics MeshOptimizer::AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize)
+{
+	VertexCacheStatistics result;
+	if(indices.size() < 3 || vertexCount == 0)
+	{
+		return result;
+	}
+
+	// A vertex is in the FIFO while fewer than cacheSize misses happened since it was last loaded.
+	std::vector<size_t> loadedAt(vertexCount, 0);
+	size_t misses = 0;
+
+	for(const uint32_t index : indices)
+	{
+		if(loadedAt[index] == 0 || misses - loadedAt[index] >= cacheSize)
+		{
+			loadedAt[index] = ++misses;
+		}
+	}
+
+	result.ACMR = float(misses) / float(indices.size() / 3);
+	result.ATVR = float(misses) / float(vertexCount);
+	return result;
+}
+
+size_t MeshOptimizer::WeldVertices(void* vertices, size_t vertexCount, size_t stride, std::span<uint32_t> indices)
+{
+	auto* bytes = static_cast<uint8_t*>(vertices);
+
+	// FNV-1a over the vertex bytes; vertices with equal hashes are compared in full.
+	const auto hash = [bytes, stride](uint32_t vertex)
+	{
+		uint64_t result = 14695981039346656037ULL;
+		for(size_t i = 0; i < stride; i++)
+		{
+			result = (result ^ bytes[vertex * stride + i]) * 1099511628211ULL;
+		}
+		return result;
+	};
+
+	std::unordered_multimap<uint64_t, uint32_t> firstCopies;
+	firstCopies.reserve(vertexCount);
+
+	std::vector<uint32_t> remap(vertexCount);
+	uint32_t weldedCount = 0;
+
+	for(uint32_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		const uint64_t vertexHash = hash(vertex);
+
+		remap[vertex] = NoIndex;
+		for(auto [ it, end ] = firstCopies.equal_range(vertexHash); it != end; ++it)
+		{
+			if(std::memcmp(bytes + it->second * stride, bytes + vertex * stride, stride) == 0)
+			{
+				remap[vertex] = it->second;
+				break;
+			}
+		}
+
+		if(remap[vertex] == NoIndex)
+		{
+			std::memmove(bytes + weldedCount * stride, bytes + vertex * stride, stride);
+			firstCopies.emplace(vertexHash, weldedCount);
+			remap[vertex] = weldedCount++;
+		}
+	}
+
+	for(uint32_t& index : indices)
+	{
+		index = remap[index];
+	}
+
+	return weldedCount;
+}
+
+// Tom Forsyth, "Linear-Speed Vertex Cache Optimisation". Triangles are emitted greedily by the summed score of
+// their vertices, which favours vertices near the front of a simulated LRU cache and vertices with few triangles left.
+static float GetVertexScore(int32_t cachePosition, uint32_t remainingTriangles)
+{
+	static constexpr float CacheDecayPower   = 1.5f;
+	static constexpr float LastTriangleScore = 0.75f;
+	static constexpr float ValenceBoostScale = 2.0f;
+	static constexpr float ValenceBoostPower = 0.5f;
+
+	if(remainingTriangles == 0)
+	{
+		return -1.0f;
+	}
+
+	float score = 0.0f;
+	if(cachePosition >= 0)
+	{
+		if(cachePosition < 3)
+		{
+			// The last triangle's vertices score the same, whatever order they were used in.
+			score = LastTriangleScore;
+		}
+		else
+		{
+			const float scaler = 1.0f / float(MeshOptimizer::CacheSize - 3);
+			score = std::pow(1.0f - float(cachePosition - 3) * scaler, CacheDecayPower);
+		}
+	}
+
+	return score + ValenceBoostScale * std::pow(float(remainingTriangles), -ValenceBoostPower);
+}
+
+void MeshOptimizer::OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if(triangleCount == 0)
+	{
+		return;
+	}
+
+	// Triangles of every vertex, packed back to back.
+	std::vector<uint32_t> triangleOffsets(vertexCount + 1, 0);
+	for(const uint32_t index : indices.first(triangleCount * 3))
+	{
+		++triangleOffsets[index + 1];
+	}
+	std::partial_sum(triangleOffsets.begin(), triangleOffsets.end(), triangleOffsets.begin());
+
+	std::vector<uint32_t> vertexTriangles(triangleCount * 3);
+	std::vector<uint32_t> remainingTriangles(vertexCount, 0);
+	for(uint32_t triangle = 0; triangle < triangleCount; triangle++)
+	{
+		for(uint32_t corner = 0; corner < 3; corner++)
+		{
+			const uint32_t vertex = indices[triangle * 3 + corner];
+			vertexTriangles[triangleOffsets[vertex] + remainingTriangles[vertex]++] = triangle;
+		}
+	}
+
+	std::vector<int32_t> cachePositions(vertexCount, -1);
+	std::vector<float>   vertexScores(vertexCount);
+	for(uint32_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		vertexScores[vertex] = GetVertexScore(-1, remainingTriangles[vertex]);
+	}
+
+	std::vector<float> triangleScores(triangleCount);
+	std::vector<bool>  isEmitted(triangleCount, false);
+	for(uint32_t triangle = 0; triangle < triangleCount; triangle++)
+	{
+		triangleScores[triangle] = vertexScores[indices[triangle * 3]] + vertexScores[indices[triangle * 3 + 1]] + vertexScores[indices[triangle * 3 + 2]];
+	}
+
+	std::vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+
+	// Three slots past the cache hold the vertices pushed out by the last triangle, so their scores can be reset.
+	std::vector<uint32_t> cache;
+	std::vector<uint32_t> nextCache;
+	cache.reserve(CacheSize + 3);
+	nextCache.reserve(CacheSize + 3);
+
+	uint32_t bestTriangle = 0;
+	uint32_t scanCursor   = 0;
+
+	for(size_t emitted = 0; emitted < triangleCount; emitted++)
+	{
+		if(bestTriangle == NoIndex)
+		{
+			// Nothing in the cache has triangles left; start again from the next triangle in input order. Its score may
+			// not be the highest overall, but a full scan would make the algorithm quadratic.
+			while(isEmitted[scanCursor])
+			{
+				++scanCursor;
+			}
+			bestTriangle = scanCursor;
+		}
+
+		const uint32_t* triangleIndices = &indices[bestTriangle * 3];
+		result.insert(result.end(), triangleIndices, triangleIndices + 3);
+		isEmitted[bestTriangle] = true;
+
+		nextCache.assign(triangleIndices, triangleIndices + 3);
+		for(const uint32_t vertex : cache)
+		{
+			if(vertex != triangleIndices[0] && vertex != triangleIndices[1] && vertex != triangleIndices[2])
+			{
+				nextCache.push_back(vertex);
+			}
+		}
+
+		for(uint32_t corner = 0; corner < 3; corner++)
+		{
+			const uint32_t vertex = triangleIndices[corner];
+
+			uint32_t* begin = vertexTriangles.data() + triangleOffsets[vertex];
+			uint32_t* end   = begin + remainingTriangles[vertex];
+			std::iter_swap(std::find(begin, end, bestTriangle), end - 1);
+			--remainingTriangles[vertex];
+		}
+
+		for(size_t position = 0; position < nextCache.size(); position++)
+		{
+			const uint32_t vertex = nextCache[position];
+			cachePositions[vertex] = position < CacheSize ? int32_t(position) : -1;
+
+			const float score = GetVertexScore(cachePositions[vertex], remainingTriangles[vertex]);
+			const float scoreChange = score - vertexScores[vertex];
+			vertexScores[vertex] = score;
+
+			for(uint32_t i = 0; i < remainingTriangles[vertex]; i++)
+			{
+				triangleScores[vertexTriangles[triangleOffsets[vertex] + i]] += scoreChange;
+			}
+		}
+
+		if(nextCache.size() > CacheSize)
+		{
+			nextCache.resize(CacheSize);
+		}
+		std::swap(cache, nextCache);
+
+		// Only triangles of cached vertices changed score, so the next best is one of them.
+		bestTriangle = NoIndex;
+		float bestScore = -1.0f;
+		for(const uint32_t vertex : cache)
+		{
+			for(uint32_t i = 0; i < remainingTriangles[vertex]; i++)
+			{
+				const uint32_t triangle = vertexTriangles[triangleOffsets[vertex] + i];
+				if(triangleScores[triangle] > bestScore)
+				{
+					bestScore    = triangleScores[triangle];
+					bestTriangle = triangle;
+				}
+			}
+		}
+	}
+
+	std::copy(result.begin(), result.end(), indices.begin());
+}
+
+// Pedro Sander et al., "Fast Triangle Reordering for Vertex Locality and Reduced Overdraw". The cache-ordered list is
+// cut into clusters wherever the running ACMR is no worse than the whole mesh's, so moving clusters around costs
+// little cache efficiency, and the clusters are sorted to draw those facing away from the mesh centre first.
+void MeshOptimizer::OptimizeOverdraw(std::span<uint32_t> indices, std::span<const glm::vec3> positions)
+{
+	const size_t triangleCount = indices.size() / 3;
+	if(triangleCount == 0)
+	{
+		return;
+	}
+
+	const float meshACMR = AnalyzeVertexCache(indices, positions.size(), AnalysisCacheSize).ACMR;
+
+	// Triangle at which each cluster starts, plus one past the last triangle.
+	std::vector<uint32_t> clusterStarts;
+	{
+		std::vector<size_t> loadedAt(positions.size(), 0);
+		size_t misses = 0;
+
+		size_t clusterMisses    = 0;
+		size_t clusterTriangles = 0;
+
+		for(uint32_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			size_t triangleMisses = 0;
+			for(uint32_t corner = 0; corner < 3; corner++)
+			{
+				const uint32_t vertex = indices[triangle * 3 + corner];
+				if(loadedAt[vertex] == 0 || misses - (loadedAt[vertex] - 1) >= AnalysisCacheSize)
+				{
+					loadedAt[vertex] = ++misses;
+					++triangleMisses;
+				}
+			}
+
+			// Cut before a cache-cold triangle once the cluster so far is cache efficient enough to stand alone.
+			const bool isCold = triangleMisses == 3;
+			if(triangle == 0 || (isCold && float(clusterMisses) <= meshACMR * OverdrawThreshold * float(clusterTriangles)))
+			{
+				clusterStarts.push_back(triangle);
+				clusterMisses    = 0;
+				clusterTriangles = 0;
+			}
+
+			clusterMisses += triangleMisses;
+			++clusterTriangles;
+		}
+
+		clusterStarts.push_back(uint32_t(triangleCount));
+	}
+
+	const size_t clusterCount = clusterStarts.size() - 1;
+
+	glm::vec3 meshCentroid(0.0f);
+	float     meshArea = 0.0f;
+
+	std::vector<glm::vec3> clusterCentroids(clusterCount, glm::vec3(0.0f));
+	std::vector<glm::vec3> clusterNormals  (clusterCount, glm::vec3(0.0f));
+
+	for(size_t cluster = 0; cluster < clusterCount; cluster++)
+	{
+		float clusterArea = 0.0f;
+		for(uint32_t triangle = clusterStarts[cluster]; triangle < clusterStarts[cluster + 1]; triangle++)
+		{
+			const glm::vec3& a = positions[indices[triangle * 3    ]];
+			const glm::vec3& b = positions[indices[triangle * 3 + 1]];
+			const glm::vec3& c = positions[indices[triangle * 3 + 2]];
+
+			// Twice the area, weighted by which the centroids and normals are averaged.
+			const glm::vec3 normal = glm::cross(b - a, c - a);
+			const float area = glm::length(normal);
+
+			clusterCentroids[cluster] += (a + b + c) * (area / 3.0f);
+			clusterNormals  [cluster] += normal;
+			clusterArea += area;
+		}
+
+		meshCentroid += clusterCentroids[cluster];
+		meshArea     += clusterArea;
+
+		if(clusterArea > 0.0f)
+		{
+			clusterCentroids[cluster] /= clusterArea;
+		}
+	}
+
+	if(meshArea > 0.0f)
+	{
+		meshCentroid /= meshArea;
+	}
+
+	std::vector<float> sortKeys(clusterCount);
+	for(size_t cluster = 0; cluster < clusterCount; cluster++)
+	{
+		const float normalLength = glm::length(clusterNormals[cluster]);
+		sortKeys[cluster] = normalLength > 0.0f ? glm::dot(clusterCentroids[cluster] - meshCentroid, clusterNormals[cluster] / normalLength) : 0.0f;
+	}
+
+	std::vector<uint32_t> clusterOrder(clusterCount);
+	std::iota(clusterOrder.begin(), clusterOrder.end(), 0);
+	std::stable_sort(clusterOrder.begin(), clusterOrder.end(), [&sortKeys](uint32_t left, uint32_t right) { return sortKeys[left] > sortKeys[right]; });
+
+	std::vector<uint32_t> result;
+	result.reserve(triangleCount * 3);
+	for(const uint32_t cluster : clusterOrder)
+	{
+		result.insert(result.end(), indices.begin() + clusterStarts[cluster] * 3, indices.begin() + clusterStarts[cluster + 1] * 3);
+	}
+
+	std::copy(result.begin(), result.end(), indices.begin());
+}
+
+size_t MeshOptimizer::OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t stride, std::span<uint32_t> indices)
+{
+	std::vector<uint32_t> remap(vertexCount, NoIndex);
+	uint32_t nextVertex = 0;
+
+	for(uint32_t& index : indices)
+	{
+		if(remap[index] == NoIndex)
+		{
+			remap[index] = nextVertex++;
+		}
+		index = remap[index];
+	}
+
+	const auto* source = static_cast<const uint8_t*>(vertices);
+
+	std::vector<uint8_t> result(size_t(nextVertex) * stride);
+	for(size_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		if(remap[vertex] != NoIndex)
+		{
+			std::memcpy(result.data() + remap[vertex] * stride, source + vertex * stride, stride);
+		}
+	}
+
+	std::memcpy(vertices, result.data(), result.size());
+	return nextVertex;
+}
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <span>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// Post-transform vertex cache efficiency of an index order. ACMR is the average number of vertices transformed per
+// triangle (0.5 at best for large regular meshes, 3 at worst), ATVR the average number of times each vertex is
+// transformed (1 at best).
+struct VertexCacheStatistics
+{
+	float ACMR = 0.0f;
+	float ATVR = 0.0f;
+};
+
+struct MeshOptimizationReport
+{
+	size_t VertexCountBefore = 0;
+	size_t VertexCountAfter  = 0;
+
+	VertexCacheStatistics Before;
+	VertexCacheStatistics After;
+};
+
+// Reorders triangle lists for the GPU at import time: welds duplicate vertices, orders triangles for the post-
+// transform vertex cache (Forsyth's linear-speed algorithm), reorders clusters of those triangles so outward-facing
+// ones draw first and cover what is behind them, then lays vertices out in the order they are first fetched.
+// Everything runs on the CPU on plain arrays.
+class MeshOptimizer
+{
+public:
+	// Size of the LRU cache the triangle order is tuned for.
+	static constexpr uint32_t CacheSize = 32;
+
+	// Size of the FIFO cache the statistics simulate, a conservative stand-in for post-transform caches.
+	static constexpr uint32_t AnalysisCacheSize = 16;
+
+	// Clusters whose triangles share a cache-cold start are moved as a whole; the overdraw pass gives up this much ACMR
+	// at most for a better draw order.
+	static constexpr float OverdrawThreshold = 1.05f;
+
+	static VertexCacheStatistics AnalyzeVertexCache(std::span<const uint32_t> indices, size_t vertexCount, uint32_t cacheSize = AnalysisCacheSize);
+
+	// Merges byte-identical vertices of the given stride and points the indices at the first copy. Returns the number
+	// of vertices left at the front of the array.
+	static size_t WeldVertices(void* vertices, size_t vertexCount, size_t stride, std::span<uint32_t> indices);
+
+	static void OptimizeVertexCache(std::span<uint32_t> indices, size_t vertexCount);
+
+	// Expects indices already in vertex cache order.
+	static void OptimizeOverdraw(std::span<uint32_t> indices, std::span<const glm::vec3> positions);
+
+	// Moves vertices into the order the indices first reference them and drops unreferenced ones. Returns the number
+	// of vertices left.
+	static size_t OptimizeVertexFetch(void* vertices, size_t vertexCount, size_t stride, std::span<uint32_t> indices);
+
+	// Runs every stage on a triangle list of vertices with a glm::vec3 Position member.
+	template<typename TVertex> requires std::same_as<decltype(TVertex::Position), glm::vec3>
+	static MeshOptimizationReport Optimize(std::vector<TVertex>& vertices, std::vector<uint32_t>& indices)
+	{
+		MeshOptimizationReport result;
+		result.VertexCountBefore = vertices.size();
+		result.VertexCountAfter  = vertices.size();
+		if(vertices.empty() || indices.size() < 3)
+		{
+			return result;
+		}
+
+		result.Before = AnalyzeVertexCache(indices, vertices.size());
+
+		vertices.resize(WeldVertices(vertices.data(), vertices.size(), sizeof(TVertex), indices), vertices.front());
+
+		OptimizeVertexCache(indices, vertices.size());
+
+		std::vector<glm::vec3> positions;
+		positions.reserve(vertices.size());
+		for(const TVertex& vertex : vertices)
+		{
+			positions.push_back(vertex.Position);
+		}
+
+		OptimizeOverdraw(indices, positions);
+
+		vertices.resize(OptimizeVertexFetch(vertices.data(), vertices.size(), sizeof(TVertex), indices), vertices.front());
+
+		result.VertexCountAfter = vertices.size();
+		result.After = AnalyzeVertexCache(indices, vertices.size());
+		return result;
+	}
+};
@@ -0,0 +1,449 @@
+#include "MeshSimplifier.hpp"
+
+#include <cmath>
+#include <cstring>
+#include <algorithm>
+#include <unordered_map>
+#include <unordered_set>
+
+static constexpr uint32_t NoIndex = UINT32_MAX;
+
+namespace
+{
+	enum class VertexKind : uint8_t
+	{
+		Manifold,
+		Border,
+		Seam,
+		Locked,
+	};
+
+	// Sum of squared distances to a set of planes, each weighted by the area it came from.
+	struct Quadric
+	{
+		double A00 = 0, A11 = 0, A22 = 0, A10 = 0, A20 = 0, A21 = 0;
+		double B0  = 0, B1  = 0, B2  = 0;
+		double C   = 0;
+		double Weight = 0;
+
+		static Quadric FromPlane(const glm::vec3& normal, const glm::vec3& point, double weight)
+		{
+			const double a = normal.x, b = normal.y, c = normal.z;
+			const double d = -glm::dot(normal, point);
+
+			Quadric result;
+			result.A00 = a * a * weight; result.A11 = b * b * weight; result.A22 = c * c * weight;
+			result.A10 = b * a * weight; result.A20 = c * a * weight; result.A21 = c * b * weight;
+			result.B0  = a * d * weight; result.B1  = b * d * weight; result.B2  = c * d * weight;
+			result.C   = d * d * weight;
+			result.Weight = weight;
+			return result;
+		}
+
+		Quadric& operator+=(const Quadric& other)
+		{
+			A00 += other.A00; A11 += other.A11; A22 += other.A22;
+			A10 += other.A10; A20 += other.A20; A21 += other.A21;
+			B0  += other.B0;  B1  += other.B1;  B2  += other.B2;
+			C   += other.C;
+			Weight += other.Weight;
+			return *this;
+		}
+
+		// Weighted mean squared distance of the point to the planes.
+		[[nodiscard]] double GetError(const glm::vec3& point) const
+		{
+			const double x = point.x, y = point.y, z = point.z;
+
+			const double result = A00 * x * x + A11 * y * y + A22 * z * z
+			                    + 2 * (A10 * x * y + A20 * x * z + A21 * y * z)
+			                    + 2 * (B0 * x + B1 * y + B2 * z)
+			                    + C;
+
+			return Weight > 0 ? std::max(result, 0.0) / Weight : 0.0;
+		}
+	};
+
+	struct Collapse
+	{
+		uint32_t From;
+		uint32_t To;
+		double   Error;
+	};
+
+	uint64_t GetEdgeKey(uint32_t from, uint32_t to) { return (uint64_t(from) << 32) | to; }
+}
+
+std::vector<uint32_t> MeshSimplifier::Simplify(std::span<const uint32_t> indices, std::span<const glm::vec3> positions, size_t targetIndexCount, float maxError, float* resultError)
+{
+	std::vector<uint32_t> result(indices.begin(), indices.end());
+
+	if(resultError)
+	{
+		*resultError = 0.0f;
+	}
+
+	const size_t vertexCount = positions.size();
+	if(result.size() < 3 || result.size() <= targetIndexCount)
+	{
+		return result;
+	}
+
+	// Vertices at the same position are one point of the surface; seams show up as two vertices per point, the second
+	// being the first's partner.
+	std::vector<uint32_t> point(vertexCount);
+	std::vector<uint32_t> partner(vertexCount, NoIndex);
+	std::vector<uint32_t> pointVertexCount(vertexCount, 0);
+	{
+		std::unordered_map<uint64_t, uint32_t> firstVertices;
+		firstVertices.reserve(vertexCount);
+
+		for(uint32_t vertex = 0; vertex < vertexCount; vertex++)
+		{
+			uint32_t bits[3];
+			std::memcpy(bits, &positions[vertex], sizeof(bits));
+
+			uint64_t hash = 14695981039346656037ULL;
+			for(const uint32_t word : bits)
+			{
+				hash = (hash ^ word) * 1099511628211ULL;
+			}
+
+			// Colliding hashes of different positions are rare; treating them as distinct points just locks less.
+			auto [ it, inserted ] = firstVertices.try_emplace(hash, vertex);
+			point[vertex] = positions[it->second] == positions[vertex] ? it->second : vertex;
+
+			if(point[vertex] != vertex)
+			{
+				partner[vertex] = point[vertex];
+				partner[point[vertex]] = vertex;
+			}
+
+			pointVertexCount[point[vertex]]++;
+		}
+	}
+
+	// An edge between two points is on a border when no triangle runs along it the other way, and an edge between two
+	// vertices is on a seam when the same holds for the vertices but not for their points. Collapses create new border
+	// and seam edges, so both sets are rebuilt before every pass.
+	std::unordered_set<uint64_t>  pointEdges;
+	std::unordered_set<uint64_t> vertexEdges;
+
+	const auto findEdges = [&]()
+	{
+		pointEdges.clear();
+		vertexEdges.clear();
+		for(size_t i = 0; i < result.size(); i += 3)
+		{
+			for(size_t corner = 0; corner < 3; corner++)
+			{
+				const uint32_t from = result[i + corner];
+				const uint32_t to   = result[i + (corner + 1) % 3];
+
+				 pointEdges.insert(GetEdgeKey(point[from], point[to]));
+				vertexEdges.insert(GetEdgeKey(from, to));
+			}
+		}
+	};
+
+	findEdges();
+
+	const auto isBorderEdge = [&](uint32_t from, uint32_t to) { return !pointEdges.contains(GetEdgeKey(point[to], point[from])); };
+	const auto   isSeamEdge = [&](uint32_t from, uint32_t to) { return vertexEdges.contains(GetEdgeKey(from, to)) != vertexEdges.contains(GetEdgeKey(to, from)); };
+
+	std::vector<VertexKind> kinds(vertexCount, VertexKind::Manifold);
+	std::vector<Quadric> quadrics(vertexCount);
+
+	for(size_t i = 0; i < result.size(); i += 3)
+	{
+		const uint32_t triangle[3] = { result[i], result[i + 1], result[i + 2] };
+
+		const glm::vec3 cross = glm::cross(positions[triangle[1]] - positions[triangle[0]], positions[triangle[2]] - positions[triangle[0]]);
+		const float area = glm::length(cross) * 0.5f;
+		const glm::vec3 normal = area > 0.0f ? cross / (area * 2.0f) : glm::vec3(0.0f);
+
+		for(size_t corner = 0; corner < 3; corner++)
+		{
+			const uint32_t from = triangle[corner];
+			const uint32_t to   = triangle[(corner + 1) % 3];
+
+			quadrics[from] += Quadric::FromPlane(normal, positions[from], area);
+
+			if(isBorderEdge(from, to))
+			{
+				kinds[from] = kinds[to] = VertexKind::Border;
+
+				// A plane through the edge, perpendicular to the triangle, holds the border in place.
+				const glm::vec3 edge = positions[to] - positions[from];
+				const float length = glm::length(edge);
+				if(length > 0.0f && area > 0.0f)
+				{
+					const glm::vec3 borderNormal = glm::normalize(glm::cross(edge, normal));
+					const Quadric borderQuadric = Quadric::FromPlane(borderNormal, positions[from], double(length) * length * BorderWeight);
+
+					quadrics[from] += borderQuadric;
+					quadrics[to]   += borderQuadric;
+				}
+			}
+		}
+	}
+
+	// Seams where more than two vertices meet, or that end on a border, stay where they are.
+	for(uint32_t vertex = 0; vertex < vertexCount; vertex++)
+	{
+		const uint32_t count = pointVertexCount[point[vertex]];
+		if(count > 2 || (count == 2 && (kinds[vertex] == VertexKind::Border || kinds[partner[vertex]] == VertexKind::Border)))
+		{
+			kinds[vertex] = VertexKind::Locked;
+		}
+		else if(count == 2)
+		{
+			kinds[vertex] = VertexKind::Seam;
+		}
+	}
+
+	std::vector<std::vector<uint32_t>> vertexTriangles(vertexCount);
+
+	// A seam vertex moves together with its partner, which goes to the vertex at the target point on its own side.
+	const auto findSeamTarget = [&](uint32_t from, uint32_t to)
+	{
+		const uint32_t other = partner[from];
+		for(const uint32_t triangle : vertexTriangles[other])
+		{
+			for(size_t corner = 0; corner < 3; corner++)
+			{
+				const uint32_t vertex = result[triangle * 3 + corner];
+				if(point[vertex] == point[to] && isSeamEdge(other, vertex))
+				{
+					return vertex;
+				}
+			}
+		}
+
+		return NoIndex;
+	};
+
+	const auto canCollapse = [&](uint32_t from, uint32_t to)
+	{
+		switch(kinds[from])
+		{
+			case VertexKind::Manifold: return true;
+			case VertexKind::Border:   return kinds[to] != VertexKind::Manifold && isBorderEdge(from, to) != isBorderEdge(to, from);
+			case VertexKind::Seam:     return kinds[to] != VertexKind::Manifold && isSeamEdge(from, to) && findSeamTarget(from, to) != NoIndex;
+			default:                   return false;
+		}
+	};
+
+	const auto isDegenerate = [&point](const uint32_t* corners)
+	{
+		return point[corners[0]] == point[corners[1]] || point[corners[1]] == point[corners[2]] || point[corners[2]] == point[corners[0]];
+	};
+
+	// Rejects collapses that would turn a remaining triangle around the vertex over.
+	const auto flipsTriangle = [&](uint32_t from, uint32_t to)
+	{
+		for(const uint32_t triangle : vertexTriangles[from])
+		{
+			const uint32_t* corners = &result[triangle * 3];
+			if(isDegenerate(corners) || point[corners[0]] == point[to] || point[corners[1]] == point[to] || point[corners[2]] == point[to])
+			{
+				continue;
+			}
+
+			glm::vec3 moved[3];
+			for(size_t corner = 0; corner < 3; corner++)
+			{
+				moved[corner] = positions[corners[corner] == from ? to : corners[corner]];
+			}
+
+			const glm::vec3 before = glm::cross(positions[corners[1]] - positions[corners[0]], positions[corners[2]] - positions[corners[0]]);
+			const glm::vec3  after = glm::cross(moved[1] - moved[0], moved[2] - moved[0]);
+
+			if(glm::dot(before, after) <= 0.2f * glm::length(before) * glm::length(after))
+			{
+				return true;
+			}
+		}
+
+		return false;
+	};
+
+	// Returns the number of triangles the collapse removes.
+	const auto collapseVertex = [&](uint32_t from, uint32_t to)
+	{
+		size_t removedTriangles = 0;
+		for(const uint32_t triangle : vertexTriangles[from])
+		{
+			uint32_t* corners = &result[triangle * 3];
+
+			const bool wasDegenerate = isDegenerate(corners);
+			for(size_t corner = 0; corner < 3; corner++)
+			{
+				if(corners[corner] == from)
+				{
+					corners[corner] = to;
+				}
+			}
+
+			if(!wasDegenerate && isDegenerate(corners))
+			{
+				removedTriangles++;
+			}
+		}
+
+		quadrics[to] += quadrics[from];
+		return removedTriangles;
+	};
+
+	const double maxSquaredError = double(maxError) * maxError;
+	double reachedError = 0.0;
+
+	std::vector<uint64_t>  edges;
+	std::vector<Collapse>  collapses;
+	std::vector<bool>      touched(vertexCount);
+
+	while(result.size() > targetIndexCount)
+	{
+		const size_t triangleCount = result.size() / 3;
+
+		findEdges();
+
+		for(std::vector<uint32_t>& triangles : vertexTriangles)
+		{
+			triangles.clear();
+		}
+
+		edges.clear();
+		for(uint32_t triangle = 0; triangle < triangleCount; triangle++)
+		{
+			for(size_t corner = 0; corner < 3; corner++)
+			{
+				const uint32_t from = result[triangle * 3 + corner];
+				const uint32_t to   = result[triangle * 3 + (corner + 1) % 3];
+
+				vertexTriangles[from].push_back(triangle);
+				edges.push_back(GetEdgeKey(std::min(from, to), std::max(from, to)));
+			}
+		}
+
+		std::sort(edges.begin(), edges.end());
+		edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+		const auto getCollapseError = [&](uint32_t from, uint32_t to)
+		{
+			if(!canCollapse(from, to))
+			{
+				return DBL_MAX;
+			}
+
+			Quadric quadric = quadrics[from];
+			quadric += quadrics[to];
+
+			if(kinds[from] == VertexKind::Seam)
+			{
+				quadric += quadrics[partner[from]];
+				quadric += quadrics[findSeamTarget(from, to)];
+			}
+
+			return quadric.GetError(positions[to]);
+		};
+
+		// Each edge collapses in whichever allowed direction costs less.
+		collapses.clear();
+		for(const uint64_t edge : edges)
+		{
+			const uint32_t first  = uint32_t(edge >> 32);
+			const uint32_t second = uint32_t(edge);
+
+			const double  firstError = getCollapseError(second, first);
+			const double secondError = getCollapseError(first, second);
+
+			if(firstError <= maxSquaredError || secondError <= maxSquaredError)
+			{
+				collapses.push_back(firstError < secondError ? Collapse{ second, first, firstError } : Collapse{ first, second, secondError });
+			}
+		}
+
+		if(collapses.empty())
+		{
+			break;
+		}
+
+		std::sort(collapses.begin(), collapses.end(), [](const Collapse& left, const Collapse& right) { return left.Error < right.Error; });
+
+		// A collapse removes about two triangles. Costs go stale as neighbours move, so a pass only takes the cheapest
+		// share of the remaining work and the rest is re-evaluated in the next one.
+		const size_t trianglesToRemove = triangleCount - targetIndexCount / 3;
+		const size_t collapseGoal = std::min(collapses.size(), std::max<size_t>(trianglesToRemove / 2, 1));
+		double passErrorLimit = collapses[collapseGoal - 1].Error * 1.5 + 1e-12;
+
+		std::fill(touched.begin(), touched.end(), false);
+
+		size_t removedTriangles = 0;
+		size_t collapseCount = 0;
+
+		for(const Collapse& collapse : collapses)
+		{
+			if((collapseCount > 0 && collapse.Error > passErrorLimit) || removedTriangles >= trianglesToRemove)
+			{
+				break;
+			}
+
+			// Neighbours of a moved vertex have stale triangle lists, so each vertex moves at most once per pass.
+			if(touched[collapse.From] || touched[collapse.To] || flipsTriangle(collapse.From, collapse.To))
+			{
+				continue;
+			}
+
+			if(kinds[collapse.From] == VertexKind::Seam)
+			{
+				const uint32_t otherFrom = partner[collapse.From];
+				const uint32_t otherTo   = findSeamTarget(collapse.From, collapse.To);
+
+				if(otherTo == NoIndex || touched[otherFrom] || touched[otherTo] || flipsTriangle(otherFrom, otherTo))
+				{
+					continue;
+				}
+
+				removedTriangles += collapseVertex(otherFrom, otherTo);
+				touched[otherFrom] = touched[otherTo] = true;
+			}
+
+			removedTriangles += collapseVertex(collapse.From, collapse.To);
+			touched[collapse.From] = touched[collapse.To] = true;
+
+			// When the cheapest collapses all flip triangles, the limit follows the first one that does not.
+			if(collapseCount++ == 0)
+			{
+				passErrorLimit = std::max(passErrorLimit, collapse.Error * 1.5 + 1e-12);
+			}
+
+			reachedError = std::max(reachedError, collapse.Error);
+		}
+
+		size_t writeIndex = 0;
+		for(size_t i = 0; i < result.size(); i += 3)
+		{
+			if(!isDegenerate(&result[i]))
+			{
+				result[writeIndex++] = result[i];
+				result[writeIndex++] = result[i + 1];
+				result[writeIndex++] = result[i + 2];
+			}
+		}
+
+		result.resize(writeIndex);
+
+		if(collapseCount == 0)
+		{
+			break;
+		}
+	}
+
+	if(resultError)
+	{
+		*resultError = float(std::sqrt(reachedError));
+	}
+
+	return result;
+}
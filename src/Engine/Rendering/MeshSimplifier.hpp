@@ -0,0 +1,78 @@
+#pragma once
+
+#include <span>
+#include <cfloat>
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "Mesh.hpp"
+#include "MeshOptimizer.hpp"
+
+// One level of a LOD chain. Error estimates how far, in object-space units, the level's surface strays from the
+// original mesh. It is the quadric error of the kept vertices, which on curved surfaces is up to about three times
+// smaller than how far the simplified triangles cut inside the original.
+struct LODModel
+{
+	LODModel(const Model& geometry, float error) : Geometry(geometry), Error(error) {}
+
+	Model Geometry;
+	float Error;
+};
+
+// Reduces triangle lists offline by collapsing edges in the order of their quadric error (Garland and Heckbert). A
+// collapse moves a vertex onto one of its neighbours rather than to a new position, so a simplified mesh is just a
+// shorter index list into the original vertices and keeps their texture coordinates, normals and tangents.
+//
+// Vertices that share their position with another vertex (texture and normal seams) never move, and vertices on open
+// borders only slide along the border, so simplification never tears the surface apart.
+class MeshSimplifier
+{
+public:
+	// Border edges resist collapsing this much more than the surface around them, keeping outlines in place.
+	static constexpr float BorderWeight = 10.0f;
+
+	// Collapses edges until at most targetIndexCount indices are left or the next collapse would exceed maxError. The
+	// error actually reached is written to resultError.
+	static std::vector<uint32_t> Simplify(std::span<const uint32_t> indices, std::span<const glm::vec3> positions, size_t targetIndexCount, float maxError = FLT_MAX, float* resultError = nullptr);
+
+	// Builds levelCount levels, the first being the mesh itself and each following one simplified from the original to
+	// reduction times the triangles of the one before. The chain ends early once locked seams and borders stop a level
+	// from getting noticeably smaller.
+	template<typename TVertex> requires std::same_as<decltype(TVertex::Position), glm::vec3>
+	static std::vector<LODModel> BuildLODChain(const std::vector<TVertex>& vertices, const std::vector<uint32_t>& indices, size_t levelCount = 4, float reduction = 0.5f)
+	{
+		std::vector<LODModel> result;
+		result.emplace_back(Model(vertices, indices), 0.0f);
+
+		std::vector<glm::vec3> positions;
+		positions.reserve(vertices.size());
+		for(const TVertex& vertex : vertices)
+		{
+			positions.push_back(vertex.Position);
+		}
+
+		size_t previousIndexCount = indices.size();
+		for(size_t level = 1; level < levelCount; level++)
+		{
+			const size_t targetIndexCount = size_t(float(previousIndexCount / 3) * reduction) * 3;
+
+			float error = 0.0f;
+			std::vector<uint32_t> levelIndices = Simplify(indices, positions, targetIndexCount, FLT_MAX, &error);
+			if(levelIndices.empty() || float(levelIndices.size()) > float(previousIndexCount) * 0.9f)
+			{
+				break;
+			}
+
+			std::vector<TVertex> levelVertices(vertices);
+			MeshOptimizer::OptimizeVertexCache(levelIndices, levelVertices.size());
+			levelVertices.resize(MeshOptimizer::OptimizeVertexFetch(levelVertices.data(), levelVertices.size(), sizeof(TVertex), levelIndices), vertices.front());
+
+			result.emplace_back(Model(levelVertices, levelIndices), error);
+			previousIndexCount = levelIndices.size();
+		}
+
+		return result;
+	}
+};
@@ -0,0 +1,342 @@
+#include "OcclusionCuller.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include <Common.hpp>
+
+#include "Engine/Core/JobSystem.hpp"
+
+#if defined(__SSE__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 1)
+	#define OCCLUSION_CULLER_SSE
+	#include <xmmintrin.h>
+#endif
+
+static float Cross(const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; }
+
+OcclusionCuller::OcclusionCuller(uint32_t width, uint32_t height) :
+	m_width(width),
+	m_height(height),
+	m_binCount(width / BinSize, height / BinSize),
+	m_viewProjection(1.0f),
+	m_depth(size_t(width) * height, 1.0f),
+	m_hiZ(size_t(width / TileSize) * (height / TileSize), 1.0f),
+	m_bins(size_t(width / BinSize) * (height / BinSize))
+{
+	DEBUG_ASSERT(width % BinSize == 0 && height % BinSize == 0, "Occlusion buffer size must be a multiple of " << BinSize << ".");
+}
+
+void OcclusionCuller::BeginFrame(const glm::mat4& viewProjection)
+{
+	m_viewProjection = viewProjection;
+	m_triangles.clear();
+	m_statistics = Statistics();
+}
+
+void OcclusionCuller::AddOccluder(const OccluderMesh& mesh, const glm::mat4& modelMatrix)
+{
+	++m_statistics.OccluderCount;
+
+	const glm::mat4 mvpMatrix = m_viewProjection * modelMatrix;
+
+	auto isInFront = [](const glm::vec4& position) { return position.z + position.w > 0.0f; };
+
+	for(size_t i = 0; i + 2 < mesh.Indices.size(); i += 3)
+	{
+		const glm::vec4 triangle[3] =
+		{
+			mvpMatrix * glm::vec4(mesh.Positions[mesh.Indices[i    ]], 1.0f),
+			mvpMatrix * glm::vec4(mesh.Positions[mesh.Indices[i + 1]], 1.0f),
+			mvpMatrix * glm::vec4(mesh.Positions[mesh.Indices[i + 2]], 1.0f),
+		};
+
+		const int inFrontCount = int(isInFront(triangle[0])) + int(isInFront(triangle[1])) + int(isInFront(triangle[2]));
+		if(inFrontCount == 0)
+		{
+			continue;
+		}
+
+		if(inFrontCount == 3)
+		{
+			AddTriangle(triangle[0], triangle[1], triangle[2]);
+			continue;
+		}
+
+		// Clip against the near plane; a triangle becomes a triangle or a quad.
+		glm::vec4 polygon[4];
+		int vertexCount = 0;
+
+		for(int j = 0; j < 3; j++)
+		{
+			const glm::vec4& current = triangle[j];
+			const glm::vec4& next    = triangle[(j + 1) % 3];
+
+			const float currentDistance = current.z + current.w;
+			const float    nextDistance =    next.z +    next.w;
+
+			if(currentDistance > 0.0f)
+			{
+				polygon[vertexCount++] = current;
+			}
+
+			if((currentDistance > 0.0f) != (nextDistance > 0.0f))
+			{
+				polygon[vertexCount++] = glm::mix(current, next, currentDistance / (currentDistance - nextDistance));
+			}
+		}
+
+		for(int j = 1; j + 1 < vertexCount; j++)
+		{
+			AddTriangle(polygon[0], polygon[j], polygon[j + 1]);
+		}
+	}
+}
+
+void OcclusionCuller::AddTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c)
+{
+	const glm::vec3 scale (m_width * 0.5f, m_height * 0.5f, 0.5f);
+	const glm::vec3 offset(m_width * 0.5f, m_height * 0.5f, 0.5f);
+
+	Triangle triangle
+	{{
+		glm::vec3(a) / std::max(a.w, 1e-6f) * scale + offset,
+		glm::vec3(b) / std::max(b.w, 1e-6f) * scale + offset,
+		glm::vec3(c) / std::max(c.w, 1e-6f) * scale + offset,
+	}};
+
+	const glm::vec3 minimum = glm::min(glm::min(triangle.Vertices[0], triangle.Vertices[1]), triangle.Vertices[2]);
+	const glm::vec3 maximum = glm::max(glm::max(triangle.Vertices[0], triangle.Vertices[1]), triangle.Vertices[2]);
+
+	if(maximum.x < 0.0f || maximum.y < 0.0f || minimum.x > float(m_width) || minimum.y > float(m_height) || minimum.z > 1.0f)
+	{
+		return;
+	}
+
+	const float area = Cross(glm::vec2(triangle.Vertices[1] - triangle.Vertices[0]), glm::vec2(triangle.Vertices[2] - triangle.Vertices[0]));
+	if(std::abs(area) < 1e-8f)
+	{
+		return;
+	}
+
+	// Occluders block from both sides, so back faces are flipped rather than culled.
+	if(area < 0.0f)
+	{
+		std::swap(triangle.Vertices[1], triangle.Vertices[2]);
+	}
+
+	m_triangles.push_back(triangle);
+	++m_statistics.TriangleCount;
+}
+
+void OcclusionCuller::Rasterize()
+{
+	std::fill(m_depth.begin(), m_depth.end(), 1.0f);
+
+	for(auto& bin : m_bins)
+	{
+		bin.clear();
+	}
+
+	for(uint32_t i = 0; i < m_triangles.size(); i++)
+	{
+		const Triangle& triangle = m_triangles[i];
+
+		const glm::vec2 minimum = glm::min(glm::min(glm::vec2(triangle.Vertices[0]), glm::vec2(triangle.Vertices[1])), glm::vec2(triangle.Vertices[2]));
+		const glm::vec2 maximum = glm::max(glm::max(glm::vec2(triangle.Vertices[0]), glm::vec2(triangle.Vertices[1])), glm::vec2(triangle.Vertices[2]));
+
+		const glm::ivec2 firstBin = glm::clamp(glm::ivec2(glm::floor(minimum)) / int(BinSize), glm::ivec2(0), glm::ivec2(m_binCount) - 1);
+		const glm::ivec2  lastBin = glm::clamp(glm::ivec2(glm::floor(maximum)) / int(BinSize), glm::ivec2(0), glm::ivec2(m_binCount) - 1);
+
+		for(int y = firstBin.y; y <= lastBin.y; y++)
+		{
+			for(int x = firstBin.x; x <= lastBin.x; x++)
+			{
+				m_bins[size_t(y) * m_binCount.x + x].push_back(i);
+			}
+		}
+	}
+
+	// Bins own disjoint pixels and HiZ tiles, so they can be rasterized without synchronization.
+	JobSystem::Get().ParallelFor(m_bins.size(), 1, [this](size_t begin, size_t end)
+	{
+		for(size_t bin = begin; bin < end; bin++)
+		{
+			RasterizeBin(uint32_t(bin));
+		}
+	});
+}
+
+void OcclusionCuller::RasterizeBin(uint32_t bin)
+{
+	const int binX = int(bin % m_binCount.x) * int(BinSize);
+	const int binY = int(bin / m_binCount.x) * int(BinSize);
+
+	for(uint32_t triangleIndex : m_bins[bin])
+	{
+		const glm::vec3* vertices = m_triangles[triangleIndex].Vertices;
+
+		const glm::vec2 minimum = glm::min(glm::min(glm::vec2(vertices[0]), glm::vec2(vertices[1])), glm::vec2(vertices[2]));
+		const glm::vec2 maximum = glm::max(glm::max(glm::vec2(vertices[0]), glm::vec2(vertices[1])), glm::vec2(vertices[2]));
+
+		// Rows start on a multiple of four so every SSE store stays inside the bin.
+		const int minimumX = std::max(binX, int(std::floor(minimum.x))) & ~3;
+		const int minimumY = std::max(binY, int(std::floor(minimum.y)));
+		const int maximumX = std::min(binX + int(BinSize) - 1, int(std::ceil(maximum.x)));
+		const int maximumY = std::min(binY + int(BinSize) - 1, int(std::ceil(maximum.y)));
+
+		if(minimumX > maximumX || minimumY > maximumY)
+		{
+			continue;
+		}
+
+		// Edge functions E(x, y) = A * x + B * y + C, positive inside for counter-clockwise triangles.
+		float edgeA[3], edgeB[3], edgeC[3];
+		for(int i = 0; i < 3; i++)
+		{
+			const glm::vec3& start = vertices[i];
+			const glm::vec3& end   = vertices[(i + 1) % 3];
+
+			edgeA[i] = start.y - end.y;
+			edgeB[i] = end.x - start.x;
+			edgeC[i] = -(edgeA[i] * start.x + edgeB[i] * start.y);
+		}
+
+		// Depth plane z(x, y) = depthA * x + depthB * y + depthC, affine in screen space after the perspective divide.
+		const glm::vec3 delta1 = vertices[1] - vertices[0];
+		const glm::vec3 delta2 = vertices[2] - vertices[0];
+		const float inverseArea = 1.0f / Cross(glm::vec2(delta1), glm::vec2(delta2));
+
+		const float depthA = (delta1.z * delta2.y - delta2.z * delta1.y) * inverseArea;
+		const float depthB = (delta2.z * delta1.x - delta1.z * delta2.x) * inverseArea;
+		const float depthC = vertices[0].z - depthA * vertices[0].x - depthB * vertices[0].y;
+
+		for(int y = minimumY; y <= maximumY; y++)
+		{
+			const float pixelY = float(y) + 0.5f;
+			float* row = &m_depth[size_t(y) * m_width];
+
+#ifdef OCCLUSION_CULLER_SSE
+			const __m128 rowEdge0 = _mm_set1_ps(edgeB[0] * pixelY + edgeC[0]);
+			const __m128 rowEdge1 = _mm_set1_ps(edgeB[1] * pixelY + edgeC[1]);
+			const __m128 rowEdge2 = _mm_set1_ps(edgeB[2] * pixelY + edgeC[2]);
+			const __m128 rowDepth = _mm_set1_ps(depthB * pixelY + depthC);
+
+			const __m128 edgeA0 = _mm_set1_ps(edgeA[0]);
+			const __m128 edgeA1 = _mm_set1_ps(edgeA[1]);
+			const __m128 edgeA2 = _mm_set1_ps(edgeA[2]);
+			const __m128 depthX = _mm_set1_ps(depthA);
+			const __m128 zero   = _mm_setzero_ps();
+
+			for(int x = minimumX; x <= maximumX; x += 4)
+			{
+				const __m128 pixelX = _mm_add_ps(_mm_set1_ps(float(x)), _mm_set_ps(3.5f, 2.5f, 1.5f, 0.5f));
+
+				const __m128 inside0 = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA0, pixelX), rowEdge0), zero);
+				const __m128 inside1 = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA1, pixelX), rowEdge1), zero);
+				const __m128 inside2 = _mm_cmpge_ps(_mm_add_ps(_mm_mul_ps(edgeA2, pixelX), rowEdge2), zero);
+				const __m128 inside  = _mm_and_ps(_mm_and_ps(inside0, inside1), inside2);
+
+				if(_mm_movemask_ps(inside) == 0)
+				{
+					continue;
+				}
+
+				const __m128 depth    = _mm_add_ps(_mm_mul_ps(depthX, pixelX), rowDepth);
+				const __m128 previous = _mm_loadu_ps(row + x);
+				const __m128 nearest  = _mm_min_ps(previous, depth);
+
+				_mm_storeu_ps(row + x, _mm_or_ps(_mm_and_ps(inside, nearest), _mm_andnot_ps(inside, previous)));
+			}
+#else
+			for(int x = minimumX; x <= maximumX; x++)
+			{
+				const float pixelX = float(x) + 0.5f;
+
+				bool isInside = true;
+				for(int i = 0; i < 3; i++)
+				{
+					isInside &= edgeA[i] * pixelX + edgeB[i] * pixelY + edgeC[i] >= 0.0f;
+				}
+
+				if(isInside)
+				{
+					row[x] = std::min(row[x], depthA * pixelX + depthB * pixelY + depthC);
+				}
+			}
+#endif
+		}
+	}
+
+	// Reduce the bin's pixels to the farthest depth per tile.
+	const uint32_t tileCountX = m_width / TileSize;
+
+	for(uint32_t tileY = binY / TileSize; tileY < (binY + BinSize) / TileSize; tileY++)
+	{
+		for(uint32_t tileX = binX / TileSize; tileX < (binX + BinSize) / TileSize; tileX++)
+		{
+			float farthest = 0.0f;
+			for(uint32_t y = tileY * TileSize; y < (tileY + 1) * TileSize; y++)
+			{
+				const float* row = &m_depth[size_t(y) * m_width + tileX * TileSize];
+				farthest = std::max(farthest, *std::max_element(row, row + TileSize));
+			}
+
+			m_hiZ[size_t(tileY) * tileCountX + tileX] = farthest;
+		}
+	}
+}
+
+bool OcclusionCuller::IsVisible(const AABB& worldBounds) const
+{
+	++m_statistics.TestedCount;
+
+	glm::vec2 minimum( INFINITY);
+	glm::vec2 maximum(-INFINITY);
+	float nearestDepth = INFINITY;
+
+	for(int i = 0; i < 8; i++)
+	{
+		const glm::vec3 corner((i & 1) ? worldBounds.Maximum.x : worldBounds.Minimum.x,
+		                       (i & 2) ? worldBounds.Maximum.y : worldBounds.Minimum.y,
+		                       (i & 4) ? worldBounds.Maximum.z : worldBounds.Minimum.z);
+
+		const glm::vec4 clip = m_viewProjection * glm::vec4(corner, 1.0f);
+
+		// Boxes crossing the near plane are always treated as visible.
+		if(clip.z + clip.w <= 0.0f || clip.w <= 1e-6f)
+		{
+			return true;
+		}
+
+		const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+		minimum = glm::min(minimum, glm::vec2(ndc));
+		maximum = glm::max(maximum, glm::vec2(ndc));
+		nearestDepth = std::min(nearestDepth, ndc.z * 0.5f + 0.5f);
+	}
+
+	if(maximum.x < -1.0f || maximum.y < -1.0f || minimum.x > 1.0f || minimum.y > 1.0f || nearestDepth > 1.0f)
+	{
+		++m_statistics.CulledCount;
+		return false;
+	}
+
+	const glm::ivec2 tileCount(m_width / TileSize, m_height / TileSize);
+	const glm::vec2  tileScale(tileCount);
+
+	const glm::ivec2 firstTile = glm::clamp(glm::ivec2(glm::floor((minimum * 0.5f + 0.5f) * tileScale)), glm::ivec2(0), tileCount - 1);
+	const glm::ivec2  lastTile = glm::clamp(glm::ivec2(glm::floor((maximum * 0.5f + 0.5f) * tileScale)), glm::ivec2(0), tileCount - 1);
+
+	for(int y = firstTile.y; y <= lastTile.y; y++)
+	{
+		for(int x = firstTile.x; x <= lastTile.x; x++)
+		{
+			if(nearestDepth <= m_hiZ[size_t(y) * tileCount.x + x])
+			{
+				return true;
+			}
+		}
+	}
+
+	++m_statistics.CulledCount;
+	return false;
+}
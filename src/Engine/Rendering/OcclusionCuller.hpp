@@ -0,0 +1,95 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <cstdint>
+#include <concepts>
+
+#include <glm/glm.hpp>
+
+#include "Engine/Physics/AABB.hpp"
+
+// CPU-side copy of the triangles an occluder contributes to the software depth buffer.
+struct OccluderMesh
+{
+	template<typename TVertex> requires std::same_as<decltype(TVertex::Position), glm::vec3>
+	OccluderMesh(const std::vector<TVertex>& vertices, const std::vector<uint32_t>& indices) : Indices(indices)
+	{
+		Positions.reserve(vertices.size());
+		for(const TVertex& vertex : vertices)
+		{
+			Positions.push_back(vertex.Position);
+		}
+	}
+
+	OccluderMesh(std::vector<glm::vec3> positions, std::vector<uint32_t> indices) :
+		Positions(std::move(positions)), Indices(std::move(indices)) {}
+
+	std::vector<glm::vec3> Positions;
+	std::vector<uint32_t>  Indices;
+};
+
+using OccluderMeshHandle = std::shared_ptr<OccluderMesh>;
+
+// Rasterizes occluders into a small depth buffer, reduces it to a max-depth pyramid level of TileSize x TileSize
+// pixels and tests screen-space bounding rectangles of occludees against it. Occluders are rasterized at pixel
+// centres, so an occluder partially covering a pixel can hide an object seen through the uncovered part.
+class OcclusionCuller
+{
+public:
+	static constexpr uint32_t TileSize = 8;
+	static constexpr uint32_t  BinSize = 32;
+
+	struct Statistics
+	{
+		size_t OccluderCount = 0;
+		size_t TriangleCount = 0;
+		size_t   TestedCount = 0;
+		size_t   CulledCount = 0;
+
+		[[nodiscard]] float CullingRate() const { return TestedCount == 0 ? 0.0f : float(CulledCount) / float(TestedCount); }
+	};
+
+	explicit OcclusionCuller(uint32_t width = 256, uint32_t height = 128);
+
+	[[nodiscard]] uint32_t Width()  const { return m_width;  }
+	[[nodiscard]] uint32_t Height() const { return m_height; }
+
+	void BeginFrame(const glm::mat4& viewProjection);
+
+	void AddOccluder(const OccluderMesh& mesh, const glm::mat4& modelMatrix);
+
+	// Bins the frame's occluder triangles into BinSize squares and rasterizes the bins on the job system.
+	void Rasterize();
+
+	[[nodiscard]] bool IsVisible(const AABB& worldBounds) const;
+
+	[[nodiscard]] const Statistics& GetStatistics() const { return m_statistics; }
+
+	// Depth in [0, 1] per pixel, row 0 at the bottom of the screen.
+	[[nodiscard]] const std::vector<float>& GetDepthBuffer() const { return m_depth; }
+private:
+	struct Triangle
+	{
+		glm::vec3 Vertices[3];
+	};
+
+	uint32_t   m_width;
+	uint32_t   m_height;
+	glm::uvec2 m_binCount;
+	glm::mat4  m_viewProjection;
+
+	std::vector<float> m_depth;
+	std::vector<float> m_hiZ;
+
+	std::vector<Triangle>              m_triangles;
+	std::vector<std::vector<uint32_t>> m_bins;
+
+	mutable Statistics m_statistics;
+
+	void AddTriangle(const glm::vec4& a, const glm::vec4& b, const glm::vec4& c);
+
+	void RasterizeBin(uint32_t bin);
+};
+
+using OcclusionCullerHandle = std::shared_ptr<OcclusionCuller>;
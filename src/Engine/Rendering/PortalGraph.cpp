@@ -0,0 +1,240 @@
+#include "PortalGraph.hpp"
+
+#include <cmath>
+#include <unordered_map>
+
+static float Cross(const glm::vec2& a, const glm::vec2& b) { return a.x * b.y - a.y * b.x; }
+
+PortalGraph::PortalGraph(const glm::uvec2& size, const std::vector<TileType>& tiles) :
+	m_size(size), m_tileCells(size_t(size.x) * size.y, InvalidCell)
+{
+	auto getTile = [&](uint32_t x, uint32_t y) { return tiles[size_t(y) * size.x + x]; };
+	auto isFree  = [&](uint32_t x, uint32_t y) { return getTile(x, y) == TileType::Open && m_tileCells[size_t(y) * size.x + x] == InvalidCell; };
+
+	// Greedy rectangle decomposition: grow each unassigned open tile right as far as possible, then down for as
+	// long as the whole row stays free. Door tiles always become their own cell so they can block on their own.
+	for(uint32_t y = 0; y < size.y; y++)
+	{
+		for(uint32_t x = 0; x < size.x; x++)
+		{
+			const TileType type = getTile(x, y);
+			if(type == TileType::Solid || m_tileCells[size_t(y) * size.x + x] != InvalidCell)
+			{
+				continue;
+			}
+
+			glm::uvec2 extent(1);
+			if(type == TileType::Open)
+			{
+				while(x + extent.x < size.x && isFree(x + extent.x, y))
+				{
+					++extent.x;
+				}
+
+				while(y + extent.y < size.y)
+				{
+					bool isRowFree = true;
+					for(uint32_t i = 0; i < extent.x && isRowFree; i++)
+					{
+						isRowFree = isFree(x + i, y + extent.y);
+					}
+
+					if(!isRowFree)
+					{
+						break;
+					}
+					++extent.y;
+				}
+			}
+
+			const auto cell = uint32_t(m_cells.size());
+			m_cells.emplace_back(glm::uvec2(x, y), glm::uvec2(x, y) + extent, type == TileType::Door);
+
+			for(uint32_t j = y; j < y + extent.y; j++)
+			{
+				for(uint32_t i = x; i < x + extent.x; i++)
+				{
+					m_tileCells[size_t(j) * size.x + i] = cell;
+				}
+			}
+		}
+	}
+
+	// Two rectangles share at most one contiguous edge, so every tile edge between two cells can be merged into
+	// the single portal for that pair.
+	std::unordered_map<uint64_t, uint32_t> portalIndices;
+
+	auto addEdge = [&](uint32_t first, uint32_t second, const glm::vec2& start, const glm::vec2& end)
+	{
+		if(first == InvalidCell || second == InvalidCell || first == second)
+		{
+			return;
+		}
+
+		const uint64_t key = (uint64_t(std::min(first, second)) << 32) | std::max(first, second);
+
+		auto it = portalIndices.find(key);
+		if(it == portalIndices.end())
+		{
+			portalIndices[key] = uint32_t(m_portals.size());
+			m_cells[first ].Portals.push_back(uint32_t(m_portals.size()));
+			m_cells[second].Portals.push_back(uint32_t(m_portals.size()));
+			m_portals.emplace_back(first, second, start, end);
+		}
+		else
+		{
+			Portal& portal = m_portals[it->second];
+			portal.Start = glm::min(portal.Start, start);
+			portal.End   = glm::max(portal.End  , end  );
+		}
+	};
+
+	for(uint32_t y = 0; y < size.y; y++)
+	{
+		for(uint32_t x = 0; x < size.x; x++)
+		{
+			const uint32_t cell = GetCell(glm::ivec2(x, y));
+
+			if(x + 1 < size.x)
+			{
+				addEdge(cell, GetCell(glm::ivec2(x + 1, y)), glm::vec2(x + 1, y), glm::vec2(x + 1, y + 1));
+			}
+
+			if(y + 1 < size.y)
+			{
+				addEdge(cell, GetCell(glm::ivec2(x, y + 1)), glm::vec2(x, y + 1), glm::vec2(x + 1, y + 1));
+			}
+		}
+	}
+}
+
+void PortalGraph::FindVisibleCells(const glm::vec2& eye, const glm::vec2& forward, float halfAngle, std::vector<bool>& visibleCells) const
+{
+	visibleCells.assign(m_cells.size(), false);
+
+	const uint32_t start = GetCellAt(eye);
+	if(start == InvalidCell)
+	{
+		return;
+	}
+
+	halfAngle = std::min(halfAngle, glm::radians(89.9f));
+
+	const float cosine = std::cos(halfAngle);
+	const float   sine = std::sin(halfAngle);
+
+	Wedge wedge;
+	wedge.Right = glm::vec2(forward.x * cosine + forward.y * sine, -forward.x * sine + forward.y * cosine);
+	wedge.Left  = glm::vec2(forward.x * cosine - forward.y * sine,  forward.x * sine + forward.y * cosine);
+
+	// Mazes with loops can reach a cell along many paths; the budget bounds the worst case.
+	size_t budget = m_cells.size() * 64;
+
+	std::vector<bool> onPath(m_cells.size(), false);
+	Visit(start, eye, wedge, visibleCells, onPath, budget);
+
+	if(budget > 0)
+	{
+		return;
+	}
+
+	// The walk was cut short, so paths it never took may still see more cells. Rather than let them pop out of
+	// view, every cell reachable from the eye's cell without passing through a blocking one counts as visible.
+	std::vector<uint32_t> stack = { start };
+	std::vector<bool>     isReached(m_cells.size(), false);
+	isReached[start] = true;
+
+	while(!stack.empty())
+	{
+		const uint32_t cell = stack.back();
+		stack.pop_back();
+
+		visibleCells[cell] = true;
+		if(m_cells[cell].IsBlocking && cell != start)
+		{
+			continue;
+		}
+
+		for(uint32_t portalIndex : m_cells[cell].Portals)
+		{
+			const uint32_t other = m_portals[portalIndex].GetOther(cell);
+			if(!isReached[other])
+			{
+				isReached[other] = true;
+				stack.push_back(other);
+			}
+		}
+	}
+}
+
+void PortalGraph::Visit(uint32_t cell, const glm::vec2& eye, const Wedge& wedge, std::vector<bool>& visibleCells, std::vector<bool>& onPath, size_t& budget) const
+{
+	visibleCells[cell] = true;
+
+	// The eye may stand inside a blocking cell and still look out of it.
+	const bool isEyeCell = GetCellAt(eye) == cell;
+	if(budget == 0 || (m_cells[cell].IsBlocking && !isEyeCell))
+	{
+		return;
+	}
+	--budget;
+
+	onPath[cell] = true;
+
+	for(uint32_t portalIndex : m_cells[cell].Portals)
+	{
+		const Portal&  portal = m_portals[portalIndex];
+		const uint32_t other  = portal.GetOther(cell);
+
+		Wedge clipped;
+		if(!onPath[other] && ClipToPortal(eye, wedge, portal, clipped))
+		{
+			Visit(other, eye, clipped, visibleCells, onPath, budget);
+		}
+	}
+
+	onPath[cell] = false;
+}
+
+bool PortalGraph::ClipToPortal(const glm::vec2& eye, const Wedge& wedge, const Portal& portal, Wedge& result)
+{
+	constexpr float epsilon = 1e-6f;
+
+	glm::vec2 a = portal.Start - eye;
+	glm::vec2 b = portal.End   - eye;
+
+	const glm::vec2 edge = portal.End - portal.Start;
+
+	// Standing on the portal itself: it cannot narrow anything.
+	const float t = glm::clamp(glm::dot(-a, edge) / glm::dot(edge, edge), 0.0f, 1.0f);
+	if(glm::length(a + edge * t) < 1e-4f)
+	{
+		result = wedge;
+		return true;
+	}
+
+	if(Cross(a, b) < 0.0f)
+	{
+		std::swap(a, b);
+	}
+
+	if(Cross(a, b) <= epsilon * glm::length(a) * glm::length(b))
+	{
+		return false;
+	}
+
+	auto isInside = [](const glm::vec2& direction, const glm::vec2& right, const glm::vec2& left)
+	{
+		const float scale = epsilon * glm::length(direction);
+		return Cross(right, direction) >= -scale * glm::length(right) && Cross(direction, left) >= -scale * glm::length(left);
+	};
+
+	// The intersection of two wedges sharing an apex keeps the more counter-clockwise right edge and the more
+	// clockwise left edge; it is empty unless both edges lie inside both wedges.
+	result.Right = Cross(wedge.Right, a) > 0.0f ? a : wedge.Right;
+	result.Left  = Cross(wedge.Left , b) < 0.0f ? b : wedge.Left;
+
+	return Cross(result.Right, result.Left) > 0.0f &&
+		isInside(result.Right, wedge.Right, wedge.Left) && isInside(result.Right, a, b) &&
+		isInside(result.Left , wedge.Right, wedge.Left) && isInside(result.Left , a, b);
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+enum class TileType : uint8_t
+{
+	Solid,
+	Open,
+	Door,
+};
+
+// Splits a tile grid into convex rectangular cells joined by portals along their shared edges. All coordinates
+// are in grid space, where tile (x, y) covers [x, x + 1] x [y, y + 1].
+class PortalGraph
+{
+public:
+	static constexpr uint32_t InvalidCell = UINT32_MAX;
+
+	struct Cell
+	{
+		Cell(const glm::uvec2& minimum, const glm::uvec2& maximum, bool isDoor) :
+			Minimum(minimum), Maximum(maximum), IsDoor(isDoor), IsBlocking(isDoor) {}
+
+		glm::uvec2 Minimum;
+		glm::uvec2 Maximum;
+
+		bool IsDoor;
+		bool IsBlocking;
+
+		std::vector<uint32_t> Portals;
+	};
+
+	struct Portal
+	{
+		Portal(uint32_t first, uint32_t second, const glm::vec2& start, const glm::vec2& end) :
+			Cells{ first, second }, Start(start), End(end) {}
+
+		uint32_t  Cells[2];
+		glm::vec2 Start;
+		glm::vec2 End;
+
+		[[nodiscard]] uint32_t GetOther(uint32_t cell) const { return Cells[0] == cell ? Cells[1] : Cells[0]; }
+	};
+
+	PortalGraph() : m_size(0) {}
+
+	PortalGraph(const glm::uvec2& size, const std::vector<TileType>& tiles);
+
+	[[nodiscard]] glm::uvec2 Size() const { return m_size; }
+
+	[[nodiscard]] const std::vector<Cell>&   GetCells()   const { return m_cells;   }
+	[[nodiscard]] const std::vector<Portal>& GetPortals() const { return m_portals; }
+
+	[[nodiscard]] uint32_t GetCell(const glm::ivec2& tile) const
+	{
+		if(tile.x < 0 || tile.y < 0 || tile.x >= int(m_size.x) || tile.y >= int(m_size.y))
+		{
+			return InvalidCell;
+		}
+		return m_tileCells[size_t(tile.y) * m_size.x + tile.x];
+	}
+
+	[[nodiscard]] uint32_t GetCellAt(const glm::vec2& position) const { return GetCell(glm::ivec2(glm::floor(position))); }
+
+	// A blocking cell (a closed door) can be seen into but not through.
+	void SetBlocking(uint32_t cell, bool blocking) { m_cells[cell].IsBlocking = blocking; }
+
+	// Flood fills from the eye's cell through every portal that is still inside the view wedge, narrowing the wedge
+	// to each portal on the way. visibleCells is resized to the cell count. If the walk runs over its budget, every
+	// cell reachable without passing through a blocking one is marked visible instead.
+	void FindVisibleCells(const glm::vec2& eye, const glm::vec2& forward, float halfAngle, std::vector<bool>& visibleCells) const;
+private:
+	struct Wedge
+	{
+		glm::vec2 Right;
+		glm::vec2 Left;
+	};
+
+	glm::uvec2 m_size;
+
+	std::vector<Cell>     m_cells;
+	std::vector<Portal>   m_portals;
+	std::vector<uint32_t> m_tileCells;
+
+	void Visit(uint32_t cell, const glm::vec2& eye, const Wedge& wedge, std::vector<bool>& visibleCells, std::vector<bool>& onPath, size_t& budget) const;
+
+	static bool ClipToPortal(const glm::vec2& eye, const Wedge& wedge, const Portal& portal, Wedge& result);
+};
@@ -5,14 +5,27 @@
 
 #include "Engine/Core/Buffer.hpp"
 
+// Storage buffer binding points render buffers commit to, e.g. "layout(std430, binding = 0) buffer".
+enum StorageSlot : uint32_t
+{
+    InstanceStorageSlot     = 0,
+    ClusterLightStorageSlot = 1,
+    ClusterTableStorageSlot = 2,
+};
+
 class DeviceRenderBuffer
 {
 public:
     virtual ~DeviceRenderBuffer() = default;
 
+    // Size of one region; the device keeps several regions in flight.
     [[nodiscard]] virtual std::size_t SizeInBytes() const = 0;
 
-    virtual void Update(ConstDynamicBufferSlice instanceData) = 0;
+    // Writable memory for the current region. Only valid until the next Commit.
+    virtual void* Map() = 0;
+
+    // Makes the first sizeInBytes bytes of the current region visible to the next draw and moves to another region.
+    virtual void Commit(size_t sizeInBytes, size_t elementCount) = 0;
 };
 
 using DeviceRenderBufferHandle = std::shared_ptr<DeviceRenderBuffer>;
@@ -21,19 +34,29 @@ template<ShallowCopyable TElement>
 class LocalRenderBuffer
 {
 public:
-    Buffer<TElement> Elements;
+    // Writes go straight into the device buffer's current region, so Elements moves on after every Update.
+    BufferSlice<TElement> Elements;
 
-    explicit LocalRenderBuffer(DeviceRenderBufferHandle deviceBuffer, size_t elementCount, const TElement& defaultValue) :
-        Elements(elementCount, defaultValue), m_deviceBuffer(std::move(deviceBuffer)) {}
+    explicit LocalRenderBuffer(DeviceRenderBufferHandle deviceBuffer) :
+        Elements(nullptr), m_deviceBuffer(std::move(deviceBuffer))
+    {
+        Map();
+    }
 
     void Update(size_t count)
     {
-        m_deviceBuffer->Update(Elements.AsSlice(0, count));
+        m_deviceBuffer->Commit(count * sizeof(TElement), count);
+        Map();
     }
 
     friend class RenderDevice;
 private:
     const DeviceRenderBufferHandle m_deviceBuffer;
+
+    void Map()
+    {
+        Elements = BufferSlice<TElement>(static_cast<TElement*>(m_deviceBuffer->Map()), m_deviceBuffer->SizeInBytes() / sizeof(TElement));
+    }
 };
 
 template<ShallowCopyable TElement>
@@ -24,9 +24,9 @@ RenderContext2D::RenderContext2D(RenderDevice& renderDevice, const RenderTargetH
 	m_rectangleShader(rectangleShader),
 	m_ellipseShader(ellipseShader),
 	m_textShader(textShader),
-	m_rectangleStream(renderDevice.CreateRenderBuffer<RectangleInfo>(5000, RectangleInfo()), quad, rectangleShader, renderTarget),
-	m_ellipseStream  (renderDevice.CreateRenderBuffer<  EllipseInfo>(5000,   EllipseInfo()), quad, ellipseShader, renderTarget),
-	m_characterStream(renderDevice.CreateRenderBuffer<CharacterInfo>(5000, CharacterInfo()), quad, textShader, renderTarget)
+	m_rectangleStream(renderDevice.CreateRenderBuffer<RectangleInfo>(5000), quad, rectangleShader, renderTarget),
+	m_ellipseStream  (renderDevice.CreateRenderBuffer<  EllipseInfo>(5000), quad, ellipseShader, renderTarget),
+	m_characterStream(renderDevice.CreateRenderBuffer<CharacterInfo>(5000), quad, textShader, renderTarget)
 {
 }
 
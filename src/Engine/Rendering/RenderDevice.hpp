@@ -6,9 +6,11 @@
 
 #include "Mesh.hpp"
 #include "RenderBuffer.hpp"
+#include "ConstantBlock.hpp"
 #include "TextureAtlas.hpp"
 #include "Shader.hpp"
 #include "RenderTarget.hpp"
+#include "RenderTargetPool.hpp"
 
 struct ScreenGraphicsMode
 {
@@ -66,11 +68,17 @@ enum RenderFlags : uint32_t
 	ClipPlane5   = 1024,
 };
 
+struct RenderDeviceStatistics
+{
+	RenderTargetPoolStatistics TargetPool;
+};
+
 class RenderDevice
 {
 public:
 	explicit RenderDevice(RenderTargetHandle screenBuffer, size_t maximumTextureBindCount) :
 		ScreenBuffer(std::move(screenBuffer)),
+		TargetPool(*this),
 		BoundRenderTarget(std::move(screenBuffer))
 	{
 		m_boundTextures.resize(maximumTextureBindCount, {});
@@ -81,6 +89,16 @@ public:
 
 	const RenderTargetHandle ScreenBuffer;
 
+	// Shared by every renderer system for targets they only need during part of a frame.
+	RenderTargetPool TargetPool;
+
+	[[nodiscard]] RenderDeviceStatistics GetStatistics() const
+	{
+		RenderDeviceStatistics result;
+		result.TargetPool = TargetPool.GetStatistics();
+		return result;
+	}
+
 	virtual void Enable(uint32_t flags) = 0;
 	virtual void Disable(uint32_t flags) = 0;
 
@@ -89,10 +107,19 @@ public:
 	virtual void SetDepthFunction(DepthFunction depthFunction) = 0;
 	virtual void SetBlendFunction(BlendFactor sourceFactor, BlendFactor destFactor) = 0;
 
-	template<typename TElement>
-	LocalRenderBufferHandle<TElement> CreateRenderBuffer(size_t elementCount, const TElement& defaultValue)
+	// Each of the regionCount regions holds elementCount elements; a region is only rewritten once the GPU is done with it.
+	// Every Update binds the region it wrote to slot.
+	template<ShallowCopyable TElement>
+	LocalRenderBufferHandle<TElement> CreateRenderBuffer(size_t elementCount, size_t regionCount = 3, uint32_t slot = InstanceStorageSlot)
+	{
+		return std::make_shared<LocalRenderBuffer<TElement>>(CreateDeviceRenderBuffer(elementCount * sizeof(TElement), regionCount, slot));
+	}
+
+	// updatesInFlight is how many Update calls may be made before the ring reuses a section the GPU might still read.
+	template<ShallowCopyable TBlock>
+	ConstantBlockHandle<TBlock> CreateConstantBlock(uint32_t slot, const TBlock& defaultValue, size_t updatesInFlight = 64)
 	{
-		return std::make_shared<LocalRenderBuffer<TElement>>(CreateDeviceRenderBuffer(elementCount * sizeof(TElement)), elementCount, defaultValue);
+		return std::make_shared<ConstantBlock<TBlock>>(CreateDeviceConstantBuffer(sizeof(TBlock), updatesInFlight), slot, defaultValue);
 	}
 
 	virtual MeshHandle         CreateMesh        (const Model& model) = 0;
@@ -101,11 +128,15 @@ public:
 	virtual RenderTargetHandle CreateRenderTarget(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment) = 0;
 	virtual ShaderHandle       CreateShader      (std::string_view sourceCode) = 0;
 
+	virtual RenderTargetArrayHandle CreateRenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount, const AttachmentInfo& depthAttachment) = 0;
+
 	friend class RenderTarget;
 	friend class MaterialTextureInfo;
 	friend class TextureAtlas;
 protected:
-	virtual DeviceRenderBufferHandle CreateDeviceRenderBuffer(size_t sizeInBytes) = 0;
+	virtual DeviceRenderBufferHandle CreateDeviceRenderBuffer(size_t sizeInBytes, size_t regionCount, uint32_t slot) = 0;
+
+	virtual DeviceConstantBufferHandle CreateDeviceConstantBuffer(size_t blockSize, size_t sectionCount) = 0;
 private:
 	RenderTargetHandle BoundRenderTarget;
 
@@ -0,0 +1,58 @@
+#include "RenderQueue.hpp"
+
+void RadixSort(std::vector<RenderSortItem>& items, std::vector<RenderSortItem>& scratch)
+{
+    if(items.size() < 2)
+    {
+        return;
+    }
+
+    scratch.resize(items.size());
+
+    // Bits set in some keys but not in others; bytes outside this mask are the same everywhere.
+    uint64_t andMask = ~uint64_t(0);
+    uint64_t  orMask = 0;
+    for(const RenderSortItem& item : items)
+    {
+        andMask &= item.Key;
+         orMask |= item.Key;
+    }
+    const uint64_t varyingBits = andMask ^ orMask;
+
+    std::vector<RenderSortItem>* source = &items;
+    std::vector<RenderSortItem>* target = &scratch;
+
+    for(uint32_t shift = 0; shift < 64; shift += 8)
+    {
+        if(((varyingBits >> shift) & 0xFF) == 0)
+        {
+            continue;
+        }
+
+        size_t offsets[256] = {};
+        for(const RenderSortItem& item : *source)
+        {
+            ++offsets[(item.Key >> shift) & 0xFF];
+        }
+
+        size_t total = 0;
+        for(size_t& offset : offsets)
+        {
+            const size_t count = offset;
+            offset = total;
+            total += count;
+        }
+
+        for(const RenderSortItem& item : *source)
+        {
+            (*target)[offsets[(item.Key >> shift) & 0xFF]++] = item;
+        }
+
+        std::swap(source, target);
+    }
+
+    if(source != &items)
+    {
+        items.swap(scratch);
+    }
+}
@@ -0,0 +1,220 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+
+#include "Mesh.hpp"
+#include "Shader.hpp"
+#include "CommandList.hpp"
+#include "RenderBuffer.hpp"
+#include "RenderTarget.hpp"
+
+// 64-bit draw sort key, most significant field first:
+//   pass (4) | render target (8) | shader (12) | material (12) | mesh (16) | depth (12)
+// IDs are truncated to their field width. Colliding IDs only cost extra state changes, never wrong state, since
+// submission compares the actual objects.
+struct RenderSortKey
+{
+    static constexpr uint32_t    PassBits = 4;
+    static constexpr uint32_t  TargetBits = 8;
+    static constexpr uint32_t  ShaderBits = 12;
+    static constexpr uint32_t MaterialBits = 12;
+    static constexpr uint32_t    MeshBits = 16;
+    static constexpr uint32_t   DepthBits = 12;
+
+    static constexpr uint32_t   DepthShift = 0;
+    static constexpr uint32_t    MeshShift = DepthShift    + DepthBits;
+    static constexpr uint32_t MaterialShift = MeshShift     + MeshBits;
+    static constexpr uint32_t  ShaderShift = MaterialShift + MaterialBits;
+    static constexpr uint32_t  TargetShift = ShaderShift   + ShaderBits;
+    static constexpr uint32_t    PassShift = TargetShift   + TargetBits;
+
+    static uint64_t Create(uint32_t pass, uint32_t target, uint32_t shader, uint32_t material, uint32_t mesh, uint32_t depth)
+    {
+        return Field(pass, PassBits, PassShift) | Field(target, TargetBits, TargetShift) | Field(shader, ShaderBits, ShaderShift) |
+               Field(material, MaterialBits, MaterialShift) | Field(mesh, MeshBits, MeshShift) | Field(depth, DepthBits, DepthShift);
+    }
+
+    // Maps [0, maximumDepth] to the depth field; pass reverse to sort back to front.
+    static uint32_t QuantizeDepth(float depth, float maximumDepth, bool reverse = false)
+    {
+        constexpr uint32_t maximum = (1U << DepthBits) - 1;
+
+        const auto result = uint32_t(std::clamp(depth / maximumDepth, 0.0f, 1.0f) * float(maximum));
+        return reverse ? maximum - result : result;
+    }
+private:
+    static uint64_t Field(uint32_t value, uint32_t bits, uint32_t shift) { return (uint64_t(value) & ((uint64_t(1) << bits) - 1)) << shift; }
+};
+
+struct RenderSortItem
+{
+    uint64_t Key;
+    uint32_t Index;
+};
+
+// Stable LSD radix sort on the key, one byte per pass; passes over bytes that are equal in every key are skipped.
+void RadixSort(std::vector<RenderSortItem>& items, std::vector<RenderSortItem>& scratch);
+
+struct RenderQueueStatistics
+{
+    size_t         ItemCount = 0;
+    size_t         DrawCount = 0;
+    size_t  ShaderChangeCount = 0;
+    size_t  TargetChangeCount = 0;
+};
+
+// Collects one instance per submitted draw, sorts them by key and submits consecutive items that share target,
+// shader, material and mesh as a single instanced draw. Shaders and targets are only bound when they change.
+// Submitted objects must stay alive until Execute returns.
+template<ShallowCopyable TInstance>
+class RenderQueue
+{
+public:
+    void Submit(uint64_t key, RenderTarget& target, Shader& shader, uint32_t material, Mesh& mesh, const TInstance& instance)
+    {
+        m_items.push_back({ key, uint32_t(m_draws.size()) });
+        m_draws.push_back({ &target, &shader, &mesh, material, instance });
+    }
+
+    void Submit(uint32_t pass, float depth, float maximumDepth, RenderTarget& target, Shader& shader, uint32_t material, Mesh& mesh, const TInstance& instance)
+    {
+        const uint64_t key = RenderSortKey::Create(pass, target.ID, shader.ID, material, mesh.ID, RenderSortKey::QuantizeDepth(depth, maximumDepth));
+        Submit(key, target, shader, material, mesh, instance);
+    }
+
+    [[nodiscard]] bool   IsEmpty() const { return m_items.empty(); }
+    [[nodiscard]] size_t   Count() const { return m_items.size();  }
+
+    [[nodiscard]] const RenderQueueStatistics& GetStatistics() const { return m_statistics; }
+
+    void Sort() { RadixSort(m_items, m_scratch); }
+
+    // Sorts, draws and clears the queue. Batches larger than the buffer are split into several draws.
+    void Execute(LocalRenderBuffer<TInstance>& buffer)
+    {
+        Sort();
+
+        m_statistics = RenderQueueStatistics();
+        m_statistics.ItemCount = m_items.size();
+
+        RenderTarget* currentTarget = nullptr;
+        Shader*       currentShader = nullptr;
+
+        const size_t capacity = buffer.Elements.Count();
+
+        size_t i = 0;
+        while(i < m_items.size())
+        {
+            const Draw& first = m_draws[m_items[i].Index];
+
+            if(first.Target != currentTarget)
+            {
+                currentTarget = first.Target;
+                currentTarget->Use();
+                ++m_statistics.TargetChangeCount;
+            }
+
+            if(first.Shader != currentShader)
+            {
+                currentShader = first.Shader;
+                currentShader->Use();
+                ++m_statistics.ShaderChangeCount;
+            }
+
+            size_t count = 0;
+            while(i < m_items.size() && count < capacity)
+            {
+                const Draw& draw = m_draws[m_items[i].Index];
+                if(draw.Target != first.Target || draw.Shader != first.Shader || draw.Material != first.Material || draw.Mesh != first.Mesh)
+                {
+                    break;
+                }
+
+                buffer.Elements[count++] = draw.Instance;
+                ++i;
+            }
+
+            buffer.Update(count);
+            first.Mesh->Draw(count);
+            ++m_statistics.DrawCount;
+        }
+
+        Clear();
+    }
+
+    // Like Execute, but writes the batches to a command list instead of the device, so it may run on any thread.
+    // Batches are only split to fit the buffer when the list is replayed.
+    void Record(CommandList& commands, LocalRenderBuffer<TInstance>& buffer)
+    {
+        Sort();
+
+        m_statistics = RenderQueueStatistics();
+        m_statistics.ItemCount = m_items.size();
+
+        RenderTarget* currentTarget = nullptr;
+        Shader*       currentShader = nullptr;
+
+        size_t i = 0;
+        while(i < m_items.size())
+        {
+            const Draw& first = m_draws[m_items[i].Index];
+
+            if(first.Target != currentTarget)
+            {
+                currentTarget = first.Target;
+                commands.UseRenderTarget(*currentTarget);
+                ++m_statistics.TargetChangeCount;
+            }
+
+            if(first.Shader != currentShader)
+            {
+                currentShader = first.Shader;
+                commands.UseShader(*currentShader);
+                ++m_statistics.ShaderChangeCount;
+            }
+
+            size_t end = i + 1;
+            while(end < m_items.size())
+            {
+                const Draw& draw = m_draws[m_items[end].Index];
+                if(draw.Target != first.Target || draw.Shader != first.Shader || draw.Material != first.Material || draw.Mesh != first.Mesh)
+                {
+                    break;
+                }
+                ++end;
+            }
+
+            TInstance* instances = commands.Draw(*first.Mesh, buffer, end - i);
+            for(; i < end; i++)
+            {
+                *instances++ = m_draws[m_items[i].Index].Instance;
+            }
+            ++m_statistics.DrawCount;
+        }
+
+        Clear();
+    }
+
+    void Clear()
+    {
+        m_items.clear();
+        m_draws.clear();
+    }
+private:
+    struct Draw
+    {
+        RenderTarget* Target;
+        ::Shader*     Shader;
+        ::Mesh*       Mesh;
+        uint32_t      Material;
+        TInstance     Instance;
+    };
+
+    std::vector<RenderSortItem> m_items;
+    std::vector<RenderSortItem> m_scratch;
+    std::vector<Draw>           m_draws;
+
+    RenderQueueStatistics m_statistics;
+};
@@ -53,12 +53,14 @@ public:
             {
                 elementsToWrite.Slice(0, remainingBuffer.Count()).CopyTo(remainingBuffer);
                 elementsToWrite = elementsToWrite.Slice(remainingBuffer.Count());
+                m_index += remainingBuffer.Count();
             }
             Flush();
             remainingBuffer = GetRemainingBuffer();
         }
 
         elementsToWrite.CopyTo(remainingBuffer);
+        m_index += elementsToWrite.Count();
     }
 
     void Flush()
@@ -81,7 +83,7 @@ private:
 
     size_t m_index;
 
-    BufferSlice<TElement> GetWrittenBuffer() const { return m_renderBuffer->Elements.AsSlice(0, m_index); }
+    BufferSlice<TElement> GetWrittenBuffer() const { return m_renderBuffer->Elements.Slice(0, m_index); }
 
-    BufferSlice<TElement> GetRemainingBuffer() const { return m_renderBuffer->Elements.AsSlice(m_index); }
+    BufferSlice<TElement> GetRemainingBuffer() const { return m_renderBuffer->Elements.Slice(m_index); }
 };
@@ -26,6 +26,44 @@ struct AttachmentInfo
 	MinFilterMode       MinFilter;
 	MagFilterMode       MagFilter;
 	TextureWrappingMode WrappingMode;
+
+	bool operator==(const AttachmentInfo& other) const = default;
+
+	// Video memory of one pixel in the internal format, not counting any padding the driver adds.
+	[[nodiscard]] size_t GetPixelSize() const
+	{
+		switch(InternalFormat)
+		{
+			case InternalImageFormat::R8     : return 1;
+			case InternalImageFormat::R16    : return 2;
+			case InternalImageFormat::R32    : return 4;
+			case InternalImageFormat::R16F   : return 2;
+			case InternalImageFormat::R32F   : return 4;
+			case InternalImageFormat::RG8    : return 2;
+			case InternalImageFormat::RG16   : return 4;
+			case InternalImageFormat::RG32   : return 8;
+			case InternalImageFormat::RG16F  : return 4;
+			case InternalImageFormat::RG32F  : return 8;
+			case InternalImageFormat::RGB8   : return 3;
+			case InternalImageFormat::RGB16  : return 6;
+			case InternalImageFormat::RGB32  : return 12;
+			case InternalImageFormat::RGB16F : return 6;
+			case InternalImageFormat::RGB32F : return 12;
+			case InternalImageFormat::RGBA8  : return 4;
+			case InternalImageFormat::RGBA16 : return 8;
+			case InternalImageFormat::RGBA32 : return 16;
+			case InternalImageFormat::RGBA16F: return 8;
+			case InternalImageFormat::RGBA32F: return 16;
+
+			case InternalImageFormat::DepthComponent16 : return 2;
+			case InternalImageFormat::DepthComponent32 : return 4;
+			case InternalImageFormat::DepthComponent32F: return 4;
+		}
+
+		return 0;
+	}
+
+	[[nodiscard]] size_t GetSizeInBytes(uint32_t width, uint32_t height) const { return size_t(width) * height * GetPixelSize(); }
 };
 
 class RenderTarget;
@@ -46,12 +84,14 @@ class RenderTarget
 {
 public:
 	RenderTarget(uint32_t width, uint32_t height, uint32_t colorAttachmentCount, bool hasDepthAttachment) :
-		Width(width), Height(height),
+		ID(s_nextID++), Width(width), Height(height),
 		ColorAttachmentCount(colorAttachmentCount), HasDepthAttachment(hasDepthAttachment),
 		ClearColor(glm::vec4(0.0f, 0.0f, 0.0f, 1.0f)) {}
 
 	virtual ~RenderTarget() = default;
 
+	const uint32_t ID;
+
 	[[nodiscard]] virtual   AttachmentHandle GetColorAttachment(size_t index) const = 0;
 	[[nodiscard]] virtual TextureAtlasHandle GetDepthAttachment()             const = 0;
 
@@ -81,4 +121,31 @@ protected:
 
 	template<ShallowCopyable TElement>
 	friend class RenderStream;
-};
\ No newline at end of file
+
+	template<ShallowCopyable TInstance>
+	friend class RenderQueue;
+
+	friend class CommandList;
+private:
+	inline static uint32_t s_nextID;
+};
+
+// Depth-only render targets that share one texture array, one target per layer. Each layer is drawn into like any
+// other render target, while shaders sample every layer at once through GetDepthAttachment as a sampler2DArray.
+class RenderTargetArray
+{
+public:
+	RenderTargetArray(uint32_t width, uint32_t height, uint32_t layerCount) : Width(width), Height(height), LayerCount(layerCount) {}
+
+	virtual ~RenderTargetArray() = default;
+
+	const uint32_t Width;
+	const uint32_t Height;
+	const uint32_t LayerCount;
+
+	[[nodiscard]] virtual RenderTarget& GetLayer(uint32_t layer) = 0;
+
+	[[nodiscard]] virtual TextureAtlasHandle GetDepthAttachment() const = 0;
+};
+
+using RenderTargetArrayHandle = std::shared_ptr<RenderTargetArray>;
\ No newline at end of file
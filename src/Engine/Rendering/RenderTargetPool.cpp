@@ -0,0 +1,179 @@
+#include "RenderTargetPool.hpp"
+
+#include <numeric>
+#include <algorithm>
+
+#include <Common.hpp>
+
+#include "RenderDevice.hpp"
+
+RenderTargetHandle RenderTargetPool::Acquire(const RenderTargetDescription& description, size_t logicalTargetCount)
+{
+	m_requestedBytes += description.GetSizeInBytes() * logicalTargetCount;
+
+	// The most recently used match is the likeliest to still be resident.
+	Entry* match = nullptr;
+	for(Entry& entry : m_entries)
+	{
+		if(!entry.IsAcquired && entry.Description == description && (!match || entry.LastUsedFrame > match->LastUsedFrame))
+		{
+			match = &entry;
+		}
+	}
+
+	if(!match)
+	{
+		RenderTargetHandle target = m_device.CreateRenderTarget(description.Width, description.Height, description.ColorAttachments, description.DepthAttachment);
+		match = &m_entries.emplace_back(Entry{ description, std::move(target), false, m_frameIndex, 0 });
+	}
+
+	match->IsAcquired         = true;
+	match->LastUsedFrame      = m_frameIndex;
+	match->LogicalTargetCount = logicalTargetCount;
+	return match->Target;
+}
+
+void RenderTargetPool::Release(const RenderTargetHandle& target)
+{
+	auto it = std::find_if(m_entries.begin(), m_entries.end(), [&target](const Entry& entry) { return entry.Target == target; });
+
+	DEBUG_ASSERT(it != m_entries.end() && it->IsAcquired, "The render target was not acquired from this pool.");
+	if(it != m_entries.end())
+	{
+		it->IsAcquired = false;
+	}
+}
+
+void RenderTargetPool::EndFrame()
+{
+	// Targets held since an earlier frame were needed in this one too.
+	for(const Entry& entry : m_entries)
+	{
+		if(entry.IsAcquired && entry.LastUsedFrame != m_frameIndex)
+		{
+			m_requestedBytes += entry.Description.GetSizeInBytes() * entry.LogicalTargetCount;
+		}
+	}
+
+	m_lastFrameRequestedBytes = m_requestedBytes;
+	m_requestedBytes = 0;
+
+	++m_frameIndex;
+
+	std::erase_if(m_entries, [this](const Entry& entry) { return !entry.IsAcquired && m_frameIndex - entry.LastUsedFrame > FramesToKeep; });
+}
+
+RenderTargetPoolStatistics RenderTargetPool::GetStatistics() const
+{
+	RenderTargetPoolStatistics result;
+	result.TargetCount    = m_entries.size();
+	result.RequestedBytes = m_lastFrameRequestedBytes;
+
+	for(const Entry& entry : m_entries)
+	{
+		result.AllocatedBytes += entry.Description.GetSizeInBytes();
+	}
+
+	return result;
+}
+
+size_t TransientRenderTargets::Declare(const RenderTargetDescription& description, uint32_t firstPass, uint32_t lastPass)
+{
+	DEBUG_ASSERT(!m_isAcquired, "Transient render targets cannot be declared while they are acquired.");
+	DEBUG_ASSERT(firstPass <= lastPass, "A transient render target must be written before it is read.");
+
+	m_declarations.push_back({ description, firstPass, lastPass, 0 });
+	m_isCompiled = false;
+	return m_declarations.size() - 1;
+}
+
+void TransientRenderTargets::Reset()
+{
+	DEBUG_ASSERT(!m_isAcquired, "Transient render targets cannot be reset while they are acquired.");
+
+	m_declarations.clear();
+	m_physicalTargets.clear();
+	m_isCompiled = false;
+}
+
+void TransientRenderTargets::Compile()
+{
+	m_physicalTargets.clear();
+
+	std::vector<size_t> order(m_declarations.size());
+	std::iota(order.begin(), order.end(), 0);
+	std::stable_sort(order.begin(), order.end(), [this](size_t left, size_t right) { return m_declarations[left].FirstPass < m_declarations[right].FirstPass; });
+
+	// Interval allocation in order of first use: each target takes the matching physical target that was freed
+	// longest ago, or a new one when every match is still in use.
+	for(const size_t index : order)
+	{
+		Declaration& declaration = m_declarations[index];
+
+		PhysicalTarget* match = nullptr;
+		for(PhysicalTarget& physicalTarget : m_physicalTargets)
+		{
+			if(physicalTarget.LastPass < declaration.FirstPass && physicalTarget.Description == declaration.Description && (!match || physicalTarget.LastPass < match->LastPass))
+			{
+				match = &physicalTarget;
+			}
+		}
+
+		if(!match)
+		{
+			match = &m_physicalTargets.emplace_back(PhysicalTarget{ declaration.Description, 0, 0, nullptr });
+		}
+
+		match->LastPass = declaration.LastPass;
+		match->DeclarationCount++;
+		declaration.PhysicalIndex = size_t(match - m_physicalTargets.data());
+	}
+
+	m_isCompiled = true;
+}
+
+void TransientRenderTargets::Acquire(RenderTargetPool& pool)
+{
+	DEBUG_ASSERT(!m_isAcquired, "Transient render targets are already acquired.");
+
+	if(!m_isCompiled)
+	{
+		Compile();
+	}
+
+	for(PhysicalTarget& physicalTarget : m_physicalTargets)
+	{
+		physicalTarget.Target = pool.Acquire(physicalTarget.Description, physicalTarget.DeclarationCount);
+	}
+
+	m_isAcquired = true;
+}
+
+void TransientRenderTargets::Release(RenderTargetPool& pool)
+{
+	DEBUG_ASSERT(m_isAcquired, "Transient render targets are not acquired.");
+
+	for(PhysicalTarget& physicalTarget : m_physicalTargets)
+	{
+		pool.Release(physicalTarget.Target);
+		physicalTarget.Target = nullptr;
+	}
+
+	m_isAcquired = false;
+}
+
+const RenderTargetHandle& TransientRenderTargets::Get(size_t index) const
+{
+	DEBUG_ASSERT(m_isAcquired, "Transient render targets are only valid between Acquire and Release.");
+	return m_physicalTargets[m_declarations[index].PhysicalIndex].Target;
+}
+
+size_t TransientRenderTargets::GetPhysicalCount()
+{
+	if(!m_isCompiled)
+	{
+		Compile();
+	}
+
+	return m_physicalTargets.size();
+}
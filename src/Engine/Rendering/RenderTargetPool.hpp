@@ -0,0 +1,138 @@
+#pragma once
+
+#include <vector>
+#include <optional>
+#include <cstdint>
+
+#include "RenderTarget.hpp"
+
+class RenderDevice;
+
+struct RenderTargetDescription
+{
+	RenderTargetDescription(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, const std::optional<AttachmentInfo>& depthAttachment = {}) :
+		Width(width), Height(height), ColorAttachments(colorAttachments), DepthAttachment(depthAttachment) {}
+
+	uint32_t Width;
+	uint32_t Height;
+
+	std::vector<AttachmentInfo>   ColorAttachments;
+	std::optional<AttachmentInfo> DepthAttachment;
+
+	bool operator==(const RenderTargetDescription& other) const = default;
+
+	[[nodiscard]] size_t GetSizeInBytes() const
+	{
+		size_t result = DepthAttachment ? DepthAttachment->GetSizeInBytes(Width, Height) : 0;
+		for(const AttachmentInfo& attachment : ColorAttachments)
+		{
+			result += attachment.GetSizeInBytes(Width, Height);
+		}
+		return result;
+	}
+};
+
+struct RenderTargetPoolStatistics
+{
+	// Targets the pool holds, handed out or not, and their video memory.
+	size_t TargetCount    = 0;
+	size_t AllocatedBytes = 0;
+
+	// Video memory the targets handed out during the last finished frame, or still held from an earlier one, would
+	// take if each had been its own.
+	size_t RequestedBytes = 0;
+
+	[[nodiscard]] size_t GetSavedBytes() const { return RequestedBytes > AllocatedBytes ? RequestedBytes - AllocatedBytes : 0; }
+};
+
+// Render targets that only live for part of a frame, keyed by size and attachment formats. A target released by one
+// pass is handed to the next pass acquiring the same description, so passes that never run at the same time share
+// memory. The contents of an acquired target are undefined until it is cleared or drawn over.
+class RenderTargetPool
+{
+public:
+	explicit RenderTargetPool(RenderDevice& device, uint32_t framesToKeep = 3) : FramesToKeep(framesToKeep), m_device(device), m_frameIndex(0), m_requestedBytes(0), m_lastFrameRequestedBytes(0) {}
+
+	RenderTargetPool(const RenderTargetPool&) = delete;
+	RenderTargetPool& operator=(const RenderTargetPool&) = delete;
+
+	// Free targets unused for this many frames are destroyed.
+	const uint32_t FramesToKeep;
+
+	// logicalTargetCount is how many targets the acquired one stands in for, for callers that alias several of their
+	// own targets onto one; it only affects the statistics.
+	[[nodiscard]] RenderTargetHandle Acquire(const RenderTargetDescription& description, size_t logicalTargetCount = 1);
+
+	void Release(const RenderTargetHandle& target);
+
+	// Called once per presented frame.
+	void EndFrame();
+
+	[[nodiscard]] RenderTargetPoolStatistics GetStatistics() const;
+private:
+	struct Entry
+	{
+		RenderTargetDescription Description;
+		RenderTargetHandle      Target;
+		bool                    IsAcquired;
+		uint64_t                LastUsedFrame;
+		size_t                  LogicalTargetCount;
+	};
+
+	RenderDevice& m_device;
+
+	std::vector<Entry> m_entries;
+
+	uint64_t m_frameIndex;
+
+	size_t m_requestedBytes;
+	size_t m_lastFrameRequestedBytes;
+};
+
+// Render-graph-style lifetime analysis for the targets of a fixed sequence of passes. Each target is declared with the
+// first pass that writes it and the last pass that reads it; targets with the same description whose pass ranges do
+// not overlap are aliased onto one physical target from the pool.
+class TransientRenderTargets
+{
+public:
+	TransientRenderTargets() : m_isCompiled(false), m_isAcquired(false) {}
+
+	// Returns the index Get takes.
+	size_t Declare(const RenderTargetDescription& description, uint32_t firstPass, uint32_t lastPass);
+
+	// Removes every declaration.
+	void Reset();
+
+	// Acquires the physical targets for one frame, planning them first if declarations changed.
+	void Acquire(RenderTargetPool& pool);
+	void Release(RenderTargetPool& pool);
+
+	[[nodiscard]] const RenderTargetHandle& Get(size_t index) const;
+
+	[[nodiscard]] size_t GetDeclaredCount() const { return m_declarations.size(); }
+	[[nodiscard]] size_t GetPhysicalCount();
+private:
+	struct Declaration
+	{
+		RenderTargetDescription Description;
+		uint32_t FirstPass;
+		uint32_t LastPass;
+		size_t   PhysicalIndex;
+	};
+
+	struct PhysicalTarget
+	{
+		RenderTargetDescription Description;
+		uint32_t                LastPass;
+		size_t                  DeclarationCount;
+		RenderTargetHandle      Target;
+	};
+
+	std::vector<Declaration>    m_declarations;
+	std::vector<PhysicalTarget> m_physicalTargets;
+
+	bool m_isCompiled;
+	bool m_isAcquired;
+
+	void Compile();
+};
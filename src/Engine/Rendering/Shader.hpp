@@ -2,6 +2,8 @@
 
 #include <Reflection.hpp>
 
+#include <span>
+#include <concepts>
 #include <utility>
 #include <vector>
 
@@ -16,31 +18,161 @@ struct Uniform
     TypeInfo* const   Type;
 };
 
+// A uniform location resolved once through Shader::GetUniform; invalid when the shader has no such uniform.
+template<typename TValue>
+class UniformHandle
+{
+public:
+    UniformHandle() : Location(-1) {}
+
+    explicit UniformHandle(int32_t location) : Location(location) {}
+
+    int32_t Location;
+
+    [[nodiscard]] bool IsValid() const { return Location >= 0; }
+};
+
+// One member of a packed struct uploaded by Shader::SetUniforms, described the way GetUniforms reports a Uniform.
+struct UniformField
+{
+    UniformField(std::string_view name, TypeInfo* type, size_t offset) :
+        Name(name), Type(type), Offset(offset) {}
+
+    template<typename TStruct, typename TMember>
+    UniformField(std::string_view name, TMember TStruct::* member) :
+        Name(name), Type(TypeInfo::Get<TMember>()), Offset(GetOffset(member)) {}
+
+    std::string_view Name;
+    TypeInfo*        Type;
+    size_t           Offset;
+private:
+    template<typename TStruct, typename TMember>
+    static size_t GetOffset(TMember TStruct::* member)
+    {
+        alignas(TStruct) const std::byte storage[sizeof(TStruct)] = {};
+        const auto* object = reinterpret_cast<const TStruct*>(storage);
+        return reinterpret_cast<const std::byte*>(&(object->*member)) - storage;
+    }
+};
+
+// The fields of a packed struct resolved against one shader. Fields the shader does not use are dropped.
+class UniformBlock
+{
+public:
+    struct Entry
+    {
+        TypeInfo* Type;
+        int32_t   Location;
+        size_t    Offset;
+    };
+
+    UniformBlock() : ShaderID(UINT32_MAX) {}
+
+    UniformBlock(uint32_t shaderID, std::vector<Entry> entries) : ShaderID(shaderID), m_entries(std::move(entries)) {}
+
+    uint32_t ShaderID;
+
+    [[nodiscard]] const std::vector<Entry>& GetEntries() const { return m_entries; }
+private:
+    std::vector<Entry> m_entries;
+};
+
 class Shader
 {
 public:
-    explicit Shader(std::string_view sourceCode) : SourceCode(sourceCode) {}
+    explicit Shader(std::string_view sourceCode) : ID(s_nextID++), SourceCode(sourceCode) {}
 
     virtual ~Shader() = default;
 
+    const uint32_t ID;
+
     const std::string SourceCode;
 
     virtual void GetUniforms(std::vector<Uniform>& uniforms) = 0;
 
     virtual void SetUniform(TypeInfo* type, std::string_view name, const void* data) = 0;
 
-    template<typename TValue>
+    template<typename TValue> requires (!std::convertible_to<TValue, TextureAtlasHandle>)
     void SetUniform(std::string_view name, const TValue& value)
     {
         SetUniform(TypeInfo::Get<TValue>(), name, static_cast<const void*>(&value));
     }
 
+    // Textures stay set until replaced and are bound to their units whenever the shader is used.
     virtual void SetUniform(std::string_view name, const TextureHandle& texture) = 0;
 
+    // Render target attachments and other whole textures.
+    void SetUniform(std::string_view name, const TextureAtlasHandle& texture)
+    {
+        SetUniform(name, TextureHandle(texture));
+    }
+
+    // Returns -1 when the shader has no active uniform of that name and type.
+    virtual int32_t GetUniformLocation(TypeInfo* type, std::string_view name) = 0;
+
+    virtual void SetUniform(TypeInfo* type, int32_t location, const void* data) = 0;
+
+    template<typename TValue>
+    [[nodiscard]] UniformHandle<TValue> GetUniform(std::string_view name)
+    {
+        return UniformHandle<TValue>(GetUniformLocation(TypeInfo::Get<TValue>(), name));
+    }
+
+    template<typename TValue>
+    void SetUniform(const UniformHandle<TValue>& uniform, const TValue& value)
+    {
+        if(uniform.IsValid())
+        {
+            SetUniform(TypeInfo::Get<TValue>(), uniform.Location, static_cast<const void*>(&value));
+        }
+    }
+
+    [[nodiscard]] UniformBlock GetUniformBlock(std::span<const UniformField> fields)
+    {
+        std::vector<UniformBlock::Entry> entries;
+        entries.reserve(fields.size());
+        for(const UniformField& field : fields)
+        {
+            const int32_t location = GetUniformLocation(field.Type, field.Name);
+            if(location >= 0)
+            {
+                entries.push_back({ field.Type, location, field.Offset });
+            }
+        }
+        return UniformBlock(ID, std::move(entries));
+    }
+
+    [[nodiscard]] UniformBlock GetUniformBlock(std::initializer_list<UniformField> fields)
+    {
+        return GetUniformBlock(std::span<const UniformField>(fields.begin(), fields.size()));
+    }
+
+    virtual void SetUniforms(const UniformBlock& block, const void* data)
+    {
+        DEBUG_ASSERT(block.ShaderID == ID, "Uniform block was resolved against another shader.");
+        for(const UniformBlock::Entry& entry : block.GetEntries())
+        {
+            SetUniform(entry.Type, entry.Location, static_cast<const std::byte*>(data) + entry.Offset);
+        }
+    }
+
+    template<ShallowCopyable TStruct> requires (!std::is_pointer_v<TStruct>)
+    void SetUniforms(const UniformBlock& block, const TStruct& data)
+    {
+        SetUniforms(block, static_cast<const void*>(&data));
+    }
+
     template<ShallowCopyable TElement>
     friend class RenderStream;
+
+    template<ShallowCopyable TInstance>
+    friend class RenderQueue;
+
+    friend class CommandList;
 protected:
     virtual void Use() = 0;
+private:
+    inline static uint32_t s_nextID;
 };
 
 using ShaderHandle = std::shared_ptr<Shader>;
@@ -0,0 +1,106 @@
+#include "ShadowCascades.hpp"
+
+#include <cmath>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+// Distance along the view direction of the point the inverse projection maps the given NDC depth to.
+static float GetViewDistance(const glm::mat4& inverseProjection, float ndcDepth)
+{
+	const glm::vec4 point = inverseProjection * glm::vec4(0.0f, 0.0f, ndcDepth, 1.0f);
+	return -point.z / point.w;
+}
+
+float GetCascadeSplitDistance(float nearDistance, float farDistance, uint32_t index, uint32_t cascadeCount, float splitBlend)
+{
+	const float fraction = float(index + 1) / float(cascadeCount);
+
+	const float logarithmicSplit = nearDistance * std::pow(farDistance / nearDistance, fraction);
+	const float     uniformSplit = nearDistance + (farDistance - nearDistance) * fraction;
+
+	return glm::mix(uniformSplit, logarithmicSplit, splitBlend);
+}
+
+void ComputeShadowCascades(const glm::mat4& cameraView, const glm::mat4& cameraProjection, const glm::vec3& lightDirection,
+                           float shadowDistance, float splitBlend, float casterDistance, uint32_t resolution, std::span<ShadowCascade> cascades)
+{
+	const glm::mat4 inverseProjection = glm::inverse(cameraProjection);
+
+	const float cameraNear = GetViewDistance(inverseProjection, -1.0f);
+	const float cameraFar  = GetViewDistance(inverseProjection,  1.0f);
+	const float farDistance = std::min(cameraFar, cameraNear + shadowDistance);
+
+	// Frustum corners in view space; a slice's corners lie on the edges between the near and far ones, and view
+	// depth changes linearly along each edge. The slices are bounded in view space too, so their spheres come out the
+	// same every frame the projection stays the same, however the camera moves.
+	glm::vec3 nearCorners[4];
+	glm::vec3  farCorners[4];
+	for(int i = 0; i < 4; i++)
+	{
+		const glm::vec2 ndc((i & 1) ? 1.0f : -1.0f, (i & 2) ? 1.0f : -1.0f);
+
+		const glm::vec4 nearCorner = inverseProjection * glm::vec4(ndc, -1.0f, 1.0f);
+		const glm::vec4  farCorner = inverseProjection * glm::vec4(ndc,  1.0f, 1.0f);
+
+		nearCorners[i] = glm::vec3(nearCorner) / nearCorner.w;
+		 farCorners[i] = glm::vec3( farCorner) /  farCorner.w;
+	}
+
+	const glm::mat4 inverseView = glm::inverse(cameraView);
+
+	const glm::vec3 direction = glm::normalize(lightDirection);
+	const glm::vec3 up = std::abs(direction.y) > 0.99f ? glm::vec3(0.0f, 0.0f, 1.0f) : glm::vec3(0.0f, 1.0f, 0.0f);
+
+	const auto cascadeCount = static_cast<uint32_t>(cascades.size());
+
+	float sliceStart = cameraNear;
+	for(uint32_t index = 0; index < cascadeCount; index++)
+	{
+		const float sliceEnd = GetCascadeSplitDistance(cameraNear, farDistance, index, cascadeCount, splitBlend);
+
+		const float startFraction = (sliceStart - cameraNear) / (cameraFar - cameraNear);
+		const float   endFraction = (sliceEnd   - cameraNear) / (cameraFar - cameraNear);
+
+		glm::vec3 corners[8];
+		glm::vec3 center(0.0f);
+		for(int i = 0; i < 4; i++)
+		{
+			corners[i * 2    ] = glm::mix(nearCorners[i], farCorners[i], startFraction);
+			corners[i * 2 + 1] = glm::mix(nearCorners[i], farCorners[i],   endFraction);
+
+			center += corners[i * 2] + corners[i * 2 + 1];
+		}
+		center /= 8.0f;
+
+		float radius = 0.0f;
+		for(const glm::vec3& corner : corners)
+		{
+			radius = std::max(radius, glm::distance(center, corner));
+		}
+
+		// Rounded up so floating point noise in the corners cannot change the cascade's texel size.
+		radius = std::ceil(radius * 16.0f) / 16.0f;
+
+		const glm::vec3 worldCenter = glm::vec3(inverseView * glm::vec4(center, 1.0f));
+
+		const glm::mat4 view = glm::lookAt(worldCenter, worldCenter + direction, up);
+		glm::mat4 projection = glm::ortho(-radius, radius, -radius, radius, -radius - casterDistance, radius);
+
+		// Moves the cascade by less than a texel so the world origin, and with it every static caster, always lands
+		// on the same position within a texel.
+		const float halfResolution = float(resolution) * 0.5f;
+
+		const glm::vec4 origin = projection * view * glm::vec4(0.0f, 0.0f, 0.0f, 1.0f);
+		const glm::vec2 texelOrigin = glm::vec2(origin) * halfResolution;
+		const glm::vec2 offset = (glm::round(texelOrigin) - texelOrigin) / halfResolution;
+
+		projection[3][0] += offset.x;
+		projection[3][1] += offset.y;
+
+		cascades[index].ViewProjection = projection * view;
+		cascades[index].SplitDistance  = sliceEnd;
+
+		sliceStart = sliceEnd;
+	}
+}
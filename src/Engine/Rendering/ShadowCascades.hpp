@@ -0,0 +1,28 @@
+#pragma once
+
+#include <span>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// Most cascades a light can have; the light shaders declare u_cascadeMatrices with this many entries.
+static constexpr uint32_t MaxShadowCascades = 4;
+
+struct ShadowCascade
+{
+	glm::mat4 ViewProjection = glm::mat4(1.0f);
+
+	// View-space distance from the camera at which the cascade ends.
+	float SplitDistance = 0.0f;
+};
+
+// Distance at which cascade index of cascadeCount ends. splitBlend mixes logarithmic splits (1), which match the
+// perspective's texel density, with uniform splits (0), which keep the near cascades from getting too small.
+float GetCascadeSplitDistance(float nearDistance, float farDistance, uint32_t index, uint32_t cascadeCount, float splitBlend);
+
+// Fits one orthographic cascade per element of cascades to consecutive slices of the camera frustum, up to
+// shadowDistance from the camera. Each cascade bounds its slice with a sphere, so its size does not change as the
+// camera turns, and its origin is snapped to whole shadow map texels, so static shadows do not shimmer as the camera
+// moves. casterDistance extends every cascade towards the light to catch casters outside the frustum.
+void ComputeShadowCascades(const glm::mat4& cameraView, const glm::mat4& cameraProjection, const glm::vec3& lightDirection,
+                           float shadowDistance, float splitBlend, float casterDistance, uint32_t resolution, std::span<ShadowCascade> cascades);
@@ -0,0 +1,183 @@
+#pragma once
+
+#include <cmath>
+#include <algorithm>
+#include <vector>
+#include <concepts>
+#include <unordered_map>
+
+#include <glm/glm.hpp>
+
+#include "Mesh.hpp"
+#include "../Core/Scene.hpp"
+#include "../EngineComponents/Transformation.hpp"
+#include "../EngineComponents/RenderableMesh.hpp"
+#include "../EngineComponents/CullableComponent.hpp"
+#include "../EngineComponents/OccluderComponent.hpp"
+
+// Merges static geometry that shares a material into one mesh per ChunkSize x ChunkSize square of the xz plane. A
+// level made of many small pieces then draws as a handful of meshes, while each chunk keeps bounds tight enough for
+// frustum, portal and shadow culling to skip it. Triangles go to the chunk containing their centroid.
+template<HasLayout TVertex, ShallowCopyable TMaterial> requires std::same_as<decltype(TVertex::Position), glm::vec3> && std::equality_comparable<TMaterial>
+class StaticBatcher
+{
+public:
+	struct Chunk
+	{
+		Chunk(const TMaterial& material, const glm::ivec2& coordinates) : Material(material), Coordinates(coordinates), Center(0.0f) {}
+
+		TMaterial  Material;
+		glm::ivec2 Coordinates;
+
+		// Vertices are relative to Center, so the chunk's entity is placed there and culls around it.
+		glm::vec3             Center;
+		std::vector<TVertex>  Vertices;
+		std::vector<uint32_t> Indices;
+	};
+
+	explicit StaticBatcher(float chunkSize = 32.0f) : ChunkSize(chunkSize), m_sourceCount(0) {}
+
+	const float ChunkSize;
+
+	// Adds a mesh in world space, transformed by modelMatrix.
+	void Add(const std::vector<TVertex>& vertices, const std::vector<uint32_t>& indices, const TMaterial& material, const glm::mat4& modelMatrix = glm::mat4(1.0f))
+	{
+		const glm::mat3 normalMatrix = glm::transpose(glm::inverse(glm::mat3(modelMatrix)));
+
+		std::vector<TVertex> transformed(vertices);
+		for(TVertex& vertex : transformed)
+		{
+			vertex.Position = glm::vec3(modelMatrix * glm::vec4(vertex.Position, 1.0f));
+
+			if constexpr(requires { requires std::same_as<decltype(TVertex::Normal), glm::vec3>; })
+			{
+				vertex.Normal = glm::normalize(normalMatrix * vertex.Normal);
+			}
+
+			if constexpr(requires { requires std::same_as<decltype(TVertex::Tangent), glm::vec3>; })
+			{
+				if(vertex.Tangent != glm::vec3(0.0f))
+				{
+					vertex.Tangent = glm::normalize(glm::mat3(modelMatrix) * vertex.Tangent);
+				}
+			}
+		}
+
+		// Source vertex index to chunk vertex index, per chunk the mesh touches.
+		std::unordered_map<size_t, std::vector<uint32_t>> remaps;
+
+		for(size_t i = 0; i + 2 < indices.size(); i += 3)
+		{
+			const glm::vec3 centroid = (transformed[indices[i]].Position + transformed[indices[i + 1]].Position + transformed[indices[i + 2]].Position) / 3.0f;
+
+			const size_t chunkIndex = GetChunkIndex(material, glm::ivec2(glm::floor(glm::vec2(centroid.x, centroid.z) / ChunkSize)));
+			Chunk& chunk = m_chunks[chunkIndex];
+
+			std::vector<uint32_t>& remap = remaps[chunkIndex];
+			if(remap.empty())
+			{
+				remap.resize(transformed.size(), UINT32_MAX);
+			}
+
+			for(size_t corner = 0; corner < 3; corner++)
+			{
+				const uint32_t sourceIndex = indices[i + corner];
+				if(remap[sourceIndex] == UINT32_MAX)
+				{
+					remap[sourceIndex] = static_cast<uint32_t>(chunk.Vertices.size());
+					chunk.Vertices.push_back(transformed[sourceIndex]);
+				}
+
+				chunk.Indices.push_back(remap[sourceIndex]);
+			}
+		}
+
+		++m_sourceCount;
+	}
+
+	// Number of meshes added; each would have been a draw of its own.
+	[[nodiscard]] size_t GetSourceCount() const { return m_sourceCount; }
+
+	// Recentres every chunk on its bounds and hands the chunks over, leaving the batcher empty.
+	[[nodiscard]] std::vector<Chunk> Build()
+	{
+		std::vector<Chunk> result;
+		result.reserve(m_chunks.size());
+
+		for(Chunk& chunk : m_chunks)
+		{
+			glm::vec3 minimum = chunk.Vertices[0].Position;
+			glm::vec3 maximum = chunk.Vertices[0].Position;
+			for(const TVertex& vertex : chunk.Vertices)
+			{
+				minimum = glm::min(minimum, vertex.Position);
+				maximum = glm::max(maximum, vertex.Position);
+			}
+
+			chunk.Center = (minimum + maximum) * 0.5f;
+			for(TVertex& vertex : chunk.Vertices)
+			{
+				vertex.Position -= chunk.Center;
+			}
+
+			result.push_back(std::move(chunk));
+		}
+
+		m_chunks.clear();
+		m_chunkIndices.clear();
+		m_sourceCount = 0;
+		return result;
+	}
+
+	// Builds the chunks and creates an entity with a static RenderableMesh for each. Chunks can also be made occluders,
+	// since level geometry is usually what hides everything else.
+	std::vector<ECS::Entity> CreateEntities(Scene& scene, bool occluders = false)
+	{
+		std::vector<ECS::Entity> result;
+
+		for(const Chunk& chunk : Build())
+		{
+			const Model model(chunk.Vertices, chunk.Indices);
+
+			RenderableMesh renderableMesh(scene.CreateMesh(model), chunk.Material);
+			renderableMesh.Static = true;
+
+			ECS::Entity entity = scene.CreateEntity(Transformation(chunk.Center), renderableMesh, CullableComponent(glm::length(model.Bounds.Size()) * 0.5f));
+			if(occluders)
+			{
+				entity.AddComponent<OccluderComponent>(std::make_shared<OccluderMesh>(chunk.Vertices, chunk.Indices));
+			}
+
+			result.push_back(entity);
+		}
+
+		return result;
+	}
+private:
+	std::vector<Chunk> m_chunks;
+
+	// Chunks of the same material are looked up by packed coordinates. Materials are compared with operator== rather
+	// than by their bytes, which would include padding.
+	std::vector<std::pair<TMaterial, std::unordered_map<uint64_t, size_t>>> m_chunkIndices;
+
+	size_t m_sourceCount;
+
+	size_t GetChunkIndex(const TMaterial& material, const glm::ivec2& coordinates)
+	{
+		auto materialIt = std::find_if(m_chunkIndices.begin(), m_chunkIndices.end(), [&material](const auto& entry) { return entry.first == material; });
+		if(materialIt == m_chunkIndices.end())
+		{
+			materialIt = m_chunkIndices.emplace(m_chunkIndices.end(), material, std::unordered_map<uint64_t, size_t>());
+		}
+
+		const uint64_t key = (uint64_t(uint32_t(coordinates.x)) << 32) | uint32_t(coordinates.y);
+
+		auto [ it, inserted ] = materialIt->second.try_emplace(key, m_chunks.size());
+		if(inserted)
+		{
+			m_chunks.emplace_back(material, coordinates);
+		}
+
+		return it->second;
+	}
+};
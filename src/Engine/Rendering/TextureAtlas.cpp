@@ -4,5 +4,9 @@
 
 TextureAtlas::~TextureAtlas()
 {
-    m_renderDevice->DeleteTexture(m_bindingIndex);
+    // Textures that were never bound have no slot to release.
+    if(m_renderDevice)
+    {
+        m_renderDevice->DeleteTexture(m_bindingIndex);
+    }
 }
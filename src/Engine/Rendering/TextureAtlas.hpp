@@ -266,6 +266,8 @@ struct Rectangle
 
 	glm::vec2 Offset;
 	glm::vec2 Size;
+
+	bool operator==(const Rectangle& other) const = default;
 };
 
 class RenderDevice;
@@ -291,6 +293,7 @@ protected:
 	virtual void Bind(uint32_t bindingIndex) = 0;
 
 	friend class RenderDevice;
+	friend class OpenGLShader;
 private:
 	uint32_t m_bindingIndex;
 	RenderDevice* m_renderDevice;
@@ -302,7 +305,7 @@ using TextureAtlasHandle = std::shared_ptr<TextureAtlas>;
 class TextureHandle
 {
 public:
-	explicit TextureHandle(TextureAtlasHandle atlas) : Atlas(std::move(atlas)), Region(Rectangle(glm::vec2(0), atlas->Size)) {}
+	explicit TextureHandle(TextureAtlasHandle atlas) : Atlas(std::move(atlas)), Region(Rectangle(glm::vec2(0), Atlas->Size)) {}
 
 	TextureHandle(TextureAtlasHandle atlas, const Rectangle& region) :
 		Atlas(std::move(atlas)),
@@ -0,0 +1,56 @@
+#pragma once
+
+#include <vector>
+#include <cstdint>
+
+#include <ECS/Entity.hpp>
+
+// Per-entity visibility written by a culling pass and read by the renderer systems. Entities the culling pass
+// never classified are treated as visible.
+class VisibilitySet
+{
+public:
+	VisibilitySet() : m_visibleCount(0), m_hiddenCount(0) {}
+
+	void Clear()
+	{
+		m_states.assign(m_states.size(), State::Unknown);
+		m_visibleCount = 0;
+		m_hiddenCount  = 0;
+	}
+
+	void Set(const ECS::Entity& entity, bool visible)
+	{
+		const size_t index = entity.GetIndex();
+		if(index >= m_states.size())
+		{
+			m_states.resize(index + 1, State::Unknown);
+		}
+
+		m_states[index] = visible ? State::Visible : State::Hidden;
+		++(visible ? m_visibleCount : m_hiddenCount);
+	}
+
+	[[nodiscard]] bool IsVisible(const ECS::Entity& entity) const
+	{
+		const size_t index = entity.GetIndex();
+		return index >= m_states.size() || m_states[index] != State::Hidden;
+	}
+
+	[[nodiscard]] size_t VisibleCount() const { return m_visibleCount; }
+	[[nodiscard]] size_t  HiddenCount() const { return m_hiddenCount;  }
+private:
+	enum class State : uint8_t
+	{
+		Unknown,
+		Visible,
+		Hidden,
+	};
+
+	std::vector<State> m_states;
+
+	size_t m_visibleCount;
+	size_t m_hiddenCount;
+};
+
+using VisibilitySetHandle = std::shared_ptr<VisibilitySet>;
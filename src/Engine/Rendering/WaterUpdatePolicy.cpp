@@ -0,0 +1,106 @@
+#include "WaterUpdatePolicy.hpp"
+
+#include <bit>
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+// Sutherland-Hodgman against one clip-space frustum plane, kept where dot(plane, vertex) >= 0.
+static void ClipPolygon(std::vector<glm::vec4>& polygon, std::vector<glm::vec4>& scratch, const glm::vec4& plane)
+{
+	scratch.clear();
+	for(size_t i = 0; i < polygon.size(); i++)
+	{
+		const glm::vec4& current = polygon[i];
+		const glm::vec4& next    = polygon[(i + 1) % polygon.size()];
+
+		const float currentDistance = glm::dot(plane, current);
+		const float nextDistance    = glm::dot(plane, next);
+
+		if(currentDistance >= 0.0f)
+		{
+			scratch.push_back(current);
+		}
+
+		if((currentDistance >= 0.0f) != (nextDistance >= 0.0f))
+		{
+			scratch.push_back(glm::mix(current, next, currentDistance / (currentDistance - nextDistance)));
+		}
+	}
+	polygon.swap(scratch);
+}
+
+WaterScreenCoverage ComputeWaterScreenCoverage(const glm::mat4& worldMatrix, const glm::mat4& viewProjection, const glm::vec3& cameraPosition)
+{
+	WaterScreenCoverage result;
+
+	const glm::mat4 wvpMatrix = viewProjection * worldMatrix;
+
+	std::vector<glm::vec4> polygon =
+	{
+		wvpMatrix * glm::vec4(-1, 0, -1, 1),
+		wvpMatrix * glm::vec4( 1, 0, -1, 1),
+		wvpMatrix * glm::vec4( 1, 0,  1, 1),
+		wvpMatrix * glm::vec4(-1, 0,  1, 1),
+	};
+
+	static const glm::vec4 planes[] =
+	{
+		glm::vec4( 1,  0,  0, 1), glm::vec4(-1,  0,  0, 1),
+		glm::vec4( 0,  1,  0, 1), glm::vec4( 0, -1,  0, 1),
+		glm::vec4( 0,  0,  1, 1), glm::vec4( 0,  0, -1, 1),
+	};
+
+	std::vector<glm::vec4> scratch;
+	for(const glm::vec4& plane : planes)
+	{
+		ClipPolygon(polygon, scratch, plane);
+		if(polygon.size() < 3)
+		{
+			return result;
+		}
+	}
+
+	// Shoelace formula over the clipped polygon in normalized device coordinates, where the screen is 2 by 2.
+	float area = 0.0f;
+	for(size_t i = 0; i < polygon.size(); i++)
+	{
+		const glm::vec2 current = glm::vec2(polygon[i]) / polygon[i].w;
+		const glm::vec2 next    = glm::vec2(polygon[(i + 1) % polygon.size()]) / polygon[(i + 1) % polygon.size()].w;
+		area += current.x * next.y - next.x * current.y;
+	}
+
+	result.IsVisible = true;
+	result.Coverage  = std::min(std::abs(area) * 0.5f / 4.0f, 1.0f);
+
+	// Nearest point of the quad, found along its own axes so a plane scaled flat to zero height still works.
+	const glm::vec3 origin = glm::vec3(worldMatrix[3]);
+	const glm::vec3 axisX  = glm::vec3(worldMatrix[0]);
+	const glm::vec3 axisZ  = glm::vec3(worldMatrix[2]);
+
+	const glm::vec3 offset = cameraPosition - origin;
+
+	const float x = glm::dot(axisX, axisX) > 0.0f ? std::clamp(glm::dot(offset, axisX) / glm::dot(axisX, axisX), -1.0f, 1.0f) : 0.0f;
+	const float z = glm::dot(axisZ, axisZ) > 0.0f ? std::clamp(glm::dot(offset, axisZ) / glm::dot(axisZ, axisZ), -1.0f, 1.0f) : 0.0f;
+
+	result.Distance = glm::distance(cameraPosition, origin + axisX * x + axisZ * z);
+	return result;
+}
+
+uint32_t WaterUpdatePolicy::GetResolution(const WaterScreenCoverage& coverage, uint32_t screenHeight, uint32_t currentResolution) const
+{
+	float size = float(std::min(MaximumResolution, std::bit_ceil(screenHeight))) * std::sqrt(coverage.Coverage);
+	if(coverage.Distance > FullResolutionDistance)
+	{
+		size *= FullResolutionDistance / coverage.Distance;
+	}
+
+	const float sizeLog = std::log2(std::max(size, 1.0f));
+	if(currentResolution > 0 && std::abs(sizeLog - std::log2(float(currentResolution))) < 0.5f + ResolutionHysteresis)
+	{
+		return std::clamp(currentResolution, MinimumResolution, MaximumResolution);
+	}
+
+	const uint32_t result = 1u << uint32_t(std::round(sizeLog));
+	return std::clamp(result, MinimumResolution, MaximumResolution);
+}
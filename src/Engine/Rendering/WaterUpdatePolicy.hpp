@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+// Where a water plane is on screen this frame. The plane is the quad from -1 to 1 along x and z of its world matrix,
+// clipped against the view frustum.
+struct WaterScreenCoverage
+{
+	// False when no part of the plane is inside the view frustum.
+	bool IsVisible = false;
+
+	// Fraction of the screen the plane covers, from 0 to 1.
+	float Coverage = 0.0f;
+
+	// From the camera to the nearest point of the plane.
+	float Distance = 0.0f;
+};
+
+WaterScreenCoverage ComputeWaterScreenCoverage(const glm::mat4& worldMatrix, const glm::mat4& viewProjection, const glm::vec3& cameraPosition);
+
+// How often and how large a water plane re-renders its reflection and refraction textures. Between updates the plane
+// keeps drawing with the textures of the last one.
+struct WaterUpdatePolicy
+{
+	static constexpr uint64_t NeverUpdated = UINT64_MAX;
+
+	// Re-renders every FrameInterval frames; 1 re-renders every frame.
+	uint32_t FrameInterval = 1;
+
+	uint32_t MinimumResolution = 128;
+	uint32_t MaximumResolution = 1024;
+
+	// A plane covering the whole screen gets the maximum resolution up to this distance, beyond which the
+	// resolution halves every time the distance doubles.
+	float FullResolutionDistance = 8.0f;
+
+	// How far past the halfway point to the next power of two, in fractions of a doubling, the wanted size has to move
+	// before a plane leaves its current resolution. Stops a plane near a boundary flipping between two sizes.
+	float ResolutionHysteresis = 0.25f;
+
+	[[nodiscard]] bool IsDue(uint64_t frameIndex, uint64_t lastUpdateFrame) const
+	{
+		return lastUpdateFrame == NeverUpdated || frameIndex - lastUpdateFrame >= FrameInterval;
+	}
+
+	// Scales with the square root of the coverage, since the textures are sampled across the part of the screen the
+	// plane covers. Rounded to a power of two, and kept at currentResolution until the wanted size is past
+	// ResolutionHysteresis, so the textures are not reallocated as the camera moves a little. A currentResolution of 0
+	// means the plane has no textures yet.
+	[[nodiscard]] uint32_t GetResolution(const WaterScreenCoverage& coverage, uint32_t screenHeight, uint32_t currentResolution = 0) const;
+};
@@ -1,11 +1,14 @@
-#version 330
+#version 420
 
 in vec2 v_position;
 
-uniform vec3  u_color;
-uniform float u_intensity;
-
-uniform vec3 u_cameraPosition;
+// LightConstants in LightComponent.hpp, uploaded once per light.
+layout(std140, binding = 2) uniform LightConstants
+{
+	vec4 colorIntensity;
+	vec4 attenuation; // constant, linear, exponent, range
+	vec4 cone;        // cutoff, shadow softness
+} u_light;
 
 uniform sampler2D u_albedoTexture;
 uniform sampler2D u_normalTexture;
@@ -17,6 +20,6 @@ out vec4 o_color;
 void main()
 {
 	vec4 texColor   = texture(u_albedoTexture, v_position);
-	vec4 lightColor = vec4(u_color, 1.0) * u_intensity;
+	vec4 lightColor = vec4(u_light.colorIntensity.rgb, 1.0) * u_light.colorIntensity.a;
 	o_color = texColor * lightColor;
 }
\ No newline at end of file
@@ -1,43 +1,89 @@
-#version 330
+#version 420
 
 in vec2 v_position;
 in vec3 v_lightDirection;
-in mat4 v_lightMatrix;
 
-uniform vec3  u_color;
-uniform float u_intensity;
-uniform float u_shadowSoftness;
-
-uniform vec3 u_cameraPosition;
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
+// LightConstants in LightComponent.hpp, uploaded once per light.
+layout(std140, binding = 2) uniform LightConstants
+{
+	vec4 colorIntensity;
+	vec4 attenuation; // constant, linear, exponent, range
+	vec4 cone;        // cutoff, shadow softness
+} u_light;
 
 uniform sampler2D u_albedoTexture;
 uniform sampler2D u_normalTexture;
 uniform sampler2D u_positionTexture;
 uniform sampler2D u_specularTexture;
+uniform sampler2D u_depthTexture;
+uniform bool u_compactGBuffer;
+
+// GBufferLayout::Compact, matching GBufferPacking.hpp.
+const float MaxPackedSpecularIntensity = 16.0;
+
+vec3 DecodeOctahedral(vec2 encoded)
+{
+	vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-normal.z, 0.0);
+	normal.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+	return normalize(normal);
+}
 
-uniform sampler2D u_shadowMap;
-uniform vec2 u_shadowMapSize;
+vec3 ReconstructPosition(vec2 texCoord, float depth)
+{
+	vec4 position = u_frame.inverseViewProjection * vec4(vec3(texCoord, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
+
+void ReadGBuffer(vec2 texCoord, out vec3 normal, out vec3 worldPosition, out float specularIntensity)
+{
+	if(u_compactGBuffer)
+	{
+		normal            = DecodeOctahedral(texture(u_normalTexture, texCoord).xy);
+		worldPosition     = ReconstructPosition(texCoord, texture(u_depthTexture, texCoord).r);
+		specularIntensity = texture(u_albedoTexture, texCoord).a * MaxPackedSpecularIntensity;
+	}
+	else
+	{
+		normal            = texture(u_normalTexture, texCoord).xyz;
+		worldPosition     = texture(u_positionTexture, texCoord).xyz;
+		specularIntensity = texture(u_specularTexture, texCoord).r;
+	}
+}
+
+uniform sampler2DArray u_cascadeShadowMap;
+uniform mat4 u_cascadeMatrices[4];
+uniform int  u_cascadeCount;
 
 out vec4 o_color;
 
-float SampleShadowMap(sampler2D shadowMap, vec2 coords, float compare, float shadowBias)
+float SampleShadowMap(sampler2DArray shadowMap, vec2 coords, float layer, float compare, float shadowBias)
 {
-	if(texture(shadowMap, coords).r >= compare - shadowBias)
+	if(texture(shadowMap, vec3(coords, layer)).r >= compare - shadowBias)
 		return 1.0;
 		
 	return 0.0;
 }
 
-float SampleShadowMapLinear(sampler2D shadowMap, vec2 coords, float compare, vec2 pixelSize, float shadowBias)
+float SampleShadowMapLinear(sampler2DArray shadowMap, vec2 coords, float layer, float compare, vec2 pixelSize, float shadowBias)
 {
 	vec2 pixelPosition = coords / pixelSize + 0.5;
 	vec2 fractionalPart = fract(pixelPosition);
 	vec2 startPixel = (pixelPosition - fractionalPart) * pixelSize;
 
-	float bl = SampleShadowMap(shadowMap, startPixel, compare, shadowBias);
-	float br = SampleShadowMap(shadowMap, startPixel + vec2(pixelSize.x, 0), compare, shadowBias);
-	float tl = SampleShadowMap(shadowMap, startPixel + vec2(0, pixelSize.y), compare, shadowBias);
-	float tr = SampleShadowMap(shadowMap, startPixel + pixelSize, compare, shadowBias);
+	float bl = SampleShadowMap(shadowMap, startPixel, layer, compare, shadowBias);
+	float br = SampleShadowMap(shadowMap, startPixel + vec2(pixelSize.x, 0), layer, compare, shadowBias);
+	float tl = SampleShadowMap(shadowMap, startPixel + vec2(0, pixelSize.y), layer, compare, shadowBias);
+	float tr = SampleShadowMap(shadowMap, startPixel + pixelSize, layer, compare, shadowBias);
 
 	float bottom = mix(bl, br, fractionalPart.x);
 	float top    = mix(tl, tr, fractionalPart.x);
@@ -45,7 +91,7 @@ float SampleShadowMapLinear(sampler2D shadowMap, vec2 coords, float compare, vec
 	return mix(bottom, top, fractionalPart.y);
 }
 
-float SampleShadowMapPCF(sampler2D shadowMap, vec2 coords, float compare, vec2 pixelSize, float samples)
+float SampleShadowMapPCF(sampler2DArray shadowMap, vec2 coords, float layer, float compare, vec2 pixelSize, float samples)
 {
 	float samplesStart = (samples - 1.0) * 0.5;
 
@@ -56,7 +102,7 @@ float SampleShadowMapPCF(sampler2D shadowMap, vec2 coords, float compare, vec2 p
 		for(float x = -samplesStart; x <= samplesStart; x += 1.0)
 		{
 			vec2 coordsOffset = vec2(x, y) * pixelSize;
-			result += SampleShadowMapLinear(shadowMap, coords + coordsOffset, compare, pixelSize, samples * 0.001);
+			result += SampleShadowMapLinear(shadowMap, coords + coordsOffset, layer, compare, pixelSize, samples * 0.001);
 		}
 	}
 
@@ -82,21 +128,28 @@ float CalcSpecularFactor(vec3 lightDirection, vec3 surfaceNormal, vec3 worldPosi
 
 void main()
 {
-	vec3 normal        = texture(u_normalTexture, v_position).xyz;
-	vec3 worldPosition = texture(u_positionTexture, v_position).xyz;
-	
-	vec4 transformedShadowMapCoords = v_lightMatrix * vec4(worldPosition, 1.0);
-	vec3 shadowMapCoords = (transformedShadowMapCoords.xyz / transformedShadowMapCoords.w) * 0.5 + 0.5;
+	vec3 normal;
+	vec3 worldPosition;
+	float specularIntensity;
+	ReadGBuffer(v_position, normal, worldPosition, specularIntensity);
 	
-	float shadowFactor = SampleShadowMapPCF(u_shadowMap, shadowMapCoords.xy, shadowMapCoords.z, 1.0 / u_shadowMapSize, u_shadowSoftness);
-	
-	float specularIntensity = texture(u_specularTexture, v_position).r;
+	// Cascades are ordered near to far, so the first one containing the position has the most detail.
+	float shadowFactor = 1.0;
+	for(int i = 0; i < u_cascadeCount; i++)
+	{
+		vec3 shadowMapCoords = (u_cascadeMatrices[i] * vec4(worldPosition, 1.0)).xyz * 0.5 + 0.5;
+		if(all(greaterThan(shadowMapCoords, vec3(0.0))) && all(lessThan(shadowMapCoords, vec3(1.0))))
+		{
+			shadowFactor = SampleShadowMapPCF(u_cascadeShadowMap, shadowMapCoords.xy, float(i), shadowMapCoords.z, 1.0 / u_frame.shadowMapSize.xy, u_light.cone.y);
+			break;
+		}
+	}
 
 	float diffuseFactor  = max(dot(-v_lightDirection, normal), 0.0);
-	float specularFactor = CalcSpecularFactor(v_lightDirection, normal, worldPosition.xyz, u_cameraPosition, specularIntensity);
+	float specularFactor = CalcSpecularFactor(v_lightDirection, normal, worldPosition.xyz, u_frame.cameraPosition.xyz, specularIntensity);
 
 	vec4 texColor   = texture(u_albedoTexture, v_position);
-	vec4 lightColor = vec4(u_color, 1.0) * u_intensity;
+	vec4 lightColor = vec4(u_light.colorIntensity.rgb, 1.0) * u_light.colorIntensity.a;
 	
 	vec4 diffuseLightColor  = lightColor * diffuseFactor;
 	vec4 specularLightColor = lightColor * specularFactor;
@@ -12,6 +12,10 @@
 #include <Engine/EngineComponents/AnimationComponent.hpp>
 #include <Engine/EngineComponents/FollowerComponent.hpp>
 #include <Engine/EngineComponents/MouseLookComponent.hpp>
+#include <Engine/EngineComponents/SpatialGridComponent.hpp>
+#include <Engine/EngineComponents/CharacterControllerComponent.hpp>
+#include <Engine/EngineComponents/CullableComponent.hpp>
+#include <Engine/EngineComponents/OccluderComponent.hpp>
 
 #include <Engine/EngineSystems/RotaterSystem.hpp>
 #include <Engine/EngineSystems/DeferredRendererSystem.hpp>
@@ -23,6 +27,12 @@
 #include <Engine/EngineSystems/FollowerSystem.hpp>
 #include <Engine/EngineSystems/SelectEntitySystem.hpp>
 #include <Engine/EngineSystems/WaterUpdaterSystem.hpp>
+#include <Engine/EngineSystems/SpatialGridSystem.hpp>
+#include <Engine/EngineSystems/CharacterControllerSystem.hpp>
+#include <Engine/EngineSystems/PortalCullingSystem.hpp>
+#include <Engine/EngineSystems/LODSystem.hpp>
+
+#include <Engine/Rendering/StaticBatcher.hpp>
 
 #include "Engine/Core/AssetFolder.hpp"
 #include "Engine/Core/AssetLoaders/AssimpMeshLoader.hpp"
@@ -49,6 +59,18 @@ static bool IsKey(glm::u8vec3 pixel)
     return pixel != glm::u8vec3(0, 0, 0) && pixel != glm::u8vec3(255, 255, 255);
 }
 
+// Tile (x, y) is centred on world (y * 2 - 1, -(x * 2 - 1)), so grid x follows -z and grid y follows x.
+static glm::mat3 GetLevelGridTransform()
+{
+    return glm::mat3(glm::vec3(0.0f, 0.5f, 0.0f), glm::vec3(-0.5f, 0.0f, 0.0f), glm::vec3(1.0f, 1.0f, 1.0f));
+}
+
+static AABB GetTileBounds(uint32_t x, uint32_t y)
+{
+    glm::vec3 center(y * 2.0f - 1.0f, 0.0f, -(x * 2.0f - 1.0f));
+    return AABB(center - 1.0f, center + 1.0f);
+}
+
 class MainScene : public Scene
 {
 private:
@@ -171,20 +193,30 @@ public:
 
         auto deferredRendererContext = std::make_shared<DeferredRenderContext>(*this, glm::vec2(512));
 
+        auto portalGraph = std::make_shared<PortalGraph>();
+        deferredRendererContext->Visibility = std::make_shared<VisibilitySet>();
+        deferredRendererContext->Occlusion  = std::make_shared<OcclusionCuller>();
+
+        AddSystem<PortalCullingSystem>(portalGraph, GetLevelGridTransform(), deferredRendererContext->Visibility);
 		AddSystem<DeferredRendererSystem<NormalMappedMaterial>>(deferredRendererContext);
+		AddSystem<SpatialGridSystem>();
 		auto& keyboardMovementSystem = AddSystem<KeyboardMovementSystem>();
 	    AddSystem<MouseLookSystem>();
         AddSystem<AnimationSystem<float>>();
         AddSystem<AnimationSystem<glm::vec3>>();
+        AddSystem<CharacterControllerSystem>();
 
-        //AddSystem<WaterRendererSystem>(glm::uvec2(256));
+        // WaterComponent still holds a MaterialHandle, which the material rework removed.
+        //AddSystem<WaterRendererSystem>(deferredRendererContext);
 
         AddSystem<FollowerSystem>();
         AddSystem<AudioUpdaterSystem>();
         AddSystem<RotaterSystem>();
         AddSystem<WaterUpdaterSystem>();
+        AddSystem<LODSystem<NormalMappedMaterial>>();
 
 		TextureHandle blankTexture = LoadTexture<glm::u8vec3>("blank.png");
+        TextureHandle blankNormalMap = LoadTexture<glm::u8vec3>("blank_normal.png");
         TextureHandle textureAtlas = LoadTexture<glm::u8vec3>("Texture Atlas.png");
         TextureHandle normalsAtlas = LoadTexture<glm::u8vec3>("Normal Map Atlas.png");
 
@@ -196,6 +228,7 @@ public:
 		normalMappedShader->GetMaterialField("Color").SetDefaultValue(glm::vec3(1.0f));
 		normalMappedShader->GetMaterialField("SpecularIntensity").SetDefaultValue(0.0f);
 		normalMappedShader->GetMaterialField("TilingFactor").SetDefaultValue(glm::vec2(1.0f));
+        deferredRendererContext->GeometryShader = normalMappedShader;
 
         ShaderHandle specularShader = LoadShader("deferred/specular.glsl", "deferred/specular_FS.glsl");
         specularShader->GetMaterialField("Color").SetDefaultValue(glm::vec3(1.0f));
@@ -215,7 +248,8 @@ public:
 
 
         MeshHandle doorMesh = CreateSphere();//LoadMesh("door.obj");
-        MeshHandle  keyMesh = CreateSphere();//LoadMesh("key.obj");
+        LODGroup   keyLODs = CreateSphereLODGroup();
+        MeshHandle  keyMesh = keyLODs.Levels[0].Mesh;
 
         BitmapHandle<glm::u8vec3> levelBitmap = LoadBitmap<glm::u8vec3>("Levels/0/Structure.PNG");
         BitmapHandle<glm::u8vec3> doorMap = LoadBitmap<glm::u8vec3>("Levels/0/Door Map.PNG");
@@ -229,7 +263,30 @@ public:
 
         std::vector<glm::uvec2> shadowLocations;
 
-        auto shadowEntities = std::make_shared<std::unordered_map<glm::uvec2, ECS::Entity>>();
+        auto shadowGrid = std::make_shared<EntityGrid>(levelBitmap->Size(), GetLevelGridTransform());
+
+        auto levelCollision = std::make_shared<StaticCollisionWorld>(2.0f);
+
+        std::vector<TileType> levelTiles(levelBitmap->PixelCount, TileType::Open);
+
+        for(uint32_t y = 0; y < levelBitmap->Height; y++)
+        {
+            for(uint32_t x = 0; x < levelBitmap->Width; x++)
+            {
+                bool isWall = levelBitmap->GetPixel(x, y) == glm::u8vec3(0, 0, 0);
+                shadowGrid->SetBlocked(glm::ivec2(x, y), isWall);
+
+                if(isWall)
+                {
+                    levelCollision->Add(GetTileBounds(x, y));
+                    levelTiles[size_t(y) * levelBitmap->Width + x] = TileType::Solid;
+                }
+                else if(IsDoor(doorMap->GetPixel(x, y)))
+                {
+                    levelTiles[size_t(y) * levelBitmap->Width + x] = TileType::Door;
+                }
+            }
+        }
 
         size_t count = 0;
 
@@ -319,13 +376,12 @@ public:
 
                     if(IsKey(keyPixel))
                     {
-                        MaterialHandle keyMaterial = CreateMaterial(specularShader);
-                        keyMaterial->Get<glm::vec3>("Color") = glm::vec3(keyPixel) / 255.0f;
-                        keyMaterial->Get<float>("SpecularIntensity") = 1.0f;
-
-                        keyMaterial->SetTexture("Texture", blankTexture);
+                        // Drawn by the deferred renderer, so the LOD system can swap the key's mesh.
+                        NormalMappedMaterial keyMaterial(glm::vec3(keyPixel) / 255.0f, 1.0f, glm::vec2(1.0f));
+                        keyMaterial.AlbedoTexture.Set(blankTexture);
+                        keyMaterial.NormalTexture.Set(blankNormalMap);
 
-                        ECS::Entity key = CreateEntity(RenderableMesh(keyMesh, keyMaterial), ClickableComponent(keyMesh));
+                        ECS::Entity key = CreateEntity(RenderableMesh(keyMesh, keyMaterial), ClickableComponent(keyMesh), CullableComponent(0.2f), keyLODs);
                         auto& keyTransformation = key.AddComponent<Transformation>(glm::vec3(y * 2.0f - 1.0f, -0.9f, -(x * 2.0f - 1.0f)));
                         keyTransformation.Rotate(glm::vec3(0, 1, 0), std::randf() * 360.0f);
                         keyTransformation.Scale = glm::vec3(0.1f);
@@ -369,7 +425,7 @@ public:
                         doorMaterial->SetTexture("Texture", CreateTexture(doorTexture));
                         doorMaterial->SetTexture("NormalMap", doorNormalMap);
 
-                        ECS::Entity door = CreateEntity(RenderableMesh(doorMesh, doorMaterial), ClickableComponent(doorMesh));
+                        ECS::Entity door = CreateEntity(RenderableMesh(doorMesh, doorMaterial), ClickableComponent(doorMesh), CullableComponent(1.5f));
                         auto& doorTransformation = door.AddComponent<Transformation>(glm::vec3(y * 2.0f - 1.0f, 0, -(x * 2.0f - 1.0f)), doorRotation);
                         doorTransformation.Scale *= 0.995f;
 
@@ -398,10 +454,14 @@ public:
                             }
                         });*/
 
-                        closeDoorAnimation.OnFinish += [door, &doorPixel]()
+                        StaticCollisionWorld::ColliderID doorCollider = levelCollision->Add(GetTileBounds(x, y));
+
+                        closeDoorAnimation.OnFinish += [door, &doorPixel, levelCollision, doorCollider, portalGraph, x, y]()
                         {
                             //door.Delete();
                             doorPixel = glm::u8vec3(0, 0, 0);
+                            levelCollision->SetEnabled(doorCollider, false);
+                            portalGraph->SetBlocking(portalGraph->GetCell(glm::ivec2(x, y)), false);
                         };
                     }
 
@@ -411,6 +471,9 @@ public:
 			}
 		}
 
+        levelCollision->Build();
+        *portalGraph = PortalGraph(levelBitmap->Size(), levelTiles);
+
         for(size_t i = 0; i < std::min(shadowLocations.size(), size_t(levelBitmap->Width / 4U)); i++)
         {
             auto randomIndex = int(std::randf() * shadowLocations.size());
@@ -418,7 +481,7 @@ public:
             glm::uvec2 randomLocation = shadowLocations[randomIndex];
             shadowLocations.erase(shadowLocations.begin() + randomIndex);
 
-            ECS::Entity shadowFigureEntity = CreateEntity();
+            ECS::Entity shadowFigureEntity = CreateEntity(CullableComponent(1.5f));
             auto& shadowFigureTransformation = shadowFigureEntity.AddComponent<Transformation>(glm::vec3(glm::vec3(randomLocation.y * 2.0f - 1.0f, -1.25f, -(randomLocation.x * 2.0f - 1.0f))), glm::quat(1, 0, 0, 0), glm::vec3(1.25f));
 
             auto& shadowFigureMeshComponent = shadowFigureEntity.AddComponent<RenderableMesh>(shadowFigureMesh, blankMaterial);
@@ -427,7 +490,7 @@ public:
             auto& shadowFigureAnimation = shadowFigureEntity.AddComponent<AnimationComponent<glm::vec3>>(shadowFigureTransformation.Position, 0.0f, false);
             shadowFigureAnimation.AddFrame(3.0f, shadowFigureTransformation.Position);
 
-            (*shadowEntities)[randomLocation] = shadowFigureEntity;
+            shadowFigureEntity.AddComponent<SpatialGridComponent>(shadowGrid);
 
             shadowFigureAnimation.OnFinish += [shadowFigureEntity]()
             {
@@ -435,14 +498,16 @@ public:
             };
         }
 
-		MaterialHandle brickMaterial = CreateMaterial(normalMappedShader);
-		brickMaterial->SetTexture("Texture", textureAtlas);
-        brickMaterial->SetTexture("NormalMap", normalsAtlas);
+		NormalMappedMaterial brickMaterial(glm::vec3(1.0f), 0.0f, glm::vec2(1.0f));
+		brickMaterial.AlbedoTexture.Set(textureAtlas);
+        brickMaterial.NormalTexture.Set(normalsAtlas);
 
         CalculateTangents(vertices, indices);
-		MeshHandle mesh = CreateMesh(Model(vertices, indices));
 
-		CreateEntity(Transformation(), RenderableMesh(mesh, brickMaterial));
+        // 16 x 16 tiles per chunk, so the maze culls piece by piece instead of always drawing as a whole.
+        StaticBatcher<DefaultVertex, NormalMappedMaterial> levelBatcher(32.0f);
+        levelBatcher.Add(vertices, indices, brickMaterial);
+        levelBatcher.CreateEntities(*this, true);
 
         ShaderHandle waterShader = LoadShader("deferred/water/water_VS.glsl", "deferred/water/water_FS.glsl");
         waterShader->GetMaterialField("WaveStrength").SetDefaultValue(0.04f);
@@ -453,7 +518,12 @@ public:
         waterMaterial->Get<glm::vec2>("TilingFactor") = glm::vec2(levelBitmap->Size()) * 10.0f;
         waterMaterial->SetTexture("DistortionMap", LoadTexture<glm::u8vec3>("Water DUDV Map.png"));
         waterMaterial->SetTexture("NormalMap", LoadTexture<glm::u8vec3>("Water Normal Map.png"));
-        ECS::Entity waterEntity = CreateEntity(Transformation(glm::vec3(0, -1.0f, 0), glm::quat(1, 0, 0, 0), glm::vec3(levelBitmap->Height * 2.0f, 0, levelBitmap->Width * 2.0f)), WaterComponent(waterMaterial, 0.07f));
+        // The water is a dark, distorted floor seen from close by, so stale and low-resolution reflections go unnoticed.
+        WaterUpdatePolicy waterUpdatePolicy;
+        waterUpdatePolicy.FrameInterval     = 3;
+        waterUpdatePolicy.MaximumResolution = 512;
+
+        ECS::Entity waterEntity = CreateEntity(Transformation(glm::vec3(0, -1.0f, 0), glm::quat(1, 0, 0, 0), glm::vec3(levelBitmap->Height * 2.0f, 0, levelBitmap->Width * 2.0f)), WaterComponent(waterMaterial, 0.07f, waterUpdatePolicy));
 
         auto& waterTransformation = waterEntity.GetComponent<Transformation>();
         auto& waterAnimation = waterEntity.AddComponent<AnimationComponent<float>>(waterTransformation.Position.y, 0.0f, true);
@@ -561,7 +631,9 @@ public:
 
         SoundHandle shadowFigureSound = LoadSound("Shadow Figure.wav");
 
-        player.SubscribeEvent(keyboardMovementSystem.MoveEvent, [&walkAnimation, &waterAnimation, shadowFigureAudioSource, shadowFigureSound, shadowEntities, playerSize, levelBitmap, doorMap, &mouthAudioSourceComponent](Key key, Transformation& transformation, glm::vec3 oldPosition, glm::vec3 newPosition)
+        player.AddComponent<CharacterControllerComponent>(levelCollision, playerSize, 1.0f);
+
+        player.SubscribeEvent(keyboardMovementSystem.MoveEvent, [&walkAnimation, &waterAnimation, shadowFigureAudioSource, shadowFigureSound, shadowGrid, levelBitmap, &mouthAudioSourceComponent](Key key, Transformation& transformation, glm::vec3 oldPosition, glm::vec3 newPosition)
         {
             float waterProgress = 1.0f - waterAnimation.GetProgress();
 
@@ -577,63 +649,13 @@ public:
                 walkAnimation.SpeedFactor = 1.0f * waterProgress;
             }
 
-            std::array<glm::vec3, 4> oldPositions =
-            {
-                oldPosition + glm::vec3(-playerSize, 0.0f,  playerSize),
-                oldPosition + glm::vec3( playerSize, 0.0f,  playerSize),
-                oldPosition + glm::vec3(-playerSize, 0.0f, -playerSize),
-                oldPosition + glm::vec3( playerSize, 0.0f, -playerSize),
-            };
-
-            std::array<glm::vec3, 4> newPositions =
-            {
-                newPosition + glm::vec3(-playerSize, 0.0f,  playerSize),
-                newPosition + glm::vec3( playerSize, 0.0f,  playerSize),
-                newPosition + glm::vec3(-playerSize, 0.0f, -playerSize),
-                newPosition + glm::vec3( playerSize, 0.0f, -playerSize),
-            };
-
-            glm::vec3 movement = newPosition - oldPosition;
-
-            for(size_t i = 0; i < 4; i++)
-            {
-                glm::uvec2 oldLocation = glm::uvec2(ceil(-oldPositions[i].z * 0.5f), ceil(oldPositions[i].x * 0.5f));
-                glm::uvec2 newLocation = glm::uvec2(ceil(-newPositions[i].z * 0.5f), ceil(newPositions[i].x * 0.5f));
-
-                glm::u8vec3 newXPixel = levelBitmap->GetPixel(newLocation.x, oldLocation.y);
-                glm::u8vec3 newYPixel = levelBitmap->GetPixel(oldLocation.x, newLocation.y);
-                glm::u8vec3 newXYPixel = levelBitmap->GetPixel(newLocation);
-
-                glm::u8vec3 newDoorXPixel = doorMap->GetPixel(newLocation.x, oldLocation.y);
-                glm::u8vec3 newDoorYPixel = doorMap->GetPixel(oldLocation.x, newLocation.y);
-                glm::u8vec3 newDoorXYPixel = doorMap->GetPixel(newLocation);
-
-                if(newXYPixel == glm::u8vec3(0, 0, 0) || IsDoor(newDoorXYPixel))
-                {
-                    if(newLocation.x != oldLocation.x && (newXPixel == glm::u8vec3(0, 0, 0) || IsDoor(newDoorXPixel)))
-                    {
-                        movement.z = 0.0f;
-                    }
-
-                    if(newLocation.y != oldLocation.y && (newYPixel == glm::u8vec3(0, 0, 0) || IsDoor(newDoorYPixel)))
-                    {
-                        movement.x = 0.0f;
-                    }
-                }
-            }
-
             glm::vec3 frontPlayerPosition = newPosition + glm::normalize(glm::rotate(transformation.Rotation, glm::vec3(0, 0, -1))) * 2.0f;
             glm::vec3 frontRightPlayerPosition = frontPlayerPosition + glm::normalize(glm::rotate(transformation.Rotation, glm::vec3(1, 0, 0))) * float(levelBitmap->Width);
 
             glm::uvec2 frontPlayerLocation = glm::uvec2(ceil(-frontPlayerPosition.z * 0.5f), ceil(frontPlayerPosition.x * 0.5f));
 
-            transformation.Position = oldPosition + movement;
-
-            auto shadowEntityIt = shadowEntities->find(frontPlayerLocation);
-            if(shadowEntityIt != shadowEntities->end())
+            shadowGrid->ForEachInCell(glm::ivec2(frontPlayerLocation), [&](EntityGrid::Handle handle, ECS::Entity shadowEntity)
             {
-                ECS::Entity shadowEntity = shadowEntityIt->second;
-
                 auto& shadowAnimationComponent = shadowEntity.GetComponent<AnimationComponent<glm::vec3>>();
 
                 auto& shadowTransformation = shadowEntity.GetComponent<Transformation>();
@@ -644,8 +666,8 @@ public:
                 shadowFigureAudioSource->Play(shadowFigureSound);
                 shadowAnimationComponent.Start();
 
-                shadowEntities->erase(shadowEntityIt);
-            }
+                shadowEntity.RemoveComponent<SpatialGridComponent>();
+            });
         });
         
         std::shared_ptr<bool> isFocused = std::make_shared<bool>(true);
@@ -11,6 +11,20 @@ uniform float     m_SpecularIntensity;
 
 uniform vec2 m_TilingFactor;
 
+uniform bool u_compactGBuffer;
+
+// GBufferLayout::Compact, matching GBufferPacking.hpp.
+const float MaxPackedSpecularIntensity = 16.0;
+
+vec2 EncodeOctahedral(vec3 normal)
+{
+	vec2 result = normal.xy / (abs(normal.x) + abs(normal.y) + abs(normal.z));
+	if(normal.z < 0.0)
+		result = (1.0 - abs(result.yx)) * mix(vec2(-1.0), vec2(1.0), greaterThanEqual(result, vec2(0.0)));
+
+	return result;
+}
+
 layout(location = 0) out vec4  o_albedo;
 layout(location = 1) out vec3  o_normal;
 layout(location = 2) out vec3  o_position;
@@ -30,4 +44,10 @@ void main()
 	o_normal   = normal;
 	o_position = v_worldPosition;
 	o_specular = m_SpecularIntensity;
+
+	if(u_compactGBuffer)
+	{
+		o_albedo = vec4(o_albedo.rgb, clamp(m_SpecularIntensity / MaxPackedSpecularIntensity, 0.0, 1.0));
+		o_normal = vec3(EncodeOctahedral(normalize(normal)), 0.0);
+	}
 }
\ No newline at end of file
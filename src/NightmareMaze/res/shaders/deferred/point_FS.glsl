@@ -1,24 +1,66 @@
-#version 330
+#version 420
 
 in vec2 v_position;
 in vec3 v_lightPosition;
 
-uniform vec3  u_color;
-uniform float u_intensity;
-
-uniform float u_constant;
-uniform float u_linear;
-uniform float u_exponent;
-uniform float u_range;
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
+// LightConstants in LightComponent.hpp, uploaded once per light.
+layout(std140, binding = 2) uniform LightConstants
+{
+	vec4 colorIntensity;
+	vec4 attenuation; // constant, linear, exponent, range
+	vec4 cone;        // cutoff, shadow softness
+} u_light;
 
 //uniform vec3 u_position;
 
-uniform vec3 u_cameraPosition;
-
 uniform sampler2D u_albedoTexture;
 uniform sampler2D u_normalTexture;
 uniform sampler2D u_positionTexture;
 uniform sampler2D u_specularTexture;
+uniform sampler2D u_depthTexture;
+uniform bool u_compactGBuffer;
+
+// GBufferLayout::Compact, matching GBufferPacking.hpp.
+const float MaxPackedSpecularIntensity = 16.0;
+
+vec3 DecodeOctahedral(vec2 encoded)
+{
+	vec3 normal = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+	float fold = max(-normal.z, 0.0);
+	normal.xy += mix(vec2(fold), vec2(-fold), greaterThanEqual(normal.xy, vec2(0.0)));
+	return normalize(normal);
+}
+
+vec3 ReconstructPosition(vec2 texCoord, float depth)
+{
+	vec4 position = u_frame.inverseViewProjection * vec4(vec3(texCoord, depth) * 2.0 - 1.0, 1.0);
+	return position.xyz / position.w;
+}
+
+void ReadGBuffer(vec2 texCoord, out vec3 normal, out vec3 worldPosition, out float specularIntensity)
+{
+	if(u_compactGBuffer)
+	{
+		normal            = DecodeOctahedral(texture(u_normalTexture, texCoord).xy);
+		worldPosition     = ReconstructPosition(texCoord, texture(u_depthTexture, texCoord).r);
+		specularIntensity = texture(u_albedoTexture, texCoord).a * MaxPackedSpecularIntensity;
+	}
+	else
+	{
+		normal            = texture(u_normalTexture, texCoord).xyz;
+		worldPosition     = texture(u_positionTexture, texCoord).xyz;
+		specularIntensity = texture(u_specularTexture, texCoord).r;
+	}
+}
 
 out vec4 o_color;
 
@@ -47,26 +89,26 @@ float CalcAttenuation(float distanceToPoint, float constant, float linear, float
 
 void main()
 {
-	vec3 normal        = texture(u_normalTexture, v_position).xyz;
-	vec3 worldPosition = texture(u_positionTexture, v_position).xyz;
-	
-	float specularIntensity = texture(u_specularTexture, v_position).r;
+	vec3 normal;
+	vec3 worldPosition;
+	float specularIntensity;
+	ReadGBuffer(v_position, normal, worldPosition, specularIntensity);
 
 	vec3 lightDirection = worldPosition - v_lightPosition;
 	float distanceToPoint = length(lightDirection);
 
-	if(distanceToPoint > u_range)
+	if(distanceToPoint > u_light.attenuation.w)
 		discard;
 
 	lightDirection = normalize(lightDirection);
 
 	float diffuseFactor  = max(dot(-lightDirection, normal), 0.0);
-	float specularFactor = CalcSpecularFactor(lightDirection, normal, worldPosition, u_cameraPosition, specularIntensity);
+	float specularFactor = CalcSpecularFactor(lightDirection, normal, worldPosition, u_frame.cameraPosition.xyz, specularIntensity);
 
 	vec4 texColor   = texture(u_albedoTexture, v_position);
-	vec4 lightColor = vec4(u_color, 1.0) * u_intensity;
+	vec4 lightColor = vec4(u_light.colorIntensity.rgb, 1.0) * u_light.colorIntensity.a;
 	
-	float attenuation = CalcAttenuation(distanceToPoint, u_constant, u_linear, u_exponent);
+	float attenuation = CalcAttenuation(distanceToPoint, u_light.attenuation.x, u_light.attenuation.y, u_light.attenuation.z);
 	
 	vec4  diffuseLightColor = (lightColor *  diffuseFactor) / attenuation;
 	vec4 specularLightColor = (lightColor * specularFactor) / attenuation;
@@ -7,6 +7,9 @@ layout(location = 2) in vec3 u_lightPosition;
 
 layout(location = 3) in mat4 u_lightMatrix;
 
+// Normalized device rectangle covering the clusters the light touches.
+uniform vec4 u_screenRect;
+
 out vec2 v_position;
 out vec3 v_lightDirection;
 out vec3 v_lightPosition;
@@ -14,8 +17,10 @@ out mat4 v_lightMatrix;
 
 void main()
 {
-	gl_Position = vec4(a_position, 0.0, 1.0);
-	v_position = a_position * 0.5 + 0.5;
+	vec2 position = mix(u_screenRect.xy, u_screenRect.zw, a_position * 0.5 + 0.5);
+
+	gl_Position = vec4(position, 0.0, 1.0);
+	v_position = position * 0.5 + 0.5;
 	v_lightDirection = u_lightDirection;
 	v_lightPosition  = u_lightPosition;
 	v_lightMatrix    = u_lightMatrix;
@@ -1,8 +0,0 @@
-#version 330
-
-out vec4 o_color;
-
-void main()
-{
-	o_color = vec4(0.0, 0.0, 0.0, 1.0);
-}
\ No newline at end of file
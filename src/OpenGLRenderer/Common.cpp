@@ -35,6 +35,7 @@ namespace GL
 				return 1;
 			case ElementType::UInt16:
 			case ElementType::SInt16:
+			case ElementType::Float16:
 				return 2;
 			case ElementType::UInt32:
 			case ElementType::SInt32:
@@ -42,6 +43,8 @@ namespace GL
 				return 4;
 			case ElementType::Float64:
 				return 8;
+			case ElementType::SInt2101010:
+				return 1; // four components share four bytes
 		}
 
 		return 0;
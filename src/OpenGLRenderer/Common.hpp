@@ -16,8 +16,12 @@ namespace GL
 		SInt16  = GL_SHORT,
 		UInt32  = GL_UNSIGNED_INT,
 		SInt32  = GL_INT,
+		Float16 = GL_HALF_FLOAT,
 		Float32 = GL_FLOAT,
 		Float64 = GL_DOUBLE,
+
+		// Four signed components of 10, 10, 10 and 2 bits packed into 32 bits; always has a count of 4.
+		SInt2101010 = GL_INT_2_10_10_10_REV,
 	};
 
 	size_t GetTypeSize(ElementType type);
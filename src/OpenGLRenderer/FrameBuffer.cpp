@@ -2,6 +2,8 @@
 
 #include <iostream>
 
+#include "StateCache.hpp"
+
 namespace GL
 {
 	TextureAttachment::TextureAttachment(uint32_t width, uint32_t height, size_t index, InternalImageFormat internalFormat, ImageFormat format, ElementType elementType, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode) : 
@@ -19,7 +21,7 @@ namespace GL
 	FrameBuffer::FrameBuffer(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment) : Width(width), Height(height)
 	{
 		glGenFramebuffers(1, &m_ID);
-		glBindFramebuffer(GL_FRAMEBUFFER, m_ID);
+		StateCache::Get().BindFrameBuffer(GL_FRAMEBUFFER, m_ID);
 
 		std::vector<GLenum> attachments;
 		m_colorAttachments.reserve(colorAttachments.size());
@@ -50,22 +52,39 @@ namespace GL
 		if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
 			std::cout << "Framebuffer is not complete!" << std::endl;
 
-		glBindFramebuffer(GL_FRAMEBUFFER, 0);
+		StateCache::Get().BindFrameBuffer(GL_FRAMEBUFFER, 0);
+	}
+
+	FrameBuffer::FrameBuffer(const std::shared_ptr<Texture2DArray>& depthArray, uint32_t layer) :
+		m_depthArray(depthArray), Width(depthArray->Width), Height(depthArray->Height)
+	{
+		glGenFramebuffers(1, &m_ID);
+		StateCache::Get().BindFrameBuffer(GL_FRAMEBUFFER, m_ID);
+
+		glFramebufferTextureLayer(GL_FRAMEBUFFER, GL_DEPTH_ATTACHMENT, m_depthArray->m_ID, 0, GLint(layer));
+		glDrawBuffer(GL_NONE);
+		glReadBuffer(GL_NONE);
+
+		if(glCheckFramebufferStatus(GL_FRAMEBUFFER) != GL_FRAMEBUFFER_COMPLETE)
+			std::cout << "Framebuffer is not complete!" << std::endl;
+
+		StateCache::Get().BindFrameBuffer(GL_FRAMEBUFFER, 0);
 	}
 
 	FrameBuffer::~FrameBuffer()
 	{
+		StateCache::Get().OnFrameBufferDeleted(m_ID);
 		glDeleteFramebuffers(1, &m_ID);
 	}
 
 	void FrameBuffer::Bind(BindMode mode)
 	{
-		glBindFramebuffer(static_cast<GLenum>(mode), m_ID);
+		StateCache::Get().BindFrameBuffer(static_cast<GLenum>(mode), m_ID);
 
 		if(m_renderBuffer)
 			m_renderBuffer->Bind();
 
-		glViewport(0, 0, Width, Height);
+		StateCache::Get().SetViewport(glm::ivec4(0, 0, Width, Height));
 	}
 
 	void BlitFrameBuffer(FrameBuffer& source, FrameBuffer& dest, MagFilterMode filterMode, uint32_t targets)
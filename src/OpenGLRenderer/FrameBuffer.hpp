@@ -51,6 +51,8 @@ namespace GL
 
 		std::shared_ptr<Texture2D> m_depthAttachment;
 
+		std::shared_ptr<Texture2DArray> m_depthArray;
+
 		std::shared_ptr<RenderBuffer> m_renderBuffer;
 	public:
 		enum class BindMode
@@ -64,6 +66,9 @@ namespace GL
 
 		FrameBuffer(uint32_t width, uint32_t height, const std::vector<AttachmentInfo>& colorAttachments, std::optional<AttachmentInfo> depthAttachment);
 
+		// Depth-only frame buffer that renders into one layer of a texture array shared with the other layers.
+		FrameBuffer(const std::shared_ptr<Texture2DArray>& depthArray, uint32_t layer);
+
 		~FrameBuffer();
 
 		const uint32_t Width;
@@ -1,5 +1,9 @@
 #include "IndexBuffer.hpp"
 
+#include <algorithm>
+
+#include <Common.hpp>
+
 namespace GL
 {
 	void IndexBuffer::Bind()
@@ -7,11 +11,30 @@ namespace GL
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_bufferID);
 	}
 
-	IndexBuffer::IndexBuffer(const std::vector<uint32_t>& indices, BufferUsage usage) : IndexCount(indices.size())
+	static ElementType GetIndexType(const std::vector<uint32_t>& indices)
+	{
+		return std::ranges::all_of(indices, [](uint32_t index) { return index <= UINT16_MAX; }) ? ElementType::UInt16 : ElementType::UInt32;
+	}
+
+	static std::vector<uint16_t> ToShortIndices(const std::vector<uint32_t>& indices)
+	{
+		return std::vector<uint16_t>(indices.begin(), indices.end());
+	}
+
+	IndexBuffer::IndexBuffer(const std::vector<uint32_t>& indices, BufferUsage usage) : IndexCount(indices.size()), IndexType(GetIndexType(indices))
 	{
 		glGenBuffers(1, &m_bufferID);
 		glBindBuffer(GL_ARRAY_BUFFER, m_bufferID);
-		glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), (GLenum)usage);
+
+		if(IndexType == ElementType::UInt16)
+		{
+			const std::vector<uint16_t> shortIndices = ToShortIndices(indices);
+			glBufferData(GL_ARRAY_BUFFER, shortIndices.size() * sizeof(uint16_t), shortIndices.data(), (GLenum)usage);
+		}
+		else
+		{
+			glBufferData(GL_ARRAY_BUFFER, indices.size() * sizeof(uint32_t), indices.data(), (GLenum)usage);
+		}
 	}
 
 	IndexBuffer::~IndexBuffer()
@@ -22,6 +45,17 @@ namespace GL
 	void IndexBuffer::SetData(const std::vector<uint32_t>& indices, size_t offset)
 	{
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_bufferID);
-		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset, indices.size(), indices.data());
+
+		if(IndexType == ElementType::UInt16)
+		{
+			DEBUG_ASSERT(GetIndexType(indices) == ElementType::UInt16, "Indices above 65535 do not fit a 16-bit index buffer.");
+
+			const std::vector<uint16_t> shortIndices = ToShortIndices(indices);
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint16_t), shortIndices.size() * sizeof(uint16_t), shortIndices.data());
+		}
+		else
+		{
+			glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, offset * sizeof(uint32_t), indices.size() * sizeof(uint32_t), indices.data());
+		}
 	}
 }
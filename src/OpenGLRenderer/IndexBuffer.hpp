@@ -13,12 +13,15 @@ namespace GL
 
 		void Bind();
 	public:
+		// Uploads 16-bit indices when every index fits, halving the buffer; 32-bit ones otherwise.
 		IndexBuffer(const std::vector<uint32_t>& indices, BufferUsage usage);
 
 		~IndexBuffer();
 
-		const size_t IndexCount;
+		const size_t      IndexCount;
+		const ElementType IndexType;
 
+		// offset counts indices. The indices must fit the buffer's IndexType.
 		void SetData(const std::vector<uint32_t>& indices, size_t offset);
 
 		friend class VertexArray;
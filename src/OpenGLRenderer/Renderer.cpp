@@ -2,11 +2,13 @@
 
 #include <iostream>
 
+#include "StateCache.hpp"
+
 namespace GL
 {
 
-	void Enable (EnableFlags flags) { glEnable((GLenum)flags);  }
-	void Disable(EnableFlags flags) { glDisable((GLenum)flags); }
+	void Enable (EnableFlags flags) { StateCache::Get().SetEnabled((GLenum)flags, true);  }
+	void Disable(EnableFlags flags) { StateCache::Get().SetEnabled((GLenum)flags, false); }
 
 	void Clear(uint32_t targets) 
 	{
@@ -15,19 +17,13 @@ namespace GL
 
 	void SetClearColor(const glm::vec4& color) { glClearColor(color.r, color.g, color.b, color.a); }
 
-	void FrontFace(FrontFaceMode mode) { glFrontFace((GLenum)mode); }
+	void FrontFace(FrontFaceMode mode) { StateCache::Get().SetFrontFace((GLenum)mode); }
 
-	void CullFace(CullFaceMode mode) { glCullFace((GLenum)mode); }
+	void CullFace(CullFaceMode mode) { StateCache::Get().SetCullFace((GLenum)mode); }
 
-	void DepthMask(bool write)
-	{
-		if(write)
-			glDepthMask(GL_TRUE);
-		else
-			glDepthMask(GL_FALSE);
-	}
+	void DepthMask(bool write) { StateCache::Get().SetDepthMask(write); }
 
-	void BlendFunc(BlendFactor sourceFactor, BlendFactor destFactor) { glBlendFunc((GLenum)sourceFactor, (GLenum)destFactor); }
+	void BlendFunc(BlendFactor sourceFactor, BlendFactor destFactor) { StateCache::Get().SetBlendFunc((GLenum)sourceFactor, (GLenum)destFactor); }
 
-	void DepthFunc(DepthFunction function) { glDepthFunc((GLenum)function); }	
+	void DepthFunc(DepthFunction function) { StateCache::Get().SetDepthFunc((GLenum)function); }	
 }
@@ -7,21 +7,20 @@ namespace GL
 {
 	GLint Shader::StoreUniformLocation(std::string_view name) const
 	{
-		return glGetUniformLocation(m_programID, name.data());
+		// A string_view need not be null terminated.
+		const std::string terminatedName(name);
+		return glGetUniformLocation(m_programID, terminatedName.c_str());
 	}
 
-	GLint Shader::RegisterUniform(std::string_view name)
+	const std::pair<const std::string, GLint>& Shader::RegisterUniform(std::string_view name)
 	{
-		std::string nameKey(name);
-		auto it = m_uniformLocations.find(nameKey);
+		auto it = m_uniformLocations.find(name);
 		if(it == m_uniformLocations.end())
 		{
-			GLint result = StoreUniformLocation(name);
-			m_uniformLocations[nameKey] = result;
-			return result;
+			it = m_uniformLocations.emplace(std::string(name), StoreUniformLocation(name)).first;
 		}
 
-		return m_uniformLocations[nameKey];
+		return *it;
 	}
 
 	static void CheckError(GLuint shader, GLuint flag, bool isProgram, std::string_view errorMessage)
@@ -111,73 +110,118 @@ namespace GL
 		{
 			glDeleteShader(shader);
 		}
+		StateCache::Get().OnProgramDeleted(m_programID);
 		glDeleteProgram(m_programID);
 	}
 
 	void Shader::SetUniform(std::string_view name, int value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform1i(location, value);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::ivec2& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform2i(location, value.x, value.y);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::ivec3& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform3i(location, value.x, value.y, value.z);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::ivec4& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform4i(location, value.x, value.y, value.z, value.w);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, float value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform1f(location, value);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::vec2& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform2f(location, value.x, value.y);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::vec3& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform3f(location, value.x, value.y, value.z);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::vec4& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniform4f(location, value.x, value.y, value.z, value.w);
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::mat2& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniformMatrix2fv(location, 1, GL_FALSE, glm::value_ptr(value));
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::mat3& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniformMatrix3fv(location, 1, GL_FALSE, glm::value_ptr(value));
+		SetUniform(GetUniformLocation(name), value);
 	}
 
 	void Shader::SetUniform(std::string_view name, const glm::mat4& value)
 	{
-		const GLint location = RegisterUniform(name);
-		glUniformMatrix4fv(location, 1, GL_FALSE, glm::value_ptr(value));
+		SetUniform(GetUniformLocation(name), value);
+	}
+
+	void Shader::SetUniform(GLint location, int value)
+	{
+		glProgramUniform1i(m_programID, location, value);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::ivec2& value)
+	{
+		glProgramUniform2i(m_programID, location, value.x, value.y);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::ivec3& value)
+	{
+		glProgramUniform3i(m_programID, location, value.x, value.y, value.z);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::ivec4& value)
+	{
+		glProgramUniform4i(m_programID, location, value.x, value.y, value.z, value.w);
+	}
+
+	void Shader::SetUniform(GLint location, float value)
+	{
+		glProgramUniform1f(m_programID, location, value);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::vec2& value)
+	{
+		glProgramUniform2f(m_programID, location, value.x, value.y);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::vec3& value)
+	{
+		glProgramUniform3f(m_programID, location, value.x, value.y, value.z);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::vec4& value)
+	{
+		glProgramUniform4f(m_programID, location, value.x, value.y, value.z, value.w);
+	}
+
+	void Shader::SetUniform(GLint location, const glm::mat2& value)
+	{
+		glProgramUniformMatrix2fv(m_programID, location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	void Shader::SetUniform(GLint location, const glm::mat3& value)
+	{
+		glProgramUniformMatrix3fv(m_programID, location, 1, GL_FALSE, glm::value_ptr(value));
+	}
+
+	void Shader::SetUniform(GLint location, const glm::mat4& value)
+	{
+		glProgramUniformMatrix4fv(m_programID, location, 1, GL_FALSE, glm::value_ptr(value));
 	}
 
 	UniformCollection Shader::GetUniforms()
@@ -208,7 +252,9 @@ namespace GL
 
 		glGetActiveUniform(m_shader.m_programID, static_cast<GLuint>(m_index), 1024, nullptr, nullptr, &type, name);
 
-		return Uniform(m_index, m_shader.RegisterUniform(name), name, static_cast<UniformType>(type));
+		// The name is returned as a view of the location cache's key, which outlives this buffer.
+		const auto& [cachedName, location] = m_shader.RegisterUniform(name);
+		return Uniform(m_index, location, cachedName, static_cast<UniformType>(type));
 	}
 
 	bool UniformIterator::operator==(const UniformIterator& other) const
@@ -8,6 +8,8 @@
 #include <glm/gtc/type_ptr.hpp>
 #include <unordered_map>
 
+#include "StateCache.hpp"
+
 namespace GL
 {
 	enum class UniformType
@@ -44,6 +46,14 @@ namespace GL
 		const UniformType      Type;
 	};
 
+	// Lets string-keyed maps be searched with a std::string_view without building a std::string.
+	struct StringHash
+	{
+		using is_transparent = void;
+
+		size_t operator()(std::string_view text) const { return std::hash<std::string_view>()(text); }
+	};
+
 	class UniformCollection;
 
 	class Shader
@@ -53,7 +63,7 @@ namespace GL
 
 		~Shader();
 
-		void Bind() { glUseProgram(m_programID); }
+		void Bind() { StateCache::Get().UseProgram(m_programID); }
 
 		void SetUniform(std::string_view name, int value);
 		void SetUniform(std::string_view name, const glm::ivec2& value);
@@ -67,6 +77,22 @@ namespace GL
 		void SetUniform(std::string_view name, const glm::mat3& value);
 		void SetUniform(std::string_view name, const glm::mat4& value);
 
+		// Cached after the first query; -1 when the program has no active uniform of that name.
+		GLint GetUniformLocation(std::string_view name) { return RegisterUniform(name).second; }
+
+		// Write to this program whether or not it is the one bound.
+		void SetUniform(GLint location, int value);
+		void SetUniform(GLint location, const glm::ivec2& value);
+		void SetUniform(GLint location, const glm::ivec3& value);
+		void SetUniform(GLint location, const glm::ivec4& value);
+		void SetUniform(GLint location, float value);
+		void SetUniform(GLint location, const glm::vec2& value);
+		void SetUniform(GLint location, const glm::vec3& value);
+		void SetUniform(GLint location, const glm::vec4& value);
+		void SetUniform(GLint location, const glm::mat2& value);
+		void SetUniform(GLint location, const glm::mat3& value);
+		void SetUniform(GLint location, const glm::mat4& value);
+
 		UniformCollection GetUniforms();
 
 		friend class UniformIterator;
@@ -76,11 +102,11 @@ namespace GL
 
 		std::vector<GLuint> m_shaders;
 
-		std::unordered_map<std::string, GLint> m_uniformLocations;
+		std::unordered_map<std::string, GLint, StringHash, std::equal_to<>> m_uniformLocations;
 
 		GLint StoreUniformLocation(std::string_view name) const;
 
-		GLint RegisterUniform(std::string_view name);
+		const std::pair<const std::string, GLint>& RegisterUniform(std::string_view name);
 
 		void Compile();
 
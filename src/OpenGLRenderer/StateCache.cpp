@@ -0,0 +1,190 @@
+#include "StateCache.hpp"
+
+namespace GL
+{
+	StateCache& StateCache::Get()
+	{
+		static StateCache s_instance;
+		return s_instance;
+	}
+
+	void StateCache::Invalidate()
+	{
+		m_capabilities.clear();
+
+		m_depthMask   = -1;
+		m_depthFunc   = Unknown;
+		m_blendSource = Unknown;
+		m_blendDest   = Unknown;
+		m_cullFace    = Unknown;
+		m_frontFace   = Unknown;
+
+		m_program         = Unknown;
+		m_vertexArray     = Unknown;
+		m_drawFrameBuffer = Unknown;
+		m_readFrameBuffer = Unknown;
+
+		m_viewport = glm::ivec4(-1);
+
+		m_activeTextureUnit = UINT32_MAX;
+		m_textures.fill(TextureBinding());
+	}
+
+	void StateCache::SetEnabled(GLenum capability, bool enabled)
+	{
+		auto it = m_capabilities.find(capability);
+		if(Update(it == m_capabilities.end() || it->second != enabled))
+		{
+			m_capabilities[capability] = enabled;
+			if(enabled)
+			{
+				glEnable(capability);
+			}
+			else
+			{
+				glDisable(capability);
+			}
+		}
+	}
+
+	void StateCache::SetDepthMask(bool write)
+	{
+		if(Update(m_depthMask != int8_t(write)))
+		{
+			m_depthMask = int8_t(write);
+			glDepthMask(write ? GL_TRUE : GL_FALSE);
+		}
+	}
+
+	void StateCache::SetDepthFunc(GLenum function)
+	{
+		if(Update(m_depthFunc != function))
+		{
+			m_depthFunc = function;
+			glDepthFunc(function);
+		}
+	}
+
+	void StateCache::SetBlendFunc(GLenum sourceFactor, GLenum destFactor)
+	{
+		if(Update(m_blendSource != sourceFactor || m_blendDest != destFactor))
+		{
+			m_blendSource = sourceFactor;
+			m_blendDest   = destFactor;
+			glBlendFunc(sourceFactor, destFactor);
+		}
+	}
+
+	void StateCache::SetCullFace(GLenum mode)
+	{
+		if(Update(m_cullFace != mode))
+		{
+			m_cullFace = mode;
+			glCullFace(mode);
+		}
+	}
+
+	void StateCache::SetFrontFace(GLenum mode)
+	{
+		if(Update(m_frontFace != mode))
+		{
+			m_frontFace = mode;
+			glFrontFace(mode);
+		}
+	}
+
+	void StateCache::UseProgram(GLuint program)
+	{
+		if(Update(m_program != program))
+		{
+			m_program = program;
+			glUseProgram(program);
+		}
+	}
+
+	void StateCache::BindVertexArray(GLuint vertexArray)
+	{
+		if(Update(m_vertexArray != vertexArray))
+		{
+			m_vertexArray = vertexArray;
+			glBindVertexArray(vertexArray);
+		}
+	}
+
+	void StateCache::BindFrameBuffer(GLenum target, GLuint frameBuffer)
+	{
+		const bool isDraw = target == GL_FRAMEBUFFER || target == GL_DRAW_FRAMEBUFFER;
+		const bool isRead = target == GL_FRAMEBUFFER || target == GL_READ_FRAMEBUFFER;
+
+		if(Update((isDraw && m_drawFrameBuffer != frameBuffer) || (isRead && m_readFrameBuffer != frameBuffer)))
+		{
+			if(isDraw) { m_drawFrameBuffer = frameBuffer; }
+			if(isRead) { m_readFrameBuffer = frameBuffer; }
+			glBindFramebuffer(target, frameBuffer);
+		}
+	}
+
+	void StateCache::SetViewport(const glm::ivec4& viewport)
+	{
+		if(Update(m_viewport != viewport))
+		{
+			m_viewport = viewport;
+			glViewport(viewport.x, viewport.y, viewport.z, viewport.w);
+		}
+	}
+
+	void StateCache::BindTexture(uint32_t unit, GLenum target, GLuint texture)
+	{
+		TextureBinding& binding = m_textures[unit];
+		if(Update(binding.Target != target || binding.Texture != texture))
+		{
+			binding.Target  = target;
+			binding.Texture = texture;
+
+			SetActiveTextureUnit(unit);
+			glBindTexture(target, texture);
+		}
+	}
+
+	void StateCache::SetActiveTextureUnit(uint32_t unit)
+	{
+		if(Update(m_activeTextureUnit != unit))
+		{
+			m_activeTextureUnit = unit;
+			glActiveTexture(GL_TEXTURE0 + unit);
+		}
+	}
+
+	void StateCache::OnProgramDeleted(GLuint program)
+	{
+		if(m_program == program)
+		{
+			m_program = Unknown;
+		}
+	}
+
+	void StateCache::OnVertexArrayDeleted(GLuint vertexArray)
+	{
+		if(m_vertexArray == vertexArray)
+		{
+			m_vertexArray = Unknown;
+		}
+	}
+
+	void StateCache::OnFrameBufferDeleted(GLuint frameBuffer)
+	{
+		if(m_drawFrameBuffer == frameBuffer) { m_drawFrameBuffer = Unknown; }
+		if(m_readFrameBuffer == frameBuffer) { m_readFrameBuffer = Unknown; }
+	}
+
+	void StateCache::OnTextureDeleted(GLuint texture)
+	{
+		for(TextureBinding& binding : m_textures)
+		{
+			if(binding.Texture == texture)
+			{
+				binding = TextureBinding();
+			}
+		}
+	}
+}
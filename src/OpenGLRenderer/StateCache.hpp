@@ -0,0 +1,95 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <unordered_map>
+
+#include <GL/glew.h>
+#include <glm/glm.hpp>
+
+namespace GL
+{
+	struct StateStatistics
+	{
+		size_t   IssuedCount = 0;
+		size_t FilteredCount = 0;
+	};
+
+	// Shadow copy of the state of the current GL context. Every state-setting call in this library goes through it
+	// and is dropped when it would not change anything. Call Invalidate after GL state was changed behind its back.
+	class StateCache
+	{
+	public:
+		static constexpr size_t TextureUnitCount = 32;
+
+		static StateCache& Get();
+
+		void Invalidate();
+
+		void SetEnabled(GLenum capability, bool enabled);
+
+		void SetDepthMask(bool write);
+		void SetDepthFunc(GLenum function);
+		void SetBlendFunc(GLenum sourceFactor, GLenum destFactor);
+		void SetCullFace(GLenum mode);
+		void SetFrontFace(GLenum mode);
+
+		void UseProgram(GLuint program);
+		void BindVertexArray(GLuint vertexArray);
+		void BindFrameBuffer(GLenum target, GLuint frameBuffer);
+		void SetViewport(const glm::ivec4& viewport);
+		void BindTexture(uint32_t unit, GLenum target, GLuint texture);
+
+		// Deleting a bound object unbinds it in GL, and its name may be handed out again.
+		void OnProgramDeleted(GLuint program);
+		void OnVertexArrayDeleted(GLuint vertexArray);
+		void OnFrameBufferDeleted(GLuint frameBuffer);
+		void OnTextureDeleted(GLuint texture);
+
+		[[nodiscard]] const StateStatistics& GetStatistics() const { return m_statistics; }
+
+		void ResetStatistics() { m_statistics = StateStatistics(); }
+	private:
+		static constexpr GLuint Unknown = UINT32_MAX;
+
+		struct TextureBinding
+		{
+			GLenum Target  = 0;
+			GLuint Texture = Unknown;
+		};
+
+		StateCache() { Invalidate(); }
+
+		std::unordered_map<GLenum, bool> m_capabilities;
+
+		int8_t m_depthMask;
+
+		GLenum m_depthFunc;
+		GLenum m_blendSource;
+		GLenum m_blendDest;
+		GLenum m_cullFace;
+		GLenum m_frontFace;
+
+		GLuint m_program;
+		GLuint m_vertexArray;
+		GLuint m_drawFrameBuffer;
+		GLuint m_readFrameBuffer;
+
+		glm::ivec4 m_viewport;
+
+		uint32_t m_activeTextureUnit;
+
+		std::array<TextureBinding, TextureUnitCount> m_textures;
+
+		StateStatistics m_statistics;
+
+		// Counts the call and reports whether it has to reach GL.
+		bool Update(bool isChanged)
+		{
+			++(isChanged ? m_statistics.IssuedCount : m_statistics.FilteredCount);
+			return isChanged;
+		}
+
+		void SetActiveTextureUnit(uint32_t unit);
+	};
+}
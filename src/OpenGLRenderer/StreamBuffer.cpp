@@ -0,0 +1,139 @@
+#include "StreamBuffer.hpp"
+
+namespace GL
+{
+    static size_t GetStorageOffsetAlignment()
+    {
+        GLint alignment = 0;
+        glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        return alignment > 0 ? size_t(alignment) : 256;
+    }
+
+    static size_t AlignUp(size_t size, size_t alignment)
+    {
+        return (size + alignment - 1) / alignment * alignment;
+    }
+
+    StreamBuffer::StreamBuffer(size_t rangeSize, size_t rangeCount) :
+        m_bufferId(0),
+        m_rangeSize(rangeSize),
+        m_alignment(GetStorageOffsetAlignment()),
+        m_capacity(AlignUp(rangeSize, m_alignment) * (rangeCount > 0 ? rangeCount : 1)),
+        m_cursor(0),
+        m_isMapped(false),
+        m_mapping(nullptr),
+        m_pendingBegin(0),
+        m_pendingEnd(0)
+    {
+        glCreateBuffers(1, &m_bufferId);
+
+        if(GLEW_ARB_buffer_storage)
+        {
+            const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+            glNamedBufferStorage(m_bufferId, GLsizeiptr(m_capacity), nullptr, flags);
+            m_mapping = static_cast<uint8_t*>(glMapNamedBufferRange(m_bufferId, 0, GLsizeiptr(m_capacity), flags));
+        }
+
+        if(!m_mapping)
+        {
+            m_staging.resize(rangeSize);
+            glNamedBufferData(m_bufferId, GLsizeiptr(rangeSize), nullptr, GL_STREAM_DRAW);
+        }
+    }
+
+    StreamBuffer::~StreamBuffer()
+    {
+        for(const Fence& fence : m_fences)
+        {
+            glDeleteSync(fence.Sync);
+        }
+
+        if(m_mapping)
+        {
+            glUnmapNamedBuffer(m_bufferId);
+        }
+        glDeleteBuffers(1, &m_bufferId);
+    }
+
+    void* StreamBuffer::Map()
+    {
+        if(!m_mapping)
+        {
+            return m_staging.data();
+        }
+
+        if(!m_isMapped)
+        {
+            if(m_cursor + m_rangeSize > m_capacity)
+            {
+                m_cursor = 0;
+            }
+
+            WaitFor(m_cursor, m_cursor + m_rangeSize);
+            m_isMapped = true;
+        }
+
+        return m_mapping + m_cursor;
+    }
+
+    void StreamBuffer::Commit(uint32_t slot, size_t sizeInBytes)
+    {
+        if(!m_mapping)
+        {
+            // Orphaning hands the old storage to the driver, which keeps it alive for queued draws.
+            glNamedBufferData(m_bufferId, GLsizeiptr(m_rangeSize), nullptr, GL_STREAM_DRAW);
+            glNamedBufferSubData(m_bufferId, 0, GLsizeiptr(sizeInBytes), m_staging.data());
+            if(sizeInBytes > 0)
+            {
+                glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot, m_bufferId, 0, GLsizeiptr(sizeInBytes));
+            }
+            return;
+        }
+
+        Map();
+        FencePending();
+
+        if(sizeInBytes > 0)
+        {
+            glBindBufferRange(GL_SHADER_STORAGE_BUFFER, slot, m_bufferId, GLintptr(m_cursor), GLsizeiptr(sizeInBytes));
+        }
+
+        m_pendingBegin = m_cursor;
+        m_pendingEnd   = m_cursor + sizeInBytes;
+
+        m_cursor   = AlignUp(m_pendingEnd, m_alignment);
+        m_isMapped = false;
+    }
+
+    void StreamBuffer::FencePending()
+    {
+        if(m_pendingEnd > m_pendingBegin)
+        {
+            m_fences.push_back({ glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0), m_pendingBegin, m_pendingEnd });
+        }
+        m_pendingBegin = m_pendingEnd = 0;
+    }
+
+    void StreamBuffer::WaitFor(size_t begin, size_t end)
+    {
+        // Only happens when the ring is too small to hold more than the range just committed.
+        if(m_pendingBegin < end && begin < m_pendingEnd)
+        {
+            FencePending();
+        }
+
+        for(auto it = m_fences.begin(); it != m_fences.end();)
+        {
+            if(it->Begin >= end || begin >= it->End)
+            {
+                ++it;
+                continue;
+            }
+
+            while(glClientWaitSync(it->Sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) == GL_TIMEOUT_EXPIRED) {}
+
+            glDeleteSync(it->Sync);
+            it = m_fences.erase(it);
+        }
+    }
+}
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "GL/glew.h"
+
+#include <deque>
+#include <vector>
+#include <cstdint>
+
+namespace GL
+{
+    // A shader storage buffer that is written through a persistently mapped, coherent ring. Every Commit publishes
+    // one range and the ring moves on; a fence per range keeps the CPU from writing over data a queued draw has yet
+    // to read. Without GL_ARB_buffer_storage the data goes through a staging copy and the buffer is orphaned on
+    // every commit instead.
+    class StreamBuffer
+    {
+    public:
+        StreamBuffer(size_t rangeSize, size_t rangeCount);
+
+        StreamBuffer(const StreamBuffer&) = delete;
+
+        ~StreamBuffer();
+
+        StreamBuffer& operator=(const StreamBuffer&) = delete;
+
+        [[nodiscard]] bool IsPersistent() const { return m_mapping != nullptr; }
+
+        // Returns rangeSize writable bytes, waiting for the GPU if they are still in use.
+        void* Map();
+
+        // Binds the first sizeInBytes bytes of the mapped range to slot. The next Map returns a new range.
+        void Commit(uint32_t slot, size_t sizeInBytes);
+    private:
+        struct Fence
+        {
+            GLsync Sync;
+            size_t Begin;
+            size_t End;
+        };
+
+        GLuint m_bufferId;
+
+        const size_t m_rangeSize;
+        const size_t m_alignment;
+        const size_t m_capacity;
+
+        size_t m_cursor;
+        bool   m_isMapped;
+
+        uint8_t*             m_mapping;
+        std::vector<uint8_t> m_staging;
+
+        std::deque<Fence> m_fences;
+
+        // The last committed range; fenced on the next commit, once the draws reading it have been issued.
+        size_t m_pendingBegin;
+        size_t m_pendingEnd;
+
+        void FencePending();
+
+        void WaitFor(size_t begin, size_t end);
+    };
+}
@@ -1,5 +1,7 @@
 #include "Texture.hpp"
 
+#include "StateCache.hpp"
+
 namespace GL
 {
 	//GLenum GetElementType(InternalFormat internalFormat)
@@ -39,6 +41,7 @@ namespace GL
 
 	Texture::~Texture()
 	{
+		StateCache::Get().OnTextureDeleted(m_ID);
 		glDeleteTextures(1, &m_ID);
 	}
 
@@ -46,8 +49,7 @@ namespace GL
 		Texture(width, height)
 	{
 		
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_2D, m_ID);
+		StateCache::Get().BindTexture(0, GL_TEXTURE_2D, m_ID);
 		glTexImage2D(GL_TEXTURE_2D, 0, (GLint)internalFormat, width, height, 0, (GLenum)format, (GLenum)elementType, pixelData);
 
 		glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, (GLint)minFilter);
@@ -65,8 +67,25 @@ namespace GL
 
 	void Texture2D::Bind(uint32_t slot)
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_2D, m_ID);
+		StateCache::Get().BindTexture(slot, GL_TEXTURE_2D, m_ID);
+	}
+
+	Texture2DArray::Texture2DArray(uint32_t width, uint32_t height, uint32_t layerCount, InternalImageFormat internalFormat, ImageFormat format, ElementType elementType, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode) :
+		Texture(width, height), LayerCount(layerCount)
+	{
+		StateCache::Get().BindTexture(0, GL_TEXTURE_2D_ARRAY, m_ID);
+		glTexImage3D(GL_TEXTURE_2D_ARRAY, 0, (GLint)internalFormat, width, height, layerCount, 0, (GLenum)format, (GLenum)elementType, nullptr);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, (GLint)minFilter);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, (GLint)magFilter);
+
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, (GLint)wrappingMode);
+		glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, (GLint)wrappingMode);
+	}
+
+	void Texture2DArray::Bind(uint32_t slot)
+	{
+		StateCache::Get().BindTexture(slot, GL_TEXTURE_2D_ARRAY, m_ID);
 	}
 
 	TextureCube::TextureCube(uint32_t width, uint32_t height, uint32_t channelCount, const void* facesPixelData, InternalImageFormat internalFormat, ImageFormat format, ElementType elementType, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode) :
@@ -74,8 +93,7 @@ namespace GL
 	{
 		size_t faceSize = size_t(width) * height * channelCount;
 
-		glActiveTexture(GL_TEXTURE0);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_ID);
+		StateCache::Get().BindTexture(0, GL_TEXTURE_CUBE_MAP, m_ID);
 		
 		std::array<GLenum, 6> faceTargets = 
 		{
@@ -108,7 +126,6 @@ namespace GL
 
 	void TextureCube::Bind(uint32_t slot)
 	{
-		glActiveTexture(GL_TEXTURE0 + slot);
-		glBindTexture(GL_TEXTURE_CUBE_MAP, m_ID);
+		StateCache::Get().BindTexture(slot, GL_TEXTURE_CUBE_MAP, m_ID);
 	}
 }
\ No newline at end of file
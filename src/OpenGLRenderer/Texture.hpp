@@ -107,6 +107,17 @@ namespace GL
 		void Bind(uint32_t slot) override;
 	};
 
+	// Layers are sampled through a sampler2DArray and rendered into one at a time by a layered FrameBuffer.
+	class Texture2DArray final : public Texture
+	{
+	public:
+		Texture2DArray(uint32_t width, uint32_t height, uint32_t layerCount, InternalImageFormat internalFormat, ImageFormat format, ElementType elementType, MinFilterMode minFilter, MagFilterMode magFilter, TextureWrappingMode wrappingMode);
+
+		const uint32_t LayerCount;
+
+		void Bind(uint32_t slot) override;
+	};
+
 	class TextureCube final : public Texture
 	{
 	public:
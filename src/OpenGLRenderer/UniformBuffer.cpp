@@ -0,0 +1,32 @@
+#include "UniformBuffer.hpp"
+
+namespace GL
+{
+    UniformBuffer::UniformBuffer(std::size_t sizeInBytes)
+    {
+        glCreateBuffers(1, &m_bufferId);
+        glNamedBufferStorage(m_bufferId, sizeInBytes, nullptr, GL_DYNAMIC_STORAGE_BIT);
+    }
+
+    UniformBuffer::~UniformBuffer()
+    {
+        glDeleteBuffers(1, &m_bufferId);
+    }
+
+    size_t UniformBuffer::GetOffsetAlignment()
+    {
+        GLint alignment = 0;
+        glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT, &alignment);
+        return alignment > 0 ? size_t(alignment) : 256;
+    }
+
+    void UniformBuffer::BindRange(uint32_t slot, size_t offset, size_t sizeInBytes) const
+    {
+        glBindBufferRange(GL_UNIFORM_BUFFER, slot, m_bufferId, GLintptr(offset), GLsizeiptr(sizeInBytes));
+    }
+
+    void UniformBuffer::UpdateData(const void* data, size_t offset, size_t sizeInBytes)
+    {
+        glNamedBufferSubData(m_bufferId, GLintptr(offset), GLsizeiptr(sizeInBytes), data);
+    }
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "GL/glew.h"
+
+namespace GL
+{
+    class UniformBuffer
+    {
+    public:
+        explicit UniformBuffer(std::size_t sizeInBytes);
+
+        UniformBuffer(const UniformBuffer&) = delete;
+
+        ~UniformBuffer();
+
+        UniformBuffer& operator=(const UniformBuffer&) = delete;
+
+        // Offsets passed to BindRange must be multiples of this.
+        static size_t GetOffsetAlignment();
+
+        void BindRange(uint32_t slot, size_t offset, size_t sizeInBytes) const;
+
+        void UpdateData(const void* data, size_t offset, size_t sizeInBytes);
+    private:
+        GLuint m_bufferId;
+    };
+}
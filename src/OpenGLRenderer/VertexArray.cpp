@@ -10,16 +10,17 @@ namespace GL
 
     VertexArray::~VertexArray()
     {
+        StateCache::Get().OnVertexArrayDeleted(m_ID);
         glDeleteVertexArrays(1, &m_ID);
     }
 
-    void VertexArray::AddAttribute(size_t count, ElementType type, size_t stride, size_t offset, bool isInstanced)
+    void VertexArray::AddAttribute(size_t count, ElementType type, bool normalized, size_t stride, size_t offset, bool isInstanced)
     {
         glEnableVertexAttribArray(GLuint(m_attributeIndex));
 
-        if(type == ElementType::Float32 || type == ElementType::Float64)
+        if(normalized || type == ElementType::Float16 || type == ElementType::Float32 || type == ElementType::Float64 || type == ElementType::SInt2101010)
         {
-            glVertexAttribPointer(GLuint(m_attributeIndex), GLint(count), (GLenum)type, GL_FALSE, GLsizei(stride), (void*)offset);
+            glVertexAttribPointer(GLuint(m_attributeIndex), GLint(count), (GLenum)type, normalized ? GL_TRUE : GL_FALSE, GLsizei(stride), (void*)offset);
         }
         else
         {
@@ -35,7 +36,7 @@ namespace GL
 
     void VertexArray::AddVertexBuffer(std::shared_ptr<VertexBuffer> vertexBuffer)
     {
-        glBindVertexArray(m_ID);
+        StateCache::Get().BindVertexArray(m_ID);
         vertexBuffer->Bind();
 
         m_vertexBuffers.push_back(vertexBuffer);
@@ -49,13 +50,13 @@ namespace GL
 
             for(size_t i = 0; i < elementSizeDiv; i++)
             {
-                AddAttribute(4, element.Type, vertexBuffer->GetLayout().GetStride(), offset, vertexBuffer->IsInstanced);
+                AddAttribute(4, element.Type, element.Normalized, vertexBuffer->GetLayout().GetStride(), offset, vertexBuffer->IsInstanced);
                 offset += GetTypeSize(element.Type) * 4;
             }
 
             if(elementSizeRem > 0)
             {
-                AddAttribute(elementSizeRem, element.Type, vertexBuffer->GetLayout().GetStride(), offset, vertexBuffer->IsInstanced);
+                AddAttribute(elementSizeRem, element.Type, element.Normalized, vertexBuffer->GetLayout().GetStride(), offset, vertexBuffer->IsInstanced);
                 offset += GetTypeSize(element.Type) * elementSizeRem;
             }
         }
@@ -63,22 +64,22 @@ namespace GL
 
     void VertexArray::SetIndexBuffer(std::shared_ptr<IndexBuffer> indexBuffer)
     {
-        glBindVertexArray(m_ID);
+        StateCache::Get().BindVertexArray(m_ID);
         indexBuffer->Bind();
         m_indexBuffer = indexBuffer;
     }
 
     void VertexArray::Draw(size_t vertexBufferIndex, DrawMode mode, size_t instanceCount) const
     {
-        glBindVertexArray(m_ID);
+        StateCache::Get().BindVertexArray(m_ID);
         glDrawArraysInstanced((GLenum)mode, 0, GLsizei(m_vertexBuffers[vertexBufferIndex]->VertexCount), GLsizei(instanceCount));
     }
 
     void VertexArray::Draw(DrawMode mode, size_t instanceCount) const
     {
-        glBindVertexArray(m_ID);
+        StateCache::Get().BindVertexArray(m_ID);
 
         if(m_indexBuffer)
-            glDrawElementsInstanced((GLenum)mode, GLsizei(m_indexBuffer->IndexCount), GL_UNSIGNED_INT, nullptr, GLsizei(instanceCount));
+            glDrawElementsInstanced((GLenum)mode, GLsizei(m_indexBuffer->IndexCount), (GLenum)m_indexBuffer->IndexType, nullptr, GLsizei(instanceCount));
     }
 }
\ No newline at end of file
@@ -4,6 +4,7 @@
 
 #include "VertexBuffer.hpp"
 #include "IndexBuffer.hpp"
+#include "StateCache.hpp"
 
 namespace GL
 {
@@ -25,13 +26,13 @@ namespace GL
 
 		size_t m_attributeIndex;
 
-		void AddAttribute(size_t count, ElementType type, size_t stride, size_t offset, bool isInstanced);
+		void AddAttribute(size_t count, ElementType type, bool normalized, size_t stride, size_t offset, bool isInstanced);
 	public:
 		VertexArray();
 
 		~VertexArray();
 
-		void Bind() const { glBindVertexArray(m_ID); }
+		void Bind() const { StateCache::Get().BindVertexArray(m_ID); }
 
 		std::shared_ptr<VertexBuffer> operator[](size_t index) const { return m_vertexBuffers[index]; }
 
@@ -12,12 +12,15 @@ namespace GL
 	class BufferElement
 	{
 	public:
-		BufferElement(ElementType type, size_t count, size_t offset) : Type(type), Count(count), Offset(offset) {}
+		BufferElement(ElementType type, size_t count, size_t offset, bool normalized) : Type(type), Count(count), Offset(offset), Normalized(normalized) {}
 
 		ElementType Type;
 		size_t      Count;
 		size_t      Offset;
 
+		// Integer components are read as floats in [0, 1] (unsigned) or [-1, 1] (signed) instead of as integers.
+		bool Normalized;
+
 		size_t SizeInBytes() const { return Count * GetTypeSize(Type); }
 	};
 
@@ -29,9 +32,9 @@ namespace GL
 	public:
 		BufferLayout() : m_stride(0) {}
 
-		void AddElement(ElementType type, size_t count)
+		void AddElement(ElementType type, size_t count, bool normalized = false)
 		{
-			const BufferElement& element = m_elements.emplace_back(type, count, m_stride);
+			const BufferElement& element = m_elements.emplace_back(type, count, m_stride, normalized);
 			m_stride += element.SizeInBytes();
 		}
 
@@ -132,7 +132,7 @@ public:
 		DeferredRendererSystem& rendererSystem = AddSystem<DeferredRendererSystem>(glm::uvec2(1024));
 		AddSystem<SkyboxRendererSystem>();
 		AddSystem<WaterRendererSystem>(glm::uvec2(1024));
-		//AddSystem<BloomRendererSystem>();
+		//AddSystem<BloomRendererSystem>(*this);
 
 		ShaderHandle skyboxShader = LoadShader("skybox_VS.glsl", "skybox_FS.glsl");
 		skyboxShader->GetMaterialField("Emission").SetDefaultValue(1.0f);
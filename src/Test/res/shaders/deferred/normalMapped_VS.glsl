@@ -1,4 +1,4 @@
-#version 330
+#version 420
 
 layout(location = 0) in vec3 a_position;
 layout(location = 1) in vec2 a_texCoord;
@@ -8,6 +8,15 @@ layout(location = 3) in vec3 a_tangent;
 layout(location = 4) in mat4 u_worldMatrix;
 layout(location = 8) in mat4 u_WVPMatrix;
 
+// FrameConstants in DeferredRendererSystem.hpp, uploaded once per frame.
+layout(std140, binding = 0) uniform FrameConstants
+{
+	mat4 viewProjection;
+	vec4 cameraPosition;
+	vec4 shadowMapSize;
+	mat4 inverseViewProjection;
+} u_frame;
+
 uniform vec4 u_clippingPlane;
 
 out vec2 v_texCoord;
@@ -19,7 +28,7 @@ void main()
 	vec4 worldPosition = u_worldMatrix * vec4(a_position, 1.0);
 	gl_ClipDistance[0] = dot(worldPosition, u_clippingPlane);
 
-	gl_Position = u_WVPMatrix * vec4(a_position, 1.0);
+	gl_Position = u_frame.viewProjection * worldPosition;
 	v_texCoord      = a_texCoord;
 	v_worldPosition = worldPosition.xyz;
 	
@@ -0,0 +1,163 @@
+#include <cmath>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <glm/gtc/packing.hpp>
+
+#include <Engine/Core/Scene.hpp>
+#include <Engine/Rendering/CompactVertex.hpp>
+
+#include "TestCheck.hpp"
+
+// Encodes random meshes into CompactVertex, decodes them the way the shaders read them and checks the errors against
+// the bounds documented on CompactEncodingError.
+
+static float GetAngleDegrees(const glm::vec3& first, const glm::vec3& second)
+{
+	return glm::degrees(std::acos(std::clamp(glm::dot(first, second), -1.0f, 1.0f)));
+}
+
+static std::vector<DefaultVertex> CreateVertices(size_t count, const glm::vec3& minimum, const glm::vec3& maximum, float texCoordRange, uint32_t seed)
+{
+	std::mt19937 random(seed);
+	std::uniform_real_distribution<float> unit(0.0f, 1.0f);
+	std::normal_distribution<float> normal;
+
+	std::vector<DefaultVertex> result;
+	for(size_t i = 0; i < count; i++)
+	{
+		const glm::vec3 position = glm::mix(minimum, maximum, glm::vec3(unit(random), unit(random), unit(random)));
+		const glm::vec2 texCoord = (glm::vec2(unit(random), unit(random)) * 2.0f - 1.0f) * texCoordRange;
+		const glm::vec3 direction = glm::normalize(glm::vec3(normal(random), normal(random), normal(random)));
+		const glm::vec3 tangent   = glm::normalize(glm::cross(direction, glm::vec3(normal(random), normal(random), normal(random))));
+
+		result.emplace_back(position, texCoord, direction, tangent);
+	}
+
+	return result;
+}
+
+static std::vector<uint32_t> CreateIndices(size_t vertexCount)
+{
+	std::vector<uint32_t> result;
+	for(uint32_t i = 0; i + 2 < vertexCount; i += 3)
+	{
+		result.insert(result.end(), { i, i + 1, i + 2 });
+	}
+	return result;
+}
+
+// Decodes every vertex of the model and returns the largest errors against the originals.
+static CompactEncodingError MeasureError(const Model& model, const std::vector<DefaultVertex>& vertices)
+{
+	const auto* compact = static_cast<const CompactVertex*>(model.Vertices->Data());
+
+	CompactEncodingError result;
+	for(size_t i = 0; i < vertices.size(); i++)
+	{
+		const glm::vec3 position = glm::vec3(model.VertexTransform * glm::vec4(glm::vec3(compact[i].Position) / 65535.0f, 1.0f));
+		const glm::vec2 texCoord(glm::unpackHalf1x16(compact[i].TexCoord[0].Bits), glm::unpackHalf1x16(compact[i].TexCoord[1].Bits));
+		const glm::vec3 normal  = glm::normalize(glm::vec3(glm::unpackSnorm3x10_1x2(compact[i].Normal.Bits)));
+		const glm::vec3 tangent = glm::normalize(glm::vec3(glm::unpackSnorm3x10_1x2(compact[i].Tangent.Bits)));
+
+		const glm::vec3 positionError = glm::abs(position - vertices[i].Position);
+		const glm::vec2 texCoordError = glm::abs(texCoord - vertices[i].TexCoord);
+
+		result.Position       = std::max({ result.Position, positionError.x, positionError.y, positionError.z });
+		result.TexCoord       = std::max({ result.TexCoord, texCoordError.x, texCoordError.y });
+		result.NormalDegrees  = std::max(result.NormalDegrees , GetAngleDegrees(vertices[i].Normal , normal ));
+		result.TangentDegrees = std::max(result.TangentDegrees, GetAngleDegrees(vertices[i].Tangent, tangent));
+	}
+
+	return result;
+}
+
+static void TestErrorBounds()
+{
+	const glm::vec3 minimum(-50.0f, 10.0f, -20.0f);
+	const glm::vec3 maximum(150.0f, 60.0f, 80.0f);
+	const float texCoordRange = 4.0f;
+
+	const std::vector<DefaultVertex> vertices = CreateVertices(30000, minimum, maximum, texCoordRange, 1234);
+	const std::vector<uint32_t>      indices  = CreateIndices(vertices.size());
+
+	CompactEncodingError reported;
+	const Model model = EncodeCompactModel(vertices, indices, &reported);
+
+	CHECK(model.GetLayout().GetStride() == sizeof(CompactVertex));
+	CHECK(sizeof(CompactVertex) == 20);
+	CHECK(model.Vertices->Count() == vertices.size());
+	CHECK(*model.Indices == indices);
+
+	const CompactEncodingError measured = MeasureError(model, vertices);
+	std::printf("Compact vertices: position %.6f, tex coord %.6f, normal %.4f degrees, tangent %.4f degrees\n",
+	            measured.Position, measured.TexCoord, measured.NormalDegrees, measured.TangentDegrees);
+
+	// The reported errors are the ones the shaders will see.
+	CHECK(std::abs(reported.Position - measured.Position) <= 1e-5f);
+	CHECK(reported.TexCoord == measured.TexCoord);
+
+	// acos close to 1 only resolves a few hundredths of a degree in float.
+	CHECK(std::abs(reported.NormalDegrees  - measured.NormalDegrees ) <= 0.03f);
+	CHECK(std::abs(reported.TangentDegrees - measured.TangentDegrees) <= 0.03f);
+
+	// Half a quantization step of the largest extent, plus float rounding of the transform.
+	const float size = 200.0f;
+	CHECK(measured.Position <= size / 131070.0f * 1.01f);
+	CHECK(measured.TexCoord <= texCoordRange / 2048.0f);
+
+	// Half a 10-bit step on each of three components is under a tenth of a degree.
+	CHECK(measured.NormalDegrees  < 0.1f);
+	CHECK(measured.TangentDegrees < 0.1f);
+
+	// The bounds are those of the original positions and the transform maps the quantized cube onto them.
+	AABB bounds(vertices[0].Position, vertices[0].Position);
+	for(const DefaultVertex& vertex : vertices)
+	{
+		bounds.Minimum = glm::min(bounds.Minimum, vertex.Position);
+		bounds.Maximum = glm::max(bounds.Maximum, vertex.Position);
+	}
+
+	CHECK(model.Bounds.Minimum == bounds.Minimum && model.Bounds.Maximum == bounds.Maximum);
+	CHECK(glm::vec3(model.VertexTransform[3]) == bounds.Minimum);
+	CHECK(model.VertexTransform[0][0] == model.VertexTransform[1][1] && model.VertexTransform[1][1] == model.VertexTransform[2][2]);
+}
+
+// A flat mesh still gets a uniform scale, so the flat axis keeps its single value exactly.
+static void TestFlatMesh()
+{
+	std::vector<DefaultVertex> vertices = CreateVertices(1000, glm::vec3(-1.0f, 2.0f, -1.0f), glm::vec3(1.0f, 2.0f, 1.0f), 1.0f, 5678);
+
+	CompactEncodingError reported;
+	const Model model = EncodeCompactModel(vertices, CreateIndices(vertices.size()), &reported);
+
+	const auto* compact = static_cast<const CompactVertex*>(model.Vertices->Data());
+	CHECK(std::all_of(compact, compact + vertices.size(), [](const CompactVertex& vertex) { return vertex.Position.y == 0; }));
+	CHECK(reported.Position <= 2.0f / 131070.0f * 1.01f);
+}
+
+// An empty mesh and zero-length normals encode without producing NaNs.
+static void TestDegenerate()
+{
+	CompactEncodingError reported;
+	const Model empty = EncodeCompactModel({}, {}, &reported);
+	CHECK(empty.Vertices->Count() == 0);
+	CHECK(reported.Position == 0.0f && reported.NormalDegrees == 0.0f);
+
+	const std::vector<DefaultVertex> vertices = { DefaultVertex(glm::vec3(1.0f), glm::vec2(0.5f), glm::vec3(0.0f)) };
+	const Model single = EncodeCompactModel(vertices, {}, &reported);
+
+	const auto* compact = static_cast<const CompactVertex*>(single.Vertices->Data());
+	CHECK(glm::unpackSnorm3x10_1x2(compact[0].Normal.Bits) == glm::vec4(0.0f));
+	CHECK(reported.Position == 0.0f);
+	CHECK(!std::isnan(reported.NormalDegrees) && !std::isnan(reported.TangentDegrees));
+}
+
+int main()
+{
+	TestErrorBounds();
+	TestFlatMesh();
+	TestDegenerate();
+	return FinishTests("CompactVertexTest");
+}
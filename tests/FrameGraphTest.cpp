@@ -0,0 +1,175 @@
+#include <memory>
+#include <string>
+
+#include <Engine/Rendering/FrameGraph.hpp>
+#include <Engine/Platform/Null/NullRenderDevice.hpp>
+
+#include "TestCheck.hpp"
+
+// Compiles small frame graphs and checks culling, clear and copy placement and transient target aliasing, then
+// executes them on the headless device.
+
+static const AttachmentInfo ColorAttachment(InternalImageFormat::RGBA8, ImageFormat::RGBA, TypeInfo::Get<glm::u8vec4>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge);
+static const AttachmentInfo DepthAttachment(InternalImageFormat::DepthComponent32, ImageFormat::DepthComponent, TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge);
+
+static void TestDeferredFrame()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), std::make_shared<RenderCommandLog>());
+
+	const RenderTargetDescription gBufferDescription(1280, 720, { ColorAttachment, ColorAttachment }, DepthAttachment);
+	const RenderTargetDescription debugDescription(640, 360, { ColorAttachment });
+
+	int executedCount = 0;
+	auto execute = [&executedCount](RenderDevice&, const FrameGraph&) { ++executedCount; };
+
+	FrameGraph graph;
+	const FrameGraphTarget output = graph.ImportTarget("Target", *renderDevice.ScreenBuffer, ColorBuffer);
+
+	// Cleared and then fully drawn over by the lighting pass, so culled.
+	graph.AddPass("Clear target", [&](FrameGraphBuilder& builder) { builder.Clear(output, ColorBuffer | DepthBuffer); });
+
+	const FrameGraphTarget gBuffer = graph.CreateTarget("G-buffer", gBufferDescription);
+	graph.AddPass("Geometry", [&](FrameGraphBuilder& builder)
+	{
+		builder.Clear(gBuffer, ColorBuffer | DepthBuffer);
+		builder.Write(gBuffer, ColorBuffer | DepthBuffer);
+	}, execute);
+
+	graph.AddPass("Lighting", [&](FrameGraphBuilder& builder)
+	{
+		builder.Read(gBuffer, ColorBuffer | DepthBuffer);
+		builder.Require(output, gBuffer, DepthBuffer);
+		builder.Clear(output, ColorBuffer);
+		builder.Write(output, ColorBuffer);
+	}, execute);
+
+	// The target already holds the G-buffer's depth, so it is not copied again.
+	graph.AddPass("Transparent", [&](FrameGraphBuilder& builder)
+	{
+		builder.Require(output, gBuffer, DepthBuffer);
+		builder.Write(output, ColorBuffer);
+	}, execute);
+
+	// Nothing reads what this draws.
+	const FrameGraphTarget debug = graph.CreateTarget("Debug", debugDescription);
+	graph.AddPass("Debug view", [&](FrameGraphBuilder& builder)
+	{
+		builder.Read(gBuffer, ColorBuffer);
+		builder.Clear(debug, ColorBuffer);
+		builder.Write(debug, ColorBuffer);
+	}, execute);
+
+	graph.Compile();
+	std::printf("%s\n", graph.Dump().c_str());
+
+	const FrameGraphStatistics& statistics = graph.GetStatistics();
+	CHECK(statistics.PassCount == 5);
+	CHECK(statistics.CulledPassCount == 2);
+	CHECK(graph.IsCulled(0) && graph.IsCulled(4));
+	CHECK(statistics.RequestedClearCount == 4 && statistics.ClearCount == 2);
+	CHECK(statistics.RequestedCopyCount == 2 && statistics.CopyCount == 1);
+	CHECK(statistics.TransientTargetCount == 1);
+
+	graph.Execute(renderDevice);
+	CHECK(executedCount == 3);
+}
+
+static void TestClearMerging()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), std::make_shared<RenderCommandLog>());
+
+	auto execute = [](RenderDevice&, const FrameGraph&) {};
+
+	FrameGraph graph;
+	const FrameGraphTarget output = graph.ImportTarget("Target", *renderDevice.ScreenBuffer, ColorBuffer);
+
+	// Clears of separate buffers of one target merge into one call when nothing uses them in between.
+	graph.AddPass("Sky", [&](FrameGraphBuilder& builder)
+	{
+		builder.Clear(output, ColorBuffer);
+		builder.Write(output, ColorBuffer);
+	}, execute);
+
+	graph.AddPass("Opaque", [&](FrameGraphBuilder& builder)
+	{
+		builder.Clear(output, DepthBuffer);
+		builder.Write(output, ColorBuffer | DepthBuffer);
+	}, execute);
+
+	// A buffer cleared twice without being used in between is only cleared once.
+	graph.AddPass("Overlay", [&](FrameGraphBuilder& builder)
+	{
+		builder.Clear(output, StencilBuffer);
+		builder.Clear(output, StencilBuffer);
+		builder.Write(output, ColorBuffer | StencilBuffer);
+	}, execute);
+
+	graph.Compile();
+	std::printf("%s\n", graph.Dump().c_str());
+
+	CHECK(graph.GetStatistics().CulledPassCount == 0);
+	CHECK(graph.GetStatistics().ClearCount == 1);
+	CHECK(graph.GetSteps()[0].Type == FrameGraphStepType::Clear);
+	CHECK(graph.GetSteps()[0].BufferType == (ColorBuffer | DepthBuffer | StencilBuffer));
+}
+
+static void TestAliasing()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), std::make_shared<RenderCommandLog>());
+
+	const RenderTargetDescription description(640, 360, { ColorAttachment });
+
+	int executedCount = 0;
+	auto execute = [&executedCount](RenderDevice&, const FrameGraph&) { ++executedCount; };
+
+	FrameGraph graph;
+	const FrameGraphTarget output = graph.ImportTarget("Target", *renderDevice.ScreenBuffer, ColorBuffer);
+
+	// A blur chain where each level only lives from the pass drawing it to the pass reading it: two physical
+	// targets take turns.
+	FrameGraphTarget previous = graph.CreateTarget("Level 0", description);
+	graph.AddPass("Downsample", [&](FrameGraphBuilder& builder) { builder.Write(previous, ColorBuffer); }, execute);
+
+	for(int i = 1; i < 6; i++)
+	{
+		const FrameGraphTarget next = graph.CreateTarget("Level " + std::to_string(i), description);
+		graph.AddPass("Blur " + std::to_string(i), [&, previous, next](FrameGraphBuilder& builder)
+		{
+			builder.Read(previous, ColorBuffer);
+			builder.Write(next, ColorBuffer);
+		}, execute);
+		previous = next;
+	}
+
+	graph.AddPass("Composite", [&](FrameGraphBuilder& builder)
+	{
+		builder.Read(previous, ColorBuffer);
+		builder.Write(output, ColorBuffer);
+	}, execute);
+
+	graph.Compile();
+	std::printf("%s\n", graph.Dump().c_str());
+
+	CHECK(graph.GetStatistics().TransientTargetCount == 6);
+	CHECK(graph.GetStatistics().PhysicalTargetCount == 2);
+
+	graph.Execute(renderDevice);
+	CHECK(executedCount == 7);
+
+	// The pool only allocated the two physical targets.
+	renderDevice.TargetPool.EndFrame();
+	CHECK(renderDevice.TargetPool.GetStatistics().TargetCount == 2);
+
+	// Running the frame again reuses them.
+	graph.Execute(renderDevice);
+	renderDevice.TargetPool.EndFrame();
+	CHECK(renderDevice.TargetPool.GetStatistics().TargetCount == 2);
+}
+
+int main()
+{
+	TestDeferredFrame();
+	TestClearMerging();
+	TestAliasing();
+	return FinishTests("FrameGraphTest");
+}
@@ -0,0 +1,116 @@
+#include <cmath>
+#include <random>
+#include <algorithm>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Engine/Rendering/GBufferPacking.hpp>
+
+#include "TestCheck.hpp"
+
+// Round-trips the compact G-buffer packing through the precision of its attachments: normals through the RG16F
+// attachment and positions through the 32-bit depth buffer.
+
+// Rounds to the nearest value a 16-bit float holds, which has 11 significant bits.
+static float QuantizeHalf(float value)
+{
+	if(value == 0.0f)
+	{
+		return 0.0f;
+	}
+
+	int exponent;
+	const float mantissa = std::frexp(value, &exponent);
+	return std::ldexp(std::round(mantissa * 2048.0f) / 2048.0f, exponent);
+}
+
+static float GetAngle(const glm::vec3& first, const glm::vec3& second)
+{
+	return std::acos(std::clamp(glm::dot(first, second), -1.0f, 1.0f));
+}
+
+static void TestOctahedralNormals()
+{
+	std::mt19937 random(1234);
+	std::normal_distribution<float> distribution;
+
+	float maximumError = 0.0f;
+	for(int i = 0; i < 100000; i++)
+	{
+		const glm::vec3 normal = glm::normalize(glm::vec3(distribution(random), distribution(random), distribution(random)));
+
+		const glm::vec2 encoded = EncodeOctahedral(normal);
+		CHECK(std::abs(encoded.x) <= 1.0f && std::abs(encoded.y) <= 1.0f);
+
+		const glm::vec3 decoded = DecodeOctahedral(glm::vec2(QuantizeHalf(encoded.x), QuantizeHalf(encoded.y)));
+		maximumError = std::max(maximumError, GetAngle(normal, decoded));
+	}
+
+	std::printf("Octahedral normals: largest error %.5f degrees\n", glm::degrees(maximumError));
+	CHECK(maximumError < glm::radians(0.1f));
+
+	// The poles, the equator and the folded corners.
+	for(const glm::vec3& normal : { glm::vec3(0, 0, 1), glm::vec3(0, 0, -1), glm::vec3(1, 0, 0), glm::vec3(0, -1, 0), glm::normalize(glm::vec3(-1, -1, -1)), glm::normalize(glm::vec3(1, -1, -0.001f)) })
+	{
+		CHECK(GetAngle(normal, DecodeOctahedral(EncodeOctahedral(normal))) < 1e-3f);
+	}
+}
+
+static void TestSpecularIntensity()
+{
+	for(const float intensity : { 0.0f, 0.5f, 1.0f, 4.0f, 16.0f })
+	{
+		const glm::vec4 packed = PackAlbedoSpecular(glm::vec3(0.25f), intensity);
+
+		// Through the 8-bit alpha channel.
+		const glm::vec4 stored(glm::vec3(packed), std::round(packed.a * 255.0f) / 255.0f);
+		CHECK(std::abs(UnpackSpecularIntensity(stored) - intensity) <= MaxPackedSpecularIntensity / 255.0f * 0.5f + 1e-5f);
+	}
+
+	CHECK(UnpackSpecularIntensity(PackAlbedoSpecular(glm::vec3(0.0f), 100.0f)) == MaxPackedSpecularIntensity);
+}
+
+static void TestPositionReconstruction()
+{
+	const glm::mat4 projection     = glm::perspective(glm::radians(70.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+	const glm::mat4 view           = glm::lookAt(glm::vec3(3.0f, 2.0f, -5.0f), glm::vec3(0.0f, 1.0f, 4.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+	const glm::mat4 viewProjection = projection * view;
+	const glm::mat4 inverse        = glm::inverse(viewProjection);
+
+	std::mt19937 random(5678);
+	std::uniform_real_distribution<float> screenDistribution(0.0f, 1.0f);
+	std::uniform_real_distribution<float> depthDistribution(0.5f, 50.0f);
+
+	float maximumRelativeError = 0.0f;
+	for(int i = 0; i < 10000; i++)
+	{
+		// A point along the ray through a random pixel, at a random distance from the camera.
+		const glm::vec2 texCoord(screenDistribution(random), screenDistribution(random));
+		const glm::vec3 nearPoint = ReconstructPosition(texCoord, 0.0f, inverse);
+		const glm::vec3  farPoint = ReconstructPosition(texCoord, 1.0f, inverse);
+
+		const glm::vec3 position = nearPoint + glm::normalize(farPoint - nearPoint) * depthDistribution(random);
+
+		const glm::vec4 clip = viewProjection * glm::vec4(position, 1.0f);
+		const glm::vec3 ndc  = glm::vec3(clip) / clip.w;
+
+		// A 32-bit float depth buffer keeps the depth to its own precision.
+		const float depth = ndc.z * 0.5f + 0.5f;
+
+		const glm::vec3 reconstructed = ReconstructPosition(glm::vec2(ndc) * 0.5f + 0.5f, depth, inverse);
+
+		const float distance = glm::distance(position, glm::vec3(3.0f, 2.0f, -5.0f));
+		maximumRelativeError = std::max(maximumRelativeError, glm::distance(position, reconstructed) / distance);
+	}
+
+	std::printf("Position reconstruction: largest error %.6f%% of the distance\n", maximumRelativeError * 100.0f);
+	CHECK(maximumRelativeError < 0.01f);
+}
+
+int main()
+{
+	TestOctahedralNormals();
+	TestSpecularIntensity();
+	TestPositionReconstruction();
+	return FinishTests("GBufferPackingTest");
+}
@@ -0,0 +1,222 @@
+#include <random>
+#include <vector>
+#include <numeric>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Engine/Rendering/LightClusterGrid.hpp>
+
+#include "TestCheck.hpp"
+
+// Assigns lights on the CPU and checks the clusters against points sampled inside the lights.
+
+static const glm::mat4 Projection = glm::perspective(glm::radians(90.0f), 16.0f / 9.0f, 0.1f, 100.0f);
+
+// Cluster containing a view space point, or false if the point is outside the frustum.
+static bool GetCluster(const LightClusterGrid& grid, const glm::vec3& point, uint32_t& cluster)
+{
+	const glm::vec4 clip = Projection * glm::vec4(point, 1.0f);
+	if(clip.w <= 0.0f)
+	{
+		return false;
+	}
+
+	const glm::vec3 ndc = glm::vec3(clip) / clip.w;
+	if(glm::any(glm::greaterThanEqual(glm::abs(ndc), glm::vec3(1.0f))))
+	{
+		return false;
+	}
+
+	const auto x = uint32_t((ndc.x * 0.5f + 0.5f) * float(grid.TilesX));
+	const auto y = uint32_t((ndc.y * 0.5f + 0.5f) * float(grid.TilesY));
+
+	cluster = grid.GetClusterIndex(x, y, grid.GetSlice(-point.z));
+	return true;
+}
+
+static glm::vec3 GetRandomPointInSphere(std::mt19937& random, const glm::vec3& center, float radius)
+{
+	std::uniform_real_distribution<float> distribution(-1.0f, 1.0f);
+
+	glm::vec3 offset;
+	do
+	{
+		offset = glm::vec3(distribution(random), distribution(random), distribution(random));
+	}
+	while(glm::dot(offset, offset) > 1.0f);
+
+	return center + offset * radius;
+}
+
+static bool IsInCone(const ClusterLight& light, const glm::vec3& point)
+{
+	const glm::vec3 offset = point - light.Position;
+	return glm::length(offset) <= light.Range && glm::dot(glm::normalize(offset), light.Direction) >= light.CosAngle;
+}
+
+static uint32_t GetTotalCount(const LightClusterGrid& grid)
+{
+	return std::accumulate(grid.GetLightCounts().begin(), grid.GetLightCounts().end(), 0u);
+}
+
+static void TestSlices()
+{
+	LightClusterGrid grid;
+	grid.SetProjection(Projection);
+
+	CHECK(grid.GetSlice(0.01f) == 0);
+	CHECK(grid.GetSlice(0.11f) == 0);
+	CHECK(grid.GetSlice(99.0f) == grid.Slices - 1);
+	CHECK(grid.GetSlice(1000.0f) == grid.Slices - 1);
+
+	// Logarithmic slices: every tenfold distance covers the same number of slices.
+	CHECK(grid.GetSlice(10.5f) - grid.GetSlice(1.05f) == grid.Slices / 3);
+}
+
+// Every cluster holding part of a light has to count it; the tests are conservative, so clusters just outside may
+// count it too.
+static void TestCoverage()
+{
+	LightClusterGrid grid;
+	grid.SetProjection(Projection);
+
+	std::mt19937 random(1234);
+
+	ClusterLight pointLight;
+	pointLight.Position = glm::vec3(2.0f, -1.0f, -8.0f);
+	pointLight.Range    = 3.0f;
+
+	ClusterLight spotLight;
+	spotLight.Position  = glm::vec3(-3.0f, 2.0f, -5.0f);
+	spotLight.Range     = 10.0f;
+	spotLight.Direction = glm::normalize(glm::vec3(0.5f, -0.3f, -1.0f));
+	spotLight.CosAngle  = std::cos(glm::radians(25.0f));
+
+	for(const ClusterLight& light : { pointLight, spotLight })
+	{
+		grid.Assign(std::span<const ClusterLight>(&light, 1));
+
+		size_t sampleCount = 0;
+		for(int i = 0; i < 20000; i++)
+		{
+			const glm::vec3 point = GetRandomPointInSphere(random, light.Position, light.Range);
+
+			uint32_t cluster;
+			if((light.CosAngle > 0.0f && !IsInCone(light, point)) || !GetCluster(grid, point, cluster))
+			{
+				continue;
+			}
+
+			++sampleCount;
+			CHECK(grid.GetLightCounts()[cluster] == 1);
+		}
+		CHECK(sampleCount > 500);
+
+		// The screen rectangle covers the light's center.
+		const glm::vec4& rect = grid.GetScreenRect(0);
+		const glm::vec4  clip = Projection * glm::vec4(light.Position, 1.0f);
+		const glm::vec2  ndc  = glm::vec2(clip) / clip.w;
+		CHECK(rect.x <= ndc.x && ndc.x <= rect.z && rect.y <= ndc.y && ndc.y <= rect.w);
+	}
+}
+
+static void TestCulling()
+{
+	LightClusterGrid grid;
+	grid.SetProjection(Projection);
+
+	std::vector<ClusterLight> lights(3);
+
+	// Behind the camera.
+	lights[0].Position = glm::vec3(0.0f, 0.0f, 5.0f);
+	lights[0].Range    = 2.0f;
+
+	// Small and in the middle of the screen, so it only touches a few tiles.
+	lights[1].Position = glm::vec3(0.0f, 0.0f, -20.0f);
+	lights[1].Range    = 0.5f;
+
+	// A spot light pointing right, with the space to its left in range but behind it.
+	lights[2].Position  = glm::vec3(0.0f, 0.0f, -10.0f);
+	lights[2].Range     = 6.0f;
+	lights[2].Direction = glm::vec3(1.0f, 0.0f, 0.0f);
+	lights[2].CosAngle  = std::cos(glm::radians(20.0f));
+
+	grid.Assign(lights);
+
+	const glm::vec4& behind = grid.GetScreenRect(0);
+	CHECK(behind.x > behind.z && behind.y > behind.w);
+
+	const glm::vec4& small = grid.GetScreenRect(1);
+	CHECK(small.x < 0.0f && small.z > 0.0f && small.y < 0.0f && small.w > 0.0f);
+	CHECK(small.z - small.x < 0.5f && small.w - small.y < 0.5f);
+
+	uint32_t cluster;
+	CHECK(GetCluster(grid, glm::vec3(-5.0f, 0.0f, -10.0f), cluster));
+	CHECK(grid.GetLightCounts()[cluster] == 0);
+
+	CHECK(GetCluster(grid, glm::vec3(5.0f, 0.0f, -10.0f), cluster));
+	CHECK(grid.GetLightCounts()[cluster] == 1);
+
+	// Assigning again starts over.
+	grid.Assign(std::span<const ClusterLight>());
+	CHECK(GetTotalCount(grid) == 0);
+}
+
+// The lists hold exactly the listed lights each cluster counts, in ascending order, and unlisted lights still get
+// their screen rectangle.
+static void TestLists()
+{
+	LightClusterGrid grid;
+	grid.SetProjection(Projection);
+
+	std::vector<ClusterLight> lights(3);
+	for(uint32_t i = 0; i < lights.size(); i++)
+	{
+		lights[i].Position = glm::vec3(float(i) - 1.0f, 0.0f, -6.0f);
+		lights[i].Range    = 2.5f;
+	}
+	lights[1].IsListed = false;
+
+	grid.Assign(lights);
+
+	const std::vector<uint32_t>& counts  = grid.GetLightCounts();
+	const std::vector<uint32_t>& offsets = grid.GetLightOffsets();
+	const std::vector<uint32_t>& indices = grid.GetLightIndices();
+
+	CHECK(indices.size() == GetTotalCount(grid));
+
+	uint32_t sharedClusters = 0;
+	for(size_t cluster = 0; cluster < counts.size(); cluster++)
+	{
+		if(cluster + 1 < counts.size())
+		{
+			CHECK(offsets[cluster] + counts[cluster] == offsets[cluster + 1]);
+		}
+
+		for(uint32_t i = 0; i < counts[cluster]; i++)
+		{
+			const uint32_t lightIndex = indices[offsets[cluster] + i];
+			CHECK(lightIndex != 1);
+			CHECK(i == 0 || indices[offsets[cluster] + i - 1] < lightIndex);
+		}
+
+		sharedClusters += counts[cluster] == 2 ? 1 : 0;
+	}
+	CHECK(sharedClusters > 0);
+
+	uint32_t cluster;
+	CHECK(GetCluster(grid, lights[1].Position, cluster));
+	CHECK(counts[cluster] == 2);
+
+	const glm::vec4& unlisted = grid.GetScreenRect(1);
+	CHECK(unlisted.x < 0.0f && unlisted.z > 0.0f);
+}
+
+int main()
+{
+	TestSlices();
+	TestCoverage();
+	TestCulling();
+	TestLists();
+	return FinishTests("LightClusterGridTest");
+}
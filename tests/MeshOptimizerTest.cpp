@@ -0,0 +1,184 @@
+#include <array>
+#include <tuple>
+#include <random>
+#include <vector>
+#include <algorithm>
+
+#include <Engine/Rendering/MeshOptimizer.hpp>
+
+#include "TestCheck.hpp"
+
+// Optimizes an unwelded, shuffled grid and checks the vertex cache statistics before and after, and that the
+// triangles themselves survive every stage.
+
+struct TestVertex
+{
+	glm::vec3 Position;
+};
+
+static constexpr uint32_t GridSize = 64;
+
+// Every triangle of a GridSize x GridSize quad grid with its own three vertices, in random order.
+static void CreateGrid(std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices)
+{
+	std::vector<std::array<glm::vec3, 3>> triangles;
+	for(uint32_t y = 0; y < GridSize; y++)
+	{
+		for(uint32_t x = 0; x < GridSize; x++)
+		{
+			const glm::vec3 corner00(float(x), float(y), 0.0f);
+			const glm::vec3 corner10(float(x + 1), float(y), 0.0f);
+			const glm::vec3 corner01(float(x), float(y + 1), 0.0f);
+			const glm::vec3 corner11(float(x + 1), float(y + 1), 0.0f);
+
+			triangles.push_back({ corner00, corner10, corner01 });
+			triangles.push_back({ corner01, corner10, corner11 });
+		}
+	}
+
+	std::mt19937 random(1234);
+	std::shuffle(triangles.begin(), triangles.end(), random);
+
+	for(const auto& triangle : triangles)
+	{
+		for(const glm::vec3& position : triangle)
+		{
+			indices.push_back(uint32_t(vertices.size()));
+			vertices.push_back({ position });
+		}
+	}
+}
+
+// The triangles as sorted position triples, so two index orders can be compared regardless of winding start.
+static std::vector<std::array<float, 9>> GetTriangles(const std::vector<TestVertex>& vertices, const std::vector<uint32_t>& indices)
+{
+	std::vector<std::array<float, 9>> result;
+	for(size_t i = 0; i < indices.size(); i += 3)
+	{
+		std::array<glm::vec3, 3> corners = { vertices[indices[i]].Position, vertices[indices[i + 1]].Position, vertices[indices[i + 2]].Position };
+
+		// Rotate the smallest corner to the front, keeping the winding.
+		const auto less = [](const glm::vec3& first, const glm::vec3& second) { return std::tie(first.x, first.y, first.z) < std::tie(second.x, second.y, second.z); };
+		std::rotate(corners.begin(), std::min_element(corners.begin(), corners.end(), less), corners.end());
+
+		result.push_back({ corners[0].x, corners[0].y, corners[0].z, corners[1].x, corners[1].y, corners[1].z, corners[2].x, corners[2].y, corners[2].z });
+	}
+
+	std::sort(result.begin(), result.end());
+	return result;
+}
+
+static void TestAnalyze()
+{
+	// Two triangles sharing an edge load four vertices.
+	const std::vector<uint32_t> quad = { 0, 1, 2, 2, 1, 3 };
+	const VertexCacheStatistics statistics = MeshOptimizer::AnalyzeVertexCache(quad, 4);
+	CHECK(statistics.ACMR == 2.0f);
+	CHECK(statistics.ATVR == 1.0f);
+
+	// With a FIFO of three, loading the fourth vertex evicts the first, which the next triangle loads once again.
+	const std::vector<uint32_t> fan = { 0, 1, 2, 0, 2, 3, 0, 3, 4, 0, 4, 5 };
+	CHECK(MeshOptimizer::AnalyzeVertexCache(fan, 6, 3).ACMR == 7.0f / 4.0f);
+	CHECK(MeshOptimizer::AnalyzeVertexCache(fan, 6, 16).ACMR == 6.0f / 4.0f);
+
+	// A single entry still hits a vertex used twice in a row.
+	const std::vector<uint32_t> repeated = { 0, 0, 1, 1, 1, 2 };
+	CHECK(MeshOptimizer::AnalyzeVertexCache(repeated, 3, 1).ACMR == 3.0f / 2.0f);
+}
+
+static void TestOptimize()
+{
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t>   indices;
+	CreateGrid(vertices, indices);
+
+	const auto trianglesBefore = GetTriangles(vertices, indices);
+
+	const MeshOptimizationReport report = MeshOptimizer::Optimize(vertices, indices);
+	std::printf("Grid: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f, %zu -> %zu vertices\n",
+	            report.Before.ACMR, report.After.ACMR, report.Before.ATVR, report.After.ATVR, report.VertexCountBefore, report.VertexCountAfter);
+
+	// Unwelded, every vertex is loaded once per triangle.
+	CHECK(report.Before.ACMR == 3.0f);
+	CHECK(report.Before.ATVR == 1.0f);
+
+	CHECK(report.VertexCountBefore == GridSize * GridSize * 6);
+	CHECK(report.VertexCountAfter == (GridSize + 1) * (GridSize + 1));
+	CHECK(vertices.size() == report.VertexCountAfter);
+
+	// A regular grid is close to 0.5 with an ideal cache; well under 1 through a 16 entry FIFO.
+	CHECK(report.After.ACMR < 0.8f);
+	CHECK(report.After.ATVR < 1.6f);
+
+	const VertexCacheStatistics after = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size());
+	CHECK(after.ACMR == report.After.ACMR && after.ATVR == report.After.ATVR);
+
+	CHECK(GetTriangles(vertices, indices) == trianglesBefore);
+
+	// Vertices are laid out in the order they are first referenced.
+	uint32_t nextVertex = 0;
+	for(const uint32_t index : indices)
+	{
+		CHECK(index <= nextVertex);
+		if(index == nextVertex)
+		{
+			nextVertex++;
+		}
+	}
+	CHECK(nextVertex == vertices.size());
+}
+
+// The stages run on their own keep the triangles too; the fetch pass drops vertices nothing references.
+static void TestStages()
+{
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t>   indices;
+	CreateGrid(vertices, indices);
+
+	const auto trianglesBefore = GetTriangles(vertices, indices);
+
+	vertices.resize(MeshOptimizer::WeldVertices(vertices.data(), vertices.size(), sizeof(TestVertex), indices));
+	CHECK(vertices.size() == (GridSize + 1) * (GridSize + 1));
+	CHECK(GetTriangles(vertices, indices) == trianglesBefore);
+
+	const float shuffledACMR = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).ACMR;
+
+	MeshOptimizer::OptimizeVertexCache(indices, vertices.size());
+	const float cacheACMR = MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).ACMR;
+	CHECK(cacheACMR < shuffledACMR * 0.5f);
+	CHECK(GetTriangles(vertices, indices) == trianglesBefore);
+
+	std::vector<glm::vec3> positions;
+	for(const TestVertex& vertex : vertices)
+	{
+		positions.push_back(vertex.Position);
+	}
+
+	MeshOptimizer::OptimizeOverdraw(indices, positions);
+	CHECK(MeshOptimizer::AnalyzeVertexCache(indices, vertices.size()).ACMR <= cacheACMR * MeshOptimizer::OverdrawThreshold + 1e-5f);
+	CHECK(GetTriangles(vertices, indices) == trianglesBefore);
+
+	// Drop the top row of quads so the top row of vertices is no longer referenced.
+	std::vector<uint32_t> remaining;
+	for(size_t i = 0; i < indices.size(); i += 3)
+	{
+		if(std::max({ vertices[indices[i]].Position.y, vertices[indices[i + 1]].Position.y, vertices[indices[i + 2]].Position.y }) < float(GridSize))
+		{
+			remaining.insert(remaining.end(), indices.begin() + i, indices.begin() + i + 3);
+		}
+	}
+	indices = remaining;
+	const auto trianglesRemaining = GetTriangles(vertices, indices);
+
+	vertices.resize(MeshOptimizer::OptimizeVertexFetch(vertices.data(), vertices.size(), sizeof(TestVertex), indices));
+	CHECK(vertices.size() == GridSize * (GridSize + 1));
+	CHECK(GetTriangles(vertices, indices) == trianglesRemaining);
+}
+
+int main()
+{
+	TestAnalyze();
+	TestOptimize();
+	TestStages();
+	return FinishTests("MeshOptimizerTest");
+}
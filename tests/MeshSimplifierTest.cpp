@@ -0,0 +1,215 @@
+#include <cmath>
+#include <vector>
+#include <algorithm>
+
+#include <glm/gtc/constants.hpp>
+
+#include <Engine/Rendering/MeshSimplifier.hpp>
+#include <Engine/EngineComponents/LODGroup.hpp>
+
+#include "TestCheck.hpp"
+
+// Builds LOD chains for a plane and a sphere, checks the reported errors against how far the levels actually stray,
+// and steps LOD selection back and forth over a switching distance.
+
+struct TestVertex
+{
+	glm::vec3 Position;
+
+	static BufferLayout GetLayout()
+	{
+		BufferLayout result;
+		result.AddAttribute<decltype(Position)>();
+		return result;
+	}
+};
+
+static void CreatePlane(uint32_t size, std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices)
+{
+	for(uint32_t y = 0; y <= size; y++)
+	{
+		for(uint32_t x = 0; x <= size; x++)
+		{
+			vertices.push_back({ glm::vec3(float(x), float(y), 0.0f) });
+		}
+	}
+
+	for(uint32_t y = 0; y < size; y++)
+	{
+		for(uint32_t x = 0; x < size; x++)
+		{
+			const uint32_t corner = y * (size + 1) + x;
+			indices.insert(indices.end(), { corner, corner + 1, corner + size + 1, corner + size + 1, corner + 1, corner + size + 2 });
+		}
+	}
+}
+
+// A closed unit sphere with one vertex at each pole.
+static void CreateSphere(uint32_t detail, std::vector<TestVertex>& vertices, std::vector<uint32_t>& indices)
+{
+	vertices.push_back({ glm::vec3(0.0f, 1.0f, 0.0f) });
+	for(uint32_t stack = 1; stack < detail; stack++)
+	{
+		const float polar = glm::pi<float>() * float(stack) / float(detail);
+		for(uint32_t sector = 0; sector < detail; sector++)
+		{
+			const float azimuth = glm::two_pi<float>() * float(sector) / float(detail);
+			vertices.push_back({ glm::vec3(std::sin(polar) * std::cos(azimuth), std::cos(polar), std::sin(polar) * std::sin(azimuth)) });
+		}
+	}
+	vertices.push_back({ glm::vec3(0.0f, -1.0f, 0.0f) });
+
+	const auto ring = [&](uint32_t stack, uint32_t sector) { return 1 + (stack - 1) * detail + sector % detail; };
+	const auto bottom = uint32_t(vertices.size() - 1);
+
+	for(uint32_t sector = 0; sector < detail; sector++)
+	{
+		indices.insert(indices.end(), { 0, ring(1, sector + 1), ring(1, sector) });
+		indices.insert(indices.end(), { bottom, ring(detail - 1, sector), ring(detail - 1, sector + 1) });
+
+		for(uint32_t stack = 1; stack + 1 < detail; stack++)
+		{
+			indices.insert(indices.end(), { ring(stack, sector), ring(stack, sector + 1), ring(stack + 1, sector) });
+			indices.insert(indices.end(), { ring(stack + 1, sector), ring(stack, sector + 1), ring(stack + 1, sector + 1) });
+		}
+	}
+}
+
+static std::vector<glm::vec3> GetPositions(const Model& model)
+{
+	const auto* vertices = static_cast<const TestVertex*>(model.Vertices->Data());
+
+	std::vector<glm::vec3> result;
+	for(size_t i = 0; i < model.Vertices->Count(); i++)
+	{
+		result.push_back(vertices[i].Position);
+	}
+	return result;
+}
+
+static void TestPlane()
+{
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t>   indices;
+	CreatePlane(32, vertices, indices);
+
+	std::vector<glm::vec3> positions;
+	for(const TestVertex& vertex : vertices)
+	{
+		positions.push_back(vertex.Position);
+	}
+
+	// The inside of a plane collapses without any error; only the border vertices are needed to cover it.
+	float error = -1.0f;
+	const std::vector<uint32_t> simplified = MeshSimplifier::Simplify(indices, positions, 0, 1e-4f, &error);
+	CHECK(error == 0.0f);
+	CHECK(simplified.size() < indices.size() / 8);
+
+	// Whatever is left covers the same area, facing the same way.
+	float area = 0.0f;
+	for(size_t i = 0; i < simplified.size(); i += 3)
+	{
+		const glm::vec3 normal = glm::cross(positions[simplified[i + 1]] - positions[simplified[i]], positions[simplified[i + 2]] - positions[simplified[i]]);
+		CHECK(normal.z > 0.0f);
+		area += 0.5f * normal.z;
+	}
+	CHECK(std::abs(area - 32.0f * 32.0f) < 1e-2f);
+
+	// The corners never move.
+	for(const uint32_t corner : { 0u, 32u, 33u * 32u, 33u * 33u - 1u })
+	{
+		CHECK(std::find(simplified.begin(), simplified.end(), corner) != simplified.end());
+	}
+}
+
+static void TestSphereChain()
+{
+	std::vector<TestVertex> vertices;
+	std::vector<uint32_t>   indices;
+	CreateSphere(48, vertices, indices);
+
+	const std::vector<LODModel> chain = MeshSimplifier::BuildLODChain(vertices, indices, 5, 0.5f);
+	CHECK(chain.size() == 5);
+	CHECK(chain[0].Error == 0.0f && *chain[0].Geometry.Indices == indices);
+
+	for(size_t level = 1; level < chain.size(); level++)
+	{
+		const std::vector<uint32_t>& levelIndices = *chain[level].Geometry.Indices;
+		const std::vector<glm::vec3> levelPositions = GetPositions(chain[level].Geometry);
+
+		const size_t previousTriangles = chain[level - 1].Geometry.Indices->size() / 3;
+		const size_t triangles = levelIndices.size() / 3;
+		CHECK(triangles <= previousTriangles / 2 + previousTriangles / 10);
+		CHECK(triangles >= previousTriangles / 4);
+
+		// Vertices only ever move onto other vertices, so they stay on the sphere and the error is how far the
+		// triangles between them cut inside it.
+		float deviation = 0.0f;
+		for(size_t i = 0; i < levelIndices.size(); i += 3)
+		{
+			const glm::vec3 center = (levelPositions[levelIndices[i]] + levelPositions[levelIndices[i + 1]] + levelPositions[levelIndices[i + 2]]) / 3.0f;
+			deviation = std::max(deviation, 1.0f - glm::length(center));
+		}
+
+		std::printf("Sphere level %zu: %zu triangles, error %.5f, deviation %.5f\n", level, triangles, chain[level].Error, deviation);
+
+		CHECK(chain[level].Error >= chain[level - 1].Error);
+		CHECK(chain[level].Error > 0.0f);
+		// The quadric error only measures the kept vertices against the original planes, so on a curved surface it
+		// understates how far the new triangles cut inside by a small factor.
+		CHECK(deviation <= chain[level].Error * 3.0f);
+		CHECK(deviation >= chain[level].Error);
+	}
+}
+
+static LODGroup CreateGroup()
+{
+	return LODGroup({ LODLevel(nullptr, 0.0f), LODLevel(nullptr, 0.01f), LODLevel(nullptr, 0.04f), LODLevel(nullptr, 0.16f) }, 0.25f);
+}
+
+static void TestSelection()
+{
+	LODGroup group = CreateGroup();
+
+	// Level 1 switches in once its error is under 0.75 pixels, and back out once it is over 1.
+	CHECK(group.SelectLevel(100.0f, 1.0f) == 0);
+	CHECK(group.SelectLevel( 75.0f, 1.0f) == 1);
+	CHECK(group.SelectLevel(  1.0f, 1.0f) == 3);
+
+	group.CurrentLevel = 1;
+	CHECK(group.SelectLevel( 99.0f, 1.0f) == 1);
+	CHECK(group.SelectLevel(101.0f, 1.0f) == 0);
+
+	// Far away from every threshold, selection jumps straight to the right level from either end.
+	group.CurrentLevel = 3;
+	CHECK(group.SelectLevel(1000.0f, 1.0f) == 0);
+	group.CurrentLevel = 0;
+	CHECK(group.SelectLevel(   4.0f, 1.0f) == 3);
+
+	// An object hovering around a switching distance settles on the finer level instead of popping back and forth.
+	group.CurrentLevel = 1;
+	size_t switches = 0;
+	for(int frame = 0; frame < 200; frame++)
+	{
+		// Between 0.9 and 1.1 pixels of error for level 1.
+		const float errorToPixels = 100.0f + 10.0f * std::sin(float(frame) * 0.3f);
+
+		const size_t level = group.SelectLevel(errorToPixels, 1.0f);
+		switches += level != group.CurrentLevel ? 1 : 0;
+		group.CurrentLevel = level;
+	}
+	CHECK(switches == 1 && group.CurrentLevel == 0);
+
+	// An out of range current level and an empty group are handled.
+	group.CurrentLevel = 10;
+	CHECK(group.SelectLevel(1.0f, 1.0f) == 3);
+	CHECK(LODGroup({}).SelectLevel(1.0f, 1.0f) == 0);
+}
+
+int main()
+{
+	TestPlane();
+	TestSphereChain();
+	TestSelection();
+	return FinishTests("MeshSimplifierTest");
+}
@@ -0,0 +1,158 @@
+#include <memory>
+#include <vector>
+
+#include <Engine/Rendering/CommandList.hpp>
+#include <Engine/Platform/Null/NullRenderDevice.hpp>
+
+#include "TestCheck.hpp"
+
+// Creates objects on the headless device, replays a command list on it and checks what the log recorded.
+
+struct TestVertex
+{
+	TestVertex(const glm::vec2& position) : Position(position) {}
+
+	glm::vec2 Position;
+
+	static BufferLayout GetLayout()
+	{
+		BufferLayout result;
+		result.AddAttribute<decltype(Position)>();
+		return result;
+	}
+};
+
+static MeshHandle CreateQuad(RenderDevice& renderDevice)
+{
+	const std::vector<TestVertex> vertices = { glm::vec2(-1, -1), glm::vec2(1, -1), glm::vec2(-1, 1), glm::vec2(1, 1) };
+	return renderDevice.CreateMesh(Model(vertices, { 0, 1, 2, 2, 1, 3 }));
+}
+
+static void TestCreation()
+{
+	auto log = std::make_shared<RenderCommandLog>();
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), log);
+	log->Clear();
+
+	MeshHandle quad = CreateQuad(renderDevice);
+	CHECK(quad->IndexSize == sizeof(uint16_t));
+
+	const RenderCommand createMesh = log->GetCommands().back();
+	CHECK(createMesh.Type == RenderCommandType::CreateMesh);
+	CHECK(createMesh.ByteCount == 4 * sizeof(TestVertex) + 6 * sizeof(uint16_t));
+	CHECK(createMesh.ElementCount == 4);
+
+	const AttachmentInfo colorAttachment(InternalImageFormat::RGBA8, ImageFormat::RGBA, TypeInfo::Get<glm::u8vec4>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge);
+	const AttachmentInfo depthAttachment(InternalImageFormat::DepthComponent32, ImageFormat::DepthComponent, TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge);
+	RenderTargetHandle target = renderDevice.CreateRenderTarget(64, 32, { colorAttachment }, depthAttachment);
+
+	auto instances = renderDevice.CreateRenderBuffer<glm::vec4>(2, 3, ClusterTableStorageSlot);
+	CHECK(log->GetCommands().back().Type == RenderCommandType::CreateRenderBuffer);
+	CHECK(log->GetCommands().back().Argument == ClusterTableStorageSlot);
+	CHECK(log->GetCommands().back().ByteCount == 2 * sizeof(glm::vec4));
+
+	auto constants = renderDevice.CreateConstantBlock(2, glm::vec4(1.0f), 4);
+	constants->Update(glm::vec4(2.0f));
+	CHECK(log->GetCommands().back().Type == RenderCommandType::UpdateConstantBuffer);
+	CHECK(log->GetCommands().back().Argument == 2);
+	CHECK(log->GetCommands().back().ByteCount == sizeof(glm::vec4));
+
+	const RenderStatistics statistics = log->GetStatistics();
+	CHECK(statistics.RenderTargetCount == 1);
+	CHECK(statistics.RenderTargetBytes == 64 * 32 * 4 * 2);
+	CHECK(statistics.UploadCount == 2);
+	CHECK(statistics.UploadedBytes == createMesh.ByteCount + sizeof(glm::vec4));
+	CHECK(statistics.DrawCount == 0);
+
+	// Nothing is kept while recording is off.
+	log->Clear();
+	log->SetRecording(false);
+	constants->Update(glm::vec4(3.0f));
+	CHECK(log->GetCommands().empty());
+}
+
+// Only plain uniform declarations are reported; arrays and blocks are skipped.
+static void TestShaderUniforms()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720));
+
+	ShaderHandle shader = renderDevice.CreateShader(
+		"uniform vec4 u_color;\n"
+		"uniform sampler2D u_texture;\n"
+		"uniform mat4 u_matrices[4];\n"
+		"layout(std140) uniform Block { vec4 value; } u_block;\n");
+
+	std::vector<Uniform> uniforms;
+	shader->GetUniforms(uniforms);
+	CHECK(uniforms.size() == 2);
+	CHECK(uniforms.size() == 2 && uniforms[0].Name == "u_color" && uniforms[0].Type == TypeInfo::Get<glm::vec4>());
+	CHECK(uniforms.size() == 2 && uniforms[1].Name == "u_texture" && uniforms[1].Type == TypeInfo::Get<int>());
+
+	CHECK( shader->GetUniform<glm::vec4>("u_color").IsValid());
+	CHECK(!shader->GetUniform<float>("u_color").IsValid());
+	CHECK(!shader->GetUniform<glm::mat4>("u_matrices").IsValid());
+}
+
+// A recorded list replays in order, and a draw of more instances than the buffer holds is split.
+static void TestReplay()
+{
+	auto log = std::make_shared<RenderCommandLog>();
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), log);
+
+	MeshHandle   quad      = CreateQuad(renderDevice);
+	ShaderHandle shader    = renderDevice.CreateShader("uniform vec4 u_color;\n");
+	auto         instances = renderDevice.CreateRenderBuffer<glm::vec4>(2);
+
+	CommandList commands;
+	commands.Enable(Blending);
+	commands.UseRenderTarget(*renderDevice.ScreenBuffer);
+	commands.UseShader(*shader);
+	commands.SetUniform(*shader, shader->GetUniform<glm::vec4>("u_color"), glm::vec4(1.0f));
+
+	glm::vec4* written = commands.Draw(*quad, *instances, 3);
+	written[0] = written[1] = written[2] = glm::vec4(0.5f);
+
+	log->Clear();
+	commands.Execute(renderDevice);
+
+	const std::vector<RenderCommandType> expected =
+	{
+		RenderCommandType::Enable,
+		RenderCommandType::UseRenderTarget,
+		RenderCommandType::UseShader,
+		RenderCommandType::SetUniform,
+		RenderCommandType::UpdateRenderBuffer,
+		RenderCommandType::Draw,
+		RenderCommandType::UpdateRenderBuffer,
+		RenderCommandType::Draw,
+	};
+
+	const std::vector<RenderCommand>& recorded = log->GetCommands();
+	CHECK(recorded.size() == expected.size());
+	for(size_t i = 0; i < recorded.size() && i < expected.size(); i++)
+	{
+		CHECK(recorded[i].Type == expected[i]);
+	}
+
+	const RenderStatistics statistics = log->GetStatistics();
+	CHECK(statistics.DrawCount == 2);
+	CHECK(statistics.InstanceCount == 3);
+	CHECK(statistics.TriangleCount == 6);
+	CHECK(statistics.StateChangeCount == 3);
+	CHECK(statistics.UploadCount == 3);
+	CHECK(statistics.UploadedBytes == sizeof(glm::vec4) * 4);
+	CHECK(log->Count(RenderCommandType::Draw) == 2);
+
+	// Replaying again records the same calls.
+	log->Clear();
+	commands.Execute(renderDevice);
+	CHECK(log->GetCommands().size() == expected.size());
+}
+
+int main()
+{
+	TestCreation();
+	TestShaderUniforms();
+	TestReplay();
+	return FinishTests("NullRenderDeviceTest");
+}
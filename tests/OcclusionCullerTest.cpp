@@ -0,0 +1,103 @@
+#include <vector>
+
+#include <glm/gtc/matrix_transform.hpp>
+
+#include <Engine/Rendering/OcclusionCuller.hpp>
+
+#include "TestCheck.hpp"
+
+// Rasterizes a wall in front of the camera and tests boxes around it against the depth buffer.
+
+// 90 degrees vertically over the culler's default 2:1 buffer, looking down -z from the origin.
+static const glm::mat4 ViewProjection = glm::perspective(glm::radians(90.0f), 2.0f, 0.1f, 100.0f) *
+                                        glm::lookAt(glm::vec3(0.0f), glm::vec3(0.0f, 0.0f, -1.0f), glm::vec3(0.0f, 1.0f, 0.0f));
+
+// A square of the given half size facing the camera at the given distance, covering the middle of the screen.
+static OccluderMesh CreateWall(float halfSize, float distance)
+{
+	return OccluderMesh(
+	{
+		glm::vec3(-halfSize, -halfSize, -distance),
+		glm::vec3( halfSize, -halfSize, -distance),
+		glm::vec3(-halfSize,  halfSize, -distance),
+		glm::vec3( halfSize,  halfSize, -distance),
+	},
+	{
+		0, 1, 2,
+		2, 1, 3,
+	});
+}
+
+static AABB CreateBox(const glm::vec3& center, float halfSize)
+{
+	return AABB(center - halfSize, center + halfSize);
+}
+
+static void TestRasterize()
+{
+	OcclusionCuller culler;
+	culler.BeginFrame(ViewProjection);
+	culler.AddOccluder(CreateWall(5.0f, 10.0f), glm::mat4(1.0f));
+	culler.Rasterize();
+
+	CHECK(culler.GetStatistics().OccluderCount == 1);
+	CHECK(culler.GetStatistics().TriangleCount == 2);
+
+	// The wall spans a quarter of the width and half the height around the centre, at its own depth.
+	const glm::vec4 clip = ViewProjection * glm::vec4(0.0f, 0.0f, -10.0f, 1.0f);
+	const float wallDepth = clip.z / clip.w * 0.5f + 0.5f;
+
+	const std::vector<float>& depth = culler.GetDepthBuffer();
+	const uint32_t width  = culler.Width();
+	const uint32_t height = culler.Height();
+
+	CHECK(glm::abs(depth[(height / 2) * width + width / 2] - wallDepth) < 1e-4f);
+	CHECK(glm::abs(depth[(height / 2 + height / 5) * width + width / 2 + width / 9] - wallDepth) < 1e-4f);
+	CHECK(depth[0] == 1.0f);
+	CHECK(depth[(height / 2) * width + width / 2 + width / 7] == 1.0f);
+	CHECK(depth[(height - 1) * width + width / 2] == 1.0f);
+}
+
+static void TestQueries()
+{
+	OcclusionCuller culler;
+	culler.BeginFrame(ViewProjection);
+	culler.AddOccluder(CreateWall(5.0f, 10.0f), glm::mat4(1.0f));
+	culler.Rasterize();
+
+	CHECK(!culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -20.0f), 1.0f)));
+	CHECK(!culler.IsVisible(CreateBox(glm::vec3(3.0f, 2.0f, -40.0f), 2.0f)));
+
+	// In front of the wall, beside it and straddling its edge.
+	CHECK(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -5.0f), 1.0f)));
+	CHECK(culler.IsVisible(CreateBox(glm::vec3(15.0f, 0.0f, -20.0f), 1.0f)));
+	CHECK(culler.IsVisible(CreateBox(glm::vec3(10.0f, 0.0f, -20.0f), 1.0f)));
+
+	// Crossing the near plane is always visible; beside the frustum never is.
+	CHECK(culler.IsVisible(CreateBox(glm::vec3(0.0f), 1.0f)));
+	CHECK(!culler.IsVisible(CreateBox(glm::vec3(-100.0f, 0.0f, -20.0f), 1.0f)));
+
+	CHECK(culler.GetStatistics().TestedCount == 7);
+	CHECK(culler.GetStatistics().CulledCount == 3);
+
+	// Turned to face sideways, the wall only covers the left of the screen.
+	culler.BeginFrame(ViewProjection);
+	culler.AddOccluder(CreateWall(5.0f, 10.0f), glm::rotate(glm::mat4(1.0f), glm::radians(90.0f), glm::vec3(0.0f, 1.0f, 0.0f)));
+	culler.Rasterize();
+
+	CHECK(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -20.0f), 1.0f)));
+
+	// A new frame starts from an empty buffer.
+	culler.BeginFrame(ViewProjection);
+	culler.Rasterize();
+
+	CHECK(culler.IsVisible(CreateBox(glm::vec3(0.0f, 0.0f, -20.0f), 1.0f)));
+	CHECK(culler.GetStatistics().OccluderCount == 0 && culler.GetStatistics().TestedCount == 1);
+}
+
+int main()
+{
+	TestRasterize();
+	TestQueries();
+	return FinishTests("OcclusionCullerTest");
+}
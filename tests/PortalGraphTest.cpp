@@ -0,0 +1,138 @@
+#include <string>
+#include <vector>
+#include <algorithm>
+
+#include <glm/gtc/constants.hpp>
+
+#include <Engine/Rendering/PortalGraph.hpp>
+
+#include "TestCheck.hpp"
+
+// Builds small tile levels and checks which cells the portal walk finds visible.
+
+// Rows from the top, '#' solid, '.' open and 'D' door; row y of the strings is tile row y.
+static PortalGraph CreateGraph(const std::vector<std::string>& rows)
+{
+	const glm::uvec2 size(uint32_t(rows[0].size()), uint32_t(rows.size()));
+
+	std::vector<TileType> tiles;
+	for(const std::string& row : rows)
+	{
+		for(const char tile : row)
+		{
+			tiles.push_back(tile == '#' ? TileType::Solid : tile == 'D' ? TileType::Door : TileType::Open);
+		}
+	}
+
+	return PortalGraph(size, tiles);
+}
+
+static bool IsVisible(const PortalGraph& graph, const std::vector<bool>& visibleCells, const glm::ivec2& tile)
+{
+	const uint32_t cell = graph.GetCell(tile);
+	return cell != PortalGraph::InvalidCell && visibleCells[cell];
+}
+
+static void TestDoor()
+{
+	PortalGraph graph = CreateGraph(
+	{
+		"#######",
+		"...D...",
+		"#######",
+	});
+
+	CHECK(graph.GetCells().size() == 3);
+	CHECK(graph.GetPortals().size() == 2);
+	CHECK(graph.GetCell(glm::ivec2(0, 0)) == PortalGraph::InvalidCell);
+	CHECK(graph.GetCell(glm::ivec2(-1, 1)) == PortalGraph::InvalidCell);
+	CHECK(graph.GetCell(glm::ivec2(0, 1)) == graph.GetCell(glm::ivec2(2, 1)));
+
+	const glm::vec2 eye(0.5f, 1.5f);
+	const uint32_t  door = graph.GetCell(glm::ivec2(3, 1));
+
+	// Doors start closed: a closed door is seen but not seen through, unless the eye stands in it.
+	std::vector<bool> visibleCells;
+	graph.FindVisibleCells(eye, glm::vec2(1.0f, 0.0f), glm::quarter_pi<float>(), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(3, 1)));
+	CHECK(!IsVisible(graph, visibleCells, glm::ivec2(6, 1)));
+
+	graph.FindVisibleCells(glm::vec2(3.5f, 1.5f), glm::vec2(1.0f, 0.0f), glm::quarter_pi<float>(), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(6, 1)));
+
+	graph.SetBlocking(door, false);
+
+	graph.FindVisibleCells(eye, glm::vec2(1.0f, 0.0f), glm::quarter_pi<float>(), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(3, 1)));
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(6, 1)));
+
+	// Looking away from the door only sees the eye's own cell.
+	graph.FindVisibleCells(eye, glm::vec2(-1.0f, 0.0f), glm::quarter_pi<float>(), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(0, 1)));
+	CHECK(!IsVisible(graph, visibleCells, glm::ivec2(3, 1)));
+}
+
+static void TestCorners()
+{
+	// A corridor that turns twice: the last leg is hidden behind the first corner.
+	PortalGraph graph = CreateGraph(
+	{
+		".....",
+		"####.",
+		"####.",
+		"####.",
+		".....",
+	});
+
+	std::vector<bool> visibleCells;
+	graph.FindVisibleCells(glm::vec2(0.5f, 0.5f), glm::vec2(1.0f, 0.0f), glm::quarter_pi<float>(), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(4, 0)));
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(4, 2)));
+	CHECK(!IsVisible(graph, visibleCells, glm::ivec2(0, 4)));
+
+	// From the bend both legs are in view.
+	graph.FindVisibleCells(glm::vec2(4.5f, 2.5f), glm::vec2(0.0f, 1.0f), glm::half_pi<float>(), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(0, 4)));
+
+	// Outside the level nothing is visible.
+	graph.FindVisibleCells(glm::vec2(0.5f, 2.5f), glm::vec2(1.0f, 0.0f), glm::quarter_pi<float>(), visibleCells);
+	CHECK(visibleCells.size() == graph.GetCells().size());
+	CHECK(std::find(visibleCells.begin(), visibleCells.end(), true) == visibleCells.end());
+}
+
+static void TestBudget()
+{
+	// Door tiles each become a cell of their own, so an open floor of them is a lattice of single tile cells with
+	// far more paths through it than the walk's budget covers. A wall with one closed door shuts off the last column.
+	const uint32_t size = 200;
+
+	std::vector<std::string> rows;
+	for(uint32_t y = 0; y < size; y++)
+	{
+		rows.push_back(std::string(size - 2, 'D') + (y == size / 2 ? "D" : "#") + ".");
+	}
+
+	PortalGraph graph = CreateGraph(rows);
+	for(uint32_t cell = 0; cell < graph.GetCells().size(); cell++)
+	{
+		graph.SetBlocking(cell, false);
+	}
+
+	graph.SetBlocking(graph.GetCell(glm::ivec2(size - 2, size / 2)), true);
+
+	// Once the walk gives up, everything reachable without passing the closed door is marked, even outside the view.
+	std::vector<bool> visibleCells;
+	graph.FindVisibleCells(glm::vec2(0.5f, 0.5f), glm::normalize(glm::vec2(1.0f, 1.0f)), glm::radians(30.0f), visibleCells);
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(size / 2, size / 2)));
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(size - 3, 0)));
+	CHECK(IsVisible(graph, visibleCells, glm::ivec2(size - 2, size / 2)));
+	CHECK(!IsVisible(graph, visibleCells, glm::ivec2(size - 1, size / 2)));
+}
+
+int main()
+{
+	TestDoor();
+	TestCorners();
+	TestBudget();
+	return FinishTests("PortalGraphTest");
+}
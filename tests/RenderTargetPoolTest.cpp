@@ -0,0 +1,144 @@
+#include <memory>
+
+#include <Engine/Rendering/RenderTargetPool.hpp>
+#include <Engine/Platform/Null/NullRenderDevice.hpp>
+
+#include "TestCheck.hpp"
+
+// Acquires and releases targets on the headless device and checks what the pool reuses, keeps and reports.
+
+static const AttachmentInfo ColorAttachment(InternalImageFormat::RGBA8, ImageFormat::RGBA, TypeInfo::Get<glm::u8vec4>(), MinFilterMode::Linear, MagFilterMode::Linear, TextureWrappingMode::ClampedToEdge);
+static const AttachmentInfo DepthAttachment(InternalImageFormat::DepthComponent32, ImageFormat::DepthComponent, TypeInfo::Get<glm::f32vec1>(), MinFilterMode::Nearest, MagFilterMode::Nearest, TextureWrappingMode::ClampedToEdge);
+
+static const RenderTargetDescription ColorDescription(256, 128, { ColorAttachment });
+static const RenderTargetDescription DepthDescription(256, 128, { ColorAttachment }, DepthAttachment);
+
+static void TestReuse()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), std::make_shared<RenderCommandLog>());
+	RenderTargetPool& pool = renderDevice.TargetPool;
+
+	CHECK(ColorDescription.GetSizeInBytes() == 256 * 128 * 4);
+	CHECK(DepthDescription.GetSizeInBytes() == 256 * 128 * 8);
+
+	// A released target goes to the next pass asking for the same description, but not to a different one.
+	RenderTargetHandle first = pool.Acquire(ColorDescription);
+	pool.Release(first);
+
+	RenderTargetHandle second = pool.Acquire(ColorDescription);
+	CHECK(second == first);
+
+	RenderTargetHandle third = pool.Acquire(ColorDescription);
+	CHECK(third != first);
+
+	RenderTargetHandle depth = pool.Acquire(DepthDescription);
+	CHECK(depth != first && depth != third);
+
+	pool.Release(second);
+	pool.Release(third);
+	pool.Release(depth);
+	pool.EndFrame();
+
+	// Four requests were served by three targets.
+	RenderTargetPoolStatistics statistics = pool.GetStatistics();
+	CHECK(statistics.TargetCount == 3);
+	CHECK(statistics.AllocatedBytes == ColorDescription.GetSizeInBytes() * 2 + DepthDescription.GetSizeInBytes());
+	CHECK(statistics.RequestedBytes == ColorDescription.GetSizeInBytes() * 3 + DepthDescription.GetSizeInBytes());
+	CHECK(statistics.GetSavedBytes() == ColorDescription.GetSizeInBytes());
+
+	// Unused targets are destroyed once they have not been asked for in FramesToKeep frames.
+	for(uint32_t frame = 0; frame < pool.FramesToKeep; frame++)
+	{
+		pool.Release(pool.Acquire(ColorDescription));
+		pool.EndFrame();
+	}
+	statistics = pool.GetStatistics();
+	CHECK(statistics.TargetCount == 1);
+	CHECK(statistics.AllocatedBytes == ColorDescription.GetSizeInBytes());
+	CHECK(statistics.RequestedBytes == ColorDescription.GetSizeInBytes());
+
+	pool.EndFrame();
+	pool.EndFrame();
+	pool.EndFrame();
+	pool.EndFrame();
+	CHECK(pool.GetStatistics().TargetCount == 0);
+}
+
+// A target held over several frames, the way the water reflections keep theirs, counts as requested in each of them.
+static void TestHeldTargets()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), std::make_shared<RenderCommandLog>());
+	RenderTargetPool& pool = renderDevice.TargetPool;
+
+	RenderTargetHandle held = pool.Acquire(DepthDescription);
+
+	for(int frame = 0; frame < 10; frame++)
+	{
+		pool.Release(pool.Acquire(ColorDescription));
+		pool.Release(pool.Acquire(ColorDescription));
+		pool.EndFrame();
+
+		const RenderTargetPoolStatistics statistics = pool.GetStatistics();
+		CHECK(statistics.TargetCount == 2);
+		CHECK(statistics.AllocatedBytes == ColorDescription.GetSizeInBytes() + DepthDescription.GetSizeInBytes());
+		CHECK(statistics.RequestedBytes == ColorDescription.GetSizeInBytes() * 2 + DepthDescription.GetSizeInBytes());
+		CHECK(statistics.GetSavedBytes() == ColorDescription.GetSizeInBytes());
+	}
+
+	// Held targets are never destroyed, but once released they stop counting and age like any other.
+	pool.Release(held);
+	pool.EndFrame();
+	CHECK(pool.GetStatistics().RequestedBytes == 0);
+	CHECK(pool.GetStatistics().TargetCount == 1);
+}
+
+static void TestTransientAliasing()
+{
+	NullRenderDevice renderDevice(ScreenGraphicsMode(1280, 720), std::make_shared<RenderCommandLog>());
+	RenderTargetPool& pool = renderDevice.TargetPool;
+
+	// Passes 0-1 and 2-3 never overlap, 1-2 overlaps both, and the depth target only matches itself.
+	TransientRenderTargets targets;
+	const size_t early  = targets.Declare(ColorDescription, 0, 1);
+	const size_t middle = targets.Declare(ColorDescription, 1, 2);
+	const size_t late   = targets.Declare(ColorDescription, 2, 3);
+	const size_t depth  = targets.Declare(DepthDescription, 2, 3);
+	const size_t last   = targets.Declare(ColorDescription, 3, 3);
+
+	CHECK(targets.GetDeclaredCount() == 5);
+	CHECK(targets.GetPhysicalCount() == 3);
+
+	targets.Acquire(pool);
+	CHECK(targets.Get(early) == targets.Get(late));
+	CHECK(targets.Get(middle) == targets.Get(last));
+	CHECK(targets.Get(early) != targets.Get(middle));
+	CHECK(targets.Get(depth) != targets.Get(early) && targets.Get(depth) != targets.Get(middle));
+	targets.Release(pool);
+	pool.EndFrame();
+
+	// The statistics count every declaration as its own target.
+	const RenderTargetPoolStatistics statistics = pool.GetStatistics();
+	CHECK(statistics.TargetCount == 3);
+	CHECK(statistics.RequestedBytes == ColorDescription.GetSizeInBytes() * 4 + DepthDescription.GetSizeInBytes());
+	CHECK(statistics.GetSavedBytes() == ColorDescription.GetSizeInBytes() * 2);
+
+	// Later frames reuse the same physical targets.
+	targets.Acquire(pool);
+	targets.Release(pool);
+	pool.EndFrame();
+	CHECK(pool.GetStatistics().TargetCount == 3);
+
+	// Declaring again plans again; overlapping targets no longer alias.
+	targets.Reset();
+	targets.Declare(ColorDescription, 0, 3);
+	targets.Declare(ColorDescription, 1, 2);
+	CHECK(targets.GetPhysicalCount() == 2);
+}
+
+int main()
+{
+	TestReuse();
+	TestHeldTargets();
+	TestTransientAliasing();
+	return FinishTests("RenderTargetPoolTest");
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include <cstdio>
+
+// Minimal checking for the test executables: failed checks are printed and counted, and main returns the count so
+// ctest reports the test as failed.
+
+inline int& GetFailedCheckCount()
+{
+	static int count = 0;
+	return count;
+}
+
+#define CHECK(condition) \
+	do \
+	{ \
+		if(!(condition)) \
+		{ \
+			std::printf("%s:%d: check failed: %s\n", __FILE__, __LINE__, #condition); \
+			++GetFailedCheckCount(); \
+		} \
+	} while(false)
+
+inline int FinishTests(const char* name)
+{
+	if(GetFailedCheckCount() > 0)
+	{
+		std::printf("%s: %d checks failed.\n", name, GetFailedCheckCount());
+		return 1;
+	}
+
+	std::printf("%s: all checks passed.\n", name);
+	return 0;
+}